@@ -15,6 +15,8 @@ find_package(ZLIB REQUIRED)
 list(APPEND CMAKE_MODULE_PATH "${CMAKE_CURRENT_LIST_DIR}/..")
 find_package(Nghttp2 REQUIRED)
 find_package(LibEv REQUIRED)
+find_package(Brotli REQUIRED)
+find_package(Zstd REQUIRED)
 find_package(UserverGTest REQUIRED)
 find_package(UserverGBench REQUIRED)
 
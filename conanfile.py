@@ -106,6 +106,8 @@ class UserverConan(ConanFile):
         self.requires('cryptopp/8.7.0')
         self.requires('fmt/8.1.1', transitive_headers=True)
         self.requires('libnghttp2/1.51.0')
+        self.requires('brotli/1.1.0')
+        self.requires('zstd/1.5.5')
         self.requires('libcurl/7.86.0')
         self.requires('libev/4.33')
         self.requires('openssl/1.1.1s')
@@ -383,6 +385,12 @@ class UserverConan(ConanFile):
         def libnghttp2():
             return ['libnghttp2::libnghttp2']
 
+        def brotli():
+            return ['brotli::brotli']
+
+        def zstd():
+            return ['zstd::zstd']
+
         def openssl():
             return ['openssl::openssl']
 
@@ -455,6 +463,8 @@ class UserverConan(ConanFile):
                     + yaml()
                     + libev()
                     + libnghttp2()
+                    + brotli()
+                    + zstd()
                     + curl()
                     + cryptopp()
                     + jemalloc()
@@ -25,6 +25,7 @@ struct UpdateStatistics final {
 
   utils::statistics::RateCounter documents_read_count{0};
   utils::statistics::RateCounter documents_parse_failures{0};
+  utils::statistics::RateCounter documents_chunks_count{0};
 
   std::atomic<std::chrono::steady_clock::time_point> last_update_start_time{{}};
   std::atomic<std::chrono::steady_clock::time_point>
@@ -84,6 +85,12 @@ class UpdateStatisticsScope final {
   /// @param add the number of non-valid items newly received
   void IncreaseDocumentsParseFailures(std::size_t add);
 
+  /// @brief Each chunk of items applied to the cache during a chunked update
+  /// should be accounted with this function, see cache::ChunkedUpdate
+  /// @note This method can be called multiple times per `Update`
+  /// @param add the number of chunks newly applied
+  void IncreaseChunksCount(std::size_t add);
+
  private:
   void DoFinish(impl::UpdateState new_state);
 
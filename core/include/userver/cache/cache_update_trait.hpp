@@ -10,6 +10,7 @@
 #include <userver/cache/update_type.hpp>
 #include <userver/components/component_fwd.hpp>
 #include <userver/dump/fwd.hpp>
+#include <userver/dump/helpers.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/rcu/fwd.hpp>
 #include <userver/utils/flags.hpp>
@@ -135,6 +136,21 @@ class CacheUpdateTrait {
 
   virtual void ReadAndSet(dump::Reader& reader);
 
+  /// @brief Override to write the changes made by incremental updates as
+  /// dump deltas, see `dump.max-delta-count` in dump::Dumper
+  ///
+  /// Should write the changes made after `since`, or return `false` if they
+  /// are unknown. The call is skipped, and a full dump is written, if there
+  /// has been a full update after `since`.
+  virtual bool GetAndWriteDelta(dump::Writer& writer,
+                                dump::TimePoint since) const;
+
+  /// @brief Override to apply the changes written by GetAndWriteDelta to the
+  /// cache
+  /// @returns `false` without reading anything if deltas are not supported.
+  /// The remaining deltas of the dump are removed then.
+  virtual bool ReadAndApplyDelta(dump::Reader& reader);
+
   class Impl;
   std::unique_ptr<Impl> impl_;
 };
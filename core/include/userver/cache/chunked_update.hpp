@@ -0,0 +1,113 @@
+#pragma once
+
+/// @file userver/cache/chunked_update.hpp
+/// @brief @copybrief cache::ChunkedUpdate
+
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include <userver/cache/cache_statistics.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @ingroup userver_concurrency
+///
+/// @brief Helper for the cache updates that receive the data in chunks, e.g.
+/// via PostgreSQL portals.
+///
+/// Each chunk is parsed in a separate task, up to `max_parallel_chunks` at
+/// once, while the updater task keeps fetching the next chunks. The parsed
+/// chunks are passed to `merge` in the order they were pushed and from the
+/// updater task only, so the cache container needs no synchronization.
+///
+/// If `max_parallel_chunks` is 0, the chunks are parsed and merged right in
+/// Push().
+///
+/// Each merged chunk is accounted in UpdateStatisticsScope.
+template <typename ParsedChunk>
+class ChunkedUpdate final {
+ public:
+  using MergeFunc = std::function<void(ParsedChunk&&)>;
+
+  ChunkedUpdate(std::size_t max_parallel_chunks,
+                UpdateStatisticsScope& stats_scope, MergeFunc merge);
+
+  ChunkedUpdate(ChunkedUpdate&&) = delete;
+  ChunkedUpdate& operator=(ChunkedUpdate&&) = delete;
+
+  /// @brief Starts `parse()` for the next chunk.
+  ///
+  /// Merges the earliest chunk first if `max_parallel_chunks` chunks are
+  /// already being parsed.
+  template <typename ParseFunc>
+  void Push(ParseFunc&& parse);
+
+  /// Waits for all the pushed chunks and merges them
+  void Finish();
+
+ private:
+  void MergeChunk(ParsedChunk&& chunk);
+
+  const std::size_t max_parallel_chunks_;
+  UpdateStatisticsScope& stats_scope_;
+  const MergeFunc merge_;
+  // Tasks are cancelled and awaited on destruction, e.g. on fetch failure
+  std::deque<engine::TaskWithResult<ParsedChunk>> parsing_;
+};
+
+template <typename ParsedChunk>
+ChunkedUpdate<ParsedChunk>::ChunkedUpdate(std::size_t max_parallel_chunks,
+                                          UpdateStatisticsScope& stats_scope,
+                                          MergeFunc merge)
+    : max_parallel_chunks_(max_parallel_chunks),
+      stats_scope_(stats_scope),
+      merge_(std::move(merge)) {}
+
+template <typename ParsedChunk>
+template <typename ParseFunc>
+void ChunkedUpdate<ParsedChunk>::Push(ParseFunc&& parse) {
+  static_assert(std::is_invocable_r_v<ParsedChunk, ParseFunc&>,
+                "ParseFunc must return the ParsedChunk");
+
+  if (max_parallel_chunks_ == 0) {
+    MergeChunk(parse());
+    return;
+  }
+
+  while (parsing_.size() >= max_parallel_chunks_) {
+    auto task = std::move(parsing_.front());
+    parsing_.pop_front();
+    MergeChunk(task.Get());
+  }
+  parsing_.push_back(utils::Async(
+      "cache-parse-chunk",
+      [parse = std::forward<ParseFunc>(parse)]() mutable -> ParsedChunk {
+        return parse();
+      }));
+}
+
+template <typename ParsedChunk>
+void ChunkedUpdate<ParsedChunk>::Finish() {
+  while (!parsing_.empty()) {
+    auto task = std::move(parsing_.front());
+    parsing_.pop_front();
+    MergeChunk(task.Get());
+  }
+}
+
+template <typename ParsedChunk>
+void ChunkedUpdate<ParsedChunk>::MergeChunk(ParsedChunk&& chunk) {
+  merge_(std::move(chunk));
+  stats_scope_.IncreaseChunksCount(1);
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -6,6 +6,9 @@
 #include <atomic>
 #include <chrono>
 #include <optional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <userver/cache/lru_cache_config.hpp>
 #include <userver/cache/lru_cache_statistics.hpp>
@@ -17,6 +20,7 @@
 #include <userver/utils/datetime.hpp>
 #include <userver/utils/impl/cached_time.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
+#include <userver/utils/scope_guard.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -61,6 +65,11 @@ template <typename Key, typename Value, typename Hash = std::hash<Key>,
 class ExpirableLruCache final {
  public:
   using UpdateValueFunc = std::function<Value(const Key&)>;
+  using ValuesMap = std::unordered_map<Key, Value, Hash, Equal>;
+  /// Loads the values of all the passed keys at once. Keys without a value
+  /// may be omitted from the result.
+  using BulkUpdateValuesFunc =
+      std::function<ValuesMap(const std::vector<Key>&)>;
 
   /// Cache read mode
   enum class ReadMode {
@@ -73,6 +82,11 @@ class ExpirableLruCache final {
   ExpirableLruCache(size_t ways, size_t way_size, const Hash& hash = Hash(),
                     const Equal& equal = Equal());
 
+  /// For the description of `ways`, `way_size` and `policy`,
+  /// see the cache::NWayLRU::NWayLRU constructors.
+  ExpirableLruCache(size_t ways, size_t way_size, CachePolicy policy,
+                    const Hash& hash = Hash(), const Equal& equal = Equal());
+
   ~ExpirableLruCache();
 
   /// For the description of `way_size`,
@@ -98,6 +112,21 @@ class ExpirableLruCache final {
   Value Get(const Key& key, const UpdateValueFunc& update_func,
             ReadMode read_mode = ReadMode::kUseCache);
 
+  /**
+   * @returns values for all the "keys" that are either in cache and not
+   * expired or are returned by "bulk_update_func". All the missing keys are
+   * loaded by a single "bulk_update_func" call, the keys that are being loaded
+   * by concurrent Get() or GetMany() calls are waited for instead of being
+   * loaded once more. The loaded values are stored in cache if "read_mode" is
+   * kUseCache.
+   *
+   * Values that are about to expire are updated in background with a single
+   * "bulk_update_func" call if background update mode is kEnabled.
+   */
+  ValuesMap GetMany(const std::vector<Key>& keys,
+                    const BulkUpdateValuesFunc& bulk_update_func,
+                    ReadMode read_mode = ReadMode::kUseCache);
+
   /**
    * Update value in cache by "update_func" if background update mode is
    * kEnabled and "key" is in cache and not expired but its lifetime ends soon.
@@ -144,6 +173,10 @@ class ExpirableLruCache final {
   /// Add async task for updating value by update_func(key)
   void UpdateInBackground(const Key& key, UpdateValueFunc update_func);
 
+  /// Add async task for updating values by a single bulk_update_func(keys)
+  void UpdateManyInBackground(std::vector<Key> keys,
+                              BulkUpdateValuesFunc bulk_update_func);
+
   void Write(dump::Writer& writer) const;
 
   void Read(dump::Reader& reader);
@@ -159,6 +192,10 @@ class ExpirableLruCache final {
   bool ShouldUpdate(std::chrono::steady_clock::time_point update_time,
                     std::chrono::steady_clock::time_point now) const;
 
+  void PutLoaded(const std::vector<Key>& keys, ValuesMap& values,
+                 std::chrono::steady_clock::time_point now, ReadMode read_mode,
+                 ValuesMap& result);
+
   cache::NWayLRU<Key, impl::ExpirableValue<Value>, Hash, Equal> lru_;
   std::atomic<std::chrono::milliseconds> max_lifetime_{
       std::chrono::milliseconds(0)};
@@ -172,7 +209,13 @@ class ExpirableLruCache final {
 template <typename Key, typename Value, typename Hash, typename Equal>
 ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
     size_t ways, size_t way_size, const Hash& hash, const Equal& equal)
-    : lru_(ways, way_size, hash, equal),
+    : ExpirableLruCache(ways, way_size, CachePolicy::kLRU, hash, equal) {}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
+    size_t ways, size_t way_size, CachePolicy policy, const Hash& hash,
+    const Equal& equal)
+    : lru_(ways, way_size, policy, hash, equal),
       mutex_set_{ways, way_size, hash, equal} {}
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -228,6 +271,101 @@ Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
   return value;
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+typename ExpirableLruCache<Key, Value, Hash, Equal>::ValuesMap
+ExpirableLruCache<Key, Value, Hash, Equal>::GetMany(
+    const std::vector<Key>& keys, const BulkUpdateValuesFunc& bulk_update_func,
+    ReadMode read_mode) {
+  auto now = utils::datetime::SteadyNow();
+  ValuesMap result;
+  result.reserve(keys.size());
+
+  std::vector<Key> missing;
+  std::vector<Key> to_update;
+  std::unordered_set<Key, Hash, Equal> seen;
+  seen.reserve(keys.size());
+  for (const auto& key : keys) {
+    if (!seen.insert(key).second) continue;
+
+    auto old_value = lru_.Get(key);
+    if (old_value) {
+      if (!IsExpired(old_value->update_time, now)) {
+        impl::CacheHit(stats_);
+        if (ShouldUpdate(old_value->update_time, now)) to_update.push_back(key);
+        result.emplace(key, std::move(old_value->value));
+        continue;
+      }
+      impl::CacheStale(stats_);
+    }
+    impl::CacheMiss(stats_);
+    missing.push_back(key);
+  }
+
+  if (!to_update.empty()) {
+    UpdateManyInBackground(std::move(to_update), bulk_update_func);
+  }
+  if (missing.empty()) return result;
+
+  // Only try_lock is used while holding other keys, so concurrent GetMany()
+  // calls with overlapping keys can not deadlock.
+  std::vector<Key> to_load;
+  std::vector<Key> busy;
+  {
+    std::vector<concurrent::ItemMutex<Key, Equal>> locked;
+    locked.reserve(missing.size());
+    utils::ScopeGuard unlock_guard([&locked] {
+      for (auto& mutex : locked) mutex.unlock();
+    });
+
+    for (auto& key : missing) {
+      auto mutex = mutex_set_.GetMutexForKey(key);
+      if (!mutex.try_lock()) {
+        busy.push_back(std::move(key));
+        continue;
+      }
+      locked.push_back(std::move(mutex));
+
+      // Test one more time - concurrent ExpirableLruCache::Get()
+      // might have put the value
+      auto old_value = lru_.Get(key);
+      if (old_value && !IsExpired(old_value->update_time, now)) {
+        result.emplace(std::move(key), std::move(old_value->value));
+      } else {
+        to_load.push_back(std::move(key));
+      }
+    }
+
+    if (!to_load.empty()) {
+      auto values = bulk_update_func(to_load);
+      PutLoaded(to_load, values, now, read_mode, result);
+    }
+  }
+
+  // Wait for the concurrent updates of the rest of the keys one by one
+  to_load.clear();
+  for (auto& key : busy) {
+    {
+      auto mutex = mutex_set_.GetMutexForKey(key);
+      std::lock_guard lock(mutex);
+    }
+    auto old_value = lru_.Get(key);
+    if (old_value && !IsExpired(old_value->update_time, now)) {
+      result.emplace(std::move(key), std::move(old_value->value));
+    } else {
+      to_load.push_back(std::move(key));
+    }
+  }
+
+  // The concurrent update has not stored the values, e.g. it was done with
+  // ReadMode::kSkipCache
+  if (!to_load.empty()) {
+    auto values = bulk_update_func(to_load);
+    PutLoaded(to_load, values, now, read_mode, result);
+  }
+
+  return result;
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptional(
     const Key& key, const UpdateValueFunc& update_func) {
@@ -365,6 +503,54 @@ void ExpirableLruCache<Key, Value, Hash, Equal>::UpdateInBackground(
   }).Detach();
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::UpdateManyInBackground(
+    std::vector<Key> keys, BulkUpdateValuesFunc bulk_update_func) {
+  stats_.total.background_updates += keys.size();
+  stats_.recent.GetCurrentCounter().background_updates += keys.size();
+
+  // cache will wait for all detached tasks in ~ExpirableLruCache()
+  engine::AsyncNoSpan([token = wait_token_storage_.GetToken(), this,
+                       keys = std::move(keys),
+                       bulk_update_func = std::move(bulk_update_func)] {
+    std::vector<Key> to_update;
+    std::vector<concurrent::ItemMutex<Key, Equal>> locked;
+    to_update.reserve(keys.size());
+    locked.reserve(keys.size());
+    utils::ScopeGuard unlock_guard([&locked] {
+      for (auto& mutex : locked) mutex.unlock();
+    });
+
+    for (const auto& key : keys) {
+      auto mutex = mutex_set_.GetMutexForKey(key);
+      // skip the keys someone is updating right now
+      if (!mutex.try_lock()) continue;
+      locked.push_back(std::move(mutex));
+      to_update.push_back(key);
+    }
+    if (to_update.empty()) return;
+
+    auto now = utils::datetime::SteadyNow();
+    auto values = bulk_update_func(to_update);
+    impl::CacheBulkUpdate(stats_, to_update.size());
+    for (auto& [key, value] : values) {
+      lru_.Put(key, {std::move(value), now});
+    }
+  }).Detach();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void ExpirableLruCache<Key, Value, Hash, Equal>::PutLoaded(
+    const std::vector<Key>& keys, ValuesMap& values,
+    std::chrono::steady_clock::time_point now, ReadMode read_mode,
+    ValuesMap& result) {
+  impl::CacheBulkUpdate(stats_, keys.size());
+  for (auto& [key, value] : values) {
+    if (read_mode == ReadMode::kUseCache) lru_.Put(key, {value, now});
+    result.emplace(key, std::move(value));
+  }
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 bool ExpirableLruCache<Key, Value, Hash, Equal>::IsExpired(
     std::chrono::steady_clock::time_point update_time,
@@ -391,13 +577,28 @@ class LruCacheWrapper final {
 
   LruCacheWrapper(std::shared_ptr<Cache> cache,
                   typename Cache::UpdateValueFunc update_func)
-      : cache_(std::move(cache)), update_func_(std::move(update_func)) {}
+      : cache_(std::move(cache)),
+        update_func_(std::move(update_func)),
+        bulk_update_func_(MakeBulkUpdateFunc(update_func_)) {}
+
+  LruCacheWrapper(std::shared_ptr<Cache> cache,
+                  typename Cache::UpdateValueFunc update_func,
+                  typename Cache::BulkUpdateValuesFunc bulk_update_func)
+      : cache_(std::move(cache)),
+        update_func_(std::move(update_func)),
+        bulk_update_func_(std::move(bulk_update_func)) {}
 
   /// Get cached value or evaluates if "key" is missing in cache
   Value Get(const Key& key, ReadMode read_mode = ReadMode::kUseCache) {
     return cache_->Get(key, update_func_, read_mode);
   }
 
+  /// Get cached values and evaluate all the missing ones at once
+  typename Cache::ValuesMap GetMany(const std::vector<Key>& keys,
+                                    ReadMode read_mode = ReadMode::kUseCache) {
+    return cache_->GetMany(keys, bulk_update_func_, read_mode);
+  }
+
   /// Get cached value or "nullopt" if "key" is missing in cache
   std::optional<Value> GetOptional(const Key& key) {
     return cache_->GetOptional(key, update_func_);
@@ -414,8 +615,20 @@ class LruCacheWrapper final {
   std::shared_ptr<Cache> GetCache() { return cache_; }
 
  private:
+  static typename Cache::BulkUpdateValuesFunc MakeBulkUpdateFunc(
+      typename Cache::UpdateValueFunc update_func) {
+    return
+        [update_func = std::move(update_func)](const std::vector<Key>& keys) {
+          typename Cache::ValuesMap values;
+          values.reserve(keys.size());
+          for (const auto& key : keys) values.emplace(key, update_func(key));
+          return values;
+        };
+  }
+
   std::shared_ptr<Cache> cache_;
   typename Cache::UpdateValueFunc update_func_;
+  typename Cache::BulkUpdateValuesFunc bulk_update_func_;
 };
 
 template <typename Key, typename Value, typename Hash, typename Equal>
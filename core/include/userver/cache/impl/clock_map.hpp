@@ -0,0 +1,271 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <userver/rcu/rcu.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Key value storage with the CLOCK eviction policy, see
+/// cache::CachePolicy::kClock.
+///
+/// Find may be called concurrently with any method and does not lock: the
+/// index is published via rcu::Variable, and a hit only sets the reference bit
+/// of the element. All the other methods must be serialized by the caller.
+///
+/// The index is split into about sqrt(max_size) shards, so a modification
+/// copies the table of the shard pointers and the one or two shards it
+/// touches, O(sqrt(max_size)) instead of the whole index.
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class ClockMap final {
+ public:
+  ClockMap(std::size_t max_size, const Hash& hash, const Equal& equal)
+      : max_size_(max_size ? max_size : 1),
+        hash_(hash),
+        equal_(equal),
+        current_shard_count_(GetShardCount(max_size_)),
+        index_(MakeTable(current_shard_count_)) {
+    UASSERT(max_size > 0);
+  }
+
+  ClockMap(const ClockMap&) = delete;
+  ClockMap& operator=(const ClockMap&) = delete;
+
+  /// Calls `func(const U&)` for the value of the key and marks the key as
+  /// recently used. @returns false if there is no such key.
+  template <typename Function>
+  bool Find(const T& key, Function&& func) const;
+
+  void Put(const T& key, U value);
+
+  void Erase(const T& key);
+
+  void SetMaxSize(std::size_t new_max_size);
+
+  void Clear();
+
+  /// Call Function(const T&, const U&) for all items
+  template <typename Function>
+  void VisitAll(Function&& func) const;
+
+  std::size_t GetSize() const { return ring_.size(); }
+
+ private:
+  struct Entry final {
+    Entry(const T& key, U&& value) : key(key), value(std::move(value)) {}
+
+    const T key;
+    const U value;
+    mutable std::atomic<bool> referenced{false};
+    // position in ring_, used by writers only
+    std::size_t slot{0};
+  };
+
+  using Shard = std::unordered_map<T, std::shared_ptr<Entry>, Hash, Equal>;
+  // The shards are immutable once published, a writer replaces the pointer
+  using Table = std::vector<std::shared_ptr<const Shard>>;
+
+  static std::size_t GetShardCount(std::size_t max_size);
+  Table MakeTable(std::size_t shard_count) const;
+  std::size_t GetShardIndex(std::size_t shard_count, const T& key) const;
+  // Replaces the shard of `key` in `table` with a copy and returns the copy
+  Shard& CopyShard(Table& table, const T& key) const;
+
+  // Evicts the first element without the reference bit that the clock hand
+  // meets and clears the bits it passes. Returns the freed slot.
+  std::size_t Evict(Table& table);
+  void RemoveSlot(std::size_t slot);
+
+  std::size_t max_size_;
+  const Hash hash_;
+  const Equal equal_;
+  // Used by writers only
+  std::size_t current_shard_count_;
+  rcu::Variable<Table, rcu::EpochRcuTraits<Table>> index_;
+  std::vector<std::shared_ptr<Entry>> ring_;
+  std::size_t hand_{0};
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+bool ClockMap<T, U, Hash, Equal>::Find(const T& key, Function&& func) const {
+  const auto table = index_.Read();
+  const auto& shard = *(*table)[GetShardIndex(table->size(), key)];
+  const auto it = shard.find(key);
+  if (it == shard.end()) return false;
+
+  const Entry& entry = *it->second;
+  // avoid writing to the shared cache line on each hit of a hot key
+  if (!entry.referenced.load(std::memory_order_relaxed)) {
+    entry.referenced.store(true, std::memory_order_relaxed);
+  }
+  func(entry.value);
+  return true;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::Put(const T& key, U value) {
+  auto table = index_.StartWrite();
+  auto entry = std::make_shared<Entry>(key, std::move(value));
+
+  const auto& shard = *(*table)[GetShardIndex(table->size(), key)];
+  const auto it = shard.find(key);
+  if (it != shard.end()) {
+    entry->slot = it->second->slot;
+    entry->referenced.store(true, std::memory_order_relaxed);
+    ring_[entry->slot] = entry;
+    CopyShard(*table, key)[key] = std::move(entry);
+  } else if (ring_.size() < max_size_) {
+    entry->slot = ring_.size();
+    ring_.push_back(entry);
+    CopyShard(*table, key).emplace(key, std::move(entry));
+  } else {
+    entry->slot = Evict(*table);
+    hand_ = entry->slot + 1;
+    ring_[entry->slot] = entry;
+    CopyShard(*table, key).emplace(key, std::move(entry));
+  }
+
+  table.Commit();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::Erase(const T& key) {
+  {
+    const auto table = index_.Read();
+    if (!(*table)[GetShardIndex(table->size(), key)]->count(key)) return;
+  }
+
+  auto table = index_.StartWrite();
+  auto& shard = CopyShard(*table, key);
+  const auto it = shard.find(key);
+  UASSERT(it != shard.end());
+  RemoveSlot(it->second->slot);
+  shard.erase(it);
+  table.Commit();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::SetMaxSize(std::size_t new_max_size) {
+  UASSERT(new_max_size > 0);
+  max_size_ = new_max_size ? new_max_size : 1;
+  const auto shard_count = GetShardCount(max_size_);
+  if (ring_.size() <= max_size_ && current_shard_count_ == shard_count) {
+    return;
+  }
+
+  auto table = index_.StartWrite();
+  while (ring_.size() > max_size_) {
+    RemoveSlot(Evict(*table));
+  }
+
+  if (current_shard_count_ != shard_count) {
+    current_shard_count_ = shard_count;
+    std::vector<Shard> shards(shard_count, Shard(0, hash_, equal_));
+    for (const auto& entry : ring_) {
+      shards[GetShardIndex(shard_count, entry->key)].emplace(entry->key,
+                                                             entry);
+    }
+    table->clear();
+    for (auto& shard : shards) {
+      table->push_back(std::make_shared<const Shard>(std::move(shard)));
+    }
+  }
+  table.Commit();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::Clear() {
+  index_.Assign(MakeTable(current_shard_count_));
+  ring_.clear();
+  hand_ = 0;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void ClockMap<T, U, Hash, Equal>::VisitAll(Function&& func) const {
+  const auto table = index_.Read();
+  for (const auto& shard : *table) {
+    for (const auto& [key, entry] : *shard) {
+      func(key, entry->value);
+    }
+  }
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t ClockMap<T, U, Hash, Equal>::GetShardCount(std::size_t max_size) {
+  // The table and a shard are of about the same size
+  std::size_t shard_count = 1;
+  while (shard_count * shard_count < max_size) shard_count <<= 1;
+  return shard_count;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+auto ClockMap<T, U, Hash, Equal>::MakeTable(std::size_t shard_count) const
+    -> Table {
+  const auto empty_shard = std::make_shared<const Shard>(0, hash_, equal_);
+  return Table(shard_count, empty_shard);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t ClockMap<T, U, Hash, Equal>::GetShardIndex(std::size_t shard_count,
+                                                       const T& key) const {
+  // The shards use the same hash, so its bits are mixed to keep the buckets
+  // inside a shard well-balanced
+  constexpr std::uint64_t kFibonacciMultiplier = 0x9E3779B97F4A7C15ULL;
+  const auto hash = static_cast<std::uint64_t>(hash_(key));
+  return static_cast<std::size_t>((hash * kFibonacciMultiplier) >> 32) &
+         (shard_count - 1);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+auto ClockMap<T, U, Hash, Equal>::CopyShard(Table& table, const T& key) const
+    -> Shard& {
+  auto& shard = table[GetShardIndex(table.size(), key)];
+  auto copy = std::make_shared<Shard>(*shard);
+  auto& result = *copy;
+  shard = std::move(copy);
+  return result;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t ClockMap<T, U, Hash, Equal>::Evict(Table& table) {
+  UASSERT(!ring_.empty());
+  if (hand_ >= ring_.size()) hand_ = 0;
+
+  // readers may set the bits concurrently, so the sweep is limited
+  for (std::size_t i = 0; i < ring_.size(); ++i) {
+    if (!ring_[hand_]->referenced.exchange(false, std::memory_order_relaxed)) {
+      break;
+    }
+    if (++hand_ == ring_.size()) hand_ = 0;
+  }
+
+  CopyShard(table, ring_[hand_]->key).erase(ring_[hand_]->key);
+  return hand_;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void ClockMap<T, U, Hash, Equal>::RemoveSlot(std::size_t slot) {
+  UASSERT(slot < ring_.size());
+  if (slot + 1 != ring_.size()) {
+    ring_[slot] = std::move(ring_.back());
+    ring_[slot]->slot = slot;
+  }
+  ring_.pop_back();
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -4,6 +4,7 @@
 /// @brief @copybrief cache::LruCacheComponent
 
 #include <functional>
+#include <vector>
 
 #include <userver/cache/expirable_lru_cache.hpp>
 #include <userver/cache/lru_cache_config.hpp>
@@ -57,6 +58,7 @@ yaml_config::Schema GetLruCacheComponentBaseSchema();
 /// ---- | ----------- | -------------
 /// size | max amount of items to store in cache | --
 /// ways | number of ways for associative cache | --
+/// policy | admission and eviction policy of the cache, one of `lru`, `slru`, `wtinylfu`, `clock` (see cache::CachePolicy) | lru
 /// lifetime | TTL for cache entries (0 is unlimited) | 0
 /// config-settings | enables dynamic reconfiguration with CacheConfigSet | true
 ///
@@ -92,6 +94,11 @@ class LruCacheComponent : public components::LoggableComponentBase,
  protected:
   virtual Value DoGetByKey(const Key& key) = 0;
 
+  /// Loads the values of all the keys at once, used by
+  /// LruCacheWrapper::GetMany. Override it to load the values with a single
+  /// request, the default implementation calls DoGetByKey for each key.
+  virtual typename Cache::ValuesMap DoGetByKeys(const std::vector<Key>& keys);
+
   std::shared_ptr<Cache> GetCacheRaw() { return cache_; }
 
  private:
@@ -99,6 +106,8 @@ class LruCacheComponent : public components::LoggableComponentBase,
 
   Value GetByKey(const Key& key);
 
+  typename Cache::ValuesMap GetByKeys(const std::vector<Key>& keys);
+
   void OnConfigUpdate(const dynamic_config::Snapshot& cfg);
 
   void UpdateConfig(const LruCacheConfig& config);
@@ -129,7 +138,8 @@ LruCacheComponent<Key, Value, Hash, Equal>::LruCacheComponent(
       name_(components::GetCurrentComponentName(config)),
       static_config_(config),
       cache_(std::make_shared<Cache>(static_config_.ways,
-                                     static_config_.GetWaySize())) {
+                                     static_config_.GetWaySize(),
+                                     static_config_.policy)) {
   if (impl::IsDumpSupportEnabled(config)) {
     dumper_ = std::make_shared<dump::Dumper>(
         config, context, static_cast<dump::DumpableEntity&>(*this));
@@ -174,7 +184,9 @@ LruCacheComponent<Key, Value, Hash, Equal>::~LruCacheComponent() {
 template <typename Key, typename Value, typename Hash, typename Equal>
 typename LruCacheComponent<Key, Value, Hash, Equal>::CacheWrapper
 LruCacheComponent<Key, Value, Hash, Equal>::GetCache() {
-  return CacheWrapper(cache_, [this](const Key& key) { return GetByKey(key); });
+  return CacheWrapper(
+      cache_, [this](const Key& key) { return GetByKey(key); },
+      [this](const std::vector<Key>& keys) { return GetByKeys(keys); });
 }
 
 template <typename Key, typename Value, typename Hash, typename Equal>
@@ -187,6 +199,23 @@ Value LruCacheComponent<Key, Value, Hash, Equal>::GetByKey(const Key& key) {
   return DoGetByKey(key);
 }
 
+template <typename Key, typename Value, typename Hash, typename Equal>
+typename LruCacheComponent<Key, Value, Hash, Equal>::Cache::ValuesMap
+LruCacheComponent<Key, Value, Hash, Equal>::GetByKeys(
+    const std::vector<Key>& keys) {
+  return DoGetByKeys(keys);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+typename LruCacheComponent<Key, Value, Hash, Equal>::Cache::ValuesMap
+LruCacheComponent<Key, Value, Hash, Equal>::DoGetByKeys(
+    const std::vector<Key>& keys) {
+  typename Cache::ValuesMap values;
+  values.reserve(keys.size());
+  for (const auto& key : keys) values.emplace(key, DoGetByKey(key));
+  return values;
+}
+
 template <typename Key, typename Value, typename Hash, typename Equal>
 void LruCacheComponent<Key, Value, Hash, Equal>::OnConfigUpdate(
     const dynamic_config::Snapshot& cfg) {
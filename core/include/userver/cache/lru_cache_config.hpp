@@ -5,6 +5,7 @@
 #include <optional>
 #include <unordered_map>
 
+#include <userver/cache/policy.hpp>
 #include <userver/components/component_fwd.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/formats/json_fwd.hpp>
@@ -43,9 +44,13 @@ struct LruCacheConfigStatic final {
 
   LruCacheConfig config;
   std::size_t ways;
+  CachePolicy policy;
   bool use_dynamic_config;
 };
 
+CachePolicy Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<CachePolicy>);
+
 extern const dynamic_config::Key<
     std::unordered_map<std::string, LruCacheConfig>>
     kLruCacheConfigSet;
@@ -16,6 +16,8 @@ struct ExpirableLruCacheStatisticsBase final {
   std::atomic<std::size_t> misses{0};
   std::atomic<std::size_t> stale{0};
   std::atomic<std::size_t> background_updates{0};
+  std::atomic<std::size_t> bulk_updates{0};
+  std::atomic<std::size_t> bulk_updated_keys{0};
 
   ExpirableLruCacheStatisticsBase();
 
@@ -40,6 +42,9 @@ void CacheMiss(ExpirableLruCacheStatistics& stats);
 
 void CacheStale(ExpirableLruCacheStatistics& stats);
 
+void CacheBulkUpdate(ExpirableLruCacheStatistics& stats,
+                     std::size_t keys_count);
+
 void DumpMetric(utils::statistics::Writer& writer,
                 const ExpirableLruCacheStatistics& stats);
 
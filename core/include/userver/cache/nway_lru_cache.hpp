@@ -1,10 +1,14 @@
 #pragma once
 
 #include <functional>
+#include <memory>
 #include <optional>
+#include <variant>
 #include <vector>
 
-#include <userver/cache/lru_map.hpp>
+#include <userver/cache/impl/clock_map.hpp>
+#include <userver/cache/impl/policy_map.hpp>
+#include <userver/cache/policy.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/dump/operations.hpp>
 #include <userver/engine/mutex.hpp>
@@ -34,6 +38,13 @@ class NWayLRU final {
   NWayLRU(size_t ways, size_t way_size, const Hash& hash = Hash(),
           const Equal& equal = Equal());
 
+  /// @param policy is the admission and eviction policy of each way, see
+  /// cache::CachePolicy. With cache::CachePolicy::kClock the hits do not lock
+  /// the way. For the description of other parameters, see the constructor
+  /// above.
+  NWayLRU(size_t ways, size_t way_size, CachePolicy policy,
+          const Hash& hash = Hash(), const Equal& equal = Equal());
+
   void Put(const T& key, U value);
 
   template <typename Validator>
@@ -67,16 +78,41 @@ class NWayLRU final {
   void SetDumper(std::shared_ptr<dump::Dumper> dumper);
 
  private:
+  using Map = impl::PolicyMap<T, U, Hash, Equal>;
+  // impl::ClockMap is not movable
+  using ClockMapPtr = std::unique_ptr<impl::ClockMap<T, U, Hash, Equal>>;
+
   struct Way {
     Way(Way&& other) noexcept : cache(std::move(other.cache)) {}
 
     // max_size is not used, will be reset by Resize() in NWayLRU::NWayLRU
-    Way(const Hash& hash, const Equal& equal) : cache(1, hash, equal) {}
+    Way(CachePolicy policy, const Hash& hash, const Equal& equal)
+        : cache(MakeCache(policy, hash, equal)) {}
 
+    // Mutex is not taken by the reads of the impl::ClockMap
     mutable engine::Mutex mutex;
-    LruMap<T, U, Hash, Equal> cache;
+    std::variant<Map, ClockMapPtr> cache;
   };
 
+  static std::variant<Map, ClockMapPtr> MakeCache(CachePolicy policy,
+                                                  const Hash& hash,
+                                                  const Equal& equal) {
+    if (policy == CachePolicy::kClock) {
+      return std::make_unique<impl::ClockMap<T, U, Hash, Equal>>(1, hash,
+                                                                 equal);
+    }
+    return Map(policy, 1, hash, equal);
+  }
+
+  // Calls `func` with the impl::PolicyMap or impl::ClockMap of the way
+  template <typename WayType, typename Function>
+  static decltype(auto) VisitCache(WayType& way, Function&& func) {
+    if (const auto* clock = std::get_if<ClockMapPtr>(&way.cache)) {
+      return func(**clock);
+    }
+    return func(std::get<Map>(way.cache));
+  }
+
   Way& GetWay(const T& key);
 
   void NotifyDumper();
@@ -89,12 +125,18 @@ class NWayLRU final {
 template <typename T, typename U, typename Hash, typename Eq>
 NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size, const Hash& hash,
                                  const Eq& equal)
+    : NWayLRU(ways, way_size, CachePolicy::kLRU, hash, equal) {}
+
+template <typename T, typename U, typename Hash, typename Eq>
+NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size,
+                                 CachePolicy policy, const Hash& hash,
+                                 const Eq& equal)
     : caches_(), hash_fn_(hash) {
   caches_.reserve(ways);
-  for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal);
+  for (size_t i = 0; i < ways; ++i) caches_.emplace_back(policy, hash, equal);
   if (ways == 0) throw std::logic_error("Ways must be positive");
 
-  for (auto& way : caches_) way.cache.SetMaxSize(way_size);
+  UpdateWaySize(way_size);
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
@@ -102,7 +144,7 @@ void NWayLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
   auto& way = GetWay(key);
   {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Put(key, std::move(value));
+    VisitCache(way, [&](auto& cache) { cache.Put(key, std::move(value)); });
   }
   NotifyDumper();
 }
@@ -112,12 +154,29 @@ template <typename Validator>
 std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key,
                                               Validator validator) {
   auto& way = GetWay(key);
+  if (const auto* clock = std::get_if<ClockMapPtr>(&way.cache)) {
+    std::optional<U> result;
+    bool is_valid = true;
+    (*clock)->Find(key, [&](const U& value) {
+      is_valid = validator(value);
+      if (is_valid) result.emplace(value);
+    });
+
+    if (!is_valid) {
+      // may erase a value that was put concurrently, a miss is fine then
+      std::unique_lock<engine::Mutex> lock(way.mutex);
+      (*clock)->Erase(key);
+    }
+    return result;
+  }
+
   std::unique_lock<engine::Mutex> lock(way.mutex);
-  auto* value = way.cache.Get(key);
+  auto& cache = std::get<Map>(way.cache);
+  auto* value = cache.Get(key);
 
   if (value) {
     if (validator(*value)) return *value;
-    way.cache.Erase(key);
+    cache.Erase(key);
   }
 
   return std::nullopt;
@@ -128,7 +187,7 @@ void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
   auto& way = GetWay(key);
   {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Erase(key);
+    VisitCache(way, [&key](auto& cache) { cache.Erase(key); });
   }
   NotifyDumper();
 }
@@ -136,15 +195,21 @@ void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
 template <typename T, typename U, typename Hash, typename Eq>
 U NWayLRU<T, U, Hash, Eq>::GetOr(const T& key, const U& default_value) {
   auto& way = GetWay(key);
+  if (const auto* clock = std::get_if<ClockMapPtr>(&way.cache)) {
+    std::optional<U> result;
+    (*clock)->Find(key, [&result](const U& value) { result.emplace(value); });
+    return result ? *std::move(result) : default_value;
+  }
+
   std::unique_lock<engine::Mutex> lock(way.mutex);
-  return way.cache.GetOr(key, default_value);
+  return std::get<Map>(way.cache).GetOr(key, default_value);
 }
 
 template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::Invalidate() {
   for (auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.Clear();
+    VisitCache(way, [](auto& cache) { cache.Clear(); });
   }
   NotifyDumper();
 }
@@ -154,7 +219,7 @@ template <typename Function>
 void NWayLRU<T, U, Hash, Eq>::VisitAll(Function func) const {
   for (const auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.VisitAll(func);
+    VisitCache(way, [&func](const auto& cache) { cache.VisitAll(func); });
   }
 }
 
@@ -163,7 +228,7 @@ size_t NWayLRU<T, U, Hash, Eq>::GetSize() const {
   size_t size{0};
   for (const auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    size += way.cache.GetSize();
+    size += VisitCache(way, [](const auto& cache) { return cache.GetSize(); });
   }
   return size;
 }
@@ -172,7 +237,7 @@ template <typename T, typename U, typename Hash, typename Eq>
 void NWayLRU<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
   for (auto& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
-    way.cache.SetMaxSize(way_size);
+    VisitCache(way, [way_size](auto& cache) { cache.SetMaxSize(way_size); });
   }
 }
 
@@ -196,11 +261,13 @@ void NWayLRU<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
   for (const Way& way : caches_) {
     std::unique_lock<engine::Mutex> lock(way.mutex);
 
-    writer.Write(way.cache.GetSize());
+    VisitCache(way, [&writer](const auto& cache) {
+      writer.Write(cache.GetSize());
 
-    way.cache.VisitAll([&writer](const T& key, const U& value) {
-      writer.Write(key);
-      writer.Write(value);
+      cache.VisitAll([&writer](const T& key, const U& value) {
+        writer.Write(key);
+        writer.Write(value);
+      });
     });
   }
 }
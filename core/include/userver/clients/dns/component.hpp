@@ -33,6 +33,8 @@ namespace clients::dns {
 /// cache-size-per-way | size of each way of network cache | 256
 /// cache-max-reply-ttl | TTL limit for network replies caching | 5m
 /// cache-failure-ttl | TTL for network failures caching | 5s
+/// cache-refresh-interval | period of re-resolving the cached names that were used since the last update and are about to expire, 0 disables the refresh | 0
+/// prefetch-names | list of names to resolve in background on start | []
 ///
 /// ## Static configuration example:
 ///
@@ -54,9 +56,11 @@ class Component final : public components::LoggableComponentBase {
 
  private:
   void Write(utils::statistics::Writer& writer);
+  void WriteCache(utils::statistics::Writer& writer);
 
   Resolver resolver_;
   utils::statistics::Entry statistics_holder_;
+  utils::statistics::Entry cache_statistics_holder_;
 };
 
 }  // namespace clients::dns
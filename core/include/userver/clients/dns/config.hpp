@@ -39,6 +39,13 @@ struct ResolverConfig {
 
   /// Network cache failure TTL
   std::chrono::milliseconds cache_failure_ttl{std::chrono::seconds{5}};
+
+  /// Period of re-resolving the cached names that are in use before they
+  /// expire, 0 disables the background refresh
+  std::chrono::milliseconds cache_refresh_interval{0};
+
+  /// Names to resolve in background on start
+  std::vector<std::string> prefetch_names;
 };
 
 }  // namespace clients::dns
@@ -34,6 +34,14 @@ class Resolver {
     utils::statistics::RelaxedCounter<size_t> network_failure{0};
   };
 
+  struct CacheCounters {
+    /// Lookups that had to wait for a network query
+    utils::statistics::RelaxedCounter<size_t> misses{0};
+    /// Background queries of the prefetched names and of the names that are
+    /// about to expire
+    utils::statistics::RelaxedCounter<size_t> refreshes{0};
+  };
+
   Resolver(engine::TaskProcessor& fs_task_processor,
            const ResolverConfig& config);
   Resolver(const Resolver&) = delete;
@@ -47,6 +55,10 @@ class Resolver {
   ///  - Cached network resolution results
   ///  - Network name servers
   ///
+  /// If ResolverConfig::cache_refresh_interval is set, the cached names that
+  /// were looked up since their last update are re-resolved in background
+  /// before they expire, so that the lookups do not wait for the network.
+  ///
   /// @throws clients::dns::NotResolvedException if none of the sources provide
   /// a result within the specified deadline.
   AddrVector Resolve(const std::string& name, engine::Deadline deadline);
@@ -54,6 +66,9 @@ class Resolver {
   /// Returns lookup source counters.
   const LookupSourceCounters& GetLookupSourceCounters() const;
 
+  /// Returns network cache miss and refresh counters.
+  const CacheCounters& GetCacheCounters() const;
+
   /// Forces the reload of lookup table file. Waits until the reload is done.
   void ReloadHosts();
 
@@ -65,7 +80,7 @@ class Resolver {
 
  private:
   class Impl;
-  constexpr static size_t kSize = 1728;
+  constexpr static size_t kSize = 2096;
   constexpr static size_t kAlignment = 16;
   utils::FastPimpl<Impl, kSize, kAlignment> impl_;
 };
@@ -16,6 +16,7 @@
 #include <userver/clients/http/plugin.hpp>
 #include <userver/clients/http/request.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/rcu/rcu.hpp>
 #include <userver/utils/fast_pimpl.hpp>
 #include <userver/utils/not_null.hpp>
@@ -107,6 +108,15 @@ class Client final {
 
   // For internal use only.
   void SetConfig(const impl::Config&);
+
+  // Starts opening the connections to the warmup destinations of
+  // ClientSettings in each IO thread in background and keeping them alive.
+  // For internal use only.
+  void StartWarmup();
+
+  // Waits for the connections opened by StartWarmup.
+  // For internal use only.
+  void WaitForWarmup();
   /// @endcond
 
   /// @brief Sets User-Agent headers for all the requests or removes that
@@ -132,6 +142,13 @@ class Client final {
  private:
   void ReinitEasy();
 
+  // Creates a request that is processed by the `multi_index`-th IO thread
+  Request CreateBoundRequest(size_t multi_index);
+
+  void SetupRequest(Request& request);
+
+  void WarmUp();
+
   InstanceStatistics GetMultiStatistics(size_t n) const;
 
   size_t FindMultiIndex(const curl::multi*) const;
@@ -180,6 +197,11 @@ class Client final {
   utils::NotNull<const tracing::TracingManagerBase*> tracing_manager_;
   const server::http::HeadersPropagator* headers_propagator_{nullptr};
   impl::PluginPipeline plugin_pipeline_;
+
+  const bool wait_for_multiplexing_;
+  const WarmupConfig warmup_config_;
+  engine::TaskWithResult<void> warmup_initial_task_;
+  utils::PeriodicTask warmup_task_;
 };
 
 }  // namespace clients::http
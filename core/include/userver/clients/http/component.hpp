@@ -49,6 +49,24 @@ namespace components {
 /// set-deadline-propagation-header | whether to set http::common::kXYaTaxiClientTimeoutMs request header, see @ref scripts/docs/en/userver/deadline_propagation.md | true
 /// plugins | Plugin names to apply. A plugin component is called "http-client-plugin-" plus the plugin name. | []
 /// cancellation-policy | Cancellation policy for new requests. | cancel
+/// warmup.destinations | list of `{url, connections}` to open `connections` to in each IO thread in background after all the components are loaded, by HEAD requests to `url` | []
+/// warmup.timeout | timeout of a warmup request | 1s
+/// warmup.keepalive-period | period of repeating the warmup requests, so that the idle connections are not closed by curl or by the server; 0 disables it | 0
+/// http2.multiplexing | allow the requests to the same host to share an HTTP/2 connection | true
+/// http2.wait-for-multiplexing | new requests wait for a connection that is being established to the same host instead of opening another one, see clients::http::Request::wait_for_multiplexing | false
+/// http2.max-concurrent-streams | max streams per HTTP/2 connection, a new connection is opened when all of them are busy | 100
+/// http2.max-host-connections | max connections to a single host in each IO thread, for any HTTP version; the requests wait for a free connection when it is reached; 0 means no limit | 0
+///
+/// Each IO thread has its own connection cache, so a host gets at least one
+/// connection per IO thread. With `wait-for-multiplexing` and
+/// `max-host-connections: 1` the requests to an HTTP/2 host share
+/// `threads` connections. The `http2` metrics of each destination count the
+/// HTTP/2 streams and the connections opened for them.
+///
+/// The warm connections are reserved in the connection cache on top of
+/// @ref HTTP_CLIENT_CONNECTION_POOL_SIZE. The `connections` metrics of each
+/// destination show how many requests reused a connection and how long the
+/// TCP and TLS handshakes of the new connections took.
 ///
 /// ## Static configuration example:
 ///
@@ -70,6 +88,8 @@ class HttpClient final : public LoggableComponentBase {
   static yaml_config::Schema GetStaticConfigSchema();
 
  private:
+  void OnAllComponentsLoaded() override;
+
   void OnConfigUpdate(const dynamic_config::Snapshot& config);
 
   void WriteStatistics(utils::statistics::Writer& writer);
@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <string>
+#include <vector>
 
 #include <userver/dynamic_config/fwd.hpp>
 #include <userver/formats/json_fwd.hpp>
@@ -31,6 +32,44 @@ enum class CancellationPolicy {
 CancellationPolicy Parse(yaml_config::YamlConfig value,
                          formats::parse::To<CancellationPolicy>);
 
+struct WarmupDestination final {
+  // URL of a cheap endpoint, that is requested to open the connections
+  std::string url;
+  // Number of the connections to keep open in each IO thread
+  std::size_t connections{1};
+};
+
+WarmupDestination Parse(const yaml_config::YamlConfig& value,
+                        formats::parse::To<WarmupDestination>);
+
+struct WarmupConfig final {
+  std::vector<WarmupDestination> destinations;
+  std::chrono::milliseconds timeout{1000};
+  // Zero disables re-warming of the idle connections. Each re-warming sends
+  // HEAD requests to the destinations from every IO thread.
+  std::chrono::milliseconds keepalive_period{0};
+};
+
+WarmupConfig Parse(const yaml_config::YamlConfig& value,
+                   formats::parse::To<WarmupConfig>);
+
+struct Http2Config final {
+  // Allows the requests to the same host to share an HTTP/2 connection
+  bool multiplexing{true};
+  // New requests wait for a connection that is being established to the same
+  // host instead of opening another one, see Request::wait_for_multiplexing
+  bool wait_for_multiplexing{false};
+  // curl opens a new connection when all the streams of the existing ones are
+  // busy
+  std::size_t max_concurrent_streams{100};
+  // Per IO thread, the requests wait for a free connection when reached.
+  // 0 means no limit
+  std::size_t max_host_connections{0};
+};
+
+Http2Config Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<Http2Config>);
+
 // Static config
 struct ClientSettings final {
   std::string thread_name_prefix{};
@@ -40,6 +79,8 @@ struct ClientSettings final {
   const tracing::TracingManagerBase* tracing_manager{nullptr};
   const server::http::HeadersPropagator* headers_propagator{nullptr};
   CancellationPolicy cancellation_policy{CancellationPolicy::kCancel};
+  WarmupConfig warmup{};
+  Http2Config http2{};
 };
 
 ClientSettings Parse(const yaml_config::YamlConfig& value,
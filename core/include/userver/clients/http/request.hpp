@@ -233,6 +233,12 @@ class Request final {
   /// Set HTTP version
   Request& http_version(HttpVersion version) &;
   Request http_version(HttpVersion version) &&;
+  /// Wait for a connection to the same host that is being established, to
+  /// multiplex the request on it if it turns out to be HTTP/2, instead of
+  /// opening a new connection. Default: the `http2.wait-for-multiplexing`
+  /// static option of components::HttpClient
+  Request& wait_for_multiplexing(bool wait = true) &;
+  Request wait_for_multiplexing(bool wait = true) &&;
 
   /// Specify number of retries on incorrect status, if on_fails is True
   /// retry on network error too. Retries = 3 means that maximum 3 request
@@ -35,6 +35,11 @@ class Manager;
 /// coro_pool.stack_size | size of a single coroutine | 256 * 1024
 /// event_thread_pool.threads | number of threads to process low level IO system calls (number of ev loops to start in libev) | 2
 /// event_thread_pool.thread_name | set OS thread name to this value | 'event-worker'
+/// event_thread_pool.cpu-set | list of CPUs to bind the event threads to, e.g. '0-3,8' | no binding
+/// event_thread_pool.io_uring.enabled | use an io_uring per event thread for file I/O, falls back to the fs task processor on kernels without io_uring | false
+/// event_thread_pool.io_uring.queue_depth | submission queue size of each ring | 256
+/// event_thread_pool.io_uring.registered_buffers | number of buffers registered in each ring for file reads, at most 64 | 0
+/// event_thread_pool.io_uring.registered_buffer_size | size of a registered buffer in bytes | 65536
 /// components | dictionary of "component name": "options" | -
 /// default_task_processor | name of the default task processor to use in components | -
 /// task_processors.*NAME*.*OPTIONS* | dictionary of task processors to create and their options. See description below | -
@@ -50,6 +55,9 @@ class Manager;
 /// worker_threads | threads count for the task processor | -
 /// os-scheduling | OS scheduling mode for the task processor threads. 'idle' sets the lowest priority. 'low-priority' sets the priority below 'normal' but higher than 'idle'. | normal
 /// spinning-iterations | tunes the number of spin-wait iterations in case of an empty task queue before threads go to sleep | 10000
+/// task-processor-queue | task queue implementation: 'global-task-queue' or 'work-stealing-task-queue' (per-worker queues with work stealing, better locality on many-core machines) | global-task-queue
+/// cpu-set | list of CPUs to bind the worker threads to, e.g. '0-3,8' | no binding
+/// numa-node | NUMA node to bind the worker threads to (intersected with cpu-set if both are set); idle coroutine stacks are reused within the node | no binding
 /// task-trace | optional dictionary of tracing options | empty (disabled)
 /// task-trace.every | set N to trace each Nth task | 1000
 /// task-trace.max-context-switch-count | set upper limit of context switches to trace for a single task | 1000
@@ -43,6 +43,20 @@ class DumpableEntity {
   virtual void GetAndWrite(dump::Writer& writer) const = 0;
 
   virtual void ReadAndSet(dump::Reader& reader) = 0;
+
+  /// @brief Writes the changes made since `since`, which is the update time of
+  /// the previously written dump or delta, see `max-delta-count`
+  /// @returns `false` if the changes are not known, e.g. if the data has been
+  /// replaced completely since then. A full dump is written in that case.
+  virtual bool GetAndWriteDelta(dump::Writer& writer, TimePoint since) const;
+
+  /// @brief Applies the changes written by `GetAndWriteDelta` on top of the
+  /// data from the previous dump or delta
+  /// @returns `false` without reading anything if deltas are not supported,
+  /// e.g. if they were written by an older version of the entity. The data
+  /// stays as of the previous dump or delta, and the remaining deltas of the
+  /// dump are removed.
+  virtual bool ReadAndApplyDelta(dump::Reader& reader);
 };
 
 enum class UpdateType {
@@ -71,6 +85,15 @@ enum class UpdateType {
 ///
 /// Here, `dumper_name` is the name of the parent component.
 ///
+/// ## Deltas
+/// With `max-delta-count` set, a modification of the data is written as a
+/// small delta file `{dump}.delta-{index}` next to the latest full dump, if
+/// dump::DumpableEntity::GetAndWriteDelta can provide it. Once the dump
+/// accumulates `max-delta-count` deltas, a new full dump is written instead,
+/// which compacts the changes. A dump is loaded together with all its deltas,
+/// and is considered as fresh as its latest delta; `max-age` applies to the
+/// full dump though.
+///
 /// ## Dynamic config
 /// * @ref USERVER_DUMPS
 ///
@@ -85,6 +108,8 @@ enum class UpdateType {
 /// `min-interval` | `string` (duration) | `WriteDumpAsync` calls performed in a fast succession are ignored | `0s`
 /// `fs-task-processor` | `string` | `TaskProcessor` for blocking disk IO | `fs-task-processor`
 /// `encrypted` | `boolean` | Whether to encrypt the dump | `false`
+/// `use-mmap` | `boolean` | Whether to read unencrypted dumps via `mmap` without intermediate copies, see dump::MmapFileReader | `false`
+/// `max-delta-count` | `integer` | If non-zero, modifications are written as up to `max-delta-count` deltas on top of the latest full dump, see dump::DumpableEntity::GetAndWriteDelta | `0`
 ///
 /// ## Sample usage
 /// @snippet core/src/dump/dumper_test.cpp  Sample Dumper usage
@@ -166,7 +191,7 @@ class Dumper final {
          const components::ComponentContext& context, DumpableEntity& dumpable);
 
   class Impl;
-  utils::FastPimpl<Impl, 1088, 16> impl_;
+  utils::FastPimpl<Impl, 1184, 16> impl_;
 };
 
 }  // namespace dump
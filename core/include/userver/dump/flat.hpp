@@ -0,0 +1,82 @@
+#pragma once
+
+/// @file userver/dump/flat.hpp
+/// @brief Dump format for arrays of trivially copyable values that are read
+/// without per-element parsing
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <userver/dump/operations.hpp>
+#include <userver/utils/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace impl {
+
+void WriteFlatBlock(Writer& writer, std::string_view data,
+                    std::size_t element_size);
+
+std::string_view ReadFlatBlock(Reader& reader, std::size_t element_size);
+
+}  // namespace impl
+
+/// @brief Writes the values as a single block of memory, which is read back
+/// with a single `memcpy` by ReadFlat.
+///
+/// The block is prefixed with the element count, the element size and the
+/// checksum of the data, ReadFlat throws dump::Error if any of them do not
+/// match.
+///
+/// @warning Unlike the rest of the dump format, the values are stored in the
+/// memory layout of the current platform. Bump `format-version` of the dump
+/// when the layout of `T` changes.
+template <typename T>
+void WriteFlat(Writer& writer, utils::span<const T> values) {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "Only trivially copyable types can be written as flat blocks");
+  impl::WriteFlatBlock(
+      writer,
+      std::string_view{reinterpret_cast<const char*>(values.data()),
+                       values.size() * sizeof(T)},
+      sizeof(T));
+}
+
+/// @brief Reads the values written by WriteFlat
+/// @throws dump::Error if the block is corrupted
+template <typename T>
+std::vector<T> ReadFlat(Reader& reader) {
+  static_assert(std::is_trivial_v<T>,
+                "Only trivial types can be read from flat blocks");
+  const auto data = impl::ReadFlatBlock(reader, sizeof(T));
+  std::vector<T> values(data.size() / sizeof(T));
+  if (!data.empty()) std::memcpy(values.data(), data.data(), data.size());
+  return values;
+}
+
+/// @brief Reads the values written by WriteFlat without copying them
+/// @warning The span is invalidated on the next `Read` operation, unless the
+/// `reader` is dump::MmapFileReader, for which it stays valid until the reader
+/// is destroyed.
+/// @note The block may be placed at any offset in the dump, so only the types
+/// without alignment requirements can be viewed in place.
+/// @throws dump::Error if the block is corrupted
+template <typename T>
+utils::span<const T> ReadFlatUnsafe(Reader& reader) {
+  static_assert(std::is_trivial_v<T>,
+                "Only trivial types can be read from flat blocks");
+  static_assert(alignof(T) == 1,
+                "Use ReadFlat for the types with alignment requirements");
+  const auto data = impl::ReadFlatBlock(reader, sizeof(T));
+  const auto* const begin = reinterpret_cast<const T*>(data.data());
+  return {begin, begin + data.size() / sizeof(T)};
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -52,9 +52,37 @@ class FileReader final : public Reader {
   std::string curr_chunk_;
 };
 
+/// @brief A handle to a dump file that is mapped into memory.
+///
+/// Unlike FileReader, the data is not copied into an intermediate buffer, and
+/// the memory returned by `ReadRaw` stays valid until the reader is destroyed.
+/// File operations block the thread.
+class MmapFileReader final : public Reader {
+ public:
+  /// @brief Opens an existing dump file and maps it into memory
+  /// @throws `Error` on a filesystem error
+  explicit MmapFileReader(std::string path);
+
+  MmapFileReader(MmapFileReader&&) = delete;
+  MmapFileReader& operator=(MmapFileReader&&) = delete;
+  ~MmapFileReader() override;
+
+  void Finish() override;
+
+ private:
+  std::string_view ReadRaw(std::size_t max_size) override;
+
+  std::string path_;
+  const char* data_{nullptr};
+  std::size_t size_{0};
+  std::size_t position_{0};
+};
+
 class FileOperationsFactory final : public OperationsFactory {
  public:
-  explicit FileOperationsFactory(boost::filesystem::perms perms);
+  /// @param use_mmap whether to read the dumps with MmapFileReader
+  explicit FileOperationsFactory(boost::filesystem::perms perms,
+                                 bool use_mmap = false);
 
   std::unique_ptr<Reader> CreateReader(std::string full_path) override;
 
@@ -63,6 +91,7 @@ class FileOperationsFactory final : public OperationsFactory {
 
  private:
   const boost::filesystem::perms perms_;
+  const bool use_mmap_;
 };
 
 }  // namespace dump
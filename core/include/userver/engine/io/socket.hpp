@@ -108,6 +108,15 @@ class [[nodiscard]] Socket final : public RwBase {
   /// @note Can return less than len if socket is closed by peer.
   [[nodiscard]] size_t SendAll(const void* buf, size_t len, Deadline deadline);
 
+  /// @brief Sends exactly len bytes of the file starting from offset,
+  /// without copying them to the userspace where sendfile(2) is available.
+  /// @note Can return less than len if socket is closed by peer or the file is
+  /// shorter.
+  /// @note The file is read synchronously, so it is expected to reside in the
+  /// page cache.
+  [[nodiscard]] size_t SendFile(int file_fd, std::size_t offset,
+                                std::size_t len, Deadline deadline);
+
   /// @brief Accepts a connection from a listening socket.
   /// @see engine::io::Listen
   [[nodiscard]] Socket Accept(Deadline);
@@ -4,6 +4,7 @@
 /// @brief TLS socket wrappers
 
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <userver/crypto/certificate.hpp>
@@ -31,11 +32,15 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
                                    const std::string& server_name,
                                    Deadline deadline);
 
-  /// Starts a TLS server on an opened socket
+  /// @brief Starts a TLS server on an opened socket
+  /// @param alpn_protocols application protocols the server supports in the
+  /// order of preference, e.g. {"h2", "http/1.1"}. The handshake does not fail
+  /// if none of them is supported by the client.
   static TlsWrapper StartTlsServer(
       Socket&& socket, const crypto::Certificate& cert,
       const crypto::PrivateKey& key, Deadline deadline,
-      const std::vector<crypto::Certificate>& cert_authorities = {});
+      const std::vector<crypto::Certificate>& cert_authorities = {},
+      const std::vector<std::string>& alpn_protocols = {});
 
   ~TlsWrapper() override;
 
@@ -99,6 +104,10 @@ class [[nodiscard]] TlsWrapper final : public RwBase {
 
   int GetRawFd();
 
+  /// @brief Application protocol negotiated during the handshake via ALPN.
+  /// @returns empty string_view if no protocol was negotiated.
+  std::string_view GetAlpnProtocol() const;
+
  private:
   explicit TlsWrapper(Socket&&);
 
@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <string>
 
+#include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/utils/function_ref.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -21,6 +22,9 @@ struct TaskProcessorPoolsConfig final {
   std::string ev_thread_name = "ev";
   bool ev_default_loop_disabled = false;
   bool defer_events = true;
+  /// Use io_uring for file I/O if the kernel supports it
+  bool io_uring_enabled = false;
+  TaskQueueType task_queue_type = TaskQueueType::kGlobalTaskQueue;
 };
 
 /// @brief Runs a payload in a temporary coroutine engine instance.
@@ -16,6 +16,18 @@ namespace engine {
 /// section of the components::ManagerControllerComponent static configuration.
 class TaskProcessor;
 
+/// @brief The implementation of the queue of tasks ready to be run on
+/// a TaskProcessor.
+enum class TaskQueueType {
+  /// A single queue shared by all the worker threads of a TaskProcessor
+  kGlobalTaskQueue,
+
+  /// Per-worker local queues with a slot for the most recently woken task and
+  /// randomized work stealing between workers. Improves the locality of
+  /// related tasks and reduces contention on machines with many cores.
+  kWorkStealingTaskQueue,
+};
+
 /// @brief Register a function that runs on all threads on task processor
 /// creation. Used for pre-initializing thread_local variables with heavy
 /// constructors (constructor that does blocking system calls, file access,
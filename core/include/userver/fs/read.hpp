@@ -50,6 +50,8 @@ FileInfoWithDataMap ReadRecursiveFilesInfoWithData(
     utils::Flags<SettingsReadFile> flags = {SettingsReadFile::kSkipHidden});
 
 /// @brief Reads file contents asynchronously
+/// @note If io_uring is enabled for the event threads, the file is read via
+/// io_uring and `async_tp` is not used.
 /// @param async_tp TaskProcessor for synchronous waiting
 /// @param path file to open
 /// @returns file contents
@@ -29,6 +29,8 @@ void CreateDirectories(engine::TaskProcessor& async_tp, std::string_view path);
 /// @brief Rewrite file contents asynchronously
 /// It doesn't provide strict atomic guarantees. If you need them, use
 /// `fs::RewriteFileContentsAtomically`.
+/// @note If io_uring is enabled for the event threads, the file is written via
+/// io_uring and `async_tp` is not used.
 /// @param async_tp TaskProcessor for synchronous waiting
 /// @param path file to rewrite
 /// @param contents new file contents
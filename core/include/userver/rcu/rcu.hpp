@@ -6,9 +6,13 @@
 #include <atomic>
 #include <cstdlib>
 #include <list>
+#include <memory>
+#include <type_traits>
 #include <unordered_set>
+#include <vector>
 
 #include <userver/compiler/thread_local.hpp>
+#include <userver/concurrent/impl/striped_read_indicator.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/mutex.hpp>
 #include <userver/logging/log.hpp>
@@ -25,8 +29,47 @@ USERVER_NAMESPACE_BEGIN
 /// with modified API
 namespace rcu {
 
+/// @brief Selects how rcu::Variable finds out that an old value may be
+/// destroyed, see `RcuTraits::kReclamation`.
+enum class Reclamation {
+  /// Each reader publishes the value it uses in a per-Variable list of hazard
+  /// pointers. Writers collect all the hazard pointers on each update.
+  /// Cheapest in memory; writers become slower as the number of readers grows.
+  kHazardPointers,
+
+  /// Each committed value starts a new epoch with its own striped (per-CPU)
+  /// read indicator. Readers only increment a counter of their CPU, no shared
+  /// cache lines are written. Writers batch the retired epochs and free each
+  /// of them as soon as its indicator becomes free, without allocations or
+  /// scanning the readers. Consumes `16 * N_CORES` bytes per live epoch.
+  kEpochs,
+};
+
 namespace impl {
 
+template <typename RcuTraits, typename = void>
+inline constexpr Reclamation kReclamationOf = Reclamation::kHazardPointers;
+
+template <typename RcuTraits>
+inline constexpr Reclamation
+    kReclamationOf<RcuTraits, std::void_t<decltype(RcuTraits::kReclamation)>> =
+        RcuTraits::kReclamation;
+
+template <typename RcuTraits>
+inline constexpr bool kUsesEpochs =
+    kReclamationOf<RcuTraits> == Reclamation::kEpochs;
+
+// A value of rcu::Variable with Reclamation::kEpochs along with its readers.
+// Records are reused by the Variable, so a record is never deallocated while
+// a reader might still try to lock it.
+template <typename T>
+struct EpochRecord final {
+  std::unique_ptr<T> data;
+  concurrent::impl::StripedReadIndicator readers;
+};
+
+struct NoEpochLock final {};
+
 // Hazard pointer implementation. Pointers form a linked list. \p ptr points
 // to the data they 'hold', next - to the next element in a list.
 // kUsed is a filler value to show that hazard pointer is not free. Please see
@@ -74,11 +117,21 @@ uint64_t GetNextEpoch() noexcept;
 /// Default Rcu traits.
 /// - `MutexType` is a writer's mutex type that has to be used to protect
 /// structure on update
+/// - optional `static constexpr Reclamation kReclamation` selects
+/// the reclamation scheme, Reclamation::kHazardPointers if missing
 template <typename T>
 struct DefaultRcuTraits {
   using MutexType = engine::Mutex;
 };
 
+/// Rcu traits for the frequently updated variables with many readers,
+/// see Reclamation::kEpochs
+template <typename T>
+struct EpochRcuTraits {
+  using MutexType = engine::Mutex;
+  static constexpr Reclamation kReclamation = Reclamation::kEpochs;
+};
+
 /// Reader smart pointer for rcu::Variable<T>. You may use operator*() or
 /// operator->() to do something with the stored value. Once created,
 /// ReadablePtr references the same immutable value: if Variable's value is
@@ -86,23 +139,34 @@ struct DefaultRcuTraits {
 /// ReadablePtr.
 template <typename T, typename RcuTraits>
 class [[nodiscard]] ReadablePtr final {
- public:
-  explicit ReadablePtr(const Variable<T, RcuTraits>& ptr)
-      : hp_record_(&ptr.MakeHazardPointer()) {
-    // This cycle guarantees that at the end of it both t_ptr_ and
-    // hp_record_->ptr will both be set to
-    // 1. something meaningful
-    // 2. and that this meaningful value was not removed between assigning to
-    //    t_ptr_ and storing  it in a hazard pointer
-    do {
-      t_ptr_ = ptr.GetCurrent();
+  static constexpr bool kUsesEpochs = impl::kUsesEpochs<RcuTraits>;
+  using EpochLock =
+      std::conditional_t<kUsesEpochs, concurrent::impl::StripedReadIndicatorLock,
+                         impl::NoEpochLock>;
 
-      hp_record_->ptr.store(t_ptr_);
-    } while (t_ptr_ != ptr.GetCurrent());
+ public:
+  explicit ReadablePtr(const Variable<T, RcuTraits>& ptr) {
+    if constexpr (kUsesEpochs) {
+      t_ptr_ = ptr.LockCurrentEpoch(epoch_lock_);
+    } else {
+      hp_record_ = &ptr.MakeHazardPointer();
+      // This cycle guarantees that at the end of it both t_ptr_ and
+      // hp_record_->ptr will both be set to
+      // 1. something meaningful
+      // 2. and that this meaningful value was not removed between assigning
+      //    to t_ptr_ and storing  it in a hazard pointer
+      do {
+        t_ptr_ = ptr.GetCurrent();
+
+        hp_record_->ptr.store(t_ptr_);
+      } while (t_ptr_ != ptr.GetCurrent());
+    }
   }
 
   ReadablePtr(ReadablePtr<T, RcuTraits>&& other) noexcept
-      : t_ptr_(other.t_ptr_), hp_record_(other.hp_record_) {
+      : t_ptr_(other.t_ptr_),
+        hp_record_(other.hp_record_),
+        epoch_lock_(std::move(other.epoch_lock_)) {
     other.t_ptr_ = nullptr;
   }
 
@@ -128,6 +192,14 @@ class [[nodiscard]] ReadablePtr final {
       return *this;
     }
 
+    if constexpr (kUsesEpochs) {
+      // The lock keeps the epoch of other.t_ptr_ alive
+      epoch_lock_ = std::move(other.epoch_lock_);
+      t_ptr_ = other.t_ptr_;
+      other.t_ptr_ = nullptr;
+      return *this;
+    }
+
     // Get rid of our current hp_record_
     if (t_ptr_) {
       hp_record_->Release();
@@ -150,7 +222,7 @@ class [[nodiscard]] ReadablePtr final {
   }
 
   ReadablePtr(const ReadablePtr<T, RcuTraits>& other)
-      : ReadablePtr(other.hp_record_->owner) {}
+      : ReadablePtr(other.MakeCopy()) {}
 
   ReadablePtr& operator=(const ReadablePtr<T, RcuTraits>& other) {
     if (this != &other) *this = ReadablePtr<T, RcuTraits>{other};
@@ -158,9 +230,11 @@ class [[nodiscard]] ReadablePtr final {
   }
 
   ~ReadablePtr() {
-    if (!t_ptr_) return;
-    UASSERT(hp_record_ != nullptr);
-    hp_record_->Release();
+    if constexpr (!kUsesEpochs) {
+      if (!t_ptr_) return;
+      UASSERT(hp_record_ != nullptr);
+      hp_record_->Release();
+    }
   }
 
   const T* Get() const& {
@@ -177,6 +251,18 @@ class [[nodiscard]] ReadablePtr final {
   const T& operator*() && { return *GetOnRvalue(); }
 
  private:
+  ReadablePtr(T* t_ptr, const EpochLock& epoch_lock) noexcept
+      : t_ptr_(t_ptr), epoch_lock_(epoch_lock) {}
+
+  ReadablePtr MakeCopy() const {
+    if constexpr (kUsesEpochs) {
+      // Sharing the epoch is safe, because our lock keeps it alive
+      return ReadablePtr(t_ptr_, epoch_lock_);
+    } else {
+      return ReadablePtr(hp_record_->owner);
+    }
+  }
+
   const T* GetOnRvalue() {
     static_assert(!sizeof(T),
                   "Don't use temporary ReadablePtr, store it to a variable");
@@ -186,12 +272,14 @@ class [[nodiscard]] ReadablePtr final {
   // This is a pointer to actual data. If it is null, then we treat it as
   // an indicator that this ReadablePtr is cleared and won't call
   // any logic associated with hp_record_
-  T* t_ptr_;
+  T* t_ptr_{nullptr};
   // Our hazard pointer. It can be nullptr in some circumstances.
   // Invariant is this: if t_ptr_ is not nullptr, then hp_record_ is also
   // not nullptr and points to hazard pointer containing same T*.
   // Thus, if t_ptr_ is nullptr, then hp_record_ is undefined.
-  impl::HazardPointerRecord<T, RcuTraits>* hp_record_;
+  impl::HazardPointerRecord<T, RcuTraits>* hp_record_{nullptr};
+  // Used instead of hp_record_ with Reclamation::kEpochs
+  EpochLock epoch_lock_{};
 };
 
 /// Smart pointer for rcu::Variable<T> for changing RCU value. It stores a
@@ -246,8 +334,7 @@ class [[nodiscard]] WritablePtr final {
     UASSERT(ptr_ != nullptr);
     LOG_TRACE() << "Committing ptr=" << ptr_.get();
 
-    std::unique_ptr<T> old_ptr(var_.current_.exchange(ptr_.release()));
-    var_.Retire(std::move(old_ptr), lock_);
+    var_.Publish(std::move(ptr_), lock_);
     lock_.unlock();
   }
 
@@ -297,6 +384,10 @@ enum class DestructionType { kSync, kAsync };
 /// be eventually freed when a subsequent writer identifies that nobody works
 /// with this version.
 ///
+/// The way old versions are tracked is selected by `RcuTraits::kReclamation`,
+/// see rcu::Reclamation. Use rcu::EpochRcuTraits for variables that are updated
+/// often while being read from many threads.
+///
 /// @note There is no way to create a "null" `Variable`.
 ///
 /// ## Example usage:
@@ -321,7 +412,9 @@ class Variable final {
                               ? DestructionType::kSync
                               : DestructionType::kAsync),
         epoch_(impl::GetNextEpoch()),
-        current_(new T(std::forward<Args>(initial_value_args)...)) {}
+        current_(new T(std::forward<Args>(initial_value_args)...)) {
+    InitEpochs();
+  }
 
   /// Create a new `Variable` with an in-place constructed initial value.
   /// @param destruction_type controls whether destruction of old values should
@@ -332,7 +425,9 @@ class Variable final {
   Variable(DestructionType destruction_type, Args&&... initial_value_args)
       : destruction_type_(destruction_type),
         epoch_(impl::GetNextEpoch()),
-        current_(new T(std::forward<Args>(initial_value_args)...)) {}
+        current_(new T(std::forward<Args>(initial_value_args)...)) {
+    InitEpochs();
+  }
 
   Variable(const Variable&) = delete;
   Variable(Variable&&) = delete;
@@ -340,7 +435,16 @@ class Variable final {
   Variable& operator=(Variable&&) = delete;
 
   ~Variable() {
-    delete current_.load();
+    if constexpr (kUsesEpochs) {
+      // current_ is owned by the current epoch
+      delete current_epoch_.load();
+      for ([[maybe_unused]] const auto& record : retired_epochs_) {
+        UASSERT_MSG(record->readers.IsFree(),
+                    "RCU variable is destroyed while being used");
+      }
+    } else {
+      delete current_.load();
+    }
 
     auto* hp = hp_record_head_.load();
     while (hp) {
@@ -404,12 +508,87 @@ class Variable final {
       return;
     }
 
-    ScanRetiredList(CollectHazardPtrs(lock));
+    if constexpr (kUsesEpochs) {
+      ScanRetiredEpochs();
+    } else {
+      ScanRetiredList(CollectHazardPtrs(lock));
+    }
   }
 
  private:
+  static constexpr bool kUsesEpochs = impl::kUsesEpochs<RcuTraits>;
+  using EpochRecord = impl::EpochRecord<T>;
+
   T* GetCurrent() const { return current_.load(); }
 
+  void InitEpochs() {
+    if constexpr (kUsesEpochs) {
+      auto record = std::make_unique<EpochRecord>();
+      record->data.reset(current_.load());
+      current_epoch_.store(record.release());
+    }
+  }
+
+  // Locks the current epoch for reading and returns its value
+  T* LockCurrentEpoch(
+      concurrent::impl::StripedReadIndicatorLock& epoch_lock) const {
+    auto* record = current_epoch_.load();
+    while (true) {
+      // Records are never deallocated while *this is alive, so it is fine to
+      // lock a record that has already been retired or even reused.
+      epoch_lock = record->readers.Lock();
+      // Pairs with the fence in RetireEpoch: either the writer sees our lock,
+      // or we see that the record is not current anymore.
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      auto* const current = current_epoch_.load();
+      if (current == record) return record->data.get();
+      record = current;
+    }
+  }
+
+  void Publish(std::unique_ptr<T> new_ptr, std::unique_lock<MutexType>& lock) {
+    if constexpr (kUsesEpochs) {
+      std::unique_ptr<EpochRecord> record;
+      if (free_epochs_.empty()) {
+        record = std::make_unique<EpochRecord>();
+      } else {
+        record = std::move(free_epochs_.back());
+        free_epochs_.pop_back();
+      }
+      record->data = std::move(new_ptr);
+      current_.store(record->data.get());
+      std::unique_ptr<EpochRecord> old_record(
+          current_epoch_.exchange(record.release()));
+      RetireEpoch(std::move(old_record));
+    } else {
+      std::unique_ptr<T> old_ptr(current_.exchange(new_ptr.release()));
+      Retire(std::move(old_ptr), lock);
+    }
+  }
+
+  void RetireEpoch(std::unique_ptr<EpochRecord> old_record) {
+    LOG_TRACE() << "Retiring epoch with ptr=" << old_record->data.get();
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    retired_epochs_.push_back(std::move(old_record));
+    ScanRetiredEpochs();
+  }
+
+  // Destroys (asynchronously) the values of retired epochs that have no
+  // readers and moves their records to the free list
+  void ScanRetiredEpochs() {
+    auto it = retired_epochs_.begin();
+    while (it != retired_epochs_.end()) {
+      if ((*it)->readers.IsFree()) {
+        DeleteAsync(std::move((*it)->data));
+        free_epochs_.push_back(std::move(*it));
+        *it = std::move(retired_epochs_.back());
+        retired_epochs_.pop_back();
+      } else {
+        ++it;
+      }
+    }
+  }
+
   impl::HazardPointerRecord<T, RcuTraits>* MakeHazardPointerCached(
       impl::CachedData<T, RcuTraits>& cache) const {
     auto* hp = cache.hp;
@@ -537,6 +716,13 @@ class Variable final {
   // may be read without mutex_ locked, but must be changed with held mutex_
   std::atomic<T*> current_;
   std::list<std::unique_ptr<T>> retire_list_head_;
+
+  // Reclamation::kEpochs only. current_epoch_ owns the value of current_.
+  // May be read without mutex_ locked, but must be changed with held mutex_.
+  std::atomic<EpochRecord*> current_epoch_{nullptr};
+  std::vector<std::unique_ptr<EpochRecord>> retired_epochs_;
+  std::vector<std::unique_ptr<EpochRecord>> free_epochs_;
+
   utils::impl::WaitTokenStorage wait_token_storage_;
 
   friend class ReadablePtr<T, RcuTraits>;
@@ -0,0 +1,473 @@
+#pragma once
+
+/// @file userver/rcu/sharded_rcu_map.hpp
+/// @brief @copybrief rcu::ShardedRcuMap
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace rcu {
+
+/// @brief Forward iterator for the rcu::ShardedRcuMap
+///
+/// Use member functions of rcu::ShardedRcuMap to retrieve the iterator.
+/// Each shard is iterated over its own snapshot, which is taken when
+/// the iterator enters the shard.
+template <typename Key, typename Value, typename IterValue,
+          typename RcuMapTraits>
+class ShardedRcuMapIterator final {
+  using Shard = RcuMap<Key, Value, RcuMapTraits>;
+  using ShardIterator = RcuMapIterator<Key, Value, IterValue, RcuMapTraits>;
+
+ public:
+  using iterator_category = std::input_iterator_tag;
+  using difference_type = ptrdiff_t;
+  using value_type = typename ShardIterator::value_type;
+  using reference = typename ShardIterator::reference;
+  using pointer = typename ShardIterator::pointer;
+
+  ShardedRcuMapIterator() = default;
+
+  ShardedRcuMapIterator operator++(int);
+  ShardedRcuMapIterator& operator++();
+  reference operator*() const;
+  pointer operator->() const;
+
+  bool operator==(const ShardedRcuMapIterator&) const;
+  bool operator!=(const ShardedRcuMapIterator&) const;
+
+  /// @cond
+  /// For internal use only
+  explicit ShardedRcuMapIterator(utils::FixedArray<Shard>& shards);
+  /// @endcond
+
+ private:
+  void EnterShard();
+  void SkipExhaustedShards();
+
+  utils::FixedArray<Shard>* shards_{nullptr};
+  std::size_t shard_index_{0};
+  ShardIterator it_;
+};
+
+/// @ingroup userver_concurrency userver_containers
+///
+/// @brief Map-like structure allowing RCU keyset updates, split into a fixed
+/// number of independently updated rcu::RcuMap shards.
+///
+/// A keyset change copies only the shard the key belongs to, and the writers
+/// of different shards do not contend with each other. Reads are as cheap as
+/// for rcu::RcuMap.
+///
+/// The price is a weaker consistency of the whole-map operations:
+/// - iteration and GetSnapshot() are snapshot-consistent within each shard,
+///   but the shards are captured one after another;
+/// - Assign() and Clear() are applied shard-by-shard, concurrent readers may
+///   observe a mix of the old and the new data;
+/// - SizeApprox() sums sizes of the shards taken at different moments.
+///
+/// Prefer rcu::RcuMap if a consistent view of the whole map is required, or if
+/// the map is small, and rcu::ShardedRcuMap for large maps with frequent
+/// single-key updates.
+///
+/// @note No synchronization is provided for value access, it must be
+/// implemented by Value when necessary.
+///
+/// ## Example usage:
+///
+/// @snippet rcu/sharded_rcu_map_test.cpp  Sample rcu::ShardedRcuMap usage
+///
+/// @see @ref scripts/docs/en/userver/synchronization.md
+template <typename Key, typename Value, typename RcuMapTraits>
+class ShardedRcuMap final {
+ public:
+  using Shard = RcuMap<Key, Value, RcuMapTraits>;
+  using RcuTraits = typename impl::RcuTraitsFromRcuMapTraits<RcuMapTraits>;
+  using Hash = typename Shard::Hash;
+  using KeyEqual = typename Shard::KeyEqual;
+  using MutexType = typename Shard::MutexType;
+  using ValuePtr = typename Shard::ValuePtr;
+  using ConstValuePtr = typename Shard::ConstValuePtr;
+  using Iterator = ShardedRcuMapIterator<Key, Value, Value, RcuMapTraits>;
+  using ConstIterator =
+      ShardedRcuMapIterator<Key, Value, const Value, RcuMapTraits>;
+  using RawMap = typename Shard::RawMap;
+  using Snapshot = typename Shard::Snapshot;
+  using InsertReturnType = typename Shard::InsertReturnType;
+
+  static constexpr std::size_t kDefaultShardCount = 64;
+
+  /// @param shard_count number of shards, rounded up to a power of 2
+  explicit ShardedRcuMap(std::size_t shard_count = kDefaultShardCount);
+
+  ShardedRcuMap(const ShardedRcuMap&) = delete;
+  ShardedRcuMap(ShardedRcuMap&&) = delete;
+  ShardedRcuMap& operator=(const ShardedRcuMap&) = delete;
+  ShardedRcuMap& operator=(ShardedRcuMap&&) = delete;
+
+  /// Returns an estimated size of the map at some point in time
+  size_t SizeApprox() const;
+
+  /// @name Iteration support
+  /// @details Keyset of each shard is fixed when the iteration reaches it and
+  /// is not affected by concurrent changes.
+  /// @{
+  ConstIterator begin() const;
+  ConstIterator end() const;
+  Iterator begin();
+  Iterator end();
+  /// @}
+
+  /// @brief Returns a readonly value pointer by its key if exists
+  /// @throws MissingKeyException if the key is not present
+  const ConstValuePtr operator[](const Key&) const;
+
+  /// @brief Returns a modifiable value pointer by key if exists or
+  /// default-creates one
+  /// @note Copies the key's shard if the key doesn't exist.
+  const ValuePtr operator[](const Key&);
+
+  /// @brief Inserts a new element into the container if there is no element
+  /// with the key in the container.
+  /// @see rcu::RcuMap::Insert
+  /// @note Copies the key's shard if the key doesn't exist.
+  InsertReturnType Insert(const Key& key, ValuePtr value);
+
+  /// @brief Inserts a new element into the container constructed in-place with
+  /// the given args if there is no element with the key in the container.
+  /// @see rcu::RcuMap::Emplace
+  /// @note Copies the key's shard if the key doesn't exist.
+  template <typename... Args>
+  InsertReturnType Emplace(const Key& key, Args&&... args);
+
+  /// @brief Constructs the value only if there is no element with the key in
+  /// the container.
+  /// @see rcu::RcuMap::TryEmplace
+  /// @note Copies the key's shard if the key doesn't exist.
+  template <typename... Args>
+  InsertReturnType TryEmplace(const Key& key, Args&&... args);
+
+  /// @brief If a key equivalent to `key` already exists in the container,
+  /// replaces the associated value. Otherwise, inserts a new pair into the map.
+  /// @note Copies the key's shard.
+  template <typename RawKey>
+  void InsertOrAssign(RawKey&& key, ValuePtr value);
+
+  /// @brief Returns a readonly value pointer by its key or an empty pointer
+  const ConstValuePtr Get(const Key&) const;
+
+  /// @brief Returns a modifiable value pointer by key or an empty pointer
+  const ValuePtr Get(const Key&);
+
+  /// @brief Removes a key from the map
+  /// @returns whether the key was present
+  /// @note Copies the key's shard.
+  bool Erase(const Key&);
+
+  /// @brief Removes a key from the map returning its value
+  /// @returns a value if the key was present, empty pointer otherwise
+  /// @note Copies the key's shard.
+  ValuePtr Pop(const Key&);
+
+  /// Resets the map to an empty state, shard-by-shard
+  void Clear();
+
+  /// Replace current data by data from `new_map`, shard-by-shard
+  void Assign(RawMap new_map);
+
+  /// @brief Starts a transaction on the shard of `key`, used to perform
+  /// a series of arbitrary changes to that shard.
+  /// @warning Only keys that belong to the same shard as `key` (see
+  /// IsSameShard) may be added through the transaction.
+  rcu::WritablePtr<RawMap, RcuTraits> StartWriteShard(const Key& key);
+
+  /// @brief Returns whether the two keys are stored in the same shard
+  bool IsSameShard(const Key& lhs, const Key& rhs) const;
+
+  /// @brief Returns a readonly copy of the map
+  /// @note Each shard is copied from its own snapshot
+  Snapshot GetSnapshot() const;
+
+  std::size_t GetShardCount() const noexcept { return shards_.size(); }
+
+ private:
+  static std::size_t RoundUpShardCount(std::size_t shard_count);
+
+  std::size_t GetShardIndex(const Key& key) const;
+  Shard& GetShard(const Key& key);
+  const Shard& GetShard(const Key& key) const;
+
+  utils::FixedArray<Shard> shards_;
+};
+
+template <typename K, typename V, typename RcuMapTraits>
+ShardedRcuMap<K, V, RcuMapTraits>::ShardedRcuMap(std::size_t shard_count)
+    : shards_(RoundUpShardCount(shard_count)) {}
+
+template <typename K, typename V, typename RcuMapTraits>
+std::size_t ShardedRcuMap<K, V, RcuMapTraits>::RoundUpShardCount(
+    std::size_t shard_count) {
+  UINVARIANT(shard_count != 0 && shard_count <= (std::size_t{1} << 16),
+             "Invalid ShardedRcuMap shard count");
+  std::size_t result = 1;
+  while (result < shard_count) result <<= 1;
+  return result;
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+std::size_t ShardedRcuMap<K, V, RcuMapTraits>::GetShardIndex(
+    const K& key) const {
+  // The same hash is used by the shards' unordered_maps, so the bits that pick
+  // a shard are mixed first to keep the buckets inside a shard well-balanced.
+  constexpr std::uint64_t kFibonacciMultiplier = 0x9E3779B97F4A7C15ULL;
+  const auto hash = static_cast<std::uint64_t>(Hash{}(key));
+  return static_cast<std::size_t>((hash * kFibonacciMultiplier) >> 32) &
+         (shards_.size() - 1);
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+auto ShardedRcuMap<K, V, RcuMapTraits>::GetShard(const K& key) -> Shard& {
+  return shards_[GetShardIndex(key)];
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+auto ShardedRcuMap<K, V, RcuMapTraits>::GetShard(const K& key) const
+    -> const Shard& {
+  return shards_[GetShardIndex(key)];
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+size_t ShardedRcuMap<K, V, RcuMapTraits>::SizeApprox() const {
+  std::size_t size = 0;
+  for (const auto& shard : shards_) size += shard.SizeApprox();
+  return size;
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+auto ShardedRcuMap<K, V, RcuMapTraits>::begin() const -> ConstIterator {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+  return ConstIterator(const_cast<utils::FixedArray<Shard>&>(shards_));
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+auto ShardedRcuMap<K, V, RcuMapTraits>::end() const -> ConstIterator {
+  return {};
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+auto ShardedRcuMap<K, V, RcuMapTraits>::begin() -> Iterator {
+  return Iterator(shards_);
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+auto ShardedRcuMap<K, V, RcuMapTraits>::end() -> Iterator {
+  return {};
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+// Protects from assignment to map[key]
+// NOLINTNEXTLINE(readability-const-return-type)
+auto ShardedRcuMap<K, V, RcuMapTraits>::operator[](const K& key) const
+    -> const ConstValuePtr {
+  return GetShard(key)[key];
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+// Protects from assignment to map[key]
+// NOLINTNEXTLINE(readability-const-return-type)
+auto ShardedRcuMap<K, V, RcuMapTraits>::operator[](const K& key)
+    -> const ValuePtr {
+  return GetShard(key)[key];
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+auto ShardedRcuMap<K, V, RcuMapTraits>::Insert(const K& key, ValuePtr value)
+    -> InsertReturnType {
+  return GetShard(key).Insert(key, std::move(value));
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+template <typename... Args>
+auto ShardedRcuMap<K, V, RcuMapTraits>::Emplace(const K& key, Args&&... args)
+    -> InsertReturnType {
+  return GetShard(key).Emplace(key, std::forward<Args>(args)...);
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+template <typename... Args>
+auto ShardedRcuMap<K, V, RcuMapTraits>::TryEmplace(const K& key,
+                                                   Args&&... args)
+    -> InsertReturnType {
+  return GetShard(key).TryEmplace(key, std::forward<Args>(args)...);
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+template <typename RawKey>
+void ShardedRcuMap<K, V, RcuMapTraits>::InsertOrAssign(RawKey&& key,
+                                                       ValuePtr value) {
+  auto& shard = GetShard(key);
+  shard.InsertOrAssign(std::forward<RawKey>(key), std::move(value));
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+// Protects from assignment to map[key]
+// NOLINTNEXTLINE(readability-const-return-type)
+auto ShardedRcuMap<K, V, RcuMapTraits>::Get(const K& key) const
+    -> const ConstValuePtr {
+  return GetShard(key).Get(key);
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+// Protects from assignment to map[key]
+// NOLINTNEXTLINE(readability-const-return-type)
+auto ShardedRcuMap<K, V, RcuMapTraits>::Get(const K& key) -> const ValuePtr {
+  return GetShard(key).Get(key);
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+bool ShardedRcuMap<K, V, RcuMapTraits>::Erase(const K& key) {
+  return GetShard(key).Erase(key);
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+auto ShardedRcuMap<K, V, RcuMapTraits>::Pop(const K& key) -> ValuePtr {
+  return GetShard(key).Pop(key);
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+void ShardedRcuMap<K, V, RcuMapTraits>::Clear() {
+  for (auto& shard : shards_) shard.Clear();
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+void ShardedRcuMap<K, V, RcuMapTraits>::Assign(RawMap new_map) {
+  std::vector<RawMap> shard_maps(shards_.size());
+  for (auto& shard_map : shard_maps) {
+    shard_map.reserve(new_map.size() / shards_.size() + 1);
+  }
+  while (!new_map.empty()) {
+    auto node = new_map.extract(new_map.begin());
+    shard_maps[GetShardIndex(node.key())].insert(std::move(node));
+  }
+
+  for (std::size_t i = 0; i < shards_.size(); ++i) {
+    shards_[i].Assign(std::move(shard_maps[i]));
+  }
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+auto ShardedRcuMap<K, V, RcuMapTraits>::StartWriteShard(const K& key)
+    -> rcu::WritablePtr<RawMap, RcuTraits> {
+  return GetShard(key).StartWrite();
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+bool ShardedRcuMap<K, V, RcuMapTraits>::IsSameShard(const K& lhs,
+                                                    const K& rhs) const {
+  return GetShardIndex(lhs) == GetShardIndex(rhs);
+}
+
+template <typename K, typename V, typename RcuMapTraits>
+auto ShardedRcuMap<K, V, RcuMapTraits>::GetSnapshot() const -> Snapshot {
+  Snapshot snapshot;
+  snapshot.reserve(SizeApprox());
+  for (const auto& shard : shards_) snapshot.insert(shard.begin(), shard.end());
+  return snapshot;
+}
+
+template <typename Key, typename Value, typename IterValue,
+          typename RcuMapTraits>
+ShardedRcuMapIterator<Key, Value, IterValue, RcuMapTraits>::
+    ShardedRcuMapIterator(utils::FixedArray<Shard>& shards)
+    : shards_(&shards) {
+  EnterShard();
+  SkipExhaustedShards();
+}
+
+template <typename Key, typename Value, typename IterValue,
+          typename RcuMapTraits>
+auto ShardedRcuMapIterator<Key, Value, IterValue, RcuMapTraits>::operator++(
+    int) -> ShardedRcuMapIterator {
+  ShardedRcuMapIterator tmp(*this);
+  ++*this;
+  return tmp;
+}
+
+template <typename Key, typename Value, typename IterValue,
+          typename RcuMapTraits>
+auto ShardedRcuMapIterator<Key, Value, IterValue, RcuMapTraits>::operator++()
+    -> ShardedRcuMapIterator& {
+  ++it_;
+  SkipExhaustedShards();
+  return *this;
+}
+
+template <typename Key, typename Value, typename IterValue,
+          typename RcuMapTraits>
+auto ShardedRcuMapIterator<Key, Value, IterValue, RcuMapTraits>::operator*()
+    const -> reference {
+  return *it_;
+}
+
+template <typename Key, typename Value, typename IterValue,
+          typename RcuMapTraits>
+auto ShardedRcuMapIterator<Key, Value, IterValue, RcuMapTraits>::operator->()
+    const -> pointer {
+  return it_.operator->();
+}
+
+template <typename Key, typename Value, typename IterValue,
+          typename RcuMapTraits>
+bool ShardedRcuMapIterator<Key, Value, IterValue, RcuMapTraits>::operator==(
+    const ShardedRcuMapIterator& rhs) const {
+  // Exhausted iterators always have shards_ == nullptr
+  if (!shards_ || !rhs.shards_) return shards_ == rhs.shards_;
+  return shard_index_ == rhs.shard_index_ && it_ == rhs.it_;
+}
+
+template <typename Key, typename Value, typename IterValue,
+          typename RcuMapTraits>
+bool ShardedRcuMapIterator<Key, Value, IterValue, RcuMapTraits>::operator!=(
+    const ShardedRcuMapIterator& rhs) const {
+  return !(*this == rhs);
+}
+
+template <typename Key, typename Value, typename IterValue,
+          typename RcuMapTraits>
+void ShardedRcuMapIterator<Key, Value, IterValue, RcuMapTraits>::EnterShard() {
+  auto& shard = (*shards_)[shard_index_];
+  if constexpr (std::is_const_v<IterValue>) {
+    it_ = std::as_const(shard).begin();
+  } else {
+    it_ = shard.begin();
+  }
+}
+
+template <typename Key, typename Value, typename IterValue,
+          typename RcuMapTraits>
+void ShardedRcuMapIterator<Key, Value, IterValue,
+                           RcuMapTraits>::SkipExhaustedShards() {
+  while (it_ == ShardIterator{}) {
+    if (++shard_index_ == shards_->size()) {
+      shards_ = nullptr;
+      shard_index_ = 0;
+      it_ = {};
+      return;
+    }
+    EnterShard();
+  }
+}
+
+}  // namespace rcu
+
+USERVER_NAMESPACE_END
@@ -77,6 +77,11 @@ namespace components {
 /// connection.requests_queue_size_threshold | drop requests from handlers that allow throttling if there's more pending requests than allowed by this value | 100
 /// connection.keepalive_timeout | timeout in seconds to drop connection if there's not data received from it | 600
 /// connection.stream_close_check_delay | delay in microseconds of the start of stream close check routine; do not set if not sure what it is doing | 20ms
+/// connection.max_pipelined_requests | max number of HTTP/1.1 pipelined requests of a connection to handle concurrently; only GET, HEAD and OPTIONS requests run ahead of the previous ones, the responses are sent in order | 1
+/// connection.http_version | '2' to also accept HTTP/2: over TLS via ALPN h2, in plaintext via h2c with prior knowledge; '1.1' to accept HTTP/1.1 only | '1.1'
+/// connection.http2_session.max_concurrent_streams | max number of concurrent streams (requests) per HTTP/2 connection | 100
+/// connection.http2_session.max_frame_size | max HTTP/2 frame payload size the server accepts | 16384
+/// connection.http2_session.initial_window_size | initial HTTP/2 per-stream flow control window for request bodies | 65535
 /// shards | how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing | -
 /// middleware-pipeline-builder | name of a component to build a server-wide middleware pipeline | default-server-middleware-pipeline-builder
 ///
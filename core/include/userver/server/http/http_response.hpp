@@ -4,8 +4,11 @@
 /// @brief @copybrief server::http::HttpResponse
 
 #include <chrono>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <variant>
+#include <vector>
 
 #include <userver/concurrent/queue.hpp>
 #include <userver/engine/single_consumer_event.hpp>
@@ -20,6 +23,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace fs::blocking {
+class FileDescriptor;
+}  // namespace fs::blocking
+
 namespace server::http {
 
 namespace impl {
@@ -30,6 +37,7 @@ void OutputHeader(USERVER_NAMESPACE::http::headers::HeadersString& header,
 }  // namespace impl
 
 class HttpRequestImpl;
+class Http2StreamWriter;
 
 /// @brief HTTP Response data
 class HttpResponse final : public request::ResponseBase {
@@ -42,6 +50,13 @@ class HttpResponse final : public request::ResponseBase {
 
   using CookiesMapKeys = decltype(utils::impl::MakeKeysView(CookiesMap()));
 
+  /// @brief Range of an open file to send as a part of the response body
+  struct FileRange {
+    std::shared_ptr<const fs::blocking::FileDescriptor> file;
+    std::size_t offset{0};
+    std::size_t size{0};
+  };
+
   /// @cond
   HttpResponse(const HttpRequestImpl& request,
                request::ResponseDataAccounter& data_accounter);
@@ -113,6 +128,29 @@ class HttpResponse final : public request::ResponseBase {
   bool HasHeader(const USERVER_NAMESPACE::http::headers::PredefinedHeader&
                      header_name) const;
 
+  /// @brief Appends a part of the body that is referenced by the response
+  /// instead of being copied into it, e.g. a file from components::FsCache.
+  ///
+  /// The parts are sent after the data set by SetData(), the in-memory ones
+  /// with a single writev(2) together with the headers.
+  void AppendBodySegment(std::shared_ptr<const std::string> data);
+
+  /// @brief Appends a file range to the body.
+  ///
+  /// The range is sent with sendfile(2) over plain TCP connections and is read
+  /// in chunks otherwise. The file is read synchronously, so its contents are
+  /// expected to reside in the page cache. The range must not change until
+  /// the response is sent. If the file turns out to be shorter than the range,
+  /// the send fails and the connection is closed.
+  void AppendBodySegment(FileRange range);
+
+  /// @brief Removes the appended body segments, e.g. to replace the body
+  /// with an error message.
+  void ClearBodySegments();
+
+  /// @return Size of the data set by SetData() and of the appended segments.
+  std::size_t GetBodySize() const;
+
   /// @return List of cookies names.
   CookiesMapKeys GetCookieNames() const;
 
@@ -123,6 +161,8 @@ class HttpResponse final : public request::ResponseBase {
   /// @cond
   // TODO: server internals. remove from public interface
   void SendResponse(engine::io::RwBase& socket) override;
+  // HTTP/2 counterpart of SendResponse, the frames are written by the session
+  void SendResponse(Http2StreamWriter& writer);
   /// @endcond
 
   void SetStatusServiceUnavailable() override {
@@ -152,6 +192,14 @@ class HttpResponse final : public request::ResponseBase {
       engine::io::RwBase& socket,
       USERVER_NAMESPACE::http::headers::HeadersString& header);
 
+  using BodySegment =
+      std::variant<std::shared_ptr<const std::string>, FileRange>;
+
+  // Returns total size of the written data
+  std::size_t WriteBodySegments(
+      engine::io::RwBase& socket,
+      USERVER_NAMESPACE::http::headers::HeadersString& header);
+
   const HttpRequestImpl& request_;
   HttpStatus status_ = HttpStatus::kOk;
   HeadersMap headers_;
@@ -161,6 +209,7 @@ class HttpResponse final : public request::ResponseBase {
       engine::SingleConsumerEvent::NoAutoReset()};
   std::optional<Queue::Consumer> body_stream_;
   std::optional<Queue::Producer> body_stream_producer_;
+  std::vector<BodySegment> body_segments_;
 };
 
 void SetThrottleReason(http::HttpResponse& http_response,
@@ -40,6 +40,8 @@ void CombineStatistics(const impl::UpdateStatistics& a,
       a.documents_read_count.Load() + b.documents_read_count.Load();
   result.documents_parse_failures =
       a.documents_parse_failures.Load() + b.documents_parse_failures.Load();
+  result.documents_chunks_count =
+      a.documents_chunks_count.Load() + b.documents_chunks_count.Load();
 
   result.last_update_start_time = std::max(a.last_update_start_time.load(),
                                            b.last_update_start_time.load());
@@ -76,6 +78,7 @@ void DumpMetric(utils::statistics::Writer& writer,
     // v2 - please see note above
     documents["read_count.v2"] = stats.documents_read_count;
     documents["parse_failures.v2"] = stats.documents_parse_failures;
+    documents["chunks_count"] = stats.documents_chunks_count;
   }
 
   if (auto age = writer["time"]) {
@@ -150,6 +153,10 @@ void UpdateStatisticsScope::IncreaseDocumentsParseFailures(std::size_t add) {
   update_stats_.documents_parse_failures += utils::statistics::Rate{add};
 }
 
+void UpdateStatisticsScope::IncreaseChunksCount(std::size_t add) {
+  update_stats_.documents_chunks_count += utils::statistics::Rate{add};
+}
+
 void UpdateStatisticsScope::DoFinish(impl::UpdateState new_state) {
   UASSERT(new_state != impl::UpdateState::kNotFinished);
   // TODO Some production caches call Finish multiple times. We should fix those
@@ -71,6 +71,12 @@ void CacheUpdateTrait::ReadAndSet(dump::Reader&) {
   dump::ThrowDumpUnimplemented(Name());
 }
 
+bool CacheUpdateTrait::GetAndWriteDelta(dump::Writer&, dump::TimePoint) const {
+  return false;
+}
+
+bool CacheUpdateTrait::ReadAndApplyDelta(dump::Reader&) { return false; }
+
 }  // namespace cache
 
 USERVER_NAMESPACE_END
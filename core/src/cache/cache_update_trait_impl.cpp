@@ -397,6 +397,8 @@ void CacheUpdateTrait::Impl::DoUpdate(UpdateType update_type,
   LOG_INFO() << "Updating cache update_type=" << update_type_str
              << " name=" << name_;
 
+  if (update_type == UpdateType::kFull) dumpable_.OnFullUpdateStarted(now);
+
   try {
     customized_trait_.Update(update_type, last_update_, now, stats);
     CheckUpdateState(stats.GetState(utils::InternalTag{}), update_type_str);
@@ -468,6 +470,22 @@ void CacheUpdateTrait::Impl::DumpableEntityProxy::ReadAndSet(
   cache_.ReadAndSet(reader);
 }
 
+bool CacheUpdateTrait::Impl::DumpableEntityProxy::GetAndWriteDelta(
+    dump::Writer& writer, dump::TimePoint since) const {
+  if (since < last_full_update_time_.load()) return false;
+  return cache_.GetAndWriteDelta(writer, since);
+}
+
+bool CacheUpdateTrait::Impl::DumpableEntityProxy::ReadAndApplyDelta(
+    dump::Reader& reader) {
+  return cache_.ReadAndApplyDelta(reader);
+}
+
+void CacheUpdateTrait::Impl::DumpableEntityProxy::OnFullUpdateStarted(
+    dump::TimePoint update_time) noexcept {
+  last_full_update_time_.store(update_time);
+}
+
 }  // namespace cache
 
 USERVER_NAMESPACE_END
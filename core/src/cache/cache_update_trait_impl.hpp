@@ -71,8 +71,17 @@ class CacheUpdateTrait::Impl final {
 
     void ReadAndSet(dump::Reader& reader) override;
 
+    bool GetAndWriteDelta(dump::Writer& writer,
+                          dump::TimePoint since) const override;
+
+    bool ReadAndApplyDelta(dump::Reader& reader) override;
+
+    // The changes made before the full update are not deltas of the data
+    void OnFullUpdateStarted(dump::TimePoint update_time) noexcept;
+
    private:
     CacheUpdateTrait& cache_;
+    std::atomic<dump::TimePoint> last_full_update_time_{};
   };
 
   enum class FirstUpdateInvalidation { kNo, kYes, kFinished };
@@ -1,8 +1,10 @@
 #include <userver/cache/cache_update_trait.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <exception>
 #include <optional>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -15,6 +17,7 @@
 #include <userver/cache/update_type.hpp>
 #include <userver/components/component.hpp>
 #include <userver/dump/common.hpp>
+#include <userver/dump/common_containers.hpp>
 #include <userver/dump/test_helpers.hpp>
 #include <userver/dynamic_config/storage_mock.hpp>
 #include <userver/engine/sleep.hpp>
@@ -533,6 +536,140 @@ UTEST(CacheUpdateTrait, WriteDumps) {
 
 namespace {
 
+// Incremental updates append values, which are dumped as deltas
+class DeltaDumpedCache final : public cache::CacheMockBase {
+ public:
+  static constexpr std::string_view kName = "delta-dumped-cache";
+
+  DeltaDumpedCache(const yaml_config::YamlConfig& config,
+                   cache::MockEnvironment& environment,
+                   cache::DataSourceMock<std::uint64_t>& data_source)
+      : cache::CacheMockBase(kName, config, environment),
+        data_source_(data_source) {
+    StartPeriodicUpdates();
+  }
+
+  ~DeltaDumpedCache() final { StopPeriodicUpdates(); }
+
+  const std::vector<std::uint64_t>& Get() const { return values_; }
+
+  int GetDeltaWriteCount() const { return delta_write_count_; }
+
+ private:
+  void Update(cache::UpdateType type,
+              const std::chrono::system_clock::time_point&,
+              const std::chrono::system_clock::time_point& now,
+              cache::UpdateStatisticsScope& stats_scope) override {
+    const auto value = data_source_.Fetch();
+    if (type == UpdateType::kFull) {
+      values_.clear();
+      changes_.clear();
+    }
+    values_.push_back(value);
+    changes_.emplace_back(
+        std::chrono::time_point_cast<dump::TimePoint::duration>(now), value);
+    OnCacheModified();
+    stats_scope.Finish(values_.size());
+  }
+
+  void GetAndWrite(dump::Writer& writer) const override {
+    writer.Write(values_);
+  }
+
+  void ReadAndSet(dump::Reader& reader) override {
+    values_ = reader.Read<std::vector<std::uint64_t>>();
+  }
+
+  bool GetAndWriteDelta(dump::Writer& writer,
+                        dump::TimePoint since) const override {
+    std::vector<std::uint64_t> delta;
+    for (const auto& [time, value] : changes_) {
+      if (time > since) delta.push_back(value);
+    }
+    writer.Write(delta);
+    ++delta_write_count_;
+    return true;
+  }
+
+  bool ReadAndApplyDelta(dump::Reader& reader) override {
+    const auto delta = reader.Read<std::vector<std::uint64_t>>();
+    values_.insert(values_.end(), delta.begin(), delta.end());
+    return true;
+  }
+
+  std::vector<std::uint64_t> values_;
+  std::vector<std::pair<dump::TimePoint, std::uint64_t>> changes_;
+  mutable int delta_write_count_{0};
+  cache::DataSourceMock<std::uint64_t>& data_source_;
+};
+
+const std::string kDeltaDumpedCacheConfig = R"(
+update-types: full-and-incremental
+update-interval: 10h
+full-update-interval: 20h
+dump:
+    enable: true
+    world-readable: true
+    format-version: 0
+    first-update-mode: skip
+    max-age:  # unlimited
+    max-count: 1
+    max-delta-count: 2
+)";
+
+}  // namespace
+
+UTEST(CacheUpdateTrait, WriteDumpDeltas) {
+  const yaml_config::YamlConfig config{
+      formats::yaml::FromString(kDeltaDumpedCacheConfig), {}};
+  cache::MockEnvironment env;
+  cache::DataSourceMock<std::uint64_t> data_source(1);
+
+  const auto count_deltas = [&] {
+    const auto filenames =
+        dump::FilenamesInDirectory(env.dump_root, DeltaDumpedCache::kName);
+    return std::count_if(
+        filenames.begin(), filenames.end(), [](const std::string& filename) {
+          return filename.find(".delta-") != std::string::npos;
+        });
+  };
+
+  {
+    DeltaDumpedCache cache(config, env, data_source);
+    const auto update_and_write = [&](std::uint64_t value,
+                                      UpdateType update_type) {
+      data_source.Set(value);
+      env.cache_control.ResetCaches(update_type, {cache.Name()},
+                                    /*force_incremental_names=*/{});
+      env.dump_control.WriteCacheDumps({cache.Name()});
+    };
+
+    env.dump_control.WriteCacheDumps({cache.Name()});
+    update_and_write(2, UpdateType::kIncremental);
+    update_and_write(3, UpdateType::kIncremental);
+    EXPECT_EQ(cache.GetDeltaWriteCount(), 2);
+    EXPECT_EQ(count_deltas(), 2);
+  }
+
+  {
+    DeltaDumpedCache cache(config, env, data_source);
+    EXPECT_EQ(cache.Get(), (std::vector<std::uint64_t>{1, 2, 3}));
+
+    // The changes made before a full update are not deltas of the new data
+    data_source.Set(4);
+    env.cache_control.ResetCaches(UpdateType::kFull, {cache.Name()},
+                                  /*force_incremental_names=*/{});
+    env.dump_control.WriteCacheDumps({cache.Name()});
+    EXPECT_EQ(cache.GetDeltaWriteCount(), 0);
+    EXPECT_EQ(count_deltas(), 0);
+  }
+
+  DeltaDumpedCache cache(config, env, data_source);
+  EXPECT_EQ(cache.Get(), std::vector<std::uint64_t>{4});
+}
+
+namespace {
+
 class FaultyDumpedCache final : public cache::CacheMockBase {
  public:
   static constexpr std::string_view kName = "faulty-dumped-cache";
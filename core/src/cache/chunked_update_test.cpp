@@ -0,0 +1,66 @@
+#include <userver/cache/chunked_update.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr int kChunks = 20;
+constexpr int kChunkSize = 10;
+
+std::vector<int> ParseChunk(int chunk) {
+  // later chunks are parsed faster, so that they finish out of order
+  engine::SleepFor(std::chrono::milliseconds{(kChunks - chunk) % 4});
+
+  std::vector<int> values;
+  for (int i = 0; i < kChunkSize; ++i) values.push_back(chunk * kChunkSize + i);
+  return values;
+}
+
+}  // namespace
+
+UTEST_MT(ChunkedUpdate, MergesInOrder, 4) {
+  for (const std::size_t max_parallel_chunks : {0, 1, 3, 8}) {
+    cache::impl::Statistics stats;
+    std::vector<int> data;
+    {
+      cache::UpdateStatisticsScope stats_scope(stats, cache::UpdateType::kFull);
+      cache::ChunkedUpdate<std::vector<int>> update{
+          max_parallel_chunks, stats_scope, [&data](std::vector<int>&& values) {
+            data.insert(data.end(), values.begin(), values.end());
+          }};
+
+      for (int chunk = 0; chunk < kChunks; ++chunk) {
+        update.Push([chunk] { return ParseChunk(chunk); });
+      }
+      update.Finish();
+      stats_scope.Finish(data.size());
+    }
+
+    ASSERT_EQ(data.size(), kChunks * kChunkSize) << max_parallel_chunks;
+    for (int i = 0; i < kChunks * kChunkSize; ++i) EXPECT_EQ(data[i], i);
+    EXPECT_EQ(stats.full_update.documents_chunks_count.Load().value, kChunks);
+  }
+}
+
+UTEST_MT(ChunkedUpdate, ParseFailure, 2) {
+  cache::impl::Statistics stats;
+  cache::UpdateStatisticsScope stats_scope(stats, cache::UpdateType::kFull);
+  std::atomic<int> merged{0};
+  cache::ChunkedUpdate<std::vector<int>> update{
+      2, stats_scope, [&merged](std::vector<int>&&) { ++merged; }};
+
+  update.Push([] { return ParseChunk(0); });
+  update.Push([]() -> std::vector<int> { throw std::runtime_error("parse"); });
+  update.Push([] { return ParseChunk(2); });
+  EXPECT_THROW(update.Finish(), std::runtime_error);
+  EXPECT_EQ(merged, 1);
+}
+
+USERVER_NAMESPACE_END
@@ -1,9 +1,14 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <string>
+#include <vector>
 
 #include <userver/utest/utest.hpp>
 
 #include <userver/cache/expirable_lru_cache.hpp>
 #include <userver/dump/operations_mock.hpp>
+#include <userver/engine/async.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/utils/mock_now.hpp>
 
@@ -357,6 +362,80 @@ UTEST(ExpirableLruCache, Example) {
   /// [Sample ExpirableLruCache]
 }
 
+UTEST(ExpirableLruCache, GetMany) {
+  SimpleCache cache(1, 10);
+  cache.Put("a", 1);
+
+  std::vector<std::vector<SimpleCacheKey>> requests;
+  const auto bulk_update =
+      [&requests](const std::vector<SimpleCacheKey>& keys) {
+        requests.push_back(keys);
+        SimpleCache::ValuesMap values;
+        for (const auto& key : keys) {
+          // keys without a value are not returned
+          if (key != "none") values.emplace(key, static_cast<int>(key.size()));
+        }
+        return values;
+      };
+
+  const auto values =
+      cache.GetMany({"a", "bb", "ccc", "bb", "none"}, bulk_update);
+  EXPECT_EQ(values, (SimpleCache::ValuesMap{{"a", 1}, {"bb", 2}, {"ccc", 3}}));
+  ASSERT_EQ(requests.size(), 1);
+  std::sort(requests[0].begin(), requests[0].end());
+  EXPECT_EQ(requests[0], (std::vector<SimpleCacheKey>{"bb", "ccc", "none"}));
+
+  const auto& stats = cache.GetStatistics().total;
+  EXPECT_EQ(stats.hits, 1);
+  EXPECT_EQ(stats.misses, 3);
+  EXPECT_EQ(stats.bulk_updates, 1);
+  EXPECT_EQ(stats.bulk_updated_keys, 3);
+
+  requests.clear();
+  EXPECT_EQ(cache.GetMany({"bb", "ccc"}, bulk_update),
+            (SimpleCache::ValuesMap{{"bb", 2}, {"ccc", 3}}));
+  EXPECT_TRUE(requests.empty());
+
+  EXPECT_EQ(
+      cache.GetMany({"d"}, bulk_update, SimpleCache::ReadMode::kSkipCache),
+      (SimpleCache::ValuesMap{{"d", 1}}));
+  EXPECT_EQ(std::nullopt, cache.GetOptionalNoUpdate("d"));
+}
+
+UTEST_MT(ExpirableLruCache, GetManyConcurrent, 4) {
+  constexpr int kKeys = 100;
+  SimpleCache cache(4, kKeys);
+
+  std::array<std::atomic<int>, kKeys> loads{};
+  const auto bulk_update = [&loads](const std::vector<SimpleCacheKey>& keys) {
+    SimpleCache::ValuesMap values;
+    for (const auto& key : keys) {
+      ++loads[std::stoi(key)];
+      values.emplace(key, std::stoi(key));
+    }
+    EngineYield();
+    return values;
+  };
+
+  std::vector<SimpleCacheKey> keys;
+  for (int i = 0; i < kKeys; ++i) keys.push_back(std::to_string(i));
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int i = 0; i < 4; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&, i] {
+      auto task_keys = keys;
+      std::rotate(task_keys.begin(), task_keys.begin() + i * kKeys / 4,
+                  task_keys.end());
+      const auto values = cache.GetMany(task_keys, bulk_update);
+      EXPECT_EQ(values.size(), kKeys);
+      for (const auto& [key, value] : values) EXPECT_EQ(std::stoi(key), value);
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  for (int i = 0; i < kKeys; ++i) EXPECT_EQ(loads[i], 1) << i;
+}
+
 UTEST(LruCacheWrapper, HitWrapper) {
   auto counter = std::make_shared<Counter>();
 
@@ -378,6 +457,11 @@ UTEST(LruCacheWrapper, HitWrapper) {
   WriteAndReadFromDump(*cache_ptr);
   EXPECT_EQ(std::make_optional(1), wrapper.GetOptional(key));
   EXPECT_EQ(Counter::Zero(), *counter);
+
+  counter->Flush();
+  EXPECT_EQ(wrapper.GetMany({key, "other-key"}),
+            (SimpleCache::ValuesMap{{key, 1}, {"other-key", 1}}));
+  EXPECT_EQ(Counter::One(), *counter);
 }
 
 USERVER_NAMESPACE_END
@@ -53,6 +53,15 @@ properties:
     ways:
         type: integer
         description: number of ways for associative cache
+    policy:
+        type: string
+        description: admission and eviction policy of the cache
+        defaultDescription: lru
+        enum:
+          - lru
+          - slru
+          - wtinylfu
+          - clock
     lifetime:
         type: string
         description: TTL for cache entries (0 is unlimited)
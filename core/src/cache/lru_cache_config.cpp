@@ -6,6 +6,8 @@
 #include <userver/dump/config.hpp>
 #include <userver/dynamic_config/value.hpp>
 #include <userver/utils/algo.hpp>
+#include <userver/utils/trivial_map.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -18,6 +20,15 @@ constexpr std::string_view kSize = "size";
 constexpr std::string_view kLifetime = "lifetime";
 constexpr std::string_view kBackgroundUpdate = "background-update";
 constexpr std::string_view kLifetimeMs = "lifetime-ms";
+constexpr std::string_view kPolicy = "policy";
+
+constexpr utils::TrivialBiMap kCachePolicyMap([](auto selector) {
+  return selector()
+      .Case(CachePolicy::kLRU, "lru")
+      .Case(CachePolicy::kSLRU, "slru")
+      .Case(CachePolicy::kWTinyLFU, "wtinylfu")
+      .Case(CachePolicy::kClock, "clock");
+});
 
 }  // namespace
 
@@ -58,6 +69,7 @@ LruCacheConfigStatic::LruCacheConfigStatic(
     const yaml_config::YamlConfig& config)
     : config(config),
       ways(config[kWays].As<std::size_t>()),
+      policy(config[kPolicy].As<CachePolicy>(CachePolicy::kLRU)),
       use_dynamic_config(config["config-settings"].As<bool>(true)) {
   if (ways <= 0) throw std::runtime_error("cache-ways is non-positive");
 }
@@ -71,6 +83,11 @@ std::size_t LruCacheConfigStatic::GetWaySize() const {
   return config.GetWaySize(ways);
 }
 
+CachePolicy Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<CachePolicy>) {
+  return utils::ParseFromValueString(value, kCachePolicyMap);
+}
+
 const dynamic_config::Key<std::unordered_map<std::string, LruCacheConfig>>
     kLruCacheConfigSet{"USERVER_LRU_CACHES",
                        dynamic_config::DefaultAsJsonString{"{}"}};
@@ -13,13 +13,17 @@ ExpirableLruCacheStatisticsBase::ExpirableLruCacheStatisticsBase(
     : hits(other.hits.load()),
       misses(other.misses.load()),
       stale(other.stale.load()),
-      background_updates(other.background_updates.load()) {}
+      background_updates(other.background_updates.load()),
+      bulk_updates(other.bulk_updates.load()),
+      bulk_updated_keys(other.bulk_updated_keys.load()) {}
 
 void ExpirableLruCacheStatisticsBase::Reset() {
   hits = 0;
   misses = 0;
   stale = 0;
   background_updates = 0;
+  bulk_updates = 0;
+  bulk_updated_keys = 0;
 }
 
 ExpirableLruCacheStatisticsBase& ExpirableLruCacheStatisticsBase::operator+=(
@@ -28,6 +32,8 @@ ExpirableLruCacheStatisticsBase& ExpirableLruCacheStatisticsBase::operator+=(
   misses += other.misses.load();
   stale += other.stale.load();
   background_updates += other.background_updates.load();
+  bulk_updates += other.bulk_updates.load();
+  bulk_updated_keys += other.bulk_updated_keys.load();
   return *this;
 }
 
@@ -49,12 +55,24 @@ void CacheStale(ExpirableLruCacheStatistics& stats) {
   LOG_TRACE() << "stale cache";
 }
 
+void CacheBulkUpdate(ExpirableLruCacheStatistics& stats,
+                     std::size_t keys_count) {
+  ++stats.total.bulk_updates;
+  stats.total.bulk_updated_keys += keys_count;
+  auto& recent = stats.recent.GetCurrentCounter();
+  ++recent.bulk_updates;
+  recent.bulk_updated_keys += keys_count;
+  LOG_TRACE() << "cache bulk update of " << keys_count << " keys";
+}
+
 void DumpMetric(utils::statistics::Writer& writer,
                 const ExpirableLruCacheStatistics& stats) {
   writer["hits"] = stats.total.hits.load();
   writer["misses"] = stats.total.misses.load();
   writer["stale"] = stats.total.stale.load();
   writer["background-updates"] = stats.total.background_updates.load();
+  writer["bulk-updates"] = stats.total.bulk_updates.load();
+  writer["bulk-updated-keys"] = stats.total.bulk_updated_keys.load();
 
   auto s1min = stats.recent.GetStatsForPeriod();
   double s1min_hits = s1min.hits.load();
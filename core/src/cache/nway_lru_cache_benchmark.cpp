@@ -0,0 +1,67 @@
+#include <userver/cache/nway_lru_cache.hpp>
+
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <utils/impl/parallelize_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kWays = 16;
+constexpr std::uint64_t kKeysCount = 16 * 1024;
+
+using Cache = cache::NWayLRU<std::uint64_t, std::uint64_t>;
+
+}  // namespace
+
+// Hits of a cache that holds all the keys, from state.range(1) threads
+void nway_lru_get(benchmark::State& state) {
+  const auto policy = static_cast<cache::CachePolicy>(state.range(0));
+  engine::RunStandalone(state.range(1), [&] {
+    Cache cache(kWays, kKeysCount / kWays * 2, policy);
+    for (std::uint64_t i = 0; i < kKeysCount; ++i) cache.Put(i, i);
+
+    RunParallelBenchmark(state, [&cache](auto& range) {
+      std::uint64_t key = 0;
+      for ([[maybe_unused]] auto _ : range) {
+        benchmark::DoNotOptimize(cache.Get(key));
+        key = (key + 7919) % kKeysCount;
+      }
+    });
+  });
+}
+BENCHMARK(nway_lru_get)
+    ->ArgNames({"policy", "threads"})
+    ->ArgsProduct({{static_cast<long>(cache::CachePolicy::kLRU),
+                    static_cast<long>(cache::CachePolicy::kClock)},
+                   {1, 2, 4, 8, 16}});
+
+// 1 of 64 accesses is a miss of a new key, that is put to the cache
+void nway_lru_get_mostly(benchmark::State& state) {
+  const auto policy = static_cast<cache::CachePolicy>(state.range(0));
+  engine::RunStandalone(state.range(1), [&] {
+    Cache cache(kWays, kKeysCount / kWays, policy);
+    for (std::uint64_t i = 0; i < kKeysCount; ++i) cache.Put(i, i);
+
+    RunParallelBenchmark(state, [&cache](auto& range) {
+      std::uint64_t key = 0;
+      std::uint64_t i = 0;
+      for ([[maybe_unused]] auto _ : range) {
+        const auto current_key = (++i % 64 == 0) ? kKeysCount + i : key;
+        if (!cache.Get(current_key)) cache.Put(current_key, current_key);
+        key = (key + 7919) % kKeysCount;
+      }
+    });
+  });
+}
+BENCHMARK(nway_lru_get_mostly)
+    ->ArgNames({"policy", "threads"})
+    ->ArgsProduct({{static_cast<long>(cache::CachePolicy::kLRU),
+                    static_cast<long>(cache::CachePolicy::kClock)},
+                   {1, 2, 4, 8, 16}});
+
+USERVER_NAMESPACE_END
@@ -1,6 +1,7 @@
 #include <userver/utest/utest.hpp>
 
 #include <userver/cache/nway_lru_cache.hpp>
+#include <userver/engine/async.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -54,6 +55,95 @@ UTEST(NWayLRU, SetMultipleWays) {
   EXPECT_EQ(1, cache.Get(1));
 }
 
+UTEST(NWayLRU, Policies) {
+  for (const auto policy :
+       {cache::CachePolicy::kLRU, cache::CachePolicy::kSLRU,
+        cache::CachePolicy::kWTinyLFU, cache::CachePolicy::kClock}) {
+    Cache cache(2, 100, policy);
+    for (int i = 0; i < 1000; ++i) cache.Put(i, i);
+    EXPECT_LE(cache.GetSize(), 200);
+
+    cache.Put(1000, 1000);
+    EXPECT_EQ(1000, cache.Get(1000));
+    EXPECT_EQ(1000, cache.GetOr(1000, -1));
+
+    cache.InvalidateByKey(1000);
+    EXPECT_FALSE(cache.Get(1000).has_value());
+
+    cache.UpdateWaySize(10);
+    EXPECT_LE(cache.GetSize(), 20);
+
+    cache.Invalidate();
+    EXPECT_EQ(0, cache.GetSize());
+  }
+}
+
+UTEST(NWayLRU, ClockEviction) {
+  Cache cache(1, 3, cache::CachePolicy::kClock);
+  cache.Put(1, 1);
+  cache.Put(2, 2);
+  cache.Put(3, 3);
+
+  // the reference bit keeps 1 and 3, 2 is evicted
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_EQ(3, cache.Get(3));
+  cache.Put(4, 4);
+  EXPECT_EQ(3, cache.GetSize());
+  EXPECT_FALSE(cache.Get(2).has_value());
+  EXPECT_EQ(1, cache.Get(1));
+  EXPECT_EQ(4, cache.Get(4));
+
+  EXPECT_FALSE(cache.Get(4, [](int) { return false; }).has_value());
+  EXPECT_EQ(2, cache.GetSize());
+}
+
+UTEST(NWayLRU, ClockResize) {
+  Cache cache(1, 4, cache::CachePolicy::kClock);
+  for (int i = 0; i < 4; ++i) cache.Put(i, i);
+
+  // The index is resharded for the new size, the elements are kept
+  cache.UpdateWaySize(10000);
+  for (int i = 4; i < 10000; ++i) cache.Put(i, i);
+  EXPECT_EQ(10000, cache.GetSize());
+  for (int i = 0; i < 10000; ++i) EXPECT_EQ(i, cache.Get(i));
+
+  cache.UpdateWaySize(16);
+  EXPECT_EQ(16, cache.GetSize());
+  int found = 0;
+  for (int i = 0; i < 10000; ++i) {
+    if (cache.Get(i)) ++found;
+  }
+  EXPECT_EQ(16, found);
+
+  cache.InvalidateByKey(9999);
+  cache.Invalidate();
+  EXPECT_EQ(0, cache.GetSize());
+  EXPECT_FALSE(cache.Get(0).has_value());
+}
+
+UTEST_MT(NWayLRU, ClockConcurrentAccess, 4) {
+  constexpr int kKeys = 100;
+  Cache cache(2, kKeys / 4, cache::CachePolicy::kClock);
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (int i = 0; i < 4; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&cache, i] {
+      for (int j = 0; j < 1000; ++j) {
+        const auto key = (i * 31 + j) % kKeys;
+        const auto value = cache.Get(key);
+        if (value) {
+          EXPECT_EQ(*value, key);
+        } else {
+          cache.Put(key, key);
+        }
+      }
+    }));
+  }
+  for (auto& task : tasks) task.Get();
+
+  EXPECT_LE(cache.GetSize(), kKeys / 2);
+}
+
 UTEST(NWayLRU, HashCombine) {
   for (const auto seed : std::vector<std::size_t>{0, 1, 7, 42, 100, 1000}) {
     /// @note: checking for seed used in way selection to not be equal after
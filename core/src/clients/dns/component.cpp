@@ -39,6 +39,12 @@ ResolverConfig ParseResolverConfig(
   config.cache_failure_ttl =
       component_config["cache_failure_ttl"].As<std::chrono::milliseconds>(
           config.cache_failure_ttl);
+  config.cache_refresh_interval =
+      component_config["cache-refresh-interval"].As<std::chrono::milliseconds>(
+          config.cache_refresh_interval);
+  config.prefetch_names =
+      component_config["prefetch-names"].As<std::vector<std::string>>(
+          config.prefetch_names);
   return config;
 }
 
@@ -54,6 +60,8 @@ Component::Component(const components::ComponentConfig& config,
       context.FindComponent<components::StatisticsStorage>().GetStorage();
   statistics_holder_ = storage.RegisterWriter(
       config.Name() + ".replies", [this](auto& writer) { Write(writer); });
+  cache_statistics_holder_ = storage.RegisterWriter(
+      config.Name() + ".cache", [this](auto& writer) { WriteCache(writer); });
 }
 
 clients::dns::Resolver& Component::GetResolver() { return resolver_; }
@@ -71,6 +79,12 @@ void Component::Write(utils::statistics::Writer& writer) {
                          {kDnsReplySource, "network-failure"});
 }
 
+void Component::WriteCache(utils::statistics::Writer& writer) {
+  const auto& counters = GetResolver().GetCacheCounters();
+  writer["misses"] = counters.misses;
+  writer["refreshes"] = counters.refreshes;
+}
+
 yaml_config::Schema Component::GetStaticConfigSchema() {
   return yaml_config::MergeSchemas<LoggableComponentBase>(R"(
 type: object
@@ -119,6 +133,19 @@ properties:
         type: string
         description: TTL for network failures caching
         defaultDescription: 5s
+    cache-refresh-interval:
+        type: string
+        description: |
+            period of re-resolving the cached names that were used since
+            the last update and are about to expire, 0 disables the refresh
+        defaultDescription: 0
+    prefetch-names:
+        type: array
+        description: list of names to resolve in background on start
+        defaultDescription: '[]'
+        items:
+            type: string
+            description: name to resolve
 )");
 }
 
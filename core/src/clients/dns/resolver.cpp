@@ -2,9 +2,12 @@
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <atomic>
 #include <cctype>
 #include <chrono>
+#include <memory>
 #include <string_view>
+#include <vector>
 
 #include <clients/dns/file_resolver.hpp>
 #include <clients/dns/helpers.hpp>
@@ -18,6 +21,7 @@
 #include <userver/utils/from_string.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
 #include <userver/utils/mock_now.hpp>
+#include <userver/utils/periodic_task.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -134,6 +138,7 @@ class Resolver::Impl {
   ~Impl();
 
   const LookupSourceCounters& GetLookupSourceCounters() const;
+  const CacheCounters& GetCacheCounters() const;
 
   void ReloadHosts();
   void FlushNetworkCache();
@@ -151,7 +156,7 @@ class Resolver::Impl {
                                engine::Deadline deadline);
 
   template <typename Mutex>
-  void StartBackgroundQuery(std::unique_lock<Mutex>& lock, Mutex&& mutex,
+  bool StartBackgroundQuery(std::unique_lock<Mutex>& lock, Mutex&& mutex,
                             const std::string& name);
 
  private:
@@ -159,8 +164,15 @@ class Resolver::Impl {
     AddrVector addrs;
     std::chrono::steady_clock::time_point expiration;
     bool is_failure{false};
+    // shared between the copies returned by the cache
+    std::shared_ptr<std::atomic<bool>> is_used{
+        std::make_shared<std::atomic<bool>>(false)};
   };
 
+  void Prefetch(const std::vector<std::string>& names);
+  void RefreshNetCache();
+  void StartRefresh(const std::string& name);
+
   template <typename Mutex>
   void MoveQueryToBackground(std::unique_lock<Mutex>& lock, Mutex&& mutex,
                              engine::Future<NetResolver::Response>&& future,
@@ -173,14 +185,17 @@ class Resolver::Impl {
                        FailureMode failure_mode);
 
   LookupSourceCounters source_counters_;
+  CacheCounters cache_counters_;
   FileResolver file_resolver_;
   NetResolver net_resolver_;
   const std::chrono::milliseconds net_cache_update_margin_;
   const std::chrono::milliseconds net_cache_max_reply_ttl_;
   const std::chrono::milliseconds net_cache_failure_ttl_;
+  const std::chrono::milliseconds net_cache_refresh_interval_;
   cache::NWayLRU<std::string, NetCacheEntry> net_cache_;
   concurrent::MutexSet<std::string> net_cache_update_mutexes_;
   utils::impl::WaitTokenStorage wait_token_storage_;
+  utils::PeriodicTask net_cache_refresher_;
 };
 
 Resolver::Impl::Impl(engine::TaskProcessor& fs_task_processor,
@@ -192,16 +207,33 @@ Resolver::Impl::Impl(engine::TaskProcessor& fs_task_processor,
       net_cache_update_margin_{config.network_timeout},
       net_cache_max_reply_ttl_{config.cache_max_reply_ttl},
       net_cache_failure_ttl_{config.cache_failure_ttl},
+      net_cache_refresh_interval_{config.cache_refresh_interval},
       net_cache_{config.cache_ways, config.cache_size_per_way},
-      net_cache_update_mutexes_(config.cache_ways) {}
+      net_cache_update_mutexes_(config.cache_ways) {
+  Prefetch(config.prefetch_names);
+
+  if (net_cache_refresh_interval_.count() > 0) {
+    net_cache_refresher_.Start(
+        "dns-cache-refresh",
+        {net_cache_refresh_interval_, {}, logging::Level::kDebug},
+        [this] { RefreshNetCache(); });
+  }
+}
 
-Resolver::Impl::~Impl() { wait_token_storage_.WaitForAllTokens(); }
+Resolver::Impl::~Impl() {
+  net_cache_refresher_.Stop();
+  wait_token_storage_.WaitForAllTokens();
+}
 
 const Resolver::LookupSourceCounters& Resolver::Impl::GetLookupSourceCounters()
     const {
   return source_counters_;
 }
 
+const Resolver::CacheCounters& Resolver::Impl::GetCacheCounters() const {
+  return cache_counters_;
+}
+
 void Resolver::Impl::ReloadHosts() { file_resolver_.ReloadHosts(); }
 
 void Resolver::Impl::FlushNetworkCache() { net_cache_.Invalidate(); }
@@ -235,6 +267,10 @@ Resolver::Impl::NetCacheResult Resolver::Impl::QueryNetCache(
   }
 
   result.addrs = cached->addrs;
+  // avoid writing to the shared cache line on each hit of a hot name
+  if (!cached->is_used->load(std::memory_order_relaxed)) {
+    cached->is_used->store(true, std::memory_order_relaxed);
+  }
   if (cached->expiration >= now) {
     ++source_counters_.cached;
   } else {
@@ -267,6 +303,7 @@ AddrVector Resolver::Impl::DoForegroundQuery(std::unique_lock<Mutex>& lock,
   UASSERT(lock.mutex() == &mutex);
 
   LOG_TRACE() << "Resolving '" << name << "' in foreground";
+  ++cache_counters_.misses;
   auto future = net_resolver_.Resolve(name);
   auto future_status = future.wait_until(deadline);
   if (future_status != engine::FutureStatus::kReady) {
@@ -285,18 +322,58 @@ AddrVector Resolver::Impl::DoForegroundQuery(std::unique_lock<Mutex>& lock,
 }
 
 template <typename Mutex>
-void Resolver::Impl::StartBackgroundQuery(std::unique_lock<Mutex>& lock,
+bool Resolver::Impl::StartBackgroundQuery(std::unique_lock<Mutex>& lock,
                                           Mutex&& mutex,
                                           const std::string& name) {
   UASSERT(lock.mutex() == &mutex);
   if (!lock && !lock.try_lock()) {
     LOG_TRACE() << "Record for '" << name << "' is already updating, skipping";
-    return;
+    return false;
   }
   LOG_TRACE() << "Updating record for '" << name << "' in background";
   auto future = net_resolver_.Resolve(name);
   MoveQueryToBackground(lock, std::forward<Mutex>(mutex), std::move(future),
                         name, FailureMode::kIgnore);
+  return true;
+}
+
+void Resolver::Impl::Prefetch(const std::vector<std::string>& names) {
+  for (const auto& name : names) {
+    if (ParseNumericAddr(name)) continue;
+    CheckValidDomainName(name);
+    if (IsInDomain(name, "localhost") || IsInDomain(name, "invalid")) continue;
+    if (!file_resolver_.Resolve(name).empty()) continue;
+
+    LOG_DEBUG() << "Prefetching '" << name << '\'';
+    StartRefresh(name);
+  }
+}
+
+void Resolver::Impl::RefreshNetCache() {
+  // The update has to finish before the callers start to update the record
+  // themselves, and the next refresh may come later than in an interval.
+  const auto refresh_margin =
+      2 * (net_cache_update_margin_ + net_cache_refresh_interval_);
+  const auto now = utils::datetime::MockSteadyNow();
+
+  std::vector<std::string> names;
+  net_cache_.VisitAll([&](const std::string& name, const NetCacheEntry& entry) {
+    // the names that were not used since the last update are left to expire
+    if (entry.is_failure || !entry.is_used->load(std::memory_order_relaxed)) {
+      return;
+    }
+    if (entry.expiration - now < refresh_margin) names.push_back(name);
+  });
+
+  for (const auto& name : names) StartRefresh(name);
+}
+
+void Resolver::Impl::StartRefresh(const std::string& name) {
+  auto mutex = GetUpdateMutex(name);
+  std::unique_lock lock{mutex, std::defer_lock};
+  if (StartBackgroundQuery(lock, std::move(mutex), name)) {
+    ++cache_counters_.refreshes;
+  }
 }
 
 template <typename Mutex>
@@ -436,6 +513,10 @@ const Resolver::LookupSourceCounters& Resolver::GetLookupSourceCounters()
   return impl_->GetLookupSourceCounters();
 }
 
+const Resolver::CacheCounters& Resolver::GetCacheCounters() const {
+  return impl_->GetCacheCounters();
+}
+
 void Resolver::ReloadHosts() { impl_->ReloadHosts(); }
 
 void Resolver::FlushNetworkCache() { impl_->FlushNetworkCache(); }
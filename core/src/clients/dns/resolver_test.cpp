@@ -58,7 +58,9 @@ constexpr auto kNetV6String{"2a02:6b8:a::a"};
 struct MockedResolver {
   using ServerMock = utest::DnsServerMock;
 
-  MockedResolver(size_t cache_max_ttl, size_t cache_size_per_way)
+  MockedResolver(size_t cache_max_ttl, size_t cache_size_per_way,
+                 std::vector<std::string> prefetch_names = {},
+                 std::chrono::milliseconds cache_refresh_interval = {})
       : hosts_file{[] {
           auto file = fs::blocking::TempFile::Create();
           fs::blocking::RewriteFileContents(file.GetPath(), kTestHosts);
@@ -88,6 +90,8 @@ struct MockedResolver {
               config.cache_ways = 1;
               config.cache_size_per_way = cache_size_per_way;
               config.network_custom_servers = {server_mock.GetServerAddress()};
+              config.prefetch_names = prefetch_names;
+              config.cache_refresh_interval = cache_refresh_interval;
               return config;
             }()} {}
 
@@ -517,4 +521,61 @@ UTEST(Resolver, FirstUpdateCombines) {
   EXPECT_EQ(counters.network_failure, 1);
 }
 
+UTEST(Resolver, Prefetch) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  MockedResolver resolver{
+      1000, 2, {"prefetched", "mycomputer", "localhost", "127.0.0.1"}};
+
+  const auto& counters = resolver->GetLookupSourceCounters();
+  while (counters.network < 1) engine::SleepFor(std::chrono::milliseconds{1});
+
+  EXPECT_PRED_FORMAT2(CheckAddrs,
+                      resolver->Resolve("prefetched", test_deadline),
+                      (Expected{kNetV6String, kNetV4String}));
+
+  EXPECT_EQ(counters.cached, 1);
+  EXPECT_EQ(counters.network, 1);
+
+  const auto& cache_counters = resolver->GetCacheCounters();
+  EXPECT_EQ(cache_counters.misses, 0);
+  EXPECT_EQ(cache_counters.refreshes, 1);
+}
+
+UTEST(Resolver, RefreshUsedNames) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  utils::datetime::MockNowSet({});
+
+  MockedResolver resolver{1000, 2, {}, std::chrono::milliseconds{10}};
+
+  EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("used", test_deadline),
+                      (Expected{kNetV6String, kNetV4String}));
+  EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("used", test_deadline),
+                      (Expected{kNetV6String, kNetV4String}));
+  EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("unused", test_deadline),
+                      (Expected{kNetV6String, kNetV4String}));
+
+  // closer to expiration than the refresh margin, but not within the update
+  // margin of the lookups
+  utils::datetime::MockSleep(std::chrono::seconds{1000} -
+                             utest::kMaxTestWaitTime * 3 / 2);
+
+  const auto& counters = resolver->GetLookupSourceCounters();
+  while (counters.network < 3) engine::SleepFor(std::chrono::milliseconds{1});
+
+  EXPECT_PRED_FORMAT2(CheckAddrs, resolver->Resolve("used", test_deadline),
+                      (Expected{kNetV6String, kNetV4String}));
+
+  EXPECT_EQ(counters.cached, 2);
+  EXPECT_EQ(counters.cached_stale, 0);
+  EXPECT_EQ(counters.network, 3);
+
+  const auto& cache_counters = resolver->GetCacheCounters();
+  EXPECT_EQ(cache_counters.misses, 2);
+  EXPECT_EQ(cache_counters.refreshes, 1);
+}
+
 USERVER_NAMESPACE_END
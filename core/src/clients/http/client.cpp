@@ -30,6 +30,7 @@ namespace {
 
 const std::string kIoThreadName = "curl";
 const auto kEasyReinitPeriod = std::chrono::minutes{1};
+const std::string kWarmupTaskName = "http_warmup";
 
 // cURL accepts options as long, but we use size_t to avoid writing checks.
 // Clamp too high values to LONG_MAX, it shouldn't matter for these magnitudes.
@@ -37,6 +38,14 @@ long ClampToLong(size_t value) {
   return std::min<size_t>(value, std::numeric_limits<long>::max());
 }
 
+size_t GetWarmConnectionsPerMulti(const WarmupConfig& config) {
+  size_t result = 0;
+  for (const auto& destination : config.destinations) {
+    result += destination.connections;
+  }
+  return result;
+}
+
 const tracing::TracingManagerBase* GetTracingManager(
     const ClientSettings& settings) {
   UASSERT(settings.tracing_manager);
@@ -57,7 +66,9 @@ Client::Client(ClientSettings settings,
       connect_rate_limiter_(std::make_shared<curl::ConnectRateLimiter>()),
       tracing_manager_(GetTracingManager(settings)),
       headers_propagator_(settings.headers_propagator),
-      plugin_pipeline_(std::move(plugin_pipeline)) {
+      plugin_pipeline_(std::move(plugin_pipeline)),
+      wait_for_multiplexing_(settings.http2.wait_for_multiplexing),
+      warmup_config_(std::move(settings.warmup)) {
   const auto io_threads = settings.io_threads;
   const auto& thread_name_prefix = settings.thread_name_prefix;
 
@@ -83,6 +94,15 @@ Client::Client(ClientSettings settings,
     }
   }).Get();
 
+  SetMultiplexingEnabled(settings.http2.multiplexing);
+  for (auto& multi : multis_) {
+    multi->SetMaxConcurrentStreams(
+        ClampToLong(settings.http2.max_concurrent_streams));
+  }
+  if (settings.http2.max_host_connections > 0) {
+    SetMaxHostConnections(settings.http2.max_host_connections);
+  }
+
   easy_reinit_task_.Start("http_easy_reinit",
                           utils::PeriodicTask::Settings(kEasyReinitPeriod),
                           [this] { ReinitEasy(); });
@@ -92,6 +112,8 @@ Client::Client(ClientSettings settings,
 
 Client::~Client() {
   easy_reinit_task_.Stop();
+  if (warmup_initial_task_.IsValid()) warmup_initial_task_.SyncCancel();
+  warmup_task_.Stop();
 
   // We have to destroy *this only when all the requests are finished, because
   // otherwise `multis_` and `thread_pool_` are destroyed and pending requests
@@ -125,26 +147,15 @@ Request Client::CreateRequest() {
           destination_statistics_, resolver_,
           plugin_pipeline_,        *tracing_manager_.GetBase()};
     } else {
-      auto i = utils::RandRange(multis_.size());
-      auto& multi = multis_[i];
-
-      try {
-        auto wrapper = engine::AsyncNoSpan(fs_task_processor_, [this, &multi] {
-                         return impl::EasyWrapper{
-                             easy_.Get()->GetBoundBlocking(*multi), *this};
-                       }).Get();
-        return Request{
-            std::move(wrapper),      statistics_[i].CreateRequestStats(),
-            destination_statistics_, resolver_,
-            plugin_pipeline_,        *tracing_manager_.GetBase()};
-      } catch (engine::WaitInterruptedException&) {
-        throw clients::http::CancelException();
-      } catch (engine::TaskCancelledException&) {
-        throw clients::http::CancelException();
-      }
+      return CreateBoundRequest(utils::RandRange(multis_.size()));
     }
   }();
 
+  SetupRequest(request);
+  return request;
+}
+
+void Client::SetupRequest(Request& request) {
   if (testsuite_config_) {
     request.SetTestsuiteConfig(testsuite_config_);
   }
@@ -165,8 +176,74 @@ Request Client::CreateRequest() {
   }
   request.SetDeadlinePropagationConfig(deadline_propagation_config_);
   request.SetCancellationPolicy(cancellation_policy_);
+  if (wait_for_multiplexing_) request.wait_for_multiplexing();
+}
 
-  return request;
+Request Client::CreateBoundRequest(size_t multi_index) {
+  UASSERT(multi_index < multis_.size());
+  auto& multi = multis_[multi_index];
+
+  try {
+    auto wrapper = engine::AsyncNoSpan(fs_task_processor_, [this, &multi] {
+                     return impl::EasyWrapper{
+                         easy_.Get()->GetBoundBlocking(*multi), *this};
+                   }).Get();
+    return Request{std::move(wrapper),
+                   statistics_[multi_index].CreateRequestStats(),
+                   destination_statistics_,
+                   resolver_,
+                   plugin_pipeline_,
+                   *tracing_manager_.GetBase()};
+  } catch (engine::WaitInterruptedException&) {
+    throw clients::http::CancelException();
+  } catch (engine::TaskCancelledException&) {
+    throw clients::http::CancelException();
+  }
+}
+
+void Client::StartWarmup() {
+  if (warmup_config_.destinations.empty()) return;
+
+  // Service start must not wait for the remote destinations
+  warmup_initial_task_ =
+      utils::CriticalAsync(kWarmupTaskName, [this] { WarmUp(); });
+  if (warmup_config_.keepalive_period.count() > 0) {
+    warmup_task_.Start(
+        kWarmupTaskName,
+        utils::PeriodicTask::Settings(warmup_config_.keepalive_period),
+        [this] { WarmUp(); });
+  }
+}
+
+void Client::WaitForWarmup() {
+  if (warmup_initial_task_.IsValid()) warmup_initial_task_.Wait();
+}
+
+void Client::WarmUp() {
+  // Concurrent requests take different connections, so that each of them is
+  // either refreshed or reopened. Without retries the whole warmup takes at
+  // most one warmup timeout.
+  std::vector<ResponseFuture> futures;
+  for (size_t i = 0; i < multis_.size(); ++i) {
+    for (const auto& destination : warmup_config_.destinations) {
+      for (size_t j = 0; j < destination.connections; ++j) {
+        auto request = CreateBoundRequest(i);
+        SetupRequest(request);
+        request.head(destination.url)
+            .retry(1)
+            .timeout(warmup_config_.timeout);
+        futures.push_back(request.async_perform());
+      }
+    }
+  }
+
+  for (auto& future : futures) {
+    try {
+      future.Get();
+    } catch (const std::exception& e) {
+      LOG_LIMITED_WARNING() << "Failed to warm up a connection: " << e;
+    }
+  }
 }
 
 void Client::SetMultiplexingEnabled(bool enabled) {
@@ -270,8 +347,11 @@ void Client::SetConfig(const impl::Config& config) {
                 << config.connection_pool_size << "/" << multis_.size()
                 << " rounded to " << pool_size << ")";
   }
+  // The warm connections must not push each other out of the cache
+  const auto cache_size =
+      pool_size + ClampToLong(GetWarmConnectionsPerMulti(warmup_config_));
   for (auto& multi : multis_) {
-    multi->SetConnectionCacheSize(pool_size);
+    multi->SetConnectionCacheSize(cache_size);
   }
 
   connect_rate_limiter_->SetGlobalHttpLimits(config.throttle.http_connect_limit,
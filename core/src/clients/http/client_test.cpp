@@ -612,6 +612,28 @@ UTEST(HttpClient, PostEcho) {
   }
 }
 
+UTEST(HttpClient, WaitForMultiplexing) {
+  EchoCallback cb;
+  const utest::SimpleServer http_server{cb};
+  auto http_client_ptr = utest::CreateHttpClient();
+
+  // HTTP/1.1 requests must not wait for each other's connections
+  std::vector<clients::http::ResponseFuture> responses;
+  for (unsigned i = 0; i < kFewRepetitions; ++i) {
+    responses.push_back(http_client_ptr->CreateRequest()
+                            .post(http_server.GetBaseUrl(), kTestData)
+                            .retry(1)
+                            .wait_for_multiplexing()
+                            .timeout(kTimeout)
+                            .async_perform());
+  }
+
+  for (auto& response : responses) {
+    EXPECT_EQ(response.Get()->body(), kTestData);
+  }
+  EXPECT_EQ(*cb.responses_200, kFewRepetitions);
+}
+
 UTEST(HttpClient, StatsOnTimeout) {
   const int kRetries = 5;
   const utest::SimpleServer http_server{&sleep_callback};
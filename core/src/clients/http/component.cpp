@@ -174,6 +174,11 @@ HttpClient::~HttpClient() {
 
 clients::http::Client& HttpClient::GetHttpClient() { return http_client_; }
 
+void HttpClient::OnAllComponentsLoaded() {
+  // after the dynamic config is applied, without delaying the service start
+  http_client_.StartWarmup();
+}
+
 void HttpClient::OnConfigUpdate(const dynamic_config::Snapshot& config) {
   http_client_.SetConfig(config[kClientConfig]);
 }
@@ -262,6 +267,57 @@ properties:
         enum:
           - cancel
           - ignore
+    warmup:
+        type: object
+        description: connections to open on start and to keep alive
+        additionalProperties: false
+        properties:
+            destinations:
+                type: array
+                description: destinations to connect to
+                items:
+                    type: object
+                    description: destination
+                    additionalProperties: false
+                    properties:
+                        url:
+                            type: string
+                            description: URL of a cheap endpoint, that is requested with HEAD to open a connection
+                        connections:
+                            type: integer
+                            description: number of connections to keep open in each IO thread
+                            defaultDescription: 1
+                            minimum: 1
+            timeout:
+                type: string
+                description: timeout of a warmup request
+                defaultDescription: 1s
+            keepalive-period:
+                type: string
+                description: period of re-requesting the destinations, so that the idle connections are not closed; 0 disables it
+                defaultDescription: 0
+    http2:
+        type: object
+        description: HTTP/2 connection sharing policy
+        additionalProperties: false
+        properties:
+            multiplexing:
+                type: boolean
+                description: allow the requests to the same host to share an HTTP/2 connection
+                defaultDescription: true
+            wait-for-multiplexing:
+                type: boolean
+                description: new requests wait for a connection that is being established to the same host instead of opening another one
+                defaultDescription: false
+            max-concurrent-streams:
+                type: integer
+                description: max streams per HTTP/2 connection, a new connection is opened when all of them are busy
+                defaultDescription: 100
+                minimum: 1
+            max-host-connections:
+                type: integer
+                description: max connections to a single host in each IO thread, for any HTTP version; the requests wait for a free connection when it is reached; 0 means no limit
+                defaultDescription: 0
 )");
 }
 
@@ -47,6 +47,41 @@ CancellationPolicy Parse(yaml_config::YamlConfig value,
   throw std::runtime_error("Invalid CancellationPolicy value: " + str);
 }
 
+WarmupDestination Parse(const yaml_config::YamlConfig& value,
+                        formats::parse::To<WarmupDestination>) {
+  WarmupDestination result;
+  result.url = value["url"].As<std::string>();
+  result.connections = value["connections"].As<size_t>(result.connections);
+  return result;
+}
+
+WarmupConfig Parse(const yaml_config::YamlConfig& value,
+                   formats::parse::To<WarmupConfig>) {
+  WarmupConfig result;
+  result.destinations =
+      value["destinations"].As<std::vector<WarmupDestination>>(
+          result.destinations);
+  result.timeout =
+      value["timeout"].As<std::chrono::milliseconds>(result.timeout);
+  result.keepalive_period =
+      value["keepalive-period"].As<std::chrono::milliseconds>(
+          result.keepalive_period);
+  return result;
+}
+
+Http2Config Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<Http2Config>) {
+  Http2Config result;
+  result.multiplexing = value["multiplexing"].As<bool>(result.multiplexing);
+  result.wait_for_multiplexing =
+      value["wait-for-multiplexing"].As<bool>(result.wait_for_multiplexing);
+  result.max_concurrent_streams = value["max-concurrent-streams"].As<size_t>(
+      result.max_concurrent_streams);
+  result.max_host_connections =
+      value["max-host-connections"].As<size_t>(result.max_host_connections);
+  return result;
+}
+
 ClientSettings Parse(const yaml_config::YamlConfig& value,
                      formats::parse::To<ClientSettings>) {
   ClientSettings result;
@@ -55,6 +90,8 @@ ClientSettings Parse(const yaml_config::YamlConfig& value,
   result.io_threads = value["threads"].As<size_t>(result.io_threads);
   result.defer_events = value["defer-events"].As<bool>(result.defer_events);
   result.deadline_propagation = ParseDeadlinePropagationConfig(value);
+  result.warmup = value["warmup"].As<WarmupConfig>(result.warmup);
+  result.http2 = value["http2"].As<Http2Config>(result.http2);
   return result;
 }
 
@@ -1,10 +1,16 @@
 #include <clients/http/destination_statistics.hpp>
 
+#include <atomic>
+#include <mutex>
 #include <unordered_set>
+#include <userver/engine/mutex.hpp>
 #include <userver/engine/sleep.hpp>
 
 #include <userver/clients/http/client.hpp>
+#include <userver/clients/http/config.hpp>
+#include <userver/tracing/manager.hpp>
 #include <userver/utest/http_client.hpp>
+#include <userver/utest/http_server_mock.hpp>
 #include <userver/utest/simple_server.hpp>
 #include <userver/utest/utest.hpp>
 
@@ -134,4 +140,54 @@ UTEST(DestinationStatistics, Multiple) {
   }
 }
 
+UTEST(DestinationStatistics, WarmConnections) {
+  std::atomic<int> head_requests{0};
+  engine::Mutex warmup_gate;
+  std::unique_lock warmup_lock{warmup_gate};
+  const utest::HttpServerMock http_server{
+      [&](const utest::HttpServerMock::HttpRequest& request) {
+        if (request.method == clients::http::HttpMethod::kHead) {
+          // Holds the warmup until the test releases the gate
+          const std::lock_guard lock{warmup_gate};
+          ++head_requests;
+        }
+        return utest::HttpServerMock::HttpResponse{200, {}, {}};
+      }};
+  const auto url = http_server.GetBaseUrl();
+
+  const tracing::GenericTracingManager tracing_manager{
+      tracing::Format::kYandexTaxi, tracing::Format::kYandexTaxi};
+  clients::http::ClientSettings settings;
+  settings.io_threads = 1;
+  settings.tracing_manager = &tracing_manager;
+  settings.warmup.destinations = {{url, 2}};
+  settings.warmup.timeout = utest::kMaxTestWaitTime;
+  clients::http::Client client{
+      std::move(settings), engine::current_task::GetTaskProcessor(),
+      std::vector<utils::NotNull<clients::http::Plugin*>>{}};
+
+  // Does not wait for the destination
+  client.StartWarmup();
+  EXPECT_EQ(head_requests, 0);
+
+  warmup_lock.unlock();
+  client.WaitForWarmup();
+  EXPECT_EQ(head_requests, 2);
+  EXPECT_EQ(http_server.GetConnectionsOpenedCount(), 2);
+
+  auto response = client.CreateRequest()
+                      .get(url)
+                      .retry(1)
+                      .timeout(utest::kMaxTestWaitTime)
+                      .perform();
+  EXPECT_EQ(response->status_code(), 200);
+  EXPECT_EQ(http_server.GetConnectionsOpenedCount(), 2);
+
+  const auto pool_stats = client.GetPoolStatistics();
+  ASSERT_EQ(pool_stats.multi.size(), 1);
+  const auto& stats = pool_stats.multi[0];
+  EXPECT_EQ(stats.connections_created, utils::statistics::Rate{2});
+  EXPECT_EQ(stats.connections_reused, utils::statistics::Rate{1});
+}
+
 USERVER_NAMESPACE_END
@@ -326,6 +326,14 @@ Request Request::http_version(HttpVersion version) && {
   return std::move(this->http_version(version));
 }
 
+Request& Request::wait_for_multiplexing(bool wait) & {
+  pimpl_->wait_for_multiplexing(wait);
+  return *this;
+}
+Request Request::wait_for_multiplexing(bool wait) && {
+  return std::move(this->wait_for_multiplexing(wait));
+}
+
 Request& Request::retry(short retries, bool on_fails) & {
   UASSERT_MSG(retries >= 0, "retires < 0 (" + std::to_string(retries) +
                                 "), uninitialized variable?");
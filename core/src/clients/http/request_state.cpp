@@ -325,6 +325,10 @@ void RequestState::http_version(curl::easy::http_version_t version) {
   easy().set_http_version(version);
 }
 
+void RequestState::wait_for_multiplexing(bool wait) {
+  easy().set_pipewait(wait);
+}
+
 void RequestState::set_timeout(long timeout_ms) {
   original_timeout_ = std::chrono::milliseconds{timeout_ms};
   remote_timeout_ = original_timeout_;
@@ -476,6 +480,7 @@ void RequestState::on_completed(std::shared_ptr<RequestState> holder,
   const auto sockets = easy.get_num_connects();
   holder->WithRequestStats(
       [sockets](RequestStats& stats) { stats.AccountOpenSockets(sockets); });
+  holder->AccountConnection(sockets, err);
 
   span.AddTag(tracing::kAttempts, holder->retry_.current);
   if (holder->deadline_propagation_config_.update_header) {
@@ -899,6 +904,34 @@ void RequestState::AccountResponse(std::error_code err) {
   });
 }
 
+void RequestState::AccountConnection(long new_connections,
+                                     std::error_code err) {
+  if (!err && easy().get_http_version() == curl::easy::http_version_2_0) {
+    WithRequestStats([new_connections](RequestStats& stats) {
+      stats.AccountHttp2Stream(new_connections > 0);
+    });
+  }
+
+  if (new_connections == 0) {
+    // a failed request might have not reached the connection phase at all
+    if (!err) {
+      WithRequestStats(
+          [](RequestStats& stats) { stats.AccountReusedConnection(); });
+    }
+    return;
+  }
+
+  // curl reports the times since the start of the transfer, the TLS handshake
+  // time is 0 for plain HTTP
+  const auto connected_at = std::max(easy().get_appconnect_time_usec(),
+                                     easy().get_connect_time_usec());
+  const auto handshake_time = std::chrono::microseconds{
+      std::max(connected_at - easy().get_namelookup_time_usec(), 0L)};
+  WithRequestStats([handshake_time](RequestStats& stats) {
+    stats.AccountNewConnection(handshake_time);
+  });
+}
+
 std::exception_ptr RequestState::PrepareException(std::error_code err) {
   if (deadline_expired_) {
     return PrepareDeadlinePassedException(easy().get_effective_url(),
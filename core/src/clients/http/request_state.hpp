@@ -77,6 +77,8 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
   void client_key_cert(crypto::PrivateKey pkey, crypto::Certificate cert);
   /// Set HTTP version
   void http_version(curl::easy::http_version_t version);
+  /// Wait for a multiplexed connection instead of opening a new one
+  void wait_for_multiplexing(bool wait);
   /// set timeout value
   void set_timeout(long timeout_ms);
   /// set number of retries
@@ -172,6 +174,7 @@ class RequestState : public std::enable_shared_from_this<RequestState> {
                                     void* userdata);
 
   void AccountResponse(std::error_code err);
+  void AccountConnection(long new_connections, std::error_code err);
   std::exception_ptr PrepareException(std::error_code err);
 
   void ResetDataForNewRequest();
@@ -77,6 +77,27 @@ void RequestStats::AccountOpenSockets(size_t sockets) noexcept {
   stats_->socket_open_ += utils::statistics::Rate{sockets};
 }
 
+void RequestStats::AccountReusedConnection() noexcept {
+  UASSERT(stats_);
+  ++stats_->connections_reused_;
+}
+
+void RequestStats::AccountNewConnection(
+    std::chrono::microseconds handshake_time) noexcept {
+  UASSERT(stats_);
+  ++stats_->connections_created_;
+  const auto ms =
+      std::chrono::duration_cast<std::chrono::milliseconds>(handshake_time);
+  stats_->handshake_timings_percentile_.GetCurrentCounter().Account(
+      ms.count());
+}
+
+void RequestStats::AccountHttp2Stream(bool new_connection) noexcept {
+  UASSERT(stats_);
+  ++stats_->http2_streams_;
+  if (new_connection) ++stats_->http2_connections_;
+}
+
 void RequestStats::AccountTimeoutUpdatedByDeadline() noexcept {
   UASSERT(stats_);
   ++stats_->timeout_updated_by_deadline_;
@@ -178,6 +199,15 @@ void DumpMetric(utils::statistics::Writer& writer,
   writer["cancelled-by-deadline"] = stats.cancelled_by_deadline;
 
   writer["sockets"]["open"] = stats.multi.socket_open;
+
+  writer["connections"]["reused"] = stats.connections_reused;
+  writer["connections"]["created"] = stats.connections_created;
+  writer["connections"]["handshake-timings"] =
+      stats.handshake_timings_percentile;
+
+  // streams / connections is the average number of streams per connection
+  writer["http2"]["streams"] = stats.http2_streams;
+  writer["http2"]["connections"] = stats.http2_connections;
 }
 
 void DumpMetric(utils::statistics::Writer& writer,
@@ -216,7 +246,13 @@ InstanceStatistics::InstanceStatistics(const Statistics& other)
       retries(other.retries_.Load()),
       timeout_updated_by_deadline(other.timeout_updated_by_deadline_.Load()),
       cancelled_by_deadline(other.cancelled_by_deadline_.Load()),
-      reply_status(other.reply_status_) {
+      reply_status(other.reply_status_),
+      connections_reused(other.connections_reused_.Load()),
+      connections_created(other.connections_created_.Load()),
+      handshake_timings_percentile(
+          other.handshake_timings_percentile_.GetStatsForPeriod()),
+      http2_streams(other.http2_streams_.Load()),
+      http2_connections(other.http2_connections_.Load()) {
   for (size_t i = 0; i < error_count.size(); i++)
     error_count[i] = other.error_count_[i].Load();
   multi.socket_open = other.socket_open_.Load();
@@ -252,6 +288,12 @@ InstanceStatistics& InstanceStatistics::operator+=(
   cancelled_by_deadline += stat.cancelled_by_deadline;
   reply_status += stat.reply_status;
 
+  connections_reused += stat.connections_reused;
+  connections_created += stat.connections_created;
+  handshake_timings_percentile.Add(stat.handshake_timings_percentile);
+  http2_streams += stat.http2_streams;
+  http2_connections += stat.http2_connections;
+
   multi += stat.multi;
   return *this;
 }
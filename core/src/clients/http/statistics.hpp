@@ -38,6 +38,10 @@ class RequestStats final {
 
   void AccountOpenSockets(size_t sockets) noexcept;
 
+  void AccountReusedConnection() noexcept;
+  void AccountNewConnection(std::chrono::microseconds handshake_time) noexcept;
+  void AccountHttp2Stream(bool new_connection) noexcept;
+
   void AccountTimeoutUpdatedByDeadline() noexcept;
   void AccountCancelledByDeadline() noexcept;
 
@@ -68,6 +72,12 @@ using Percentile =
                                   /*extra_buckets=*/1180,
                                   /*extra_bucket_size=*/100>;
 
+// TCP and TLS handshake timings in ms, up to 10.5 seconds
+using HandshakePercentile =
+    utils::statistics::Percentile</*buckets =*/500, unsigned int,
+                                  /*extra_buckets=*/100,
+                                  /*extra_bucket_size=*/100>;
+
 class Statistics {
  public:
   Statistics() = default;
@@ -108,6 +118,13 @@ class Statistics {
   utils::statistics::RateCounter timeout_updated_by_deadline_;
   utils::statistics::RateCounter cancelled_by_deadline_;
   utils::statistics::HttpCodes reply_status_;
+  utils::statistics::RateCounter connections_reused_;
+  utils::statistics::RateCounter connections_created_;
+  utils::statistics::RecentPeriod<HandshakePercentile, HandshakePercentile,
+                                  utils::datetime::SteadyClock>
+      handshake_timings_percentile_;
+  utils::statistics::RateCounter http2_streams_;
+  utils::statistics::RateCounter http2_connections_;
 
   friend struct InstanceStatistics;
   friend class RequestStats;
@@ -136,6 +153,12 @@ struct InstanceStatistics {
   utils::statistics::Rate cancelled_by_deadline;
   utils::statistics::HttpCodes::Snapshot reply_status;
 
+  utils::statistics::Rate connections_reused;
+  utils::statistics::Rate connections_created;
+  HandshakePercentile handshake_timings_percentile;
+  utils::statistics::Rate http2_streams;
+  utils::statistics::Rate http2_connections;
+
   MultiStats multi;
 };
 
@@ -1,5 +1,6 @@
 #include <components/manager.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <future>
 #include <set>
@@ -95,6 +96,18 @@ void ValidateConfigs(const components::ComponentList& component_list,
   }
 }
 
+engine::coro::PoolConfig MakeCoroPoolConfig(
+    const components::ManagerConfig& config) {
+  auto coro_pool_config = config.coro_pool;
+  for (const auto& processor_config : config.task_processors) {
+    if (processor_config.numa_node) {
+      coro_pool_config.numa_nodes = std::max(coro_pool_config.numa_nodes,
+                                             *processor_config.numa_node + 1);
+    }
+  }
+  return coro_pool_config;
+}
+
 }  // namespace
 
 namespace components {
@@ -135,7 +148,7 @@ Manager::Manager(std::unique_ptr<ManagerConfig>&& config,
     : config_(std::move(config)),
       task_processors_storage_(
           std::make_shared<engine::impl::TaskProcessorPools>(
-              config_->coro_pool, config_->event_thread_pool)),
+              MakeCoroPoolConfig(*config_), config_->event_thread_pool)),
       start_time_(std::chrono::steady_clock::now()) {
   LOG_INFO() << "Starting components manager";
 
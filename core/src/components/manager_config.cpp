@@ -125,6 +125,42 @@ properties:
                 description: >
                     Whether to defer timer events to a per-thread periodic timer
                     or notify ev-loop right away
+            cpu-set:
+                type: string
+                description: |
+                    list of CPUs to bind the event threads to, in the
+                    Linux cpulist format, e.g. "0-3,8"
+                defaultDescription: no binding
+            io_uring:
+                type: object
+                description: |
+                    io_uring backend for file I/O, one ring per event
+                    thread. Falls back to the fs task processor if the
+                    kernel does not support io_uring
+                additionalProperties: false
+                properties:
+                    enabled:
+                        type: boolean
+                        description: whether to use io_uring
+                        defaultDescription: false
+                    queue_depth:
+                        type: integer
+                        description: submission queue size of each ring
+                        defaultDescription: 256
+                        minimum: 1
+                    registered_buffers:
+                        type: integer
+                        description: |
+                            number of buffers registered in each ring for
+                            file reads
+                        defaultDescription: 0
+                        minimum: 0
+                        maximum: 64
+                    registered_buffer_size:
+                        type: integer
+                        description: size of a registered buffer in bytes
+                        defaultDescription: 65536
+                        minimum: 1
     components:
         type: object
         description: 'dictionary of "component name": "options"'
@@ -166,6 +202,31 @@ properties:
                         tunes the number of spin-wait iterations in case of
                         an empty task queue before threads go to sleep
                     defaultDescription: 10000
+                task-processor-queue:
+                    type: string
+                    description: |
+                        task queue implementation. `work-stealing-task-queue`
+                        gives each worker thread a local queue and a slot for
+                        the most recently woken task, idle workers steal tasks
+                        from the busy ones
+                    defaultDescription: global-task-queue
+                    enum:
+                      - global-task-queue
+                      - work-stealing-task-queue
+                cpu-set:
+                    type: string
+                    description: |
+                        list of CPUs to bind the worker threads to, in the
+                        Linux cpulist format, e.g. "0-3,8"
+                    defaultDescription: no binding
+                numa-node:
+                    type: integer
+                    description: |
+                        NUMA node to bind the worker threads to; combined with
+                        cpu-set, the threads are bound to the CPUs of the node
+                        from the cpu-set. Idle coroutine stacks are reused
+                        within the node
+                    defaultDescription: no binding
                 task-trace:
                     type: object
                     description: .
@@ -49,6 +49,13 @@ void DumpMetric(utils::statistics::Writer& writer,
   }
 
   writer["worker-threads"] = task_processor.GetWorkerCount();
+
+  if (!task_processor.GetWorkerCpus().empty()) {
+    writer["worker-cpus"] = task_processor.GetWorkerCpus().size();
+  }
+  if (const auto numa_node = task_processor.GetNumaNode()) {
+    writer["numa-node"] = *numa_node;
+  }
 }
 
 }  // namespace engine
@@ -108,10 +115,20 @@ void ManagerControllerComponent::WriteStatistics(
   // coroutines
   if (auto coro_pool = writer["coro-pool"]) {
     if (auto coro_stats = coro_pool["coroutines"]) {
-      auto stats =
-          components_manager_.GetTaskProcessorPools()->GetCoroPool().GetStats();
+      const auto& coro_pool_ref =
+          components_manager_.GetTaskProcessorPools()->GetCoroPool();
+      auto stats = coro_pool_ref.GetStats();
       coro_stats["active"] = stats.active_coroutines;
       coro_stats["total"] = stats.total_coroutines;
+
+      const auto numa_nodes = coro_pool_ref.GetNumaNodesCount();
+      if (numa_nodes > 1) {
+        for (std::size_t node = 0; node < numa_nodes; ++node) {
+          coro_stats["idle"].ValueWithLabels(
+              coro_pool_ref.GetIdleCoroutinesApprox(node),
+              {{"numa_node", std::to_string(node)}});
+        }
+      }
     }
   }
 
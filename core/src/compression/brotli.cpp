@@ -0,0 +1,93 @@
+#include <compression/brotli.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+#include <brotli/decode.h>
+#include <brotli/encode.h>
+#include <fmt/format.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression::brotli {
+
+namespace {
+
+// A guess for "small" data chunk, the buffer grows exponentially after that
+constexpr std::size_t kDecompressBufferSize = 1024;
+
+struct DecoderDeleter final {
+  void operator()(BrotliDecoderState* state) const noexcept {
+    BrotliDecoderDestroyInstance(state);
+  }
+};
+
+}  // namespace
+
+std::string Decompress(std::string_view compressed, std::size_t max_size) {
+  const std::unique_ptr<BrotliDecoderState, DecoderDeleter> state{
+      BrotliDecoderCreateInstance(nullptr, nullptr, nullptr)};
+  if (!state) throw std::bad_alloc();
+
+  const auto* next_in = reinterpret_cast<const std::uint8_t*>(compressed.data());
+  std::size_t available_in = compressed.size();
+  std::string decompressed;
+
+  while (true) {
+    const auto old_size = decompressed.size();
+    // One extra byte to detect an overflow of max_size
+    const auto chunk_size = std::min(std::max(old_size, kDecompressBufferSize),
+                                     max_size - old_size + 1);
+    decompressed.resize(old_size + chunk_size);
+
+    auto* next_out = reinterpret_cast<std::uint8_t*>(decompressed.data()) +
+                     old_size;
+    std::size_t available_out = chunk_size;
+    const auto result = BrotliDecoderDecompressStream(
+        state.get(), &available_in, &next_in, &available_out, &next_out,
+        nullptr);
+
+    decompressed.resize(old_size + chunk_size - available_out);
+    if (decompressed.size() > max_size) throw TooBigError();
+
+    switch (result) {
+      case BROTLI_DECODER_RESULT_SUCCESS:
+        if (available_in != 0) {
+          throw DecompressionError(
+              "failed to decompress brotli data: trailing garbage");
+        }
+        return decompressed;
+      case BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT:
+        break;
+      case BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT:
+        throw DecompressionError("failed to decompress brotli data: truncated");
+      case BROTLI_DECODER_RESULT_ERROR:
+        throw DecompressionError(fmt::format(
+            "failed to decompress brotli data: {}",
+            BrotliDecoderErrorString(BrotliDecoderGetErrorCode(state.get()))));
+    }
+  }
+}
+
+std::string Compress(std::string_view data, int quality) {
+  std::size_t compressed_size = BrotliEncoderMaxCompressedSize(data.size());
+  if (compressed_size == 0) {
+    throw CompressionError("failed to compress brotli data: too big");
+  }
+
+  std::string compressed(compressed_size, '\0');
+  if (!BrotliEncoderCompress(
+          quality, BROTLI_DEFAULT_WINDOW, BROTLI_MODE_GENERIC, data.size(),
+          reinterpret_cast<const std::uint8_t*>(data.data()), &compressed_size,
+          reinterpret_cast<std::uint8_t*>(compressed.data()))) {
+    throw CompressionError("failed to compress brotli data");
+  }
+  compressed.resize(compressed_size);
+  return compressed;
+}
+
+}  // namespace compression::brotli
+
+USERVER_NAMESPACE_END
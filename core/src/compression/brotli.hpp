@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include <compression/error.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression::brotli {
+
+/// Compression quality that is fast enough to compress the data on the fly
+inline constexpr int kDefaultQuality = 4;
+
+/// Decompresses the string.
+/// @throws DecompressionError
+std::string Decompress(std::string_view compressed, std::size_t max_size);
+
+/// Compresses the string
+/// @throws CompressionError
+std::string Compress(std::string_view data, int quality = kDefaultQuality);
+
+}  // namespace compression::brotli
+
+USERVER_NAMESPACE_END
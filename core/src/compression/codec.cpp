@@ -0,0 +1,155 @@
+#include <compression/codec.hpp>
+
+#include <userver/utils/assert.hpp>
+#include <userver/utils/str_icase.hpp>
+#include <userver/utils/text_light.hpp>
+
+#include <compression/brotli.hpp>
+#include <compression/gzip.hpp>
+#include <compression/zstd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression {
+
+namespace {
+
+// q-values are compared in thousandths
+constexpr int kMaxQValue = 1000;
+
+std::string_view TrimView(std::string_view str) {
+  while (!str.empty() && utils::text::IsAsciiSpace(str.front())) {
+    str.remove_prefix(1);
+  }
+  while (!str.empty() && utils::text::IsAsciiSpace(str.back())) {
+    str.remove_suffix(1);
+  }
+  return str;
+}
+
+// qvalue = ( "0" [ "." 0*3DIGIT ] ) / ( "1" [ "." 0*3("0") ] )
+std::optional<int> ParseQValue(std::string_view value) {
+  if (value.empty() || (value[0] != '0' && value[0] != '1')) return {};
+  int result = (value[0] - '0') * kMaxQValue;
+  value.remove_prefix(1);
+  if (value.empty()) return result;
+
+  if (value[0] != '.' || value.size() > 4) return {};
+  value.remove_prefix(1);
+  int multiplier = kMaxQValue / 10;
+  for (const char c : value) {
+    if (c < '0' || c > '9') return {};
+    result += (c - '0') * multiplier;
+    multiplier /= 10;
+  }
+  if (result > kMaxQValue) return {};
+  return result;
+}
+
+struct AcceptedCoding final {
+  std::string_view coding;
+  int q_value{kMaxQValue};
+};
+
+std::optional<AcceptedCoding> ParseAcceptedCoding(std::string_view element) {
+  AcceptedCoding result;
+  const auto params_pos = element.find(';');
+  result.coding = TrimView(element.substr(0, params_pos));
+  if (result.coding.empty()) return {};
+
+  if (params_pos != std::string_view::npos) {
+    const auto param = TrimView(element.substr(params_pos + 1));
+    if (param.size() < 2 || (param[0] != 'q' && param[0] != 'Q') ||
+        param[1] != '=') {
+      return {};
+    }
+    const auto q_value = ParseQValue(TrimView(param.substr(2)));
+    if (!q_value) return {};
+    result.q_value = *q_value;
+  }
+  return result;
+}
+
+}  // namespace
+
+std::optional<Codec> ParseContentEncoding(std::string_view content_encoding) {
+  const utils::StrIcaseEqual equal;
+  if (equal(content_encoding, "gzip") || equal(content_encoding, "x-gzip")) {
+    return Codec::kGzip;
+  }
+  if (equal(content_encoding, "zstd")) return Codec::kZstd;
+  if (equal(content_encoding, "br")) return Codec::kBrotli;
+  return {};
+}
+
+std::string_view ToContentEncoding(Codec codec) {
+  switch (codec) {
+    case Codec::kGzip:
+      return "gzip";
+    case Codec::kZstd:
+      return "zstd";
+    case Codec::kBrotli:
+      return "br";
+  }
+  UINVARIANT(false, "Unexpected compression codec");
+}
+
+std::string Decompress(Codec codec, std::string_view compressed,
+                       std::size_t max_size) {
+  switch (codec) {
+    case Codec::kGzip:
+      return gzip::Decompress(compressed, max_size);
+    case Codec::kZstd:
+      return zstd::Decompress(compressed, max_size);
+    case Codec::kBrotli:
+      return brotli::Decompress(compressed, max_size);
+  }
+  UINVARIANT(false, "Unexpected compression codec");
+}
+
+std::string Compress(Codec codec, std::string_view data) {
+  switch (codec) {
+    case Codec::kGzip:
+      return gzip::Compress(data);
+    case Codec::kZstd:
+      return zstd::Compress(data);
+    case Codec::kBrotli:
+      return brotli::Compress(data);
+  }
+  UINVARIANT(false, "Unexpected compression codec");
+}
+
+std::optional<Codec> NegotiateCodec(std::string_view accept_encoding,
+                                    utils::span<const Codec> supported) {
+  std::array<std::optional<int>, kCodecs.size()> q_values{};
+  std::optional<int> wildcard_q_value;
+
+  for (const auto element :
+       utils::text::SplitIntoStringViewVector(accept_encoding, ",")) {
+    const auto accepted = ParseAcceptedCoding(element);
+    if (!accepted) continue;
+
+    if (accepted->coding == "*") {
+      wildcard_q_value = accepted->q_value;
+    } else if (const auto codec = ParseContentEncoding(accepted->coding)) {
+      q_values[static_cast<std::size_t>(*codec)] = accepted->q_value;
+    }
+  }
+
+  std::optional<Codec> best_codec;
+  int best_q_value = 0;
+  for (const auto codec : supported) {
+    // "*" matches any coding that is not explicitly listed
+    const auto q_value = q_values[static_cast<std::size_t>(codec)]
+                             .value_or(wildcard_q_value.value_or(0));
+    if (q_value > best_q_value) {
+      best_codec = codec;
+      best_q_value = q_value;
+    }
+  }
+  return best_codec;
+}
+
+}  // namespace compression
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <compression/error.hpp>
+#include <userver/utils/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression {
+
+/// HTTP content codings, see RFC 9110, 8.4.1
+enum class Codec {
+  kGzip,
+  kZstd,
+  kBrotli,
+};
+
+/// All the codecs, in the order of preference for compressing the responses
+inline constexpr std::array kCodecs{Codec::kZstd, Codec::kBrotli, Codec::kGzip};
+
+/// @returns the codec for the `Content-Encoding` header value, or `nullopt`
+/// if the coding is not supported
+std::optional<Codec> ParseContentEncoding(std::string_view content_encoding);
+
+/// @returns the `Content-Encoding` header value for the codec
+std::string_view ToContentEncoding(Codec codec);
+
+/// Decompresses the string with the codec's default settings.
+/// @throws DecompressionError
+std::string Decompress(Codec codec, std::string_view compressed,
+                       std::size_t max_size);
+
+/// Compresses the string with the codec's default settings, which are fast
+/// enough to compress the data on the fly.
+/// @throws CompressionError
+std::string Compress(Codec codec, std::string_view data);
+
+/// @brief Chooses the codec for a response by the `Accept-Encoding` request
+/// header, see RFC 9110, 12.5.3.
+///
+/// The codec with the highest q-value wins, the ties are resolved by the
+/// order of `supported`.
+/// @returns `nullopt` if the response should not be compressed
+std::optional<Codec> NegotiateCodec(std::string_view accept_encoding,
+                                    utils::span<const Codec> supported);
+
+}  // namespace compression
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,120 @@
+#include <compression/codec.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <compression/brotli.hpp>
+#include <compression/gzip.hpp>
+#include <compression/zstd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::string SampleData(std::size_t size) {
+  std::string data;
+  for (std::size_t i = 0; data.size() < size; ++i) {
+    data += "{\"id\":" + std::to_string(i) + ",\"name\":\"item\"},";
+  }
+  data.resize(size);
+  return data;
+}
+
+}  // namespace
+
+TEST(Compression, RoundTrip) {
+  for (const auto codec : compression::kCodecs) {
+    for (const std::size_t size : {0, 1, 1000, 1024, 100'000}) {
+      const auto data = SampleData(size);
+      const auto compressed = compression::Compress(codec, data);
+      EXPECT_EQ(compression::Decompress(codec, compressed, size), data)
+          << compression::ToContentEncoding(codec) << ' ' << size;
+    }
+  }
+}
+
+TEST(Compression, TooBig) {
+  const auto data = SampleData(100'000);
+  for (const auto codec : compression::kCodecs) {
+    const auto compressed = compression::Compress(codec, data);
+    EXPECT_THROW(compression::Decompress(codec, compressed, data.size() - 1),
+                 compression::TooBigError)
+        << compression::ToContentEncoding(codec);
+  }
+}
+
+TEST(Compression, Corrupted) {
+  const auto data = SampleData(10'000);
+  for (const auto codec : compression::kCodecs) {
+    const auto compressed = compression::Compress(codec, data);
+    const auto truncated = compressed.substr(0, compressed.size() / 2);
+    EXPECT_THROW(compression::Decompress(codec, truncated, data.size()),
+                 compression::DecompressionError)
+        << compression::ToContentEncoding(codec);
+    EXPECT_THROW(compression::Decompress(codec, data, data.size()),
+                 compression::DecompressionError)
+        << compression::ToContentEncoding(codec);
+  }
+}
+
+TEST(Compression, ZstdStreamedFrames) {
+  // The frames compressed without the content size and one after another
+  const auto data = SampleData(50'000);
+  const auto compressed = compression::zstd::Compress(data.substr(0, 20'000)) +
+                          compression::zstd::Compress(data.substr(20'000));
+  EXPECT_EQ(compression::zstd::Decompress(compressed, data.size()), data);
+  EXPECT_THROW(compression::zstd::Decompress(compressed, data.size() - 1),
+               compression::TooBigError);
+}
+
+TEST(Compression, ZstdDictionary) {
+  const compression::zstd::Dictionary dictionary{SampleData(4096)};
+  const auto data = SampleData(300);
+
+  const auto compressed = compression::zstd::Compress(data, dictionary);
+  EXPECT_LT(compressed.size(), compression::zstd::Compress(data).size());
+  EXPECT_EQ(compression::zstd::Decompress(compressed, data.size(), &dictionary),
+            data);
+}
+
+TEST(Compression, ParseContentEncoding) {
+  EXPECT_EQ(compression::ParseContentEncoding("gzip"),
+            compression::Codec::kGzip);
+  EXPECT_EQ(compression::ParseContentEncoding("X-GZIP"),
+            compression::Codec::kGzip);
+  EXPECT_EQ(compression::ParseContentEncoding("zstd"),
+            compression::Codec::kZstd);
+  EXPECT_EQ(compression::ParseContentEncoding("br"),
+            compression::Codec::kBrotli);
+  EXPECT_EQ(compression::ParseContentEncoding("deflate"), std::nullopt);
+  EXPECT_EQ(compression::ParseContentEncoding("identity"), std::nullopt);
+}
+
+TEST(Compression, NegotiateCodec) {
+  using compression::Codec;
+  const auto negotiate = [](std::string_view accept_encoding) {
+    return compression::NegotiateCodec(accept_encoding, compression::kCodecs);
+  };
+
+  EXPECT_EQ(negotiate(""), std::nullopt);
+  EXPECT_EQ(negotiate("identity"), std::nullopt);
+  EXPECT_EQ(negotiate("deflate"), std::nullopt);
+  EXPECT_EQ(negotiate("gzip"), Codec::kGzip);
+  EXPECT_EQ(negotiate("gzip, deflate, br"), Codec::kBrotli);
+  EXPECT_EQ(negotiate("gzip, deflate, br, zstd"), Codec::kZstd);
+  EXPECT_EQ(negotiate("zstd;q=0.5, gzip"), Codec::kGzip);
+  EXPECT_EQ(negotiate("br;q=0.9,gzip ; Q=0.95"), Codec::kGzip);
+  EXPECT_EQ(negotiate("*"), Codec::kZstd);
+  EXPECT_EQ(negotiate("*;q=0.1, zstd;q=0"), Codec::kBrotli);
+  EXPECT_EQ(negotiate("gzip;q=0"), std::nullopt);
+  EXPECT_EQ(negotiate("gzip;q=2, br;q=0.5x"), std::nullopt);
+
+  const std::array gzip_only{Codec::kGzip};
+  EXPECT_EQ(compression::NegotiateCodec("zstd, br", gzip_only), std::nullopt);
+  EXPECT_EQ(compression::NegotiateCodec("zstd, br;q=0.5, gzip;q=0.1",
+                                        gzip_only),
+            Codec::kGzip);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,66 @@
+#include <compression/codec.hpp>
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+// JSON-like text, that compresses about as well as typical response bodies
+std::string MakeBody(std::size_t size) {
+  std::string body;
+  for (std::size_t i = 0; body.size() < size; ++i) {
+    body += fmt::format(R"({{"id":{},"name":"item-{}","price":{}.{:02}}},)", i,
+                        i * 7919 % 1000, i % 1000, i % 100);
+  }
+  body.resize(size);
+  return body;
+}
+
+template <compression::Codec kCodec>
+void compression_compress(benchmark::State& state) {
+  const auto body = MakeBody(state.range(0));
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(compression::Compress(kCodec, body));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+template <compression::Codec kCodec>
+void compression_decompress(benchmark::State& state) {
+  const auto body = MakeBody(state.range(0));
+  const auto compressed = compression::Compress(kCodec, body);
+  state.counters["ratio"] =
+      static_cast<double>(body.size()) / compressed.size();
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(
+        compression::Decompress(kCodec, compressed, body.size()));
+  }
+  state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+}  // namespace
+
+BENCHMARK(compression_compress<compression::Codec::kGzip>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK(compression_compress<compression::Codec::kZstd>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK(compression_compress<compression::Codec::kBrotli>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK(compression_decompress<compression::Codec::kGzip>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK(compression_decompress<compression::Codec::kZstd>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 20);
+BENCHMARK(compression_decompress<compression::Codec::kBrotli>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 20);
+
+USERVER_NAMESPACE_END
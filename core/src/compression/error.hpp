@@ -17,6 +17,11 @@ class TooBigError : public DecompressionError {
   TooBigError() : DecompressionError("Decompressed data exceeds the limit") {}
 };
 
+/// Failure of a compression library
+class CompressionError : public std::runtime_error {
+  using std::runtime_error::runtime_error;
+};
+
 }  // namespace compression
 
 USERVER_NAMESPACE_END
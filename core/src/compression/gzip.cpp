@@ -1,5 +1,6 @@
 #include <compression/gzip.hpp>
 
+#include <boost/iostreams/device/back_inserter.hpp>
 #include <boost/iostreams/filter/gzip.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
 
@@ -25,19 +26,34 @@ std::string Decompress(std::string_view compressed, size_t max_size) {
   stream.push(bio::gzip_decompressor());
   stream.push(bio::array_source(compressed.data(), compressed.size()));
 
-  while (stream && (decompressed.size() < max_size)) {
+  while (stream) {
     char buf[kDecompressBufferSize];
     stream.read(buf, sizeof(buf));
     decompressed.insert(decompressed.end(), buf, buf + stream.gcount());
+    if (decompressed.size() > max_size) throw TooBigError();
   }
 
   if (stream.bad())
     throw DecompressionError("failed to decompress gzip'ed data");
-  if (stream) throw TooBigError();
 
   return decompressed;
 }
 
+std::string Compress(std::string_view data) {
+  std::string compressed;
+
+  namespace bio = boost::iostreams;
+
+  bio::filtering_ostream stream;
+  stream.push(bio::gzip_compressor());
+  stream.push(bio::back_inserter(compressed));
+  stream.write(data.data(), data.size());
+  // closes the chain, which writes the gzip trailer
+  stream.reset();
+
+  return compressed;
+}
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string>
 #include <string_view>
 
 #include <compression/error.hpp>
@@ -12,6 +13,9 @@ namespace compression::gzip {
 /// @throws DecompressionError
 std::string Decompress(std::string_view compressed, size_t max_size);
 
+/// Compresses the string with the default compression level
+std::string Compress(std::string_view data);
+
 }  // namespace compression::gzip
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,147 @@
+#include <compression/zstd.hpp>
+
+#include <algorithm>
+#include <new>
+
+#include <fmt/format.h>
+#include <zstd.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression::zstd {
+
+namespace {
+
+// A guess for "small" data chunk, the buffer grows exponentially after that
+constexpr std::size_t kDecompressBufferSize = 1024;
+
+struct DCtxDeleter final {
+  void operator()(ZSTD_DCtx* ctx) const noexcept { ZSTD_freeDCtx(ctx); }
+};
+
+struct CCtxDeleter final {
+  void operator()(ZSTD_CCtx* ctx) const noexcept { ZSTD_freeCCtx(ctx); }
+};
+
+struct DDictDeleter final {
+  void operator()(ZSTD_DDict* dict) const noexcept { ZSTD_freeDDict(dict); }
+};
+
+struct CDictDeleter final {
+  void operator()(ZSTD_CDict* dict) const noexcept { ZSTD_freeCDict(dict); }
+};
+
+template <typename Error>
+void ThrowIfError(std::size_t code, std::string_view operation) {
+  if (ZSTD_isError(code)) {
+    throw Error(fmt::format("failed to {} zstd data: {}", operation,
+                            ZSTD_getErrorName(code)));
+  }
+}
+
+template <typename T>
+T* CheckAllocated(T* ptr) {
+  if (!ptr) throw std::bad_alloc();
+  return ptr;
+}
+
+std::string DoCompress(std::string_view data, ZSTD_CCtx& ctx,
+                       const ZSTD_CDict* dictionary, int level) {
+  std::string compressed(ZSTD_compressBound(data.size()), '\0');
+  const auto size =
+      dictionary ? ZSTD_compress_usingCDict(&ctx, compressed.data(),
+                                            compressed.size(), data.data(),
+                                            data.size(), dictionary)
+                 : ZSTD_compressCCtx(&ctx, compressed.data(), compressed.size(),
+                                     data.data(), data.size(), level);
+  ThrowIfError<CompressionError>(size, "compress");
+  compressed.resize(size);
+  return compressed;
+}
+
+}  // namespace
+
+struct Dictionary::Impl final {
+  std::unique_ptr<ZSTD_CDict, CDictDeleter> cdict;
+  std::unique_ptr<ZSTD_DDict, DDictDeleter> ddict;
+};
+
+Dictionary::Dictionary(std::string_view data, int level)
+    : impl_(std::make_unique<Impl>()) {
+  impl_->cdict.reset(ZSTD_createCDict(data.data(), data.size(), level));
+  impl_->ddict.reset(ZSTD_createDDict(data.data(), data.size()));
+  if (!impl_->cdict || !impl_->ddict) {
+    throw CompressionError("failed to load a zstd dictionary");
+  }
+}
+
+Dictionary::Dictionary(Dictionary&&) noexcept = default;
+
+Dictionary& Dictionary::operator=(Dictionary&&) noexcept = default;
+
+Dictionary::~Dictionary() = default;
+
+std::string Decompress(std::string_view compressed, std::size_t max_size,
+                       const Dictionary* dictionary) {
+  const std::unique_ptr<ZSTD_DCtx, DCtxDeleter> ctx{
+      CheckAllocated(ZSTD_createDCtx())};
+  if (dictionary) {
+    ThrowIfError<DecompressionError>(
+        ZSTD_DCtx_refDDict(ctx.get(), dictionary->impl_->ddict.get()),
+        "decompress");
+  }
+
+  // The size is stored in the frame header if the data was compressed at once
+  std::size_t expected_size = kDecompressBufferSize;
+  const auto content_size =
+      ZSTD_getFrameContentSize(compressed.data(), compressed.size());
+  if (content_size != ZSTD_CONTENTSIZE_UNKNOWN &&
+      content_size != ZSTD_CONTENTSIZE_ERROR) {
+    if (content_size > max_size) throw TooBigError();
+    // One extra byte to finish in one pass
+    expected_size = content_size + 1;
+  }
+
+  std::string decompressed;
+  ZSTD_inBuffer input{compressed.data(), compressed.size(), 0};
+  std::size_t result = 0;
+
+  while (true) {
+    const auto old_size = decompressed.size();
+    // One extra byte to detect an overflow of max_size
+    const auto chunk_size =
+        std::min(std::max({old_size, kDecompressBufferSize, expected_size}),
+                 max_size - old_size + 1);
+    decompressed.resize(old_size + chunk_size);
+
+    ZSTD_outBuffer output{decompressed.data() + old_size, chunk_size, 0};
+    result = ZSTD_decompressStream(ctx.get(), &output, &input);
+    ThrowIfError<DecompressionError>(result, "decompress");
+
+    decompressed.resize(old_size + output.pos);
+    if (decompressed.size() > max_size) throw TooBigError();
+    // Otherwise some data may still be buffered inside the context
+    if (input.pos == input.size && output.pos < output.size) break;
+  }
+
+  if (result != 0) {
+    throw DecompressionError("failed to decompress zstd data: truncated");
+  }
+  return decompressed;
+}
+
+std::string Compress(std::string_view data, int level) {
+  const std::unique_ptr<ZSTD_CCtx, CCtxDeleter> ctx{
+      CheckAllocated(ZSTD_createCCtx())};
+  return DoCompress(data, *ctx, nullptr, level);
+}
+
+std::string Compress(std::string_view data, const Dictionary& dictionary) {
+  const std::unique_ptr<ZSTD_CCtx, CCtxDeleter> ctx{
+      CheckAllocated(ZSTD_createCCtx())};
+  return DoCompress(data, *ctx, dictionary.impl_->cdict.get(), 0);
+}
+
+}  // namespace compression::zstd
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <compression/error.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace compression::zstd {
+
+/// Compression level that is fast enough to compress the data on the fly
+inline constexpr int kDefaultLevel = 3;
+
+/// @brief A dictionary trained on the samples of similar data, e.g. with
+/// `zstd --train`. Greatly improves the compression of small messages.
+///
+/// The data compressed with a dictionary may only be decompressed with the
+/// same dictionary.
+class Dictionary final {
+ public:
+  /// @throws CompressionError if the dictionary is malformed
+  explicit Dictionary(std::string_view data, int level = kDefaultLevel);
+
+  Dictionary(Dictionary&&) noexcept;
+  Dictionary& operator=(Dictionary&&) noexcept;
+  ~Dictionary();
+
+ private:
+  friend std::string Decompress(std::string_view, std::size_t,
+                                const Dictionary*);
+  friend std::string Compress(std::string_view, const Dictionary&);
+
+  struct Impl;
+  std::unique_ptr<Impl> impl_;
+};
+
+/// Decompresses the string, which may consist of multiple zstd frames.
+/// @throws DecompressionError
+std::string Decompress(std::string_view compressed, std::size_t max_size,
+                       const Dictionary* dictionary = nullptr);
+
+/// Compresses the string
+/// @throws CompressionError
+std::string Compress(std::string_view data, int level = kDefaultLevel);
+
+/// Compresses the string using the dictionary and its compression level
+/// @throws CompressionError
+std::string Compress(std::string_view data, const Dictionary& dictionary);
+
+}  // namespace compression::zstd
+
+USERVER_NAMESPACE_END
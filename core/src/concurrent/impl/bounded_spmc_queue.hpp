@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <concurrent/impl/interference_shield.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent::impl {
+
+/// @brief A bounded lock-free FIFO queue of pointers with a single producer
+/// and multiple consumers.
+///
+/// - Only the owner (producer) thread may call `TryPush`
+/// - Any thread may call `TryPop`, which makes the queue suitable as a local
+///   run queue for work stealing: the owner and the thieves pop from the same
+///   end, so the items are processed in FIFO order
+/// - The queue does not own the pointed-to objects
+template <typename T, std::size_t Capacity>
+class BoundedSpmcQueue final {
+  static_assert(Capacity != 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of 2");
+
+ public:
+  constexpr BoundedSpmcQueue() = default;
+
+  BoundedSpmcQueue(BoundedSpmcQueue&&) = delete;
+  BoundedSpmcQueue& operator=(BoundedSpmcQueue&&) = delete;
+
+  /// Producer-only. Returns `false` if the queue is full.
+  bool TryPush(T* item) noexcept {
+    UASSERT(item);
+    const auto tail = tail_->load(std::memory_order_relaxed);
+    const auto head = head_->load(std::memory_order_acquire);
+    if (tail - head >= Capacity) return false;
+
+    GetCell(tail).store(item, std::memory_order_relaxed);
+    tail_->store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Thread-safe. Returns `nullptr` if the queue is empty.
+  T* TryPop() noexcept {
+    auto head = head_->load(std::memory_order_acquire);
+    while (true) {
+      const auto tail = tail_->load(std::memory_order_acquire);
+      if (head == tail) return nullptr;
+
+      // The cell may only be overwritten by the producer after `head_` moves
+      // past it, in which case the CAS below fails and the value is discarded.
+      T* const item = GetCell(head).load(std::memory_order_relaxed);
+      if (head_->compare_exchange_weak(head, head + 1,
+                                       std::memory_order_acq_rel,
+                                       std::memory_order_acquire)) {
+        return item;
+      }
+    }
+  }
+
+  /// Thread-safe, the result may be outdated by the time it is returned.
+  std::size_t GetSizeApproximate() const noexcept {
+    const auto head = head_->load(std::memory_order_relaxed);
+    const auto tail = tail_->load(std::memory_order_relaxed);
+    return tail > head ? tail - head : 0;
+  }
+
+  static constexpr std::size_t GetCapacity() noexcept { return Capacity; }
+
+ private:
+  std::atomic<T*>& GetCell(std::size_t index) noexcept {
+    return buffer_[index & (Capacity - 1)];
+  }
+
+  InterferenceShield<std::atomic<std::size_t>> head_{0};
+  InterferenceShield<std::atomic<std::size_t>> tail_{0};
+  std::array<std::atomic<T*>, Capacity> buffer_{};
+};
+
+}  // namespace concurrent::impl
+
+USERVER_NAMESPACE_END
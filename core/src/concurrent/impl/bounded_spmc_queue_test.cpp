@@ -0,0 +1,92 @@
+#include <concurrent/impl/bounded_spmc_queue.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Queue = concurrent::impl::BoundedSpmcQueue<std::size_t, 8>;
+
+}  // namespace
+
+TEST(BoundedSpmcQueue, Empty) {
+  Queue queue;
+  EXPECT_EQ(queue.TryPop(), nullptr);
+  EXPECT_EQ(queue.GetSizeApproximate(), 0);
+}
+
+TEST(BoundedSpmcQueue, Fifo) {
+  Queue queue;
+  std::size_t values[3]{1, 2, 3};
+
+  for (auto& value : values) EXPECT_TRUE(queue.TryPush(&value));
+  EXPECT_EQ(queue.GetSizeApproximate(), 3);
+
+  EXPECT_EQ(queue.TryPop(), &values[0]);
+  EXPECT_EQ(queue.TryPop(), &values[1]);
+  EXPECT_EQ(queue.TryPop(), &values[2]);
+  EXPECT_EQ(queue.TryPop(), nullptr);
+}
+
+TEST(BoundedSpmcQueue, Overflow) {
+  Queue queue;
+  std::vector<std::size_t> values(Queue::GetCapacity() + 1);
+
+  for (std::size_t i = 0; i < Queue::GetCapacity(); ++i) {
+    EXPECT_TRUE(queue.TryPush(&values[i]));
+  }
+  EXPECT_FALSE(queue.TryPush(&values.back()));
+
+  EXPECT_EQ(queue.TryPop(), &values[0]);
+  EXPECT_TRUE(queue.TryPush(&values.back()));
+
+  for (std::size_t i = 1; i < values.size(); ++i) {
+    EXPECT_EQ(queue.TryPop(), &values[i]);
+  }
+  EXPECT_EQ(queue.TryPop(), nullptr);
+}
+
+TEST(BoundedSpmcQueue, ConcurrentSteal) {
+  constexpr std::size_t kItems = 100'000;
+  constexpr std::size_t kThieves = 3;
+
+  Queue queue;
+  std::vector<std::size_t> values(kItems);
+  std::vector<std::atomic<std::size_t>> pop_counts(kItems);
+  std::atomic<bool> is_producing{true};
+
+  const auto consume = [&] {
+    while (true) {
+      const bool was_producing = is_producing.load();
+      auto* item = queue.TryPop();
+      if (item) {
+        ++pop_counts[item - values.data()];
+      } else if (!was_producing) {
+        break;
+      }
+    }
+  };
+
+  std::vector<std::thread> thieves;
+  for (std::size_t i = 0; i < kThieves; ++i) thieves.emplace_back(consume);
+
+  for (auto& value : values) {
+    while (!queue.TryPush(&value)) {
+      if (auto* item = queue.TryPop()) ++pop_counts[item - values.data()];
+    }
+  }
+  is_producing = false;
+  consume();
+
+  for (auto& thief : thieves) thief.join();
+
+  for (const auto& count : pop_counts) ASSERT_EQ(count.load(), 1);
+}
+
+USERVER_NAMESPACE_END
@@ -506,6 +506,7 @@ class easy final : public std::enable_shared_from_this<easy> {
   };
   IMPLEMENT_CURL_OPTION_ENUM(set_http_version, native::CURLOPT_HTTP_VERSION,
                              http_version_t, long);
+  IMPLEMENT_CURL_OPTION_BOOLEAN(set_pipewait, native::CURLOPT_PIPEWAIT);
   IMPLEMENT_CURL_OPTION_BOOLEAN(set_ignore_content_length,
                                 native::CURLOPT_IGNORE_CONTENT_LENGTH);
   IMPLEMENT_CURL_OPTION_BOOLEAN(set_http_content_decoding,
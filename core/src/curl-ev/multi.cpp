@@ -37,6 +37,10 @@ const char* GetSetterName(native::CURLMoption option) {
       return "SetMaxHostConnections";
     case native::CURLMOPT_MAXCONNECTS:
       return "SetConnectionCacheSize";
+#if LIBCURL_VERSION_NUM >= 0x074300
+    case native::CURLMOPT_MAX_CONCURRENT_STREAMS:
+      return "SetMaxConcurrentStreams";
+#endif
     default:
       return "<unknown setter>";
   }
@@ -140,7 +144,9 @@ void multi::CheckRateLimit(const char* url_str, std::error_code& ec) {
 }
 
 void multi::SetMultiplexingEnabled(bool value) {
-  SetOptionAsync(native::CURLMOPT_PIPELINING, value ? 1 : 0);
+  // CURLPIPE_HTTP1 (1) is a no-op since curl 7.62, it disables multiplexing
+  SetOptionAsync(native::CURLMOPT_PIPELINING,
+                 value ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING);
 }
 
 void multi::SetMaxHostConnections(long value) {
@@ -151,6 +157,17 @@ void multi::SetConnectionCacheSize(long value) {
   SetOptionAsync(native::CURLMOPT_MAXCONNECTS, value);
 }
 
+void multi::SetMaxConcurrentStreams(long value) {
+#if LIBCURL_VERSION_NUM >= 0x074300
+  SetOptionAsync(native::CURLMOPT_MAX_CONCURRENT_STREAMS, value);
+#else
+  LOG_WARNING() << "Max concurrent HTTP/2 streams can not be set, libcurl "
+                   "7.67.0 or newer is required, current version is "
+                << LIBCURL_VERSION;
+  static_cast<void>(value);
+#endif
+}
+
 void multi::add_handle(native::CURL* native_easy) {
   std::error_code ec{static_cast<errc::MultiErrorCode>(
       native::curl_multi_add_handle(handle_, native_easy))};
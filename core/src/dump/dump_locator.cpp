@@ -1,6 +1,8 @@
 #include <dump/dump_locator.hpp>
 
 #include <algorithm>
+#include <map>
+#include <unordered_set>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
@@ -20,13 +22,22 @@ namespace dump {
 namespace {
 
 const std::string kTimeZone = "UTC";
+const std::string kDeltaSeparator = ".delta-";
+
+// `{dump filename}.delta-{index}` -> `{dump filename}`
+std::string GetDeltaBaseFilename(const std::string& delta_filename) {
+  return delta_filename.substr(0, delta_filename.rfind(kDeltaSeparator));
+}
 
 }  // namespace
 
 DumpLocator::DumpLocator(Config static_config)
     : config_(static_config),
       filename_regex_(GenerateFilenameRegex(FileFormatType::kNormal)),
-      tmp_filename_regex_(GenerateFilenameRegex(FileFormatType::kTmp)) {}
+      tmp_filename_regex_(GenerateFilenameRegex(FileFormatType::kTmp)),
+      delta_filename_regex_(GenerateFilenameRegex(FileFormatType::kDelta)),
+      delta_tmp_filename_regex_(
+          GenerateFilenameRegex(FileFormatType::kDeltaTmp)) {}
 
 DumpFileStats DumpLocator::RegisterNewDump(TimePoint update_time) {
   std::string dump_path = GenerateDumpPath(update_time);
@@ -48,6 +59,23 @@ DumpFileStats DumpLocator::RegisterNewDump(TimePoint update_time) {
   return {update_time, std::move(dump_path), config_.dump_format_version};
 }
 
+std::string DumpLocator::RegisterNewDelta(TimePoint base_update_time,
+                                          uint64_t delta_index) {
+  UASSERT(delta_index > 0);
+  std::string delta_path = fmt::format(
+      FMT_COMPILE("{}{}{}"), GenerateDumpPath(base_update_time),
+      kDeltaSeparator, delta_index);
+
+  if (boost::filesystem::exists(delta_path)) {
+    throw std::runtime_error(fmt::format(
+        "{}: could not write a delta to \"{}\", because the file already "
+        "exists",
+        config_.name, delta_path));
+  }
+
+  return delta_path;
+}
+
 std::optional<DumpFileStats> DumpLocator::GetLatestDump() const {
   try {
     std::optional<DumpFileStats> stats = GetLatestDumpImpl();
@@ -89,6 +117,13 @@ bool DumpLocator::BumpDumpTime(TimePoint old_update_time,
           << "\" has suddenly disappeared. A new dump will be created.";
       return false;
     }
+    // The deltas go first: if the dump is not renamed after that, the deltas
+    // are just lost, and the dump is not presented as fresher than it is
+    for (const auto& old_delta : FindDeltas(old_name)) {
+      boost::filesystem::rename(
+          old_delta, new_name + old_delta.substr(
+                                    old_delta.rfind(kDeltaSeparator)));
+    }
     boost::filesystem::rename(old_name, new_name);
     LOG_INFO() << config_.name << ": renamed dump \"" << old_name << "\" to \""
                << new_name << "\"";
@@ -103,6 +138,8 @@ bool DumpLocator::BumpDumpTime(TimePoint old_update_time,
 void DumpLocator::Cleanup() {
   const auto min_update_time = MinAcceptableUpdateTime();
   std::vector<DumpFileStats> dumps;
+  std::unordered_set<std::string> kept_dump_filenames;
+  std::vector<boost::filesystem::path> deltas;
 
   try {
     if (!boost::filesystem::exists(config_.dump_directory)) {
@@ -119,13 +156,19 @@ void DumpLocator::Cleanup() {
 
       std::string filename = file.path().filename().string();
 
-      if (boost::regex_match(filename, tmp_filename_regex_)) {
+      if (boost::regex_match(filename, tmp_filename_regex_) ||
+          boost::regex_match(filename, delta_tmp_filename_regex_)) {
         LOG_DEBUG() << "Removing a leftover tmp file \"" << file.path().string()
                     << "\"";
         boost::filesystem::remove(file);
         continue;
       }
 
+      if (boost::regex_match(filename, delta_filename_regex_)) {
+        deltas.push_back(file.path());
+        continue;
+      }
+
       auto dump = ParseDumpName(file.path().string());
       if (!dump) {
         LOG_WARNING() << config_.name
@@ -142,6 +185,7 @@ void DumpLocator::Cleanup() {
         continue;
       }
 
+      kept_dump_filenames.insert(std::move(filename));
       if (dump->format_version == config_.dump_format_version) {
         dumps.push_back(std::move(*dump));
       }
@@ -156,6 +200,17 @@ void DumpLocator::Cleanup() {
       LOG_DEBUG() << config_.name << ": removing an excessive dump \""
                   << dumps[i].full_path << "\"";
       boost::filesystem::remove(dumps[i].full_path);
+      kept_dump_filenames.erase(
+          boost::filesystem::path{dumps[i].full_path}.filename().string());
+    }
+
+    for (const auto& delta : deltas) {
+      const auto filename = delta.filename().string();
+      if (kept_dump_filenames.count(GetDeltaBaseFilename(filename)) == 0) {
+        LOG_DEBUG() << config_.name << ": removing a delta of a removed dump \""
+                    << delta.string() << "\"";
+        boost::filesystem::remove(delta);
+      }
     }
   } catch (const std::exception& ex) {
     LOG_ERROR() << config_.name
@@ -210,8 +265,12 @@ std::optional<DumpFileStats> DumpLocator::GetLatestDumpImpl() const {
 
       auto curr_dump = ParseDumpName(file.path().string());
       if (!curr_dump) {
-        if (boost::regex_match(file.path().filename().string(),
-                               tmp_filename_regex_)) {
+        const auto filename = file.path().filename().string();
+        if (boost::regex_match(filename, delta_filename_regex_)) {
+          continue;
+        }
+        if (boost::regex_match(filename, tmp_filename_regex_) ||
+            boost::regex_match(filename, delta_tmp_filename_regex_)) {
           LOG_DEBUG() << "A leftover tmp file found: \"" << file.path().string()
                       << "\". It will be removed on next Cleanup";
         } else {
@@ -241,6 +300,8 @@ std::optional<DumpFileStats> DumpLocator::GetLatestDumpImpl() const {
         best_dump = std::move(curr_dump);
       }
     }
+
+    if (best_dump) best_dump->delta_paths = FindDeltas(best_dump->full_path);
   } catch (const std::exception& ex) {
     LOG_ERROR() << config_.name
                 << ": error while trying to fetch dumps. Cause: " << ex;
@@ -250,6 +311,43 @@ std::optional<DumpFileStats> DumpLocator::GetLatestDumpImpl() const {
   return best_dump ? std::optional{std::move(best_dump)} : std::nullopt;
 }
 
+std::vector<std::string> DumpLocator::FindDeltas(
+    const std::string& dump_path) const {
+  const boost::filesystem::path path{dump_path};
+  const auto prefix = path.filename().string() + kDeltaSeparator;
+  std::map<uint64_t, std::string> deltas;
+
+  for (const auto& file :
+       boost::filesystem::directory_iterator{path.parent_path()}) {
+    if (!boost::filesystem::is_regular_file(file.status())) {
+      continue;
+    }
+
+    const auto filename = file.path().filename().string();
+    boost::smatch regex;
+    if (filename.compare(0, prefix.size(), prefix) != 0 ||
+        !boost::regex_match(filename, regex, delta_filename_regex_)) {
+      continue;
+    }
+
+    const auto index = utils::FromString<uint64_t>(regex[3].str());
+    deltas.emplace(index, (path.parent_path() / filename).string());
+  }
+
+  std::vector<std::string> result;
+  for (auto& [index, delta_path] : deltas) {
+    if (index != result.size() + 1) {
+      // A delta can only be applied on top of all the previous ones
+      LOG_WARNING() << config_.name << ": delta #" << result.size() + 1
+                    << " of dump \"" << dump_path
+                    << "\" is missing, ignoring the subsequent deltas";
+      break;
+    }
+    result.push_back(std::move(delta_path));
+  }
+  return result;
+}
+
 std::string DumpLocator::GenerateDumpPath(TimePoint update_time) const {
   return fmt::format(
       FMT_COMPILE("{}/{}-v{}"), config_.dump_directory,
@@ -264,9 +362,19 @@ TimePoint DumpLocator::MinAcceptableUpdateTime() const {
 }
 
 std::string DumpLocator::GenerateFilenameRegex(FileFormatType type) {
-  return std::string{
-             R"(^(\d{4}-\d{2}-\d{2}T\d{2}:?\d{2}:?\d{2}\.\d{6}Z?)-v(\d+))"} +
-         (type == FileFormatType::kTmp ? "\\.tmp$" : "$");
+  const std::string dump_regex{
+      R"(^(\d{4}-\d{2}-\d{2}T\d{2}:?\d{2}:?\d{2}\.\d{6}Z?)-v(\d+))"};
+  switch (type) {
+    case FileFormatType::kNormal:
+      return dump_regex + "$";
+    case FileFormatType::kTmp:
+      return dump_regex + "\\.tmp$";
+    case FileFormatType::kDelta:
+      return dump_regex + "\\.delta-(\\d+)$";
+    case FileFormatType::kDeltaTmp:
+      return dump_regex + "\\.delta-(\\d+)\\.tmp$";
+  }
+  UINVARIANT(false, "Unexpected FileFormatType");
 }
 
 TimePoint DumpLocator::Round(std::chrono::system_clock::time_point time) {
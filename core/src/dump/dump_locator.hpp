@@ -4,6 +4,7 @@
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <boost/regex.hpp>
 
@@ -21,6 +22,8 @@ struct DumpFileStats final {
   TimePoint update_time;
   std::string full_path;
   uint64_t format_version;
+  /// Deltas on top of the dump, in the order of writing
+  std::vector<std::string> delta_paths{};
 };
 
 /// @brief Manages dump files on disk. Encapsulates file paths and naming scheme
@@ -36,29 +39,41 @@ class DumpLocator final {
   /// @throws On a filesystem error
   DumpFileStats RegisterNewDump(TimePoint update_time);
 
+  /// @brief Prepare the place for a new delta on top of the dump
+  /// @param base_update_time the update time of the dump
+  /// @param delta_index 1 for the first delta of the dump, and so on
+  /// @note The operation is blocking, and should run in FS TaskProcessor
+  /// @note The actual creation of the file is a caller's responsibility
+  /// @throws On a filesystem error
+  std::string RegisterNewDelta(TimePoint base_update_time,
+                               uint64_t delta_index);
+
   /// @brief Finds the latest suitable dump
   /// @note The operation is blocking, and should run in FS TaskProcessor
   /// @returns The full path of the dump if available and fresh enough,
   /// or `nullopt` otherwise
   std::optional<DumpFileStats> GetLatestDump() const;
 
-  /// @brief Modifies the update time for a dump
+  /// @brief Modifies the update time for a dump, keeping its deltas
   /// @note The operation is blocking, and should run in FS TaskProcessor
   /// @return `true` on success, `false` if the dump is not available
   bool BumpDumpTime(TimePoint old_update_time, TimePoint new_update_time);
 
-  /// @brief Removes old dumps and tmp files
+  /// @brief Removes old dumps together with their deltas, and tmp files
   /// @note The operation is blocking, and should run in FS TaskProcessor
   /// @warning Must not be called concurrently with `RegisterNewDump`
   void Cleanup();
 
  private:
-  enum class FileFormatType { kNormal, kTmp };
+  enum class FileFormatType { kNormal, kTmp, kDelta, kDeltaTmp };
 
   std::optional<DumpFileStats> ParseDumpName(std::string full_path) const;
 
   std::optional<DumpFileStats> GetLatestDumpImpl() const;
 
+  // Returns the paths of the deltas of the dump, ordered by index
+  std::vector<std::string> FindDeltas(const std::string& dump_path) const;
+
   std::string GenerateDumpPath(TimePoint update_time) const;
 
   TimePoint MinAcceptableUpdateTime() const;
@@ -70,6 +85,8 @@ class DumpLocator final {
   const Config config_;
   const boost::regex filename_regex_;
   const boost::regex tmp_filename_regex_;
+  const boost::regex delta_filename_regex_;
+  const boost::regex delta_tmp_filename_regex_;
 };
 
 }  // namespace dump
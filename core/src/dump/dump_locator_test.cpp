@@ -268,4 +268,68 @@ max-age: 30m
   }
 }
 
+UTEST(DumpLocator, Deltas) {
+  using namespace std::chrono_literals;
+
+  const std::string kConfig = R"(
+enable: true
+world-readable: false
+format-version: 5
+max-count: 1
+max-age: null
+max-delta-count: 5
+)";
+  const auto dir = fs::blocking::TempDirectory::Create();
+
+  const std::string old_dump = "2015-03-22T090000.000000Z-v5";
+  const std::string dump = "2015-03-22T090001.000000Z-v5";
+  dump::CreateDumps({old_dump, old_dump + ".delta-1", dump, dump + ".delta-2",
+                     dump + ".delta-1", dump + ".delta-4",
+                     dump + ".delta-3.tmp"},
+                    dir, kDumperName);
+
+  const dump::Config config{dump::ConfigFromYaml(kConfig, dir, kDumperName)};
+  dump::DumpLocator locator{config};
+
+  {
+    // The deltas after a missing one are ignored
+    const auto dump_stats = locator.GetLatestDump();
+    ASSERT_TRUE(dump_stats);
+    EXPECT_EQ(Filename(dump_stats->full_path), dump);
+    ASSERT_EQ(dump_stats->delta_paths.size(), 2);
+    EXPECT_EQ(Filename(dump_stats->delta_paths[0]), dump + ".delta-1");
+    EXPECT_EQ(Filename(dump_stats->delta_paths[1]), dump + ".delta-2");
+  }
+
+  {
+    // The deltas are removed together with their dump
+    locator.Cleanup();
+    EXPECT_EQ(dump::FilenamesInDirectory(dir, kDumperName),
+              (std::set<std::string>{dump, dump + ".delta-1", dump + ".delta-2",
+                                     dump + ".delta-4"}));
+  }
+
+  {
+    const auto delta_path = locator.RegisterNewDelta(BaseTime() + 1s, 3);
+    EXPECT_EQ(Filename(delta_path), dump + ".delta-3");
+    fs::blocking::RewriteFileContents(delta_path, "delta");
+    EXPECT_THROW(locator.RegisterNewDelta(BaseTime() + 1s, 3),
+                 std::runtime_error);
+  }
+
+  {
+    // The deltas are renamed together with their dump
+    const std::string new_dump = "2015-03-22T090005.000000Z-v5";
+    EXPECT_TRUE(locator.BumpDumpTime(BaseTime() + 1s, BaseTime() + 5s));
+
+    const auto dump_stats = locator.GetLatestDump();
+    ASSERT_TRUE(dump_stats);
+    EXPECT_EQ(dump_stats->update_time, BaseTime() + 5s);
+    ASSERT_EQ(dump_stats->delta_paths.size(), 4);
+    EXPECT_EQ(Filename(dump_stats->delta_paths[2]), new_dump + ".delta-3");
+    EXPECT_EQ(fs::blocking::ReadFileContents(dump_stats->delta_paths[2]),
+              "delta");
+  }
+}
+
 USERVER_NAMESPACE_END
@@ -1,5 +1,10 @@
 #include <userver/dump/dumper.hpp>
 
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <fmt/format.h>
 #include <boost/filesystem/operations.hpp>
 
@@ -32,6 +37,7 @@
 #include <dump/dump_locator.hpp>
 #include <dump/statistics.hpp>
 #include <userver/components/dump_configurator.hpp>
+#include <userver/dump/common.hpp>
 #include <userver/dump/config.hpp>
 #include <userver/dump/factory.hpp>
 #include <userver/testsuite/dump_control.hpp>
@@ -48,6 +54,12 @@ void ThrowDumpUnimplemented(const std::string& name) {
 
 DumpableEntity::~DumpableEntity() = default;
 
+bool DumpableEntity::GetAndWriteDelta(dump::Writer&, TimePoint) const {
+  return false;
+}
+
+bool DumpableEntity::ReadAndApplyDelta(dump::Reader&) { return false; }
+
 namespace {
 
 struct UpdateTime final {
@@ -55,6 +67,12 @@ struct UpdateTime final {
   TimePoint last_modifying_update;
 };
 
+// The full dump, on top of which the next delta is written
+struct DeltaBase final {
+  TimePoint update_time;
+  uint64_t delta_count{0};
+};
+
 struct DumpData {
   DumpData(const Config& static_config,
            std::unique_ptr<OperationsFactory> rw_factory,
@@ -69,6 +87,7 @@ struct DumpData {
   DumpableEntity& dumpable;
   DumpLocator locator;
   std::optional<UpdateTime> dumped_update_time;
+  std::optional<DeltaBase> delta_base;
 };
 
 struct UpdateData {
@@ -141,6 +160,16 @@ class Dumper::Impl {
   void DoWriteDump(TimePoint update_time, tracing::ScopeTime& scope,
                    DumpData& dump_data);
 
+  /// @returns `false` if a full dump should be written instead
+  /// @throws std::exception on failure
+  bool TryWriteDelta(TimePoint update_time, tracing::ScopeTime& scope,
+                     DumpData& dump_data);
+
+  // Removes the deltas starting from `first_index`, so that they are never
+  // applied on top of a newer state
+  void RemoveUnsupportedDeltas(const std::vector<std::string>& delta_paths,
+                               std::size_t first_index) const noexcept;
+
   enum class DumpOperation { kNewDump, kBumpTime };
 
   /// @returns `update_time` of the loaded dump on success, `null` otherwise
@@ -353,15 +382,24 @@ void Dumper::Impl::WriteDump(DumpData& dump_data) {
 
   switch (operation_type) {
     case DumpOperation::kNewDump: {
-      dump_data.locator.Cleanup();
-      DoWriteDump(update_time.last_update, scope_time, dump_data);
+      if (!TryWriteDelta(update_time.last_update, scope_time, dump_data)) {
+        dump_data.locator.Cleanup();
+        DoWriteDump(update_time.last_update, scope_time, dump_data);
+      }
       break;
     }
     case DumpOperation::kBumpTime: {
       UASSERT(dumped_update_time);
-      if (!dump_data.locator.BumpDumpTime(dumped_update_time->last_update,
+      auto& delta_base = dump_data.delta_base;
+      // The deltas are renamed together with their full dump
+      const auto dump_update_time = delta_base
+                                        ? delta_base->update_time
+                                        : dumped_update_time->last_update;
+      if (!dump_data.locator.BumpDumpTime(dump_update_time,
                                           update_time.last_update)) {
         DoWriteDump(update_time.last_update, scope_time, dump_data);
+      } else if (delta_base) {
+        delta_base->update_time = update_time.last_update;
       }
       break;
     }
@@ -437,6 +475,64 @@ void Dumper::Impl::DoWriteDump(TimePoint update_time, tracing::ScopeTime& scope,
       std::chrono::duration_cast<std::chrono::milliseconds>(
           std::chrono::steady_clock::now() - dump_start);
   statistics_.last_nontrivial_write_start_time = dump_start;
+
+  if (static_config_.max_delta_count > 0) {
+    dump_data.delta_base = DeltaBase{update_time, 0};
+  }
+}
+
+bool Dumper::Impl::TryWriteDelta(TimePoint update_time,
+                                 tracing::ScopeTime& scope,
+                                 DumpData& dump_data) {
+  if (!dump_data.delta_base || !dump_data.dumped_update_time ||
+      dump_data.delta_base->delta_count >= static_config_.max_delta_count) {
+    return false;
+  }
+
+  const auto dump_start = std::chrono::steady_clock::now();
+  // If anything fails, the next dump is a full one
+  const auto delta_base = *std::exchange(dump_data.delta_base, std::nullopt);
+  const auto delta_index = delta_base.delta_count + 1;
+
+  const auto delta_path =
+      dump_data.locator.RegisterNewDelta(delta_base.update_time, delta_index);
+  auto writer = dump_data.rw_factory->CreateWriter(delta_path, scope);
+  writer->Write(update_time);
+  if (!dump_data.dumpable.GetAndWriteDelta(
+          *writer, dump_data.dumped_update_time->last_update)) {
+    LOG_DEBUG() << Name() << ": the changes are unknown, writing a full dump";
+    return false;
+  }
+  writer->Finish();
+  const auto delta_size = boost::filesystem::file_size(delta_path);
+
+  LOG_INFO() << Name() << ": a new delta has been written at \"" << delta_path
+             << '"';
+
+  statistics_.last_written_size = delta_size;
+  statistics_.last_nontrivial_write_duration =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - dump_start);
+  statistics_.last_nontrivial_write_start_time = dump_start;
+
+  dump_data.delta_base = DeltaBase{delta_base.update_time, delta_index};
+  return true;
+}
+
+void Dumper::Impl::RemoveUnsupportedDeltas(
+    const std::vector<std::string>& delta_paths,
+    std::size_t first_index) const noexcept {
+  LOG_WARNING() << Name() << ": the dumpable entity does not support deltas, "
+                << "removing " << delta_paths.size() - first_index
+                << " deltas of the dump";
+  for (auto i = first_index; i < delta_paths.size(); ++i) {
+    boost::system::error_code error;
+    boost::filesystem::remove(delta_paths[i], error);
+    if (error) {
+      LOG_WARNING() << Name() << ": failed to remove an unsupported delta \""
+                    << delta_paths[i] << "\": " << error.message();
+    }
+  }
 }
 
 std::optional<TimePoint> Dumper::Impl::LoadFromDump(
@@ -450,6 +546,7 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(
   }
 
   const auto load_start = std::chrono::steady_clock::now();
+  std::optional<DeltaBase> delta_base;
 
   const std::optional<TimePoint> update_time =
       utils::CriticalAsync(fs_task_processor_, read_span_name_, [&] {
@@ -464,8 +561,26 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(
           dump_data.dumpable.ReadAndSet(*reader);
           reader->Finish();
 
-          LOG_INFO() << Name() << ": a dump has been loaded successfully";
-          return std::optional{dump_stats->update_time};
+          // The time of the full dump may have been bumped after the deltas
+          auto update_time = dump_stats->update_time;
+          const auto& delta_paths = dump_stats->delta_paths;
+          std::size_t applied_deltas = 0;
+          for (; applied_deltas < delta_paths.size(); ++applied_deltas) {
+            auto delta_reader =
+                dump_data.rw_factory->CreateReader(delta_paths[applied_deltas]);
+            const auto delta_time = delta_reader->Read<TimePoint>();
+            if (!dump_data.dumpable.ReadAndApplyDelta(*delta_reader)) break;
+            delta_reader->Finish();
+            update_time = std::max(update_time, delta_time);
+          }
+          if (applied_deltas < delta_paths.size()) {
+            RemoveUnsupportedDeltas(delta_paths, applied_deltas);
+          }
+
+          LOG_INFO() << Name() << ": a dump has been loaded successfully, "
+                     << applied_deltas << " deltas applied";
+          delta_base = DeltaBase{dump_stats->update_time, applied_deltas};
+          return std::optional{update_time};
         } catch (const std::exception& ex) {
           LOG_ERROR() << Name()
                       << ": error while reading a dump. Reason: " << ex;
@@ -483,6 +598,9 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(
   }
   // So that we don't attempt to write the dump we've just read
   dump_data.dumped_update_time = update_times;
+  if (static_config_.max_delta_count > 0) {
+    dump_data.delta_base = delta_base;
+  }
 
   statistics_.is_loaded = true;
   statistics_.load_duration =
@@ -574,6 +692,14 @@ properties:
                 type: boolean
                 description: Whether to encrypt the dump
                 defaultDescription: false
+            use-mmap:
+                type: boolean
+                description: Whether to read unencrypted dumps via mmap without intermediate copies
+                defaultDescription: false
+            max-delta-count:
+                type: integer
+                description: If non-zero, modifications are written as up to max-delta-count deltas on top of the latest full dump
+                defaultDescription: 0
 )");
 }
 
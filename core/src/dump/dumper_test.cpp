@@ -1,8 +1,12 @@
 #include <userver/dump/dumper.hpp>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <set>
+#include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <dump/internal_helpers_test.hpp>
@@ -351,6 +355,175 @@ UTEST_F(DumperFixtureNonPeriodic, ForcedReadsEnabled) {
 
 namespace {
 
+// Appends the values that have been added since the previous dump as deltas
+struct AppendOnlyEntity final : public dump::DumpableEntity {
+  static constexpr std::string_view kName = "append-only";
+
+  void Append(dump::TimePoint time, int value) {
+    values.push_back(value);
+    log.emplace_back(time, value);
+  }
+
+  void GetAndWrite(dump::Writer& writer) const override {
+    writer.Write(values);
+  }
+
+  void ReadAndSet(dump::Reader& reader) override {
+    values = reader.Read<std::vector<int>>();
+  }
+
+  bool GetAndWriteDelta(dump::Writer& writer,
+                        dump::TimePoint since) const override {
+    std::vector<int> delta;
+    for (const auto& [time, value] : log) {
+      if (time > since) delta.push_back(value);
+    }
+    writer.Write(delta);
+    ++delta_write_count;
+    return true;
+  }
+
+  bool ReadAndApplyDelta(dump::Reader& reader) override {
+    if (!are_deltas_supported) return false;
+    const auto delta = reader.Read<std::vector<int>>();
+    values.insert(values.end(), delta.begin(), delta.end());
+    return true;
+  }
+
+  std::vector<int> values;
+  std::vector<std::pair<dump::TimePoint, int>> log;
+  mutable int delta_write_count{0};
+  bool are_deltas_supported{true};
+};
+
+const std::string kDeltaConfig = R"(
+enable: true
+world-readable: true
+format-version: 0
+max-age:  # unlimited
+max-count: 1
+max-delta-count: 2
+)";
+
+std::size_t CountDeltas(const std::set<std::string>& filenames) {
+  return std::count_if(filenames.begin(), filenames.end(), [](const auto& f) {
+    return f.find(".delta-") != std::string::npos;
+  });
+}
+
+class DumperDeltas : public ::testing::Test {
+ protected:
+  dump::Dumper MakeDumper(dump::DumpableEntity& dumpable) {
+    return dump::Dumper{
+        config_,
+        dump::CreateDefaultOperationsFactory(config_),
+        engine::current_task::GetTaskProcessor(),
+        config_storage_.GetSource(),
+        statistics_storage_,
+        control_,
+        dumpable,
+    };
+  }
+
+  std::set<std::string> Filenames() const {
+    return dump::FilenamesInDirectory(root_, AppendOnlyEntity::kName);
+  }
+
+ private:
+  const fs::blocking::TempDirectory root_ =
+      fs::blocking::TempDirectory::Create();
+  const dump::Config config_ =
+      dump::ConfigFromYaml(kDeltaConfig, root_, AppendOnlyEntity::kName);
+  testsuite::DumpControl control_{
+      testsuite::DumpControl::PeriodicsMode::kDisabled};
+  utils::statistics::Storage statistics_storage_;
+  dynamic_config::StorageMock config_storage_{{dump::kConfigSet, {}}};
+};
+
+void AppendAndWrite(AppendOnlyEntity& entity, dump::Dumper& dumper,
+                    int value) {
+  utils::datetime::MockSleep(1s);
+  entity.Append(Now(), value);
+  dumper.OnUpdateCompleted(Now(), dump::UpdateType::kModified);
+  dumper.WriteDumpSyncDebug();
+}
+
+}  // namespace
+
+UTEST_F(DumperDeltas, WriteAndRead) {
+  utils::datetime::MockNowSet({});
+  {
+    AppendOnlyEntity entity;
+    auto dumper = MakeDumper(entity);
+    dumper.ReadDump();
+
+    const auto update = [&](int value) {
+      AppendAndWrite(entity, dumper, value);
+    };
+
+    // full dump, 2 deltas, full dump (compaction), 1 delta
+    for (int i = 1; i <= 5; ++i) update(i);
+    EXPECT_EQ(entity.delta_write_count, 3);
+    EXPECT_EQ(Filenames().size(), 5);
+    EXPECT_EQ(CountDeltas(Filenames()), 3);
+
+    // The deltas are removed together with the excessive full dump
+    update(6);
+    update(7);
+    EXPECT_EQ(Filenames().size(), 4);
+    EXPECT_EQ(CountDeltas(Filenames()), 2);
+
+    update(8);
+    EXPECT_EQ(entity.delta_write_count, 5);
+
+    // The deltas are renamed together with the full dump
+    utils::datetime::MockSleep(1s);
+    dumper.OnUpdateCompleted(Now(), dump::UpdateType::kAlreadyUpToDate);
+    dumper.WriteDumpSyncDebug();
+    EXPECT_EQ(Filenames().size(), 5);
+    EXPECT_EQ(CountDeltas(Filenames()), 3);
+  }
+
+  AppendOnlyEntity entity;
+  auto dumper = MakeDumper(entity);
+  EXPECT_EQ(dumper.ReadDump(), Now());
+  EXPECT_EQ(entity.values, (std::vector<int>{1, 2, 3, 4, 5, 6, 7, 8}));
+}
+
+UTEST_F(DumperDeltas, UnsupportedDeltasAreRemoved) {
+  utils::datetime::MockNowSet({});
+  dump::TimePoint full_dump_time;
+  {
+    AppendOnlyEntity entity;
+    auto dumper = MakeDumper(entity);
+    dumper.ReadDump();
+
+    // full dump, 2 deltas
+    AppendAndWrite(entity, dumper, 1);
+    full_dump_time = Now();
+    AppendAndWrite(entity, dumper, 2);
+    AppendAndWrite(entity, dumper, 3);
+    EXPECT_EQ(CountDeltas(Filenames()), 2);
+  }
+
+  {
+    AppendOnlyEntity entity;
+    entity.are_deltas_supported = false;
+    auto dumper = MakeDumper(entity);
+    EXPECT_EQ(dumper.ReadDump(), full_dump_time);
+    EXPECT_EQ(entity.values, std::vector<int>{1});
+    EXPECT_EQ(CountDeltas(Filenames()), 0);
+  }
+
+  // The removed deltas are not applied once they are supported again
+  AppendOnlyEntity entity;
+  auto dumper = MakeDumper(entity);
+  EXPECT_EQ(dumper.ReadDump(), full_dump_time);
+  EXPECT_EQ(entity.values, std::vector<int>{1});
+}
+
+namespace {
+
 /// [Sample Dumper usage]
 // NOLINTNEXTLINE(fuchsia-multiple-inheritance)
 class SampleComponentWithDumps final : public components::LoggableComponentBase,
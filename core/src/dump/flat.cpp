@@ -0,0 +1,64 @@
+#include <userver/dump/flat.hpp>
+
+#include <cstdint>
+#include <limits>
+
+#include <fmt/format.h>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/utils/assert.hpp>
+#include <utils/impl/byte_utils.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+namespace {
+
+// The keys are fixed, so that the checksum does not change between restarts
+constexpr std::uint64_t kChecksumKey0 = 0x0706050403020100ULL;
+constexpr std::uint64_t kChecksumKey1 = 0x0f0e0d0c0b0a0908ULL;
+
+std::uint64_t GetChecksum(std::string_view data) noexcept {
+  return utils::impl::SipHasher{kChecksumKey0, kChecksumKey1}(data);
+}
+
+}  // namespace
+
+void WriteFlatBlock(Writer& writer, std::string_view data,
+                    std::size_t element_size) {
+  UASSERT(element_size > 0 && data.size() % element_size == 0);
+  writer.Write(data.size() / element_size);
+  writer.Write(element_size);
+  writer.Write(GetChecksum(data));
+  WriteStringViewUnsafe(writer, data);
+}
+
+std::string_view ReadFlatBlock(Reader& reader, std::size_t element_size) {
+  const auto count = reader.Read<std::size_t>();
+  const auto stored_element_size = reader.Read<std::size_t>();
+  const auto checksum = reader.Read<std::uint64_t>();
+
+  if (stored_element_size != element_size) {
+    throw Error(fmt::format(
+        "Unexpected element size of a flat block in the dump: expected={}, "
+        "actual={}",
+        element_size, stored_element_size));
+  }
+  if (count > std::numeric_limits<std::size_t>::max() / element_size) {
+    throw Error(fmt::format(
+        "Too many elements in a flat block of the dump: count={}", count));
+  }
+
+  const auto data = ReadStringViewUnsafe(reader, count * element_size);
+  if (GetChecksum(data) != checksum) {
+    throw Error(fmt::format(
+        "Checksum mismatch of a flat block in the dump: size={}", data.size()));
+  }
+  return data;
+}
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,82 @@
+#include <userver/dump/flat.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/operations_mock.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct Point final {
+  std::int32_t x;
+  std::int32_t y;
+};
+
+std::string WriteFlatToString(const std::vector<Point>& points) {
+  dump::MockWriter writer;
+  dump::WriteFlat<Point>(writer, points);
+  return std::move(writer).Extract();
+}
+
+}  // namespace
+
+TEST(DumpFlat, WriteRead) {
+  const std::vector<Point> points{{1, 2}, {3, -4}, {5, 6}};
+
+  dump::MockReader reader(WriteFlatToString(points));
+  const auto result = dump::ReadFlat<Point>(reader);
+  reader.Finish();
+
+  ASSERT_EQ(result.size(), points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    EXPECT_EQ(result[i].x, points[i].x);
+    EXPECT_EQ(result[i].y, points[i].y);
+  }
+}
+
+TEST(DumpFlat, Empty) {
+  dump::MockReader reader(WriteFlatToString({}));
+  EXPECT_TRUE(dump::ReadFlat<Point>(reader).empty());
+  reader.Finish();
+}
+
+TEST(DumpFlat, View) {
+  const std::string data = "flat data";
+  dump::MockWriter writer;
+  dump::WriteFlat<char>(writer, data);
+  writer.Write(42);
+
+  dump::MockReader reader(std::move(writer).Extract());
+  const auto view = dump::ReadFlatUnsafe<char>(reader);
+  EXPECT_EQ(std::string(view.begin(), view.end()), data);
+  EXPECT_EQ(reader.Read<int>(), 42);
+  reader.Finish();
+}
+
+TEST(DumpFlat, Corrupted) {
+  auto data = WriteFlatToString({{1, 2}, {3, 4}});
+  data.back() ^= 1;
+
+  dump::MockReader reader(std::move(data));
+  EXPECT_THROW(dump::ReadFlat<Point>(reader), dump::Error);
+}
+
+TEST(DumpFlat, ElementSizeMismatch) {
+  dump::MockReader reader(WriteFlatToString({{1, 2}}));
+  EXPECT_THROW(dump::ReadFlat<std::int32_t>(reader), dump::Error);
+}
+
+TEST(DumpFlat, Truncated) {
+  auto data = WriteFlatToString({{1, 2}, {3, 4}});
+  data.pop_back();
+
+  dump::MockReader reader(std::move(data));
+  EXPECT_THROW(dump::ReadFlat<Point>(reader), dump::Error);
+}
+
+USERVER_NAMESPACE_END
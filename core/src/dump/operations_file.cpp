@@ -1,12 +1,17 @@
 #include <userver/dump/operations_file.hpp>
 
+#include <sys/mman.h>
+
 #include <algorithm>
 #include <stdexcept>
 #include <utility>
 
 #include <fmt/format.h>
 
+#include <userver/fs/blocking/file_descriptor.hpp>
 #include <userver/fs/blocking/write.hpp>
+#include <userver/utils/assert.hpp>
+#include <utils/check_syscall.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -116,11 +121,56 @@ void FileReader::Finish() {
   }
 }
 
-FileOperationsFactory::FileOperationsFactory(boost::filesystem::perms perms)
-    : perms_(perms) {}
+MmapFileReader::MmapFileReader(std::string path) : path_(std::move(path)) {
+  try {
+    // the mapping stays valid after the file is closed
+    const auto file = fs::blocking::FileDescriptor::Open(
+        path_, fs::blocking::OpenFlag::kRead);
+    size_ = file.GetSize();
+    if (size_ == 0) return;
+
+    void* const data = utils::CheckSyscallNotEquals(
+        ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, file.GetNative(), 0),
+        MAP_FAILED, "mmap");
+    data_ = static_cast<const char*>(data);
+  } catch (const std::exception& ex) {
+    throw Error(fmt::format(
+        "Failed to open the dump file for reading \"{}\". Reason: {}", path_,
+        ex.what()));
+  }
+
+  // The dump is read once from the beginning to the end
+  ::madvise(const_cast<char*>(data_), size_, MADV_SEQUENTIAL);
+}
+
+MmapFileReader::~MmapFileReader() {
+  if (data_) ::munmap(const_cast<char*>(data_), size_);
+}
+
+std::string_view MmapFileReader::ReadRaw(std::size_t max_size) {
+  UASSERT(position_ <= size_);
+  const auto size = std::min(max_size, size_ - position_);
+  const std::string_view result{data_ + position_, size};
+  position_ += size;
+  return result;
+}
+
+void MmapFileReader::Finish() {
+  if (position_ != size_) {
+    throw Error(
+        fmt::format("Unexpected extra data at the end of the dump file \"{}\": "
+                    "file-size={}, position={}, unread-size={}",
+                    path_, size_, position_, size_ - position_));
+  }
+}
+
+FileOperationsFactory::FileOperationsFactory(boost::filesystem::perms perms,
+                                             bool use_mmap)
+    : perms_(perms), use_mmap_(use_mmap) {}
 
 std::unique_ptr<Reader> FileOperationsFactory::CreateReader(
     std::string full_path) {
+  if (use_mmap_) return std::make_unique<MmapFileReader>(std::move(full_path));
   return std::make_unique<FileReader>(std::move(full_path));
 }
 
@@ -0,0 +1,76 @@
+#include <userver/dump/operations_file.hpp>
+
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/flat.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/tracing/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+enum class Format { kElementWise, kFlat };
+
+template <Format kFormat>
+void WriteDump(const std::string& path, std::size_t size) {
+  std::vector<std::uint64_t> values(size);
+  // large numbers, so that the compressed integers take 9 bytes
+  std::iota(values.begin(), values.end(), std::uint64_t{1} << 62);
+
+  tracing::Span span{"dump-benchmark"};
+  auto scope_time = span.CreateScopeTime("write");
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time);
+  if constexpr (kFormat == Format::kFlat) {
+    dump::WriteFlat<std::uint64_t>(writer, values);
+  } else {
+    writer.Write(values);
+  }
+  writer.Finish();
+}
+
+template <typename Reader, Format kFormat>
+void dump_read(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = dir.GetPath() + "/dump";
+    WriteDump<kFormat>(path, state.range(0));
+
+    for ([[maybe_unused]] auto _ : state) {
+      Reader reader(path);
+      if constexpr (kFormat == Format::kFlat) {
+        benchmark::DoNotOptimize(dump::ReadFlat<std::uint64_t>(reader));
+      } else {
+        benchmark::DoNotOptimize(
+            reader.template Read<std::vector<std::uint64_t>>());
+      }
+      reader.Finish();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  });
+}
+
+}  // namespace
+
+BENCHMARK(dump_read<dump::FileReader, Format::kElementWise>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 22);
+BENCHMARK(dump_read<dump::MmapFileReader, Format::kElementWise>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 22);
+BENCHMARK(dump_read<dump::FileReader, Format::kFlat>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 22);
+BENCHMARK(dump_read<dump::MmapFileReader, Format::kFlat>)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 22);
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,9 @@
 #include <userver/dump/operations_file.hpp>
 
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <boost/regex.hpp>
 
 #include <userver/dump/unsafe.hpp>
@@ -113,4 +117,63 @@ TEST(DumpOperationsFile, Underread) {
   FAIL();
 }
 
+UTEST(DumpOperationsFile, MmapReadRaw) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  const auto path = DumpFilePath(dir);
+
+  constexpr std::size_t kMaxLength = 10;
+  std::size_t total_length = 0;
+
+  auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+  dump::FileWriter writer(path, boost::filesystem::perms::owner_read,
+                          scope_time);
+  for (std::size_t i = 0; i <= kMaxLength; ++i) {
+    WriteStringViewUnsafe(writer, std::string(i, static_cast<char>('a' + i)));
+    total_length += i;
+  }
+  writer.Finish();
+
+  dump::MmapFileReader reader(path);
+  std::vector<std::string_view> views;
+  for (std::size_t i = 0; i <= kMaxLength; ++i) {
+    views.push_back(ReadStringViewUnsafe(reader, i));
+  }
+  reader.Finish();
+
+  // the memory stays valid until the reader is destroyed
+  for (std::size_t i = 0; i <= kMaxLength; ++i) {
+    EXPECT_EQ(views[i], std::string(i, static_cast<char>('a' + i)));
+  }
+}
+
+TEST(DumpOperationsFile, MmapEmptyDump) {
+  const auto file = fs::blocking::TempFile::Create();
+
+  dump::MmapFileReader reader(file.GetPath());
+  EXPECT_EQ(ReadUnsafeAtMost(reader, 1), "");
+  reader.Finish();
+}
+
+TEST(DumpOperationsFile, MmapOverread) {
+  const auto file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(file.GetPath(), std::string(10, 'a'));
+
+  dump::MmapFileReader reader(file.GetPath());
+  EXPECT_THROW(ReadStringViewUnsafe(reader, 11), dump::Error);
+}
+
+TEST(DumpOperationsFile, MmapUnderread) {
+  const auto file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(file.GetPath(), std::string(10, 'a'));
+
+  dump::MmapFileReader reader(file.GetPath());
+  EXPECT_EQ(ReadStringViewUnsafe(reader, 9), std::string(9, 'a'));
+  EXPECT_THROW(reader.Finish(), dump::Error);
+}
+
+TEST(DumpOperationsFile, MmapMissingFile) {
+  const auto dir = fs::blocking::TempDirectory::Create();
+  EXPECT_THROW(dump::MmapFileReader{DumpFilePath(dir)}, dump::Error);
+}
+
 USERVER_NAMESPACE_END
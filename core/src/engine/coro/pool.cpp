@@ -0,0 +1,22 @@
+#include <engine/coro/pool.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::coro {
+
+namespace {
+
+// Only accessed outside of coroutines, so a plain thread_local is fine.
+thread_local std::size_t local_numa_node = 0;
+
+}  // namespace
+
+void SetLocalNumaNode(std::size_t numa_node) noexcept {
+  local_numa_node = numa_node;
+}
+
+std::size_t GetLocalNumaNode() noexcept { return local_numa_node; }
+
+}  // namespace engine::coro
+
+USERVER_NAMESPACE_END
@@ -11,6 +11,7 @@
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
 
 #include "pool_config.hpp"
 #include "pool_stats.hpp"
@@ -19,6 +20,13 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::coro {
 
+/// Sets the NUMA node of the current thread for the purposes of choosing
+/// the working set of coroutines. Must be called before the thread first
+/// interacts with a Pool.
+void SetLocalNumaNode(std::size_t numa_node) noexcept;
+
+std::size_t GetLocalNumaNode() noexcept;
+
 template <typename Task>
 class Pool final {
  public:
@@ -35,6 +43,9 @@ class Pool final {
   PoolStats GetStats() const;
   std::size_t GetStackSize() const;
 
+  std::size_t GetNumaNodesCount() const noexcept;
+  std::size_t GetIdleCoroutinesApprox(std::size_t numa_node) const;
+
  private:
   Coroutine CreateCoroutine(bool quiet = false);
   void OnCoroutineDestruction() noexcept;
@@ -42,6 +53,8 @@ class Pool final {
   template <typename Token>
   Token& GetUsedPoolToken();
 
+  std::size_t GetLocalUsedPoolIndex() const noexcept;
+
   const PoolConfig config_;
   const Executor executor_;
 
@@ -53,8 +66,11 @@ class Pool final {
   //
   // The same could've been achieved with some LIFO container, but apparently
   // we don't have a container handy enough to not just use 2 queues.
+  //
+  // The 'working set' is split by NUMA nodes, see PoolConfig::numa_nodes.
+  // A coroutine is always returned to the node it was first taken on.
   moodycamel::ConcurrentQueue<Coroutine> initial_coroutines_;
-  moodycamel::ConcurrentQueue<Coroutine> used_coroutines_;
+  utils::FixedArray<moodycamel::ConcurrentQueue<Coroutine>> used_coroutines_;
 
   std::atomic<std::size_t> idle_coroutines_num_;
   std::atomic<std::size_t> total_coroutines_num_;
@@ -63,8 +79,9 @@ class Pool final {
 template <typename Task>
 class Pool<Task>::CoroutinePtr final {
  public:
-  CoroutinePtr(Coroutine&& coro, Pool<Task>& pool) noexcept
-      : coro_(std::move(coro)), pool_(&pool) {}
+  CoroutinePtr(Coroutine&& coro, Pool<Task>& pool,
+               std::size_t numa_node) noexcept
+      : coro_(std::move(coro)), pool_(&pool), numa_node_(numa_node) {}
 
   CoroutinePtr(CoroutinePtr&&) noexcept = default;
   CoroutinePtr& operator=(CoroutinePtr&&) noexcept = default;
@@ -84,9 +101,13 @@ class Pool<Task>::CoroutinePtr final {
     pool_->PutCoroutine(std::move(*this));
   }
 
+  // The NUMA node of the 'working set' the coroutine belongs to
+  std::size_t GetNumaNode() const noexcept { return numa_node_; }
+
  private:
   Coroutine coro_;
   Pool<Task>* pool_;
+  std::size_t numa_node_;
 };
 
 template <typename Task>
@@ -95,7 +116,10 @@ Pool<Task>::Pool(PoolConfig config, Executor executor)
       executor_(executor),
       stack_allocator_(config_.stack_size),
       initial_coroutines_(config_.initial_size),
-      used_coroutines_(config_.max_size),
+      // The nodes share the max_size limit, do not preallocate it for each
+      used_coroutines_(
+          std::max<std::size_t>(config_.numa_nodes, 1),
+          config_.max_size / std::max<std::size_t>(config_.numa_nodes, 1)),
       idle_coroutines_num_(config_.initial_size),
       total_coroutines_num_(0) {
   moodycamel::ProducerToken token(initial_coroutines_);
@@ -122,36 +146,61 @@ typename Pool<Task>::CoroutinePtr Pool<Task>::GetCoroutine() {
 
   std::optional<Coroutine> coroutine;
   CoroutineMover mover{coroutine};
+  const auto local_numa_node = GetLocalUsedPoolIndex();
 
   // First try to dequeue from 'working set': if we can get a coroutine
   // from there we are happy, because we saved on minor-page-faulting (thus
   // increasing resident memory usage) a not-yet-de-virtualized coroutine stack.
-  if (used_coroutines_.try_dequeue(
+  if (used_coroutines_[local_numa_node].try_dequeue(
           GetUsedPoolToken<moodycamel::ConsumerToken>(), mover) ||
       initial_coroutines_.try_dequeue(mover)) {
     --idle_coroutines_num_;
-  } else {
-    coroutine.emplace(CreateCoroutine());
+    return CoroutinePtr(std::move(*coroutine), *this, local_numa_node);
   }
-  return CoroutinePtr(std::move(*coroutine), *this);
+
+  // A stack from a remote NUMA node is still cheaper than a new mmap. It goes
+  // back to its node afterwards.
+  for (std::size_t numa_node = 0; numa_node < used_coroutines_.size();
+       ++numa_node) {
+    if (numa_node == local_numa_node) continue;
+    if (used_coroutines_[numa_node].try_dequeue(mover)) {
+      --idle_coroutines_num_;
+      return CoroutinePtr(std::move(*coroutine), *this, numa_node);
+    }
+  }
+
+  coroutine.emplace(CreateCoroutine());
+  return CoroutinePtr(std::move(*coroutine), *this, local_numa_node);
 }
 
 template <typename Task>
 void Pool<Task>::PutCoroutine(CoroutinePtr&& coroutine_ptr) {
   if (idle_coroutines_num_.load() >= config_.max_size) return;
-  auto& token = GetUsedPoolToken<moodycamel::ProducerToken>();
+  const auto numa_node = coroutine_ptr.GetNumaNode();
+  UASSERT(numa_node < used_coroutines_.size());
+  // We only ever return coroutines into the 'working set' of their node.
+  // The thread local token is bound to the queue of the local node.
   const bool ok =
-      // We only ever return coroutines into our 'working set'.
-      used_coroutines_.enqueue(token, std::move(coroutine_ptr.Get()));
+      numa_node == GetLocalUsedPoolIndex()
+          ? used_coroutines_[numa_node].enqueue(
+                GetUsedPoolToken<moodycamel::ProducerToken>(),
+                std::move(coroutine_ptr.Get()))
+          : used_coroutines_[numa_node].enqueue(
+                std::move(coroutine_ptr.Get()));
   if (ok) ++idle_coroutines_num_;
 }
 
 template <typename Task>
 PoolStats Pool<Task>::GetStats() const {
+  std::size_t used_coroutines_size = 0;
+  for (const auto& used_coroutines : used_coroutines_) {
+    used_coroutines_size += used_coroutines.size_approx();
+  }
+
   PoolStats stats;
   stats.active_coroutines =
       total_coroutines_num_.load() -
-      (used_coroutines_.size_approx() + initial_coroutines_.size_approx());
+      (used_coroutines_size + initial_coroutines_.size_approx());
   stats.total_coroutines =
       std::max(total_coroutines_num_.load(), stats.active_coroutines);
   return stats;
@@ -194,13 +243,29 @@ std::size_t Pool<Task>::GetStackSize() const {
   return config_.stack_size;
 }
 
+template <typename Task>
+std::size_t Pool<Task>::GetNumaNodesCount() const noexcept {
+  return used_coroutines_.size();
+}
+
+template <typename Task>
+std::size_t Pool<Task>::GetIdleCoroutinesApprox(std::size_t numa_node) const {
+  UASSERT(numa_node < used_coroutines_.size());
+  return used_coroutines_[numa_node].size_approx();
+}
+
 template <typename Task>
 template <typename Token>
 Token& Pool<Task>::GetUsedPoolToken() {
-  thread_local Token token(used_coroutines_);
+  thread_local Token token(used_coroutines_[GetLocalUsedPoolIndex()]);
   return token;
 }
 
+template <typename Task>
+std::size_t Pool<Task>::GetLocalUsedPoolIndex() const noexcept {
+  return GetLocalNumaNode() % used_coroutines_.size();
+}
+
 }  // namespace engine::coro
 
 USERVER_NAMESPACE_END
@@ -13,6 +13,11 @@ struct PoolConfig {
   std::size_t initial_size = 1000;
   std::size_t max_size = 4000;
   std::size_t stack_size = 256 * 1024ULL;
+
+  // Not a part of the static config, derived from the task processors configs.
+  // Idle coroutines are kept per NUMA node, so that the stacks first-touched
+  // by the workers of a node are reused on that node.
+  std::size_t numa_nodes = 1;
 };
 
 PoolConfig Parse(const yaml_config::YamlConfig& value,
@@ -0,0 +1,77 @@
+#include <engine/coro/pool.hpp>
+
+#include <thread>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct DummyTask {};
+
+using DummyPool = engine::coro::Pool<DummyTask>;
+
+void DummyExecutor(DummyPool::TaskPipe& pipe) {
+  for ([[maybe_unused]] auto* task : pipe) {
+  }
+}
+
+engine::coro::PoolConfig MakeNumaPoolConfig() {
+  engine::coro::PoolConfig config;
+  config.initial_size = 0;
+  config.max_size = 8;
+  config.stack_size = 64 * 1024ULL;
+  config.numa_nodes = 2;
+  return config;
+}
+
+template <typename Func>
+void RunOnNumaNode(std::size_t numa_node, Func func) {
+  // A thread uses the working set of a single node over its lifetime
+  std::thread thread{[numa_node, &func] {
+    engine::coro::SetLocalNumaNode(numa_node);
+    func();
+  }};
+  thread.join();
+}
+
+}  // namespace
+
+TEST(CoroPool, ReturnsCoroutinesToTheirNumaNode) {
+  DummyPool pool{MakeNumaPoolConfig(), &DummyExecutor};
+  ASSERT_EQ(pool.GetNumaNodesCount(), 2);
+
+  RunOnNumaNode(1, [&pool] {
+    auto coroutine = pool.GetCoroutine();
+    EXPECT_EQ(coroutine.GetNumaNode(), 1);
+    std::move(coroutine).ReturnToPool();
+  });
+  EXPECT_EQ(pool.GetIdleCoroutinesApprox(0), 0);
+  EXPECT_EQ(pool.GetIdleCoroutinesApprox(1), 1);
+
+  RunOnNumaNode(0, [&pool] {
+    // Taken from the remote node instead of creating a new one
+    auto coroutine = pool.GetCoroutine();
+    EXPECT_EQ(coroutine.GetNumaNode(), 1);
+    EXPECT_EQ(pool.GetIdleCoroutinesApprox(1), 0);
+    std::move(coroutine).ReturnToPool();
+  });
+  EXPECT_EQ(pool.GetIdleCoroutinesApprox(0), 0);
+  EXPECT_EQ(pool.GetIdleCoroutinesApprox(1), 1);
+  EXPECT_EQ(pool.GetStats().total_coroutines, 1);
+}
+
+TEST(CoroPool, NewCoroutinesBelongToLocalNumaNode) {
+  DummyPool pool{MakeNumaPoolConfig(), &DummyExecutor};
+
+  RunOnNumaNode(0, [&pool] {
+    auto coroutine = pool.GetCoroutine();
+    EXPECT_EQ(coroutine.GetNumaNode(), 0);
+    std::move(coroutine).ReturnToPool();
+  });
+  EXPECT_EQ(pool.GetIdleCoroutinesApprox(0), 1);
+  EXPECT_EQ(pool.GetIdleCoroutinesApprox(1), 0);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,452 @@
+#include <engine/ev/io_uring.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+#include <vector>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define USERVER_IMPL_IO_URING_SUPPORTED
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+#ifdef USERVER_IMPL_IO_URING_SUPPORTED
+
+namespace {
+
+// IORING_FEAT_NODROP: completions are never lost on CQ overflow.
+constexpr unsigned kRequiredFeatures =
+    IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP;
+
+constexpr std::size_t kMaxRegisteredBuffers = 64;
+
+std::uint8_t ToOpcode(IoUringOp op) {
+  switch (op) {
+    case IoUringOp::kNop:
+      return IORING_OP_NOP;
+    case IoUringOp::kRead:
+      return IORING_OP_READ;
+    case IoUringOp::kReadFixed:
+      return IORING_OP_READ_FIXED;
+    case IoUringOp::kWrite:
+      return IORING_OP_WRITE;
+    case IoUringOp::kOpenAt:
+      return IORING_OP_OPENAT;
+    case IoUringOp::kAsyncCancel:
+      return IORING_OP_ASYNC_CANCEL;
+  }
+  UINVARIANT(false, "Unexpected IoUringOp");
+}
+
+constexpr IoUringOp kAllOps[] = {
+    IoUringOp::kNop,   IoUringOp::kRead,   IoUringOp::kReadFixed,
+    IoUringOp::kWrite, IoUringOp::kOpenAt, IoUringOp::kAsyncCancel,
+};
+
+int SysIoUringSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+int SysIoUringEnter(int fd, unsigned to_submit, unsigned min_complete,
+                    unsigned flags) {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit,
+                                    min_complete, flags, nullptr, 0));
+}
+
+int SysIoUringRegister(int fd, unsigned opcode, const void* arg,
+                       unsigned nr_args) {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+void* MapRing(int ring_fd, std::size_t size, std::uint64_t offset) {
+  return utils::CheckSyscallNotEquals(
+      ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+             ring_fd, static_cast<off_t>(offset)),
+      MAP_FAILED, "mapping io_uring, offset={}", offset);
+}
+
+template <typename T>
+T* RingField(void* ring, std::uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+}  // namespace
+
+struct IoUring::Impl final {
+  Impl() = default;
+  Impl(Impl&&) = delete;
+  Impl& operator=(Impl&&) = delete;
+
+  ~Impl() {
+    if (buffers != MAP_FAILED) ::munmap(buffers, buffers_size);
+    if (sqes != MAP_FAILED) ::munmap(sqes, sqes_size);
+    if (ring != MAP_FAILED) ::munmap(ring, ring_size);
+    if (event_fd != -1) ::close(event_fd);
+    if (ring_fd != -1) ::close(ring_fd);
+  }
+
+  void Setup(const IoUringConfig& config);
+  void CheckSupportedOps();
+  void RegisterBuffers(const IoUringConfig& config);
+
+  int ring_fd{-1};
+  int event_fd{-1};
+
+  void* ring{MAP_FAILED};
+  std::size_t ring_size{0};
+  void* sqes{MAP_FAILED};
+  std::size_t sqes_size{0};
+
+  unsigned* sq_head{nullptr};
+  unsigned* sq_tail{nullptr};
+  unsigned* sq_flags{nullptr};
+  unsigned* sq_array{nullptr};
+  unsigned sq_mask{0};
+  unsigned sq_entries{0};
+  // Tail of the prepared entries, not yet visible to the kernel
+  unsigned sq_local_tail{0};
+
+  unsigned* cq_head{nullptr};
+  unsigned* cq_tail{nullptr};
+  io_uring_cqe* cqes{nullptr};
+  unsigned cq_mask{0};
+
+  void* buffers{MAP_FAILED};
+  std::size_t buffers_size{0};
+  std::size_t buffer_size{0};
+  std::atomic<std::uint64_t> free_buffers{0};
+};
+
+void IoUring::Impl::Setup(const IoUringConfig& config) {
+  io_uring_params params{};
+  ring_fd = utils::CheckSyscall(
+      SysIoUringSetup(static_cast<unsigned>(config.queue_depth), &params),
+      "setting up io_uring, entries={}", config.queue_depth);
+  if ((params.features & kRequiredFeatures) != kRequiredFeatures) {
+    throw std::runtime_error(
+        fmt::format("kernel io_uring lacks required features, features={:#x}",
+                    params.features));
+  }
+
+  // With IORING_FEAT_SINGLE_MMAP both rings share a single mapping
+  ring_size = std::max(
+      params.sq_off.array + params.sq_entries * sizeof(unsigned),
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+  ring = MapRing(ring_fd, ring_size, IORING_OFF_SQ_RING);
+  sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+  sqes = MapRing(ring_fd, sqes_size, IORING_OFF_SQES);
+
+  sq_head = RingField<unsigned>(ring, params.sq_off.head);
+  sq_tail = RingField<unsigned>(ring, params.sq_off.tail);
+  sq_flags = RingField<unsigned>(ring, params.sq_off.flags);
+  sq_array = RingField<unsigned>(ring, params.sq_off.array);
+  sq_mask = *RingField<unsigned>(ring, params.sq_off.ring_mask);
+  sq_entries = *RingField<unsigned>(ring, params.sq_off.ring_entries);
+  sq_local_tail = *sq_tail;
+
+  cq_head = RingField<unsigned>(ring, params.cq_off.head);
+  cq_tail = RingField<unsigned>(ring, params.cq_off.tail);
+  cqes = RingField<io_uring_cqe>(ring, params.cq_off.cqes);
+  cq_mask = *RingField<unsigned>(ring, params.cq_off.ring_mask);
+
+  event_fd = utils::CheckSyscall(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC),
+                                 "creating eventfd for io_uring");
+  utils::CheckSyscall(
+      SysIoUringRegister(ring_fd, IORING_REGISTER_EVENTFD, &event_fd, 1),
+      "registering eventfd in io_uring");
+}
+
+void IoUring::Impl::CheckSupportedOps() {
+  constexpr std::size_t kProbeOps = 256;
+  std::vector<char> probe_storage(sizeof(io_uring_probe) +
+                                  kProbeOps * sizeof(io_uring_probe_op));
+  auto* probe = reinterpret_cast<io_uring_probe*>(probe_storage.data());
+  utils::CheckSyscall(
+      SysIoUringRegister(ring_fd, IORING_REGISTER_PROBE, probe, kProbeOps),
+      "probing io_uring operations");
+
+  for (const auto op : kAllOps) {
+    const auto opcode = ToOpcode(op);
+    if (opcode > probe->last_op ||
+        !(probe->ops[opcode].flags & IO_URING_OP_SUPPORTED)) {
+      throw std::runtime_error(fmt::format(
+          "kernel io_uring does not support operation {}", opcode));
+    }
+  }
+}
+
+void IoUring::Impl::RegisterBuffers(const IoUringConfig& config) {
+  if (config.registered_buffers == 0) return;
+  UINVARIANT(config.registered_buffers <= kMaxRegisteredBuffers,
+             "Too many io_uring registered buffers");
+  UINVARIANT(config.registered_buffer_size > 0,
+             "io_uring registered buffers must not be empty");
+
+  const auto size = config.registered_buffers * config.registered_buffer_size;
+  buffers = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (buffers == MAP_FAILED) {
+    LOG_WARNING() << "Failed to allocate io_uring registered buffers: "
+                  << std::error_code(errno, std::system_category()).message();
+    return;
+  }
+  buffers_size = size;
+
+  std::vector<iovec> iovecs(config.registered_buffers);
+  for (std::size_t i = 0; i < iovecs.size(); ++i) {
+    iovecs[i].iov_base =
+        static_cast<char*>(buffers) + i * config.registered_buffer_size;
+    iovecs[i].iov_len = config.registered_buffer_size;
+  }
+
+  // Pinned pages are accounted against RLIMIT_MEMLOCK, registration may fail
+  // in a restricted environment. The ring is usable without the buffers.
+  if (SysIoUringRegister(ring_fd, IORING_REGISTER_BUFFERS, iovecs.data(),
+                         static_cast<unsigned>(iovecs.size())) == -1) {
+    LOG_WARNING() << "Failed to register io_uring buffers, registered file "
+                     "reads are disabled: "
+                  << std::error_code(errno, std::system_category()).message();
+    return;
+  }
+
+  buffer_size = config.registered_buffer_size;
+  free_buffers = (config.registered_buffers == kMaxRegisteredBuffers)
+                     ? ~std::uint64_t{0}
+                     : (std::uint64_t{1} << config.registered_buffers) - 1;
+}
+
+std::unique_ptr<IoUring> IoUring::TryCreate(const IoUringConfig& config) {
+  if (!config.enabled) return nullptr;
+
+  auto impl = std::make_unique<Impl>();
+  try {
+    impl->Setup(config);
+    impl->CheckSupportedOps();
+  } catch (const std::exception& ex) {
+    LOG_WARNING() << "io_uring is not available, falling back to readiness "
+                     "notifications: "
+                  << ex;
+    return nullptr;
+  }
+  impl->RegisterBuffers(config);
+
+  return std::unique_ptr<IoUring>(new IoUring(std::move(impl)));
+}
+
+int IoUring::GetEventFd() const noexcept { return impl_->event_fd; }
+
+void IoUring::ClearEventFd() noexcept {
+  std::uint64_t counter = 0;
+  [[maybe_unused]] const auto res =
+      ::read(impl_->event_fd, &counter, sizeof(counter));
+}
+
+bool IoUring::TryPrepare(const IoUringSqe& sqe) noexcept {
+  auto& impl = *impl_;
+  const auto head = __atomic_load_n(impl.sq_head, __ATOMIC_ACQUIRE);
+  if (impl.sq_local_tail - head >= impl.sq_entries) return false;
+
+  const auto index = impl.sq_local_tail & impl.sq_mask;
+  auto& entry = static_cast<io_uring_sqe*>(impl.sqes)[index];
+  std::memset(&entry, 0, sizeof(entry));
+  entry.opcode = ToOpcode(sqe.op);
+  entry.fd = sqe.fd;
+  entry.addr = sqe.addr;
+  entry.len = sqe.len;
+  entry.off = sqe.offset;
+  // rw_flags and open_flags share a union
+  entry.rw_flags = sqe.op_flags;
+  entry.buf_index = sqe.buf_index;
+  entry.user_data = sqe.user_data;
+
+  impl.sq_array[index] = index;
+  ++impl.sq_local_tail;
+  return true;
+}
+
+std::size_t IoUring::Submit() {
+  auto& impl = *impl_;
+  // Entries published before a failed io_uring_enter are still in the ring
+  const auto pending = impl.sq_local_tail -
+                       __atomic_load_n(impl.sq_head, __ATOMIC_ACQUIRE);
+  if (pending == 0) return 0;
+
+  __atomic_store_n(impl.sq_tail, impl.sq_local_tail, __ATOMIC_RELEASE);
+  while (true) {
+    int error = TakeInjectedSubmitError();
+    if (!error) {
+      const auto res = SysIoUringEnter(impl.ring_fd, pending, 0, 0);
+      if (res != -1) return static_cast<std::size_t>(res);
+      error = errno;
+    }
+
+    if (error == EINTR) continue;
+    if (error == EAGAIN || error == EBUSY) return 0;
+    throw std::system_error(error, std::system_category(),
+                            fmt::format("Error while submitting {} io_uring "
+                                        "entries",
+                                        pending));
+  }
+}
+
+std::size_t IoUring::GetUnsubmittedCount() const noexcept {
+  const auto& impl = *impl_;
+  return impl.sq_local_tail - __atomic_load_n(impl.sq_head, __ATOMIC_ACQUIRE);
+}
+
+std::size_t IoUring::DropUnsubmitted(
+    utils::function_ref<void(std::uint64_t)> func) noexcept {
+  auto& impl = *impl_;
+  // Without SQPOLL the kernel consumes entries only within io_uring_enter,
+  // so the tail may be moved back between the calls
+  const auto head = __atomic_load_n(impl.sq_head, __ATOMIC_ACQUIRE);
+  for (auto position = head; position != impl.sq_local_tail; ++position) {
+    const auto index = impl.sq_array[position & impl.sq_mask];
+    func(static_cast<io_uring_sqe*>(impl.sqes)[index].user_data);
+  }
+  const std::size_t dropped = impl.sq_local_tail - head;
+  impl.sq_local_tail = head;
+  __atomic_store_n(impl.sq_tail, head, __ATOMIC_RELEASE);
+  return dropped;
+}
+
+std::size_t IoUring::Reap(
+    utils::function_ref<void(std::uint64_t, int)> func) {
+  auto& impl = *impl_;
+  std::size_t reaped = 0;
+  while (true) {
+    auto head = *impl.cq_head;
+    const auto tail = __atomic_load_n(impl.cq_tail, __ATOMIC_ACQUIRE);
+    for (; head != tail; ++head, ++reaped) {
+      const auto& cqe = impl.cqes[head & impl.cq_mask];
+      func(cqe.user_data, cqe.res);
+    }
+    __atomic_store_n(impl.cq_head, head, __ATOMIC_RELEASE);
+
+    // The kernel keeps completions that did not fit into the CQ aside until
+    // they are explicitly flushed
+    if (!(__atomic_load_n(impl.sq_flags, __ATOMIC_ACQUIRE) &
+          IORING_SQ_CQ_OVERFLOW)) {
+      return reaped;
+    }
+    SysIoUringEnter(impl.ring_fd, 0, 0, IORING_ENTER_GETEVENTS);
+  }
+}
+
+std::size_t IoUring::GetRegisteredBufferSize() const noexcept {
+  return impl_->buffer_size;
+}
+
+std::optional<std::uint16_t> IoUring::TryAcquireRegisteredBuffer() noexcept {
+  auto& free_buffers = impl_->free_buffers;
+  auto free = free_buffers.load(std::memory_order_relaxed);
+  while (free != 0) {
+    const auto index = __builtin_ctzll(free);
+    if (free_buffers.compare_exchange_weak(
+            free, free & ~(std::uint64_t{1} << index),
+            std::memory_order_acquire, std::memory_order_relaxed)) {
+      return static_cast<std::uint16_t>(index);
+    }
+  }
+  return std::nullopt;
+}
+
+void IoUring::ReleaseRegisteredBuffer(std::uint16_t index) noexcept {
+  UASSERT(index < kMaxRegisteredBuffers);
+  UASSERT(!(impl_->free_buffers.load() & (std::uint64_t{1} << index)));
+  impl_->free_buffers.fetch_or(std::uint64_t{1} << index,
+                               std::memory_order_release);
+}
+
+char* IoUring::GetRegisteredBuffer(std::uint16_t index) const noexcept {
+  UASSERT(impl_->buffer_size != 0);
+  return static_cast<char*>(impl_->buffers) + index * impl_->buffer_size;
+}
+
+#else  // USERVER_IMPL_IO_URING_SUPPORTED
+
+struct IoUring::Impl final {};
+
+std::unique_ptr<IoUring> IoUring::TryCreate(const IoUringConfig& config) {
+  if (config.enabled) {
+    LOG_WARNING() << "io_uring is not supported on this platform, falling "
+                     "back to readiness notifications";
+  }
+  return nullptr;
+}
+
+int IoUring::GetEventFd() const noexcept { return -1; }
+
+void IoUring::ClearEventFd() noexcept {}
+
+bool IoUring::TryPrepare(const IoUringSqe&) noexcept { return false; }
+
+std::size_t IoUring::Submit() { return 0; }
+
+std::size_t IoUring::GetUnsubmittedCount() const noexcept { return 0; }
+
+std::size_t IoUring::DropUnsubmitted(
+    utils::function_ref<void(std::uint64_t)>) noexcept {
+  return 0;
+}
+
+std::size_t IoUring::Reap(utils::function_ref<void(std::uint64_t, int)>) {
+  return 0;
+}
+
+std::size_t IoUring::GetRegisteredBufferSize() const noexcept { return 0; }
+
+std::optional<std::uint16_t> IoUring::TryAcquireRegisteredBuffer() noexcept {
+  return std::nullopt;
+}
+
+void IoUring::ReleaseRegisteredBuffer(std::uint16_t) noexcept {}
+
+char* IoUring::GetRegisteredBuffer(std::uint16_t) const noexcept {
+  return nullptr;
+}
+
+#endif  // USERVER_IMPL_IO_URING_SUPPORTED
+
+IoUring::IoUring(std::unique_ptr<Impl>&& impl) noexcept
+    : impl_(std::move(impl)) {}
+
+void IoUring::InjectSubmitErrors(int error, std::size_t count) noexcept {
+  injected_submit_error_.store(error, std::memory_order_relaxed);
+  injected_submit_errors_left_.store(count, std::memory_order_release);
+}
+
+int IoUring::TakeInjectedSubmitError() noexcept {
+  auto left = injected_submit_errors_left_.load(std::memory_order_acquire);
+  while (left != 0) {
+    if (injected_submit_errors_left_.compare_exchange_weak(
+            left, left - 1, std::memory_order_acquire)) {
+      return injected_submit_error_.load(std::memory_order_relaxed);
+    }
+  }
+  return 0;
+}
+
+IoUring::~IoUring() = default;
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include <userver/utils/function_ref.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+struct IoUringConfig final {
+  bool enabled{false};
+  std::size_t queue_depth{256};
+  std::size_t registered_buffers{0};
+  std::size_t registered_buffer_size{64 * 1024};
+};
+
+/// Operations supported by IoUring, a subset of IORING_OP_*
+enum class IoUringOp : std::uint8_t {
+  kNop,
+  kRead,
+  kReadFixed,
+  kWrite,
+  kOpenAt,
+  kAsyncCancel,
+};
+
+/// Submission queue entry. Fields are interpreted as in io_uring_enter(2).
+struct IoUringSqe final {
+  IoUringOp op{IoUringOp::kNop};
+  int fd{-1};
+  // buffer, path or user_data of the request to cancel
+  std::uint64_t addr{0};
+  // buffer length or file mode for kOpenAt
+  std::uint32_t len{0};
+  // file offset, -1 for the current file position
+  std::uint64_t offset{0};
+  // rw_flags or open_flags
+  std::uint32_t op_flags{0};
+  // index of a registered buffer for kReadFixed
+  std::uint16_t buf_index{0};
+  std::uint64_t user_data{0};
+};
+
+/// @brief A thin wrapper over the io_uring kernel interface
+///
+/// liburing is not used, the ring is set up with raw syscalls. Entries are
+/// prepared one by one and submitted in a batch with a single io_uring_enter
+/// call. Completions are signalled via an eventfd.
+///
+/// Apart from registered buffers acquisition, the methods must be called from
+/// a single thread.
+class IoUring final {
+ public:
+  /// Returns nullptr and logs the reason if io_uring is not available: an old
+  /// kernel, a non-Linux system, a seccomp filter or the io_uring_disabled
+  /// sysctl.
+  static std::unique_ptr<IoUring> TryCreate(const IoUringConfig& config);
+
+  IoUring(IoUring&&) = delete;
+  IoUring& operator=(IoUring&&) = delete;
+  ~IoUring();
+
+  /// An eventfd that becomes readable when there are completions to reap
+  int GetEventFd() const noexcept;
+
+  /// Resets the eventfd counter, must be called before Reap
+  void ClearEventFd() noexcept;
+
+  /// Returns false if the submission queue is full
+  [[nodiscard]] bool TryPrepare(const IoUringSqe& sqe) noexcept;
+
+  /// Submits all the prepared entries with a single syscall
+  /// @returns the number of entries consumed by the kernel, 0 if the kernel
+  /// is temporarily out of resources (EAGAIN or EBUSY)
+  /// @throws std::system_error on unexpected io_uring_enter failure
+  std::size_t Submit();
+
+  /// Number of the prepared entries not consumed by the kernel yet
+  std::size_t GetUnsubmittedCount() const noexcept;
+
+  /// Takes the prepared entries not consumed by the kernel yet back from
+  /// the submission queue, calls `func(user_data)` for each of them
+  /// @returns the number of dropped entries
+  std::size_t DropUnsubmitted(
+      utils::function_ref<void(std::uint64_t)> func) noexcept;
+
+  /// Makes the next `count` Submit calls fail with `error` as if it was
+  /// returned by io_uring_enter. Thread-safe, for tests only.
+  void InjectSubmitErrors(int error, std::size_t count) noexcept;
+
+  /// Calls `func(user_data, result)` for every completion, `result` is
+  /// the operation result or a negative errno value
+  /// @returns the number of reaped completions
+  std::size_t Reap(utils::function_ref<void(std::uint64_t, int)> func);
+
+  std::size_t GetRegisteredBufferSize() const noexcept;
+
+  /// Thread-safe, returns std::nullopt if all the registered buffers are busy
+  std::optional<std::uint16_t> TryAcquireRegisteredBuffer() noexcept;
+
+  /// Thread-safe
+  void ReleaseRegisteredBuffer(std::uint16_t index) noexcept;
+
+  char* GetRegisteredBuffer(std::uint16_t index) const noexcept;
+
+ private:
+  struct Impl;
+
+  explicit IoUring(std::unique_ptr<Impl>&& impl) noexcept;
+
+  // Returns 0 if there is no injected error
+  int TakeInjectedSubmitError() noexcept;
+
+  std::unique_ptr<Impl> impl_;
+  std::atomic<int> injected_submit_error_{0};
+  std::atomic<std::size_t> injected_submit_errors_left_{0};
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
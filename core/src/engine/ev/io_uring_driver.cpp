@@ -0,0 +1,217 @@
+#include <engine/ev/io_uring_driver.hpp>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <system_error>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+namespace {
+
+constexpr ev_tstamp kSubmitRetryDelaySeconds = 0.001;
+constexpr std::size_t kMaxSubmitRetries = 100;
+
+constexpr std::chrono::milliseconds kCancelResubmitDelay{1};
+
+}  // namespace
+
+IoUringDriver::Request::Request(const IoUringSqe& sqe) noexcept : sqe(sqe) {
+  this->sqe.user_data = reinterpret_cast<std::uintptr_t>(this);
+}
+
+std::unique_ptr<IoUringDriver> IoUringDriver::TryCreate(
+    const IoUringConfig& config) {
+  auto ring = IoUring::TryCreate(config);
+  if (!ring) return nullptr;
+  return std::unique_ptr<IoUringDriver>(new IoUringDriver(std::move(ring)));
+}
+
+IoUringDriver::IoUringDriver(std::unique_ptr<IoUring>&& ring)
+    : ring_(std::move(ring)) {
+  UASSERT(ring_);
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+  ev_async_init(&watch_submit_, SubmitWatcher);
+  watch_submit_.data = this;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+  ev_io_init(&watch_completion_, CompletionWatcher, ring_->GetEventFd(),
+             EV_READ);
+  watch_completion_.data = this;
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+  ev_timer_init(&watch_retry_, RetryWatcher, kSubmitRetryDelaySeconds, 0.0);
+  watch_retry_.data = this;
+}
+
+IoUringDriver::~IoUringDriver() {
+  UASSERT_MSG(!loop_, "IoUringDriver must be stopped before destruction");
+}
+
+void IoUringDriver::Start(struct ev_loop* loop) noexcept {
+  UASSERT(!loop_);
+  loop_ = loop;
+  ev_async_start(loop_, &watch_submit_);
+  ev_io_start(loop_, &watch_completion_);
+}
+
+void IoUringDriver::Stop() noexcept {
+  UASSERT(loop_);
+  ev_async_stop(loop_, &watch_submit_);
+  ev_io_stop(loop_, &watch_completion_);
+  ev_timer_stop(loop_, &watch_retry_);
+  loop_ = nullptr;
+
+  UINVARIANT(!queue_.TryPop() && overflow_.empty(),
+             "Some io_uring requests were enqueued on a dead ev thread");
+}
+
+int IoUringDriver::Perform(const IoUringSqe& sqe, Deadline deadline) {
+  Request request{sqe};
+  Submit(request);
+
+  if (request.completed.WaitUntil(deadline) != FutureStatus::kReady) {
+    IoUringSqe cancel_sqe;
+    cancel_sqe.op = IoUringOp::kAsyncCancel;
+    cancel_sqe.addr = request.sqe.user_data;
+
+    // The kernel may still be writing into the caller's buffer, so the cancel
+    // is resubmitted until it reaches the kernel
+    const TaskCancellationBlocker block_cancel;
+    while (true) {
+      Request cancel{cancel_sqe};
+      Submit(cancel);
+      cancel.completed.WaitNonCancellable();
+      if (!cancel.is_dropped || request.is_dropped) break;
+      engine::SleepFor(kCancelResubmitDelay);
+    }
+    request.completed.WaitNonCancellable();
+  }
+  return request.result;
+}
+
+void IoUringDriver::Submit(Request& request) noexcept {
+  queue_.Push(request);
+  // Sends are coalesced by libev until the watcher is invoked, so all
+  // the requests enqueued in the meantime are submitted together.
+  ev_async_send(loop_, &watch_submit_);
+}
+
+void IoUringDriver::SubmitWatcher(struct ev_loop*, ev_async* w,
+                                  int) noexcept {
+  auto* driver = static_cast<IoUringDriver*>(w->data);
+  UASSERT(driver != nullptr);
+  try {
+    driver->SubmitImpl();
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to submit io_uring requests: " << ex;
+  }
+}
+
+void IoUringDriver::CompletionWatcher(struct ev_loop*, ev_io* w,
+                                      int) noexcept {
+  auto* driver = static_cast<IoUringDriver*>(w->data);
+  UASSERT(driver != nullptr);
+  try {
+    driver->ReapImpl();
+    driver->SubmitImpl();
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to process io_uring completions: " << ex;
+  }
+}
+
+void IoUringDriver::RetryWatcher(struct ev_loop*, ev_timer* w, int) noexcept {
+  auto* driver = static_cast<IoUringDriver*>(w->data);
+  UASSERT(driver != nullptr);
+  try {
+    driver->ReapImpl();
+    driver->SubmitImpl();
+  } catch (const std::exception& ex) {
+    LOG_ERROR() << "Failed to retry io_uring submission: " << ex;
+  }
+}
+
+void IoUringDriver::SubmitImpl() {
+  while (true) {
+    std::size_t prepared = 0;
+    for (; prepared < overflow_.size(); ++prepared) {
+      if (!ring_->TryPrepare(overflow_[prepared]->sqe)) break;
+    }
+    overflow_.erase(overflow_.begin(), overflow_.begin() + prepared);
+
+    while (overflow_.empty()) {
+      Request* request = queue_.TryPop();
+      if (!request) break;
+      if (!ring_->TryPrepare(request->sqe)) overflow_.push_back(request);
+    }
+
+    std::size_t submitted = 0;
+    try {
+      submitted = ring_->Submit();
+    } catch (const std::system_error& ex) {
+      LOG_ERROR() << "Failed to submit io_uring requests: " << ex;
+      FailUnsubmitted(-ex.code().value());
+      return;
+    }
+
+    if (submitted == 0 && ring_->GetUnsubmittedCount() != 0) {
+      // The kernel is out of resources, nothing may be in flight to wake us
+      // up on a completion
+      if (++submit_retries_ > kMaxSubmitRetries) {
+        LOG_ERROR() << "io_uring is out of resources for "
+                    << kMaxSubmitRetries << " submission attempts in a row";
+        FailUnsubmitted(-EAGAIN);
+      } else {
+        ScheduleSubmitRetry();
+      }
+      return;
+    }
+    submit_retries_ = 0;
+
+    // The submission queue is drained by io_uring_enter, so a batch larger
+    // than the queue is submitted in several syscalls.
+    if (overflow_.empty() && ring_->GetUnsubmittedCount() == 0) return;
+  }
+}
+
+void IoUringDriver::ScheduleSubmitRetry() noexcept {
+  if (ev_is_active(&watch_retry_)) return;
+  ev_timer_set(&watch_retry_, kSubmitRetryDelaySeconds, 0.0);
+  ev_timer_start(loop_, &watch_retry_);
+}
+
+void IoUringDriver::FailUnsubmitted(int error) noexcept {
+  const auto fail = [error](Request& request) {
+    request.result = error;
+    request.is_dropped = true;
+    // The waiter may destroy the request right after Send
+    request.completed.Send();
+  };
+
+  ring_->DropUnsubmitted([&fail](std::uint64_t user_data) {
+    fail(*reinterpret_cast<Request*>(user_data));
+  });
+  for (auto* request : overflow_) fail(*request);
+  overflow_.clear();
+  submit_retries_ = 0;
+}
+
+void IoUringDriver::ReapImpl() {
+  ring_->ClearEventFd();
+  ring_->Reap([](std::uint64_t user_data, int result) {
+    auto* request = reinterpret_cast<Request*>(user_data);
+    UASSERT(request != nullptr);
+    request->result = result;
+    // The waiter may destroy the request right after Send
+    request->completed.Send();
+  });
+}
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
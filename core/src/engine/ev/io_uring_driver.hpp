@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <ev.h>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/single_use_event.hpp>
+
+#include <concurrent/impl/intrusive_hooks.hpp>
+#include <concurrent/impl/intrusive_mpsc_queue.hpp>
+#include <engine/ev/io_uring.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::ev {
+
+/// @brief Drives an IoUring from an ev thread
+///
+/// Coroutines enqueue requests from any thread, the ev thread moves all the
+/// queued requests into the submission queue and submits them with a single
+/// syscall. Completions are reaped on the ev thread when the ring eventfd
+/// becomes readable.
+///
+/// If the kernel is temporarily out of resources, the submission is retried
+/// on a timer, and the requests fail with -EAGAIN after too many retries.
+/// On other submission errors the requests that have not reached the kernel
+/// fail with the error right away.
+class IoUringDriver final {
+ public:
+  /// Returns nullptr if io_uring is disabled or not available
+  static std::unique_ptr<IoUringDriver> TryCreate(const IoUringConfig& config);
+
+  IoUringDriver(IoUringDriver&&) = delete;
+  IoUringDriver& operator=(IoUringDriver&&) = delete;
+  ~IoUringDriver();
+
+  // Must be called on the ev thread or before the ev thread starts
+  void Start(struct ev_loop* loop) noexcept;
+  // Must be called on the ev thread or after the ev thread stops
+  void Stop() noexcept;
+
+  /// @brief Submits the operation and waits for its completion.
+  ///
+  /// If the deadline expires or the current task is cancelled,
+  /// the operation is cancelled and the completion is awaited anyway.
+  /// @returns the result of the operation or a negative errno, -ECANCELED or
+  /// -EINTR if the operation was interrupted, or the error of its submission
+  int Perform(const IoUringSqe& sqe, Deadline deadline);
+
+  /// Registered buffers management, see IoUring
+  IoUring& GetRing() noexcept { return *ring_; }
+
+ private:
+  class Request final : public concurrent::impl::SinglyLinkedBaseHook {
+   public:
+    explicit Request(const IoUringSqe& sqe) noexcept;
+
+    IoUringSqe sqe;
+    int result{0};
+    // The request has failed without reaching the kernel
+    std::atomic<bool> is_dropped{false};
+    engine::SingleUseEvent completed;
+  };
+
+  explicit IoUringDriver(std::unique_ptr<IoUring>&& ring);
+
+  void Submit(Request& request) noexcept;
+
+  static void SubmitWatcher(struct ev_loop*, ev_async* w, int) noexcept;
+  static void CompletionWatcher(struct ev_loop*, ev_io* w, int) noexcept;
+  static void RetryWatcher(struct ev_loop*, ev_timer* w, int) noexcept;
+  void SubmitImpl();
+  void ReapImpl();
+  void ScheduleSubmitRetry() noexcept;
+  void FailUnsubmitted(int error) noexcept;
+
+  std::unique_ptr<IoUring> ring_;
+  concurrent::impl::IntrusiveMpscQueue<Request> queue_;
+  // Requests that did not fit into the submission queue, ev thread only
+  std::vector<Request*> overflow_;
+  // Consecutive submissions the kernel was out of resources for, ev thread only
+  std::size_t submit_retries_{0};
+
+  struct ev_loop* loop_{nullptr};
+  ev_async watch_submit_{};
+  ev_io watch_completion_{};
+  ev_timer watch_retry_{};
+};
+
+}  // namespace engine::ev
+
+USERVER_NAMESPACE_END
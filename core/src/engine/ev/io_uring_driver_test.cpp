@@ -0,0 +1,80 @@
+#include <engine/ev/io_uring_driver.hpp>
+
+#include <cerrno>
+
+#include <gtest/gtest.h>
+
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/task_base.hpp>
+
+#include <engine/ev/thread_control.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using engine::ev::IoUringDriver;
+using engine::ev::IoUringSqe;
+
+engine::TaskProcessorPoolsConfig MakeIoUringConfig() {
+  engine::TaskProcessorPoolsConfig config;
+  config.io_uring_enabled = true;
+  return config;
+}
+
+IoUringDriver* GetDriver() {
+  return engine::current_task::GetEventThread().GetIoUring();
+}
+
+}  // namespace
+
+TEST(IoUringDriver, SubmitRetriedWhenOutOfResources) {
+  engine::RunStandalone(1, MakeIoUringConfig(), [] {
+    auto* driver = GetDriver();
+    if (!driver) GTEST_SKIP() << "io_uring is not supported here";
+
+    // Nothing else is in flight, so no completion triggers the retry
+    driver->GetRing().InjectSubmitErrors(EAGAIN, 3);
+    EXPECT_EQ(driver->Perform(IoUringSqe{}, engine::Deadline{}), 0);
+    EXPECT_EQ(driver->Perform(IoUringSqe{}, engine::Deadline{}), 0);
+  });
+}
+
+TEST(IoUringDriver, SubmitFailsWhenOutOfResourcesForLong) {
+  engine::RunStandalone(1, MakeIoUringConfig(), [] {
+    auto* driver = GetDriver();
+    if (!driver) GTEST_SKIP() << "io_uring is not supported here";
+
+    driver->GetRing().InjectSubmitErrors(EAGAIN, 1000);
+    EXPECT_EQ(driver->Perform(IoUringSqe{}, engine::Deadline{}), -EAGAIN);
+
+    driver->GetRing().InjectSubmitErrors(0, 0);
+    EXPECT_EQ(driver->Perform(IoUringSqe{}, engine::Deadline{}), 0);
+  });
+}
+
+TEST(IoUringDriver, SubmitError) {
+  engine::RunStandalone(1, MakeIoUringConfig(), [] {
+    auto* driver = GetDriver();
+    if (!driver) GTEST_SKIP() << "io_uring is not supported here";
+
+    driver->GetRing().InjectSubmitErrors(EINVAL, 1);
+    EXPECT_EQ(driver->Perform(IoUringSqe{}, engine::Deadline{}), -EINVAL);
+    EXPECT_EQ(driver->Perform(IoUringSqe{}, engine::Deadline{}), 0);
+  });
+}
+
+TEST(IoUringDriver, TimeoutWhileOutOfResources) {
+  engine::RunStandalone(1, MakeIoUringConfig(), [] {
+    auto* driver = GetDriver();
+    if (!driver) GTEST_SKIP() << "io_uring is not supported here";
+
+    // The request and its cancellation fail together
+    driver->GetRing().InjectSubmitErrors(EAGAIN, 1000);
+    EXPECT_EQ(driver->Perform(IoUringSqe{}, engine::Deadline::Passed()),
+              -EAGAIN);
+  });
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,223 @@
+#include <engine/ev/io_uring.hpp>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using engine::ev::IoUring;
+using engine::ev::IoUringConfig;
+using engine::ev::IoUringOp;
+using engine::ev::IoUringSqe;
+
+using Completions = std::vector<std::pair<std::uint64_t, int>>;
+
+std::unique_ptr<IoUring> MakeRing(std::size_t registered_buffers = 0) {
+  IoUringConfig config;
+  config.enabled = true;
+  config.queue_depth = 8;
+  config.registered_buffers = registered_buffers;
+  config.registered_buffer_size = 4096;
+  return IoUring::TryCreate(config);
+}
+
+Completions WaitCompletions(IoUring& ring, std::size_t count) {
+  Completions result;
+  while (result.size() < count) {
+    pollfd pfd{ring.GetEventFd(), POLLIN, 0};
+    EXPECT_EQ(::poll(&pfd, 1, 5000), 1);
+    ring.ClearEventFd();
+    ring.Reap([&result](std::uint64_t user_data, int res) {
+      result.emplace_back(user_data, res);
+    });
+  }
+  return result;
+}
+
+class Pipe final {
+ public:
+  Pipe() { EXPECT_EQ(::pipe2(fds_.data(), O_CLOEXEC | O_NONBLOCK), 0); }
+  ~Pipe() {
+    ::close(fds_[0]);
+    ::close(fds_[1]);
+  }
+
+  int In() const { return fds_[0]; }
+  int Out() const { return fds_[1]; }
+
+ private:
+  std::array<int, 2> fds_{};
+};
+
+}  // namespace
+
+TEST(IoUring, Disabled) {
+  EXPECT_EQ(IoUring::TryCreate(IoUringConfig{}), nullptr);
+}
+
+TEST(IoUring, BatchedNops) {
+  auto ring = MakeRing();
+  if (!ring) GTEST_SKIP() << "io_uring is not supported here";
+
+  for (std::uint64_t i = 1; i <= 5; ++i) {
+    IoUringSqe sqe;
+    sqe.user_data = i;
+    ASSERT_TRUE(ring->TryPrepare(sqe));
+  }
+  EXPECT_EQ(ring->Submit(), 5);
+  EXPECT_EQ(ring->Submit(), 0);
+
+  const auto completions = WaitCompletions(*ring, 5);
+  ASSERT_EQ(completions.size(), 5);
+  for (std::uint64_t i = 1; i <= 5; ++i) {
+    EXPECT_EQ(completions[i - 1], std::make_pair(i, 0));
+  }
+}
+
+TEST(IoUring, SubmissionQueueFull) {
+  auto ring = MakeRing();
+  if (!ring) GTEST_SKIP() << "io_uring is not supported here";
+
+  std::size_t prepared = 0;
+  while (ring->TryPrepare(IoUringSqe{})) ++prepared;
+  EXPECT_EQ(prepared, 8);
+
+  EXPECT_EQ(ring->Submit(), 8);
+  EXPECT_TRUE(ring->TryPrepare(IoUringSqe{}));
+  EXPECT_EQ(ring->Submit(), 1);
+  EXPECT_EQ(WaitCompletions(*ring, 9).size(), 9);
+}
+
+TEST(IoUring, ReadWrite) {
+  auto ring = MakeRing();
+  if (!ring) GTEST_SKIP() << "io_uring is not supported here";
+  Pipe pipe;
+
+  std::array<char, 16> buffer{};
+  IoUringSqe read;
+  read.op = IoUringOp::kRead;
+  read.fd = pipe.In();
+  read.addr = reinterpret_cast<std::uintptr_t>(buffer.data());
+  read.len = buffer.size();
+  read.offset = static_cast<std::uint64_t>(-1);
+  read.user_data = 1;
+  ASSERT_TRUE(ring->TryPrepare(read));
+  ASSERT_EQ(ring->Submit(), 1);
+
+  constexpr std::string_view kData = "hello";
+  IoUringSqe write;
+  write.op = IoUringOp::kWrite;
+  write.fd = pipe.Out();
+  write.addr = reinterpret_cast<std::uintptr_t>(kData.data());
+  write.len = kData.size();
+  write.offset = static_cast<std::uint64_t>(-1);
+  write.user_data = 2;
+  ASSERT_TRUE(ring->TryPrepare(write));
+  ASSERT_EQ(ring->Submit(), 1);
+
+  auto completions = WaitCompletions(*ring, 2);
+  std::sort(completions.begin(), completions.end());
+  ASSERT_EQ(completions.size(), 2);
+  EXPECT_EQ(completions[1], std::make_pair(std::uint64_t{2}, 5));
+  if (completions[0].second == -EAGAIN) {
+    GTEST_SKIP() << "the kernel does not poll non-blocking pipes";
+  }
+  EXPECT_EQ(completions[0], std::make_pair(std::uint64_t{1}, 5));
+  EXPECT_EQ(std::string_view(buffer.data(), 5), kData);
+}
+
+TEST(IoUring, AsyncCancel) {
+  auto ring = MakeRing();
+  if (!ring) GTEST_SKIP() << "io_uring is not supported here";
+  Pipe pipe;
+
+  char byte = 0;
+  IoUringSqe read;
+  read.op = IoUringOp::kRead;
+  read.fd = pipe.In();
+  read.addr = reinterpret_cast<std::uintptr_t>(&byte);
+  read.len = 1;
+  read.offset = static_cast<std::uint64_t>(-1);
+  read.user_data = 1;
+  ASSERT_TRUE(ring->TryPrepare(read));
+  ASSERT_EQ(ring->Submit(), 1);
+
+  IoUringSqe cancel;
+  cancel.op = IoUringOp::kAsyncCancel;
+  cancel.addr = 1;
+  cancel.user_data = 2;
+  ASSERT_TRUE(ring->TryPrepare(cancel));
+  ASSERT_EQ(ring->Submit(), 1);
+
+  auto completions = WaitCompletions(*ring, 2);
+  std::sort(completions.begin(), completions.end());
+  ASSERT_EQ(completions.size(), 2);
+  if (completions[0].second == -EAGAIN) {
+    GTEST_SKIP() << "the kernel does not poll non-blocking pipes";
+  }
+  EXPECT_EQ(completions[0], std::make_pair(std::uint64_t{1}, -ECANCELED));
+  EXPECT_EQ(completions[1], std::make_pair(std::uint64_t{2}, 0));
+}
+
+TEST(IoUring, RegisteredBuffers) {
+  auto ring = MakeRing(/*registered_buffers=*/2);
+  if (!ring) GTEST_SKIP() << "io_uring is not supported here";
+  if (ring->GetRegisteredBufferSize() == 0) {
+    GTEST_SKIP() << "buffers registration is not permitted here";
+  }
+  EXPECT_EQ(ring->GetRegisteredBufferSize(), 4096);
+
+  const auto first = ring->TryAcquireRegisteredBuffer();
+  const auto second = ring->TryAcquireRegisteredBuffer();
+  ASSERT_TRUE(first && second);
+  EXPECT_NE(*first, *second);
+  EXPECT_FALSE(ring->TryAcquireRegisteredBuffer());
+
+  char path[] = "/tmp/userver-io-uring-XXXXXX";
+  const int fd = ::mkstemp(path);
+  ASSERT_NE(fd, -1);
+  ::unlink(path);
+  constexpr std::string_view kData = "registered";
+  ASSERT_EQ(::write(fd, kData.data(), kData.size()), kData.size());
+
+  IoUringSqe read;
+  read.op = IoUringOp::kReadFixed;
+  read.fd = fd;
+  read.addr =
+      reinterpret_cast<std::uintptr_t>(ring->GetRegisteredBuffer(*second));
+  read.len = ring->GetRegisteredBufferSize();
+  read.offset = 0;
+  read.buf_index = *second;
+  read.user_data = 1;
+  ASSERT_TRUE(ring->TryPrepare(read));
+  ASSERT_EQ(ring->Submit(), 1);
+
+  const auto completions = WaitCompletions(*ring, 1);
+  ::close(fd);
+  EXPECT_EQ(completions.front(),
+            std::make_pair(std::uint64_t{1}, static_cast<int>(kData.size())));
+  EXPECT_EQ(std::string_view(ring->GetRegisteredBuffer(*second), kData.size()),
+            kData);
+
+  ring->ReleaseRegisteredBuffer(*first);
+  EXPECT_EQ(ring->TryAcquireRegisteredBuffer(), first);
+  ring->ReleaseRegisteredBuffer(*first);
+  ring->ReleaseRegisteredBuffer(*second);
+}
+
+USERVER_NAMESPACE_END
@@ -15,10 +15,12 @@
 #include <userver/utils/thread_name.hpp>
 
 #include <utils/check_syscall.hpp>
+#include <utils/cpu_affinity.hpp>
 #include <utils/impl/assert_extra.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 #include "child_process_map.hpp"
+#include "io_uring_driver.hpp"
 
 USERVER_NAMESPACE_BEGIN
 
@@ -63,21 +65,25 @@ constexpr std::size_t kCpuStatsThrottle{16};
 }  // namespace
 
 Thread::Thread(const std::string& thread_name,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, false, register_event_mode) {}
+               RegisterEventMode register_event_mode,
+               const IoUringConfig& io_uring_config)
+    : Thread(thread_name, false, register_event_mode, io_uring_config) {}
 
 Thread::Thread(const std::string& thread_name, UseDefaultEvLoop,
-               RegisterEventMode register_event_mode)
-    : Thread(thread_name, true, register_event_mode) {}
+               RegisterEventMode register_event_mode,
+               const IoUringConfig& io_uring_config)
+    : Thread(thread_name, true, register_event_mode, io_uring_config) {}
 
 Thread::Thread(const std::string& thread_name, bool use_ev_default_loop,
-               RegisterEventMode register_event_mode)
+               RegisterEventMode register_event_mode,
+               const IoUringConfig& io_uring_config)
     : use_ev_default_loop_(use_ev_default_loop),
       register_event_mode_(register_event_mode),
       loop_(nullptr),
       lock_(loop_mutex_, std::defer_lock),
       name_{thread_name},
       cpu_stats_storage_{kCpuStatsCollectInterval, kCpuStatsThrottle},
+      io_uring_(IoUringDriver::TryCreate(io_uring_config)),
       is_running_(false) {
   if (use_ev_default_loop_) AcquireEvDefaultLoop(name_);
   Start();
@@ -135,6 +141,10 @@ std::uint8_t Thread::GetCurrentLoadPercent() const {
 
 const std::string& Thread::GetName() const { return name_; }
 
+void Thread::SetCpuAffinity(const std::vector<std::size_t>& cpus) {
+  utils::SetThreadCpuAffinity(thread_.native_handle(), cpus);
+}
+
 void Thread::Start() {
   loop_ = use_ev_default_loop_ ? ev_default_loop(EVFLAG_AUTO)
                                : ev_loop_new(EVFLAG_AUTO);
@@ -183,6 +193,8 @@ void Thread::Start() {
     ev_child_start(loop_, &watch_child_);
   }
 
+  if (io_uring_) io_uring_->Start(loop_);
+
   is_running_ = true;
   thread_ = std::thread([this] {
     utils::SetCurrentThreadName(name_);
@@ -219,6 +231,7 @@ void Thread::RunEvLoop() {
     ev_timer_stop(loop_, &stats_timer_);
   }
   if (use_ev_default_loop_) ev_child_stop(loop_, &watch_child_);
+  if (io_uring_) io_uring_->Stop();
 }
 
 void Thread::UpdateLoopWatcher(struct ev_loop* loop, ev_async*, int) noexcept {
@@ -5,6 +5,7 @@
 #include <mutex>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <ev.h>
 
@@ -12,12 +13,15 @@
 
 #include <concurrent/impl/intrusive_mpsc_queue.hpp>
 #include <engine/ev/async_payload_base.hpp>
+#include <engine/ev/io_uring.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
 
+class IoUringDriver;
+
 class Thread final {
  public:
   struct UseDefaultEvLoop {};
@@ -34,12 +38,17 @@ class Thread final {
     kDeferred
   };
 
-  Thread(const std::string& thread_name, RegisterEventMode);
-  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode);
+  Thread(const std::string& thread_name, RegisterEventMode,
+         const IoUringConfig& io_uring_config = {});
+  Thread(const std::string& thread_name, UseDefaultEvLoop, RegisterEventMode,
+         const IoUringConfig& io_uring_config = {});
   ~Thread();
 
   struct ev_loop* GetEvLoop() const { return loop_; }
 
+  // Returns nullptr if io_uring is disabled or not supported by the kernel
+  IoUringDriver* GetIoUring() const noexcept { return io_uring_.get(); }
+
   // Callbacks passed to RunInEvLoopAsync() are serialized.
   // All callbacks are guaranteed to execute.
   void RunInEvLoopAsync(AsyncPayloadBase& payload) noexcept;
@@ -55,9 +64,13 @@ class Thread final {
   std::uint8_t GetCurrentLoadPercent() const;
   const std::string& GetName() const;
 
+  // Throws std::system_error on failure
+  void SetCpuAffinity(const std::vector<std::size_t>& cpus);
+
  private:
   Thread(const std::string& thread_name, bool use_ev_default_loop,
-         RegisterEventMode register_event_mode);
+         RegisterEventMode register_event_mode,
+         const IoUringConfig& io_uring_config);
 
   void RegisterInEvLoop(AsyncPayloadBase& payload);
 
@@ -98,6 +111,8 @@ class Thread final {
   const std::string name_;
   utils::statistics::ThreadCpuStatsStorage cpu_stats_storage_;
 
+  std::unique_ptr<IoUringDriver> io_uring_;
+
   bool is_running_;
 };
 
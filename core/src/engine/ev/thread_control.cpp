@@ -28,6 +28,10 @@ bool ThreadControlBase::IsInEvThread() const noexcept {
   return thread_.IsInEvThread();
 }
 
+IoUringDriver* ThreadControlBase::GetIoUring() const noexcept {
+  return thread_.GetIoUring();
+}
+
 std::uint8_t ThreadControlBase::GetCurrentLoadPercent() const {
   return thread_.GetCurrentLoadPercent();
 }
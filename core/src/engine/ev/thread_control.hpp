@@ -99,6 +99,7 @@ class CallerOwnedPayloadBlocking final
 }  // namespace impl
 
 class Thread;
+class IoUringDriver;
 
 class ThreadControlBase {
  public:
@@ -130,6 +131,9 @@ class ThreadControlBase {
 
   bool IsInEvThread() const noexcept;
 
+  /// Returns nullptr if io_uring is disabled or not supported by the kernel
+  IoUringDriver* GetIoUring() const noexcept;
+
   std::uint8_t GetCurrentLoadPercent() const;
   const std::string& GetName() const;
 
@@ -38,8 +38,9 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop)
               fmt::format("{}_{}", config.thread_name, index);
           return (use_ev_default_loop && index == 0)
                      ? Thread(thread_name, Thread::kUseDefaultEvLoop,
-                              register_timer_event_mode)
-                     : Thread(thread_name, register_timer_event_mode);
+                              register_timer_event_mode, config.io_uring)
+                     : Thread(thread_name, register_timer_event_mode,
+                              config.io_uring);
         });
 
     default_threads_.thread_controls = utils::GenerateFixedArray(
@@ -68,6 +69,15 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop)
           return TimerThreadControl{threads_to_wrap[index]};
         });
   }
+
+  if (!config.cpu_set.empty()) {
+    for (auto& thread : default_threads_.threads) {
+      thread.SetCpuAffinity(config.cpu_set);
+    }
+    for (auto& thread : timer_threads_.threads) {
+      thread.SetCpuAffinity(config.cpu_set);
+    }
+  }
 }
 
 ThreadPool::~ThreadPool() {
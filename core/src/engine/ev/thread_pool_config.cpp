@@ -1,9 +1,25 @@
 #include "thread_pool_config.hpp"
 
+#include <utils/cpu_affinity.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
 
+IoUringConfig Parse(const yaml_config::YamlConfig& value,
+                    formats::parse::To<IoUringConfig>) {
+  IoUringConfig config;
+  config.enabled = value["enabled"].As<bool>(config.enabled);
+  config.queue_depth =
+      value["queue_depth"].As<std::size_t>(config.queue_depth);
+  config.registered_buffers =
+      value["registered_buffers"].As<std::size_t>(config.registered_buffers);
+  config.registered_buffer_size =
+      value["registered_buffer_size"].As<std::size_t>(
+          config.registered_buffer_size);
+  return config;
+}
+
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ThreadPoolConfig>) {
   ThreadPoolConfig config;
@@ -13,6 +29,9 @@ ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
           config.dedicated_timer_threads);
   config.thread_name = value["thread_name"].As<std::string>(config.thread_name);
   config.defer_events = value["defer_events"].As<bool>(config.defer_events);
+  config.cpu_set =
+      utils::ParseCpuList(value["cpu-set"].As<std::string>(std::string{}));
+  config.io_uring = value["io_uring"].As<IoUringConfig>(config.io_uring);
   return config;
 }
 
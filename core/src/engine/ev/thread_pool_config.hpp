@@ -1,10 +1,13 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <userver/formats/yaml.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
+#include <engine/ev/io_uring.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
@@ -15,8 +18,13 @@ struct ThreadPoolConfig {
   std::string thread_name = "event-worker";
   bool ev_default_loop_disabled = false;
   bool defer_events = false;
+  std::vector<std::size_t> cpu_set;
+  IoUringConfig io_uring;
 };
 
+IoUringConfig Parse(const yaml_config::YamlConfig& value,
+                    formats::parse::To<IoUringConfig>);
+
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ThreadPoolConfig>);
 
@@ -29,9 +29,10 @@ std::shared_ptr<TaskProcessorPools> MakeTaskProcessorPools(
 
 class TaskProcessorHolder final {
  public:
-  static TaskProcessorHolder Make(std::size_t threads_num,
-                                  std::string thread_name,
-                                  std::shared_ptr<TaskProcessorPools> pools);
+  static TaskProcessorHolder Make(
+      std::size_t threads_num, std::string thread_name,
+      std::shared_ptr<TaskProcessorPools> pools,
+      TaskQueueType task_queue_type = TaskQueueType::kGlobalTaskQueue);
 
   explicit TaskProcessorHolder(std::unique_ptr<TaskProcessor>&&);
 
@@ -88,6 +88,13 @@ class Direction final {
                     TransferMode mode, Deadline deadline,
                     const Context&... context);
 
+  // (IoFunc*)(int, size_t), e.g. sendfile with the source position tracked
+  // by the wrapper
+  template <typename IoFunc, typename... Context>
+  size_t PerformTransfer(SingleUserGuard& guard, IoFunc&& io_func, size_t len,
+                         TransferMode mode, Deadline deadline,
+                         const Context&... context);
+
   engine::impl::ContextAccessor* TryGetContextAccessor() noexcept;
 
  private:
@@ -253,6 +260,30 @@ size_t Direction::PerformIo(SingleUserGuard&, IoFunc&& io_func, void* buf,
   return pos - begin;
 }
 
+template <typename IoFunc, typename... Context>
+size_t Direction::PerformTransfer(SingleUserGuard&, IoFunc&& io_func,
+                                  size_t len, TransferMode mode,
+                                  Deadline deadline,
+                                  const Context&... context) {
+  size_t processed_bytes = 0;
+
+  while (processed_bytes < len) {
+    auto chunk_size = io_func(Fd(), len - processed_bytes);
+
+    if (chunk_size > 0) {
+      processed_bytes += chunk_size;
+      if (mode == TransferMode::kOnce) {
+        break;
+      }
+    } else if (!chunk_size ||
+               TryHandleError(errno, processed_bytes, mode, deadline,
+                              context...) == ErrorMode::kFatal) {
+      break;
+    }
+  }
+  return processed_bytes;
+}
+
 }  // namespace engine::io::impl
 
 USERVER_NAMESPACE_END
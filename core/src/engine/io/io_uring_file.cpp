@@ -0,0 +1,137 @@
+#include <engine/io/io_uring_file.hpp>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <limits>
+#include <system_error>
+
+#include <fmt/format.h>
+
+#include <userver/engine/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_base.hpp>
+#include <userver/utils/fast_scope_guard.hpp>
+
+#include <engine/ev/io_uring_driver.hpp>
+#include <engine/ev/thread_control.hpp>
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io::impl {
+
+namespace {
+
+constexpr std::size_t kReadChunkSize = 64 * 1024;
+constexpr std::size_t kMaxWriteSize = std::numeric_limits<std::int32_t>::max();
+
+int CheckResult(int result, std::string_view operation,
+                const std::string& path) {
+  if (result >= 0) return result;
+  if ((result == -ECANCELED || result == -EINTR) &&
+      current_task::ShouldCancel()) {
+    throw WaitInterruptedException(current_task::CancellationReason());
+  }
+  throw std::system_error(
+      std::error_code(-result, std::system_category()),
+      fmt::format("Error while {} file '{}' via io_uring", operation, path));
+}
+
+int OpenFile(ev::IoUringDriver& io_uring, const std::string& path, int flags,
+             mode_t mode) {
+  ev::IoUringSqe sqe;
+  sqe.op = ev::IoUringOp::kOpenAt;
+  sqe.fd = AT_FDCWD;
+  sqe.addr = reinterpret_cast<std::uintptr_t>(path.c_str());
+  sqe.len = mode;
+  sqe.op_flags = flags | O_CLOEXEC;
+  return CheckResult(io_uring.Perform(sqe, {}), "opening", path);
+}
+
+}  // namespace
+
+std::optional<std::string> TryReadFileContentsIoUring(const std::string& path) {
+  auto* io_uring = current_task::GetEventThread().GetIoUring();
+  if (!io_uring) return std::nullopt;
+
+  const int fd = OpenFile(*io_uring, path, O_RDONLY, 0);
+  const utils::FastScopeGuard close_guard([fd]() noexcept { ::close(fd); });
+
+  // A registered buffer saves the kernel from pinning the destination pages
+  // on every read
+  auto& ring = io_uring->GetRing();
+  const auto buffer_index = ring.TryAcquireRegisteredBuffer();
+  const utils::FastScopeGuard release_guard([&]() noexcept {
+    if (buffer_index) ring.ReleaseRegisteredBuffer(*buffer_index);
+  });
+
+  std::string contents;
+  std::size_t offset = 0;
+  while (true) {
+    ev::IoUringSqe sqe;
+    sqe.fd = fd;
+    sqe.offset = offset;
+    if (buffer_index) {
+      sqe.op = ev::IoUringOp::kReadFixed;
+      sqe.addr = reinterpret_cast<std::uintptr_t>(
+          ring.GetRegisteredBuffer(*buffer_index));
+      sqe.len = static_cast<std::uint32_t>(ring.GetRegisteredBufferSize());
+      sqe.buf_index = *buffer_index;
+    } else {
+      contents.resize(offset + kReadChunkSize);
+      sqe.op = ev::IoUringOp::kRead;
+      sqe.addr = reinterpret_cast<std::uintptr_t>(contents.data() + offset);
+      sqe.len = kReadChunkSize;
+    }
+
+    const auto read = static_cast<std::size_t>(
+        CheckResult(io_uring->Perform(sqe, {}), "reading", path));
+    if (read == 0) break;
+    if (buffer_index) {
+      contents.append(ring.GetRegisteredBuffer(*buffer_index), read);
+    }
+    offset += read;
+  }
+  contents.resize(offset);
+  return contents;
+}
+
+bool TryRewriteFileContentsIoUring(const std::string& path,
+                                   std::string_view contents) {
+  auto* io_uring = current_task::GetEventThread().GetIoUring();
+  if (!io_uring) return false;
+
+  const int fd =
+      OpenFile(*io_uring, path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+  utils::FastScopeGuard close_guard([fd]() noexcept { ::close(fd); });
+
+  std::size_t offset = 0;
+  while (offset < contents.size()) {
+    ev::IoUringSqe sqe;
+    sqe.op = ev::IoUringOp::kWrite;
+    sqe.fd = fd;
+    sqe.offset = offset;
+    sqe.addr = reinterpret_cast<std::uintptr_t>(contents.data() + offset);
+    sqe.len = static_cast<std::uint32_t>(
+        std::min(contents.size() - offset, kMaxWriteSize));
+
+    const auto written = static_cast<std::size_t>(
+        CheckResult(io_uring->Perform(sqe, {}), "writing", path));
+    if (written == 0) {
+      CheckResult(-EIO, "writing", path);
+    }
+    offset += written;
+  }
+
+  close_guard.Release();
+  utils::CheckSyscall(::close(fd), "closing file '{}'", path);
+  return true;
+}
+
+}  // namespace engine::io::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io::impl {
+
+// File operations performed by the io_uring of an ev thread, without
+// offloading blocking syscalls to a separate task processor.
+// Return std::nullopt (false) if io_uring is not available, the caller should
+// fall back to the blocking implementation.
+// Throw std::system_error on failure and engine::WaitInterruptedException if
+// the current task is cancelled.
+
+std::optional<std::string> TryReadFileContentsIoUring(const std::string& path);
+
+bool TryRewriteFileContentsIoUring(const std::string& path,
+                                   std::string_view contents);
+
+}  // namespace engine::io::impl
+
+USERVER_NAMESPACE_END
@@ -4,7 +4,12 @@
 #include <sys/socket.h>
 #include <sys/uio.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
 
+#include <algorithm>
+#include <array>
 #include <cerrno>
 #include <string>
 #include <vector>
@@ -60,15 +65,45 @@ Sockaddr& MemoizeAddr(Sockaddr& addr, decltype(&::getpeername) getter,
   return ::recv(fd, buf, len, 0);
 }
 
-[[nodiscard]] ssize_t SendWrapper(int fd, const void* buf, size_t len) {
-  return ::send(fd, buf, len,
+constexpr int kSendFlags =
 // MAC_COMPAT: does not support MSG_NOSIGNAL
 #ifdef MSG_NOSIGNAL
-                MSG_NOSIGNAL |
+    MSG_NOSIGNAL |
 #endif
-                    0);
+    0;
+
+[[nodiscard]] ssize_t SendWrapper(int fd, const void* buf, size_t len) {
+  return ::send(fd, buf, len, kSendFlags);
 }
 
+class SendFileWrapper {
+ public:
+  SendFileWrapper(int file_fd, size_t offset)
+      : file_fd_(file_fd), offset_(offset) {}
+
+  [[nodiscard]] ssize_t operator()(int fd, size_t len) {
+#ifdef __linux__
+    auto offset = static_cast<off_t>(offset_);
+    const auto result = ::sendfile(fd, file_fd_, &offset, len);
+    if (result > 0) offset_ += result;
+    return result;
+#else
+    // MAC_COMPAT: sendfile has a different signature, copy via a buffer
+    std::array<char, 64 * 1024> buffer{};
+    const auto read = ::pread(file_fd_, buffer.data(),
+                              std::min(len, buffer.size()), offset_);
+    if (read <= 0) return read;
+    const auto result = ::send(fd, buffer.data(), read, kSendFlags);
+    if (result > 0) offset_ += result;
+    return result;
+#endif
+  }
+
+ private:
+  const int file_fd_;
+  size_t offset_;
+};
+
 class RecvFromWrapper {
  public:
   [[nodiscard]] ssize_t operator()(int fd, void* buf, size_t len) {
@@ -291,6 +326,20 @@ size_t Socket::SendAll(const void* buf, size_t len, Deadline deadline) {
                        peername_);
 }
 
+size_t Socket::SendFile(int file_fd, std::size_t offset, std::size_t len,
+                        Deadline deadline) {
+  if (!IsValid()) {
+    throw IoException("Attempt to SendFile to closed socket");
+  }
+  if (len == 0) return 0;
+  auto& dir = fd_control_->Write();
+  dir.ResetReady();
+  impl::Direction::SingleUserGuard guard(dir);
+  return dir.PerformTransfer(guard, SendFileWrapper{file_fd, offset}, len,
+                             impl::TransferMode::kWhole, deadline,
+                             "SendFile to ", peername_);
+}
+
 Socket::RecvFromResult Socket::RecvSomeFrom(void* buf, size_t len,
                                             Deadline deadline) {
   if (!IsValid()) {
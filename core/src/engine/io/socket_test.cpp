@@ -18,6 +18,9 @@
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/wait_any.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
 #include <userver/internal/net/net_listener.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -171,6 +174,27 @@ UTEST(Socket, SendAllVector) {
   EXPECT_EQ(bytes_sent, bytes_read);
 }
 
+UTEST(Socket, SendFile) {
+  const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  const auto temp_file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(temp_file.GetPath(), "0123456789");
+  const auto file = fs::blocking::FileDescriptor::Open(
+      temp_file.GetPath(), fs::blocking::OpenFlag::kRead);
+
+  TcpListener listener;
+  auto sockets = listener.MakeSocketPair(deadline);
+  EXPECT_EQ(sockets.second.SendFile(file.GetNative(), 2, 5, deadline), 5);
+  // stops at the end of file
+  EXPECT_EQ(sockets.second.SendFile(file.GetNative(), 8, 5, deadline), 2);
+  EXPECT_EQ(sockets.second.SendFile(file.GetNative(), 0, 0, deadline), 0);
+
+  std::array<char, 7> buf = {};
+  EXPECT_EQ(sockets.first.RecvAll(buf.data(), buf.size(), deadline),
+            buf.size());
+  EXPECT_EQ(std::string_view(buf.data(), buf.size()), "2345689");
+}
+
 UTEST(Socket, WaitAnyRead) {
   const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
   TcpListener listener;
@@ -231,6 +231,26 @@ enum InterruptAction {
   kFail,
 };
 
+#if OPENSSL_VERSION_NUMBER >= 0x010002000L
+int SelectAlpnProtocol(SSL*, const unsigned char** out, unsigned char* outlen,
+                       const unsigned char* in, unsigned int inlen,
+                       void* arg) noexcept {
+  const auto* protocols = static_cast<const std::string*>(arg);
+  UASSERT(protocols);
+
+  unsigned char* selected = nullptr;
+  if (OPENSSL_NPN_NEGOTIATED !=
+      SSL_select_next_proto(
+          &selected, outlen,
+          reinterpret_cast<const unsigned char*>(protocols->data()),
+          protocols->size(), in, inlen)) {
+    return SSL_TLSEXT_ERR_NOACK;
+  }
+  *out = selected;
+  return SSL_TLSEXT_ERR_OK;
+}
+#endif
+
 }  // namespace
 
 class TlsWrapper::ReadContextAccessor final
@@ -473,7 +493,8 @@ TlsWrapper TlsWrapper::StartTlsClient(Socket&& socket,
 TlsWrapper TlsWrapper::StartTlsServer(
     Socket&& socket, const crypto::Certificate& cert,
     const crypto::PrivateKey& key, Deadline deadline,
-    const std::vector<crypto::Certificate>& cert_authorities) {
+    const std::vector<crypto::Certificate>& cert_authorities,
+    const std::vector<std::string>& alpn_protocols) {
   auto ssl_ctx = MakeSslCtx();
 
   if (!cert_authorities.empty()) {
@@ -502,11 +523,33 @@ TlsWrapper TlsWrapper::StartTlsServer(
         "Failed to set up server TLS wrapper: SSL_CTX_use_PrivateKey"));
   }
 
+  // ALPN wire format: length-prefixed names, must outlive SSL_accept
+  std::string alpn_wire_protocols;
+  if (!alpn_protocols.empty()) {
+#if OPENSSL_VERSION_NUMBER >= 0x010002000L
+    for (const auto& protocol : alpn_protocols) {
+      UINVARIANT(!protocol.empty() && protocol.size() <= 255,
+                 "Invalid ALPN protocol name length");
+      alpn_wire_protocols.push_back(static_cast<char>(protocol.size()));
+      alpn_wire_protocols += protocol;
+    }
+    SSL_CTX_set_alpn_select_cb(ssl_ctx.get(), &SelectAlpnProtocol,
+                               &alpn_wire_protocols);
+#else
+    LOG_WARNING() << "ALPN is not supported by this OpenSSL version";
+#endif
+  }
+
   TlsWrapper wrapper{std::move(socket)};
   wrapper.impl_->SetUp(std::move(ssl_ctx));
   wrapper.impl_->bio_data.current_deadline = deadline;
 
   auto ret = SSL_accept(wrapper.impl_->ssl.get());
+#if OPENSSL_VERSION_NUMBER >= 0x010002000L
+  if (!alpn_wire_protocols.empty()) {
+    SSL_CTX_set_alpn_select_cb(ssl_ctx.get(), nullptr, nullptr);
+  }
+#endif
   if (1 != ret) {
     if (wrapper.impl_->bio_data.last_exception) {
       std::rethrow_exception(wrapper.impl_->bio_data.last_exception);
@@ -665,6 +708,19 @@ Socket TlsWrapper::StopTls(Deadline deadline) {
 
 int TlsWrapper::GetRawFd() { return impl_->bio_data.socket.Fd(); }
 
+std::string_view TlsWrapper::GetAlpnProtocol() const {
+#if OPENSSL_VERSION_NUMBER >= 0x010002000L
+  if (!impl_->ssl) return {};
+
+  const unsigned char* protocol = nullptr;
+  unsigned int length = 0;
+  SSL_get0_alpn_selected(impl_->ssl.get(), &protocol, &length);
+  return {reinterpret_cast<const char*>(protocol), length};
+#else
+  return {};
+#endif
+}
+
 }  // namespace engine::io
 
 USERVER_NAMESPACE_END
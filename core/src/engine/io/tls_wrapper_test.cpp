@@ -453,6 +453,33 @@ UTEST(TlsWrapper, Cancel) {
   server_task.SyncCancel();
 }
 
+UTEST(TlsWrapper, AlpnWithoutClientSupport) {
+  const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  TcpListener tcp_listener;
+  auto [server, client] = tcp_listener.MakeSocketPair(test_deadline);
+
+  auto server_task = engine::AsyncNoSpan(
+      [test_deadline](auto&& server) {
+        auto tls_server = io::TlsWrapper::StartTlsServer(
+            std::forward<decltype(server)>(server),
+            crypto::Certificate::LoadFromString(cert),
+            crypto::PrivateKey::LoadFromString(key), test_deadline, {},
+            {"h2", "http/1.1"});
+        EXPECT_EQ(tls_server.GetAlpnProtocol(), "");
+        EXPECT_EQ(1, tls_server.SendAll("1", 1, test_deadline));
+      },
+      std::move(server));
+
+  auto tls_client =
+      io::TlsWrapper::StartTlsClient(std::move(client), {}, test_deadline);
+  EXPECT_EQ(tls_client.GetAlpnProtocol(), "");
+  char c = 0;
+  EXPECT_EQ(1, tls_client.RecvAll(&c, 1, test_deadline));
+  EXPECT_EQ('1', c);
+  server_task.Get();
+}
+
 UTEST_MT(TlsWrapper, CertKeyMismatch, 2) {
   const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
 
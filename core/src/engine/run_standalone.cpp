@@ -26,7 +26,7 @@ void RunStandalone(std::size_t worker_threads,
 
   auto task_processor_holder = engine::impl::TaskProcessorHolder::Make(
       worker_threads, "coro-runner",
-      engine::impl::MakeTaskProcessorPools(config));
+      engine::impl::MakeTaskProcessorPools(config), config.task_queue_type);
 
   engine::impl::RunOnTaskProcessorSync(*task_processor_holder,
                                        std::move(payload));
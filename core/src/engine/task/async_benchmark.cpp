@@ -1,7 +1,9 @@
 #include <benchmark/benchmark.h>
 
 #include <array>
+#include <atomic>
 #include <thread>
+#include <vector>
 
 #include <userver/engine/async.hpp>
 #include <userver/engine/impl/task_local_storage.hpp>
@@ -44,6 +46,85 @@ void async_comparisons_coro(benchmark::State& state) {
 }
 BENCHMARK(async_comparisons_coro)->RangeMultiplier(2)->Range(1, 32);
 
+template <engine::TaskQueueType QueueType>
+void async_comparisons_coro_task_queue(benchmark::State& state) {
+  engine::TaskProcessorPoolsConfig config;
+  config.task_queue_type = QueueType;
+  engine::RunStandalone(state.range(0), config, [&] {
+    std::uint64_t constructed_joined_count = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      engine::AsyncNoSpan([] {}).Wait();
+      ++constructed_joined_count;
+    }
+    benchmark::DoNotOptimize(constructed_joined_count);
+  });
+}
+BENCHMARK_TEMPLATE(async_comparisons_coro_task_queue,
+                   engine::TaskQueueType::kGlobalTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+BENCHMARK_TEMPLATE(async_comparisons_coro_task_queue,
+                   engine::TaskQueueType::kWorkStealingTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+
+// Many short tasks spawned and awaited by several tasks at once, the task queue
+// is the main point of contention here.
+template <engine::TaskQueueType QueueType>
+void async_fan_out_task_queue(benchmark::State& state) {
+  constexpr std::size_t kFanOut = 16;
+  const auto worker_threads = static_cast<std::size_t>(state.range(0));
+
+  engine::TaskProcessorPoolsConfig config;
+  config.task_queue_type = QueueType;
+  engine::RunStandalone(worker_threads, config, [&] {
+    std::vector<engine::TaskWithResult<void>> spawners;
+    spawners.reserve(worker_threads);
+
+    for ([[maybe_unused]] auto _ : state) {
+      for (std::size_t i = 0; i < worker_threads; ++i) {
+        spawners.push_back(engine::AsyncNoSpan([] {
+          std::array<engine::TaskWithResult<void>, kFanOut> children;
+          for (auto& child : children) child = engine::AsyncNoSpan([] {});
+          for (auto& child : children) child.Wait();
+        }));
+      }
+      for (auto& spawner : spawners) spawner.Wait();
+      spawners.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * worker_threads * kFanOut);
+  });
+}
+BENCHMARK_TEMPLATE(async_fan_out_task_queue,
+                   engine::TaskQueueType::kGlobalTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+BENCHMARK_TEMPLATE(async_fan_out_task_queue,
+                   engine::TaskQueueType::kWorkStealingTaskQueue)
+    ->RangeMultiplier(2)
+    ->Range(1, 32);
+
+// A task spawned by a busy task must be picked up by an idle worker, the time
+// of the handoff is measured.
+template <engine::TaskQueueType QueueType>
+void async_handoff_from_busy_task_queue(benchmark::State& state) {
+  engine::TaskProcessorPoolsConfig config;
+  config.task_queue_type = QueueType;
+  engine::RunStandalone(2, config, [&] {
+    for ([[maybe_unused]] auto _ : state) {
+      std::atomic<bool> is_started{false};
+      auto task = engine::AsyncNoSpan([&is_started] { is_started = true; });
+      while (!is_started) {
+      }
+      task.Wait();
+    }
+  });
+}
+BENCHMARK_TEMPLATE(async_handoff_from_busy_task_queue,
+                   engine::TaskQueueType::kGlobalTaskQueue);
+BENCHMARK_TEMPLATE(async_handoff_from_busy_task_queue,
+                   engine::TaskQueueType::kWorkStealingTaskQueue);
+
 void wrap_call_single(benchmark::State& state) {
   engine::RunStandalone([&] {
     for ([[maybe_unused]] auto _ : state) {
@@ -12,6 +12,7 @@
 #include <userver/utils/rand.hpp>
 #include <userver/utils/thread_name.hpp>
 #include <userver/utils/threads.hpp>
+#include <utils/cpu_affinity.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 #include <engine/task/counted_coroutine_ptr.hpp>
@@ -54,6 +55,19 @@ void EmitMagicNanosleep() {
   nanosleep(&ts, nullptr);
 }
 
+std::variant<TaskQueue, WorkStealingTaskQueue> MakeTaskQueue(
+    const TaskProcessorConfig& config) {
+  switch (config.task_queue) {
+    case TaskQueueType::kGlobalTaskQueue:
+      return std::variant<TaskQueue, WorkStealingTaskQueue>{
+          std::in_place_type<TaskQueue>, config};
+    case TaskQueueType::kWorkStealingTaskQueue:
+      return std::variant<TaskQueue, WorkStealingTaskQueue>{
+          std::in_place_type<WorkStealingTaskQueue>, config};
+  }
+  UINVARIANT(false, "Unexpected value of TaskQueueType");
+}
+
 void TaskProcessorThreadStartedHook() {
   utils::impl::AssertStaticRegistrationFinished();
   utils::WithDefaultRandom([](auto&) {});
@@ -68,14 +82,18 @@ void TaskProcessorThreadStartedHook() {
 TaskProcessor::TaskProcessor(TaskProcessorConfig config,
                              std::shared_ptr<impl::TaskProcessorPools> pools)
     : task_counter_(config.worker_threads),
-      task_queue_(config),
+      task_queue_(MakeTaskQueue(config)),
       config_(std::move(config)),
+      worker_cpus_(utils::ResolveCpuSet(config_.cpu_set, config_.numa_node)),
       pools_(std::move(pools)) {
   utils::impl::FinishStaticRegistration();
   try {
     LOG_INFO() << "creating task_processor " << Name() << " "
                << "worker_threads=" << config_.worker_threads
-               << " thread_name=" << config_.thread_name;
+               << " thread_name=" << config_.thread_name
+               << " work_stealing_task_queue="
+               << (config_.task_queue == TaskQueueType::kWorkStealingTaskQueue)
+               << " worker_cpus=" << worker_cpus_.size();
     concurrent::impl::Latch workers_left{
         static_cast<std::ptrdiff_t>(config_.worker_threads)};
     workers_.reserve(config_.worker_threads);
@@ -85,6 +103,10 @@ TaskProcessor::TaskProcessor(TaskProcessorConfig config,
         workers_left.count_down();
         ProcessTasks();
       });
+      if (!worker_cpus_.empty()) {
+        utils::SetThreadCpuAffinity(workers_.back().native_handle(),
+                                    worker_cpus_);
+      }
     }
 
     cpu_stats_storage_ =
@@ -105,7 +127,7 @@ void TaskProcessor::Cleanup() noexcept {
   // Some tasks may be bound but not scheduled yet
   task_counter_.WaitForExhaustion();
 
-  task_queue_.StopProcessing();
+  std::visit([](auto& queue) { queue.StopProcessing(); }, task_queue_);
 
   for (auto& w : workers_) {
     w.join();
@@ -136,13 +158,18 @@ void TaskProcessor::Schedule(impl::TaskContext* context) {
 
   SetTaskQueueWaitTimepoint(context);
 
-  task_queue_.Push(context);
+  std::visit([context](auto& queue) { queue.Push(context); }, task_queue_);
 }
 
 void TaskProcessor::Adopt(impl::TaskContext& context) {
   detached_contexts_->Add(context);
 }
 
+size_t TaskProcessor::GetTaskQueueSize() const {
+  return std::visit([](const auto& queue) { return queue.GetSizeApproximate(); },
+                    task_queue_);
+}
+
 ev::ThreadPool& TaskProcessor::EventThreadPool() {
   return pools_->EventThreadPool();
 }
@@ -243,13 +270,22 @@ void TaskProcessor::PrepareWorkerThread(std::size_t index) noexcept {
   utils::SetCurrentThreadName(fmt::format("{}_{}", config_.thread_name, index));
 
   impl::SetLocalTaskCounterData(task_counter_, index);
+  if (config_.numa_node) coro::SetLocalNumaNode(*config_.numa_node);
+  if (auto* queue = std::get_if<WorkStealingTaskQueue>(&task_queue_)) {
+    queue->PrepareWorker(index);
+  }
 
   TaskProcessorThreadStartedHook();
 }
 
 void TaskProcessor::ProcessTasks() noexcept {
+  std::visit([this](auto& queue) { ProcessTasks(queue); }, task_queue_);
+}
+
+template <typename TaskQueueImpl>
+void TaskProcessor::ProcessTasks(TaskQueueImpl& task_queue) noexcept {
   while (true) {
-    auto context = task_queue_.PopBlocking();
+    auto context = task_queue.PopBlocking();
     if (!context) break;
 
     GetTaskCounter().AccountTaskSwitchSlow();
@@ -4,7 +4,9 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <thread>
+#include <variant>
 #include <vector>
 
 #include <boost/smart_ptr/intrusive_ptr.hpp>
@@ -13,6 +15,7 @@
 #include <engine/task/task_counter.hpp>
 #include <engine/task/task_processor_config.hpp>
 #include <engine/task/task_queue.hpp>
+#include <engine/task/work_stealing_task_queue.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
@@ -57,10 +60,16 @@ class TaskProcessor final {
 
   const impl::TaskCounter& GetTaskCounter() const { return task_counter_; }
 
-  size_t GetTaskQueueSize() const { return task_queue_.GetSizeApproximate(); }
+  size_t GetTaskQueueSize() const;
 
   size_t GetWorkerCount() const { return workers_.size(); }
 
+  const std::vector<std::size_t>& GetWorkerCpus() const {
+    return worker_cpus_;
+  }
+
+  std::optional<std::size_t> GetNumaNode() const { return config_.numa_node; }
+
   void SetSettings(const TaskProcessorSettings& settings);
 
   std::chrono::microseconds GetProfilerThreshold() const;
@@ -84,6 +93,9 @@ class TaskProcessor final {
 
   void ProcessTasks() noexcept;
 
+  template <typename TaskQueueImpl>
+  void ProcessTasks(TaskQueueImpl& task_queue) noexcept;
+
   void CheckWaitTime(impl::TaskContext& context);
 
   void SetTaskQueueWaitTimeOverloaded(bool new_value) noexcept;
@@ -95,9 +107,10 @@ class TaskProcessor final {
       detached_contexts_{impl::DetachedTasksSyncBlock::StopMode::kCancel};
   concurrent::impl::InterferenceShield<std::atomic<bool>>
       task_queue_wait_time_overloaded_{false};
-  TaskQueue task_queue_;
+  std::variant<TaskQueue, WorkStealingTaskQueue> task_queue_;
 
   const TaskProcessorConfig config_;
+  const std::vector<std::size_t> worker_cpus_;
   const std::shared_ptr<impl::TaskProcessorPools> pools_;
   std::vector<std::thread> workers_;
   logging::LoggerPtr task_trace_logger_{nullptr};
@@ -8,6 +8,7 @@
 #include <userver/utils/text_light.hpp>
 #include <userver/utils/trivial_map.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
+#include <utils/cpu_affinity.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -45,6 +46,17 @@ OsScheduling Parse(const yaml_config::YamlConfig& value,
   return utils::ParseFromValueString(value, kMap);
 }
 
+TaskQueueType Parse(const yaml_config::YamlConfig& value,
+                    formats::parse::To<TaskQueueType>) {
+  static constexpr utils::TrivialBiMap kMap([](auto selector) {
+    return selector()
+        .Case(TaskQueueType::kGlobalTaskQueue, "global-task-queue")
+        .Case(TaskQueueType::kWorkStealingTaskQueue, "work-stealing-task-queue");
+  });
+
+  return utils::ParseFromValueString(value, kMap);
+}
+
 TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
                           formats::parse::To<TaskProcessorConfig>) {
   TaskProcessorConfig config;
@@ -56,6 +68,11 @@ TaskProcessorConfig Parse(const yaml_config::YamlConfig& value,
       value["os-scheduling"].As<OsScheduling>(config.os_scheduling);
   config.spinning_iterations =
       value["spinning-iterations"].As<int>(config.spinning_iterations);
+  config.task_queue =
+      value["task-processor-queue"].As<TaskQueueType>(config.task_queue);
+  config.cpu_set =
+      utils::ParseCpuList(value["cpu-set"].As<std::string>(std::string{}));
+  config.numa_node = value["numa-node"].As<std::optional<std::size_t>>();
 
   const auto task_trace = value["task-trace"];
   if (!task_trace.IsMissing()) {
@@ -0,0 +1,268 @@
+#include <engine/task/work_stealing_task_queue.hpp>
+
+#include <moodycamel/lightweightsemaphore.h>
+
+#include <concurrent/impl/bounded_spmc_queue.hpp>
+#include <engine/task/task_context.hpp>
+#include <userver/compiler/thread_local.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace {
+
+// Must be large enough to absorb bursts of wakeups from a single task, and
+// small enough to keep the memory footprint of a TaskProcessor reasonable.
+constexpr std::size_t kLocalQueueCapacity = 256;
+
+// Limits the number of consecutive runs from the LIFO slot. Two tasks that
+// keep waking each other up would otherwise starve the local queue.
+constexpr std::size_t kMaxLifoStreak = 3;
+
+// The global queue is checked first every N pops, otherwise the tasks
+// scheduled from ev threads could starve while workers are busy with
+// the local tasks.
+constexpr std::size_t kGlobalQueueCheckInterval = 61;
+
+struct LocalConsumerData final {
+  const WorkStealingTaskQueue* queue{nullptr};
+  void* consumer{nullptr};
+};
+
+compiler::ThreadLocal local_consumer_data = [] { return LocalConsumerData{}; };
+
+}  // namespace
+
+class alignas(concurrent::impl::kDestructiveInterferenceSize)
+    WorkStealingTaskQueue::Consumer final {
+ public:
+  Consumer(std::size_t index, int spinning_iterations)
+      : semaphore(0, spinning_iterations),
+        random_state(static_cast<std::uint32_t>(index) * 2654435761U + 1) {}
+
+  // Shared with thieves
+  concurrent::impl::BoundedSpmcQueue<impl::TaskContext, kLocalQueueCapacity>
+      local_queue;
+  std::atomic<impl::TaskContext*> lifo_slot{nullptr};
+  moodycamel::LightweightSemaphore semaphore;
+
+  // Accessed only by the owning worker thread
+  impl::TaskContext* current{nullptr};
+  std::size_t lifo_streak{0};
+  std::size_t pops_since_global_check{0};
+  std::uint32_t random_state;
+
+  std::uint32_t NextRandom() noexcept {
+    // xorshift32
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+    return random_state;
+  }
+};
+
+WorkStealingTaskQueue::WorkStealingTaskQueue(const TaskProcessorConfig& config)
+    : consumers_(utils::GenerateFixedArray(
+          config.worker_threads,
+          [&config](std::size_t index) {
+            return Consumer(index, config.spinning_iterations);
+          })) {
+  parked_.reserve(config.worker_threads);
+}
+
+WorkStealingTaskQueue::~WorkStealingTaskQueue() = default;
+
+void WorkStealingTaskQueue::PrepareWorker(std::size_t index) noexcept {
+  UASSERT(index < consumers_.size());
+  auto local_data = local_consumer_data.Use();
+  *local_data = {this, &consumers_[index]};
+}
+
+void WorkStealingTaskQueue::Push(
+    boost::intrusive_ptr<impl::TaskContext>&& context) {
+  UASSERT(context);
+  // Counted before the task becomes visible to the consumers, so that its pop
+  // never makes the counter wrap around
+  size_->fetch_add(1, std::memory_order_relaxed);
+  DoPush(context.get());
+  context.detach();
+}
+
+boost::intrusive_ptr<impl::TaskContext> WorkStealingTaskQueue::PopBlocking() {
+  auto* consumer = GetLocalConsumer();
+  UASSERT_MSG(consumer, "PopBlocking must be called from a worker thread");
+
+  while (true) {
+    if (auto* context = TryPop(*consumer)) {
+      size_->fetch_sub(1, std::memory_order_relaxed);
+      consumer->current = context;
+      return {context, /* add_ref= */ false};
+    }
+    if (!Park(*consumer)) {
+      consumer->current = nullptr;
+      return nullptr;
+    }
+  }
+}
+
+void WorkStealingTaskQueue::StopProcessing() {
+  std::vector<Consumer*> parked;
+  {
+    const std::lock_guard lock{parked_mutex_};
+    is_stopped_ = true;
+    parked.swap(parked_);
+    parked_count_->store(0, std::memory_order_relaxed);
+  }
+  for (auto* consumer : parked) consumer->semaphore.signal();
+}
+
+std::size_t WorkStealingTaskQueue::GetSizeApproximate() const noexcept {
+  return size_->load(std::memory_order_relaxed);
+}
+
+WorkStealingTaskQueue::Consumer*
+WorkStealingTaskQueue::GetLocalConsumer() noexcept {
+  auto local_data = local_consumer_data.Use();
+  if (local_data->queue != this) return nullptr;
+  return static_cast<Consumer*>(local_data->consumer);
+}
+
+void WorkStealingTaskQueue::DoPush(impl::TaskContext* context) {
+  auto* consumer = GetLocalConsumer();
+  if (!consumer) {
+    PushToSharedQueues(nullptr, context);
+    return;
+  }
+
+  if (context == consumer->current) {
+    // The task is being rescheduled right after its own step (e.g. it has
+    // yielded), let the other tasks run first.
+    PushToSharedQueues(consumer, context);
+    return;
+  }
+
+  auto* const evicted =
+      consumer->lifo_slot.exchange(context, std::memory_order_acq_rel);
+  if (evicted) PushToSharedQueues(consumer, evicted);
+  // The current step of this worker may take long, let an idle worker steal
+  // the task from the LIFO slot meanwhile.
+  NotifyParked();
+}
+
+void WorkStealingTaskQueue::PushToSharedQueues(Consumer* local_consumer,
+                                               impl::TaskContext* context) {
+  if (!local_consumer || !local_consumer->local_queue.TryPush(context)) {
+    global_queue_.enqueue(context);
+  }
+  NotifyParked();
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPop(Consumer& consumer) {
+  if (++consumer.pops_since_global_check >= kGlobalQueueCheckInterval) {
+    if (auto* context = TryPopGlobal(consumer)) return context;
+  }
+
+  if (consumer.lifo_streak < kMaxLifoStreak) {
+    if (auto* context =
+            consumer.lifo_slot.exchange(nullptr, std::memory_order_acq_rel)) {
+      ++consumer.lifo_streak;
+      return context;
+    }
+  }
+  consumer.lifo_streak = 0;
+
+  if (auto* context = consumer.local_queue.TryPop()) return context;
+  if (auto* context = TryPopGlobal(consumer)) return context;
+  if (auto* context =
+          consumer.lifo_slot.exchange(nullptr, std::memory_order_acq_rel)) {
+    return context;
+  }
+  return TrySteal(consumer);
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TryPopGlobal(Consumer& consumer) {
+  consumer.pops_since_global_check = 0;
+  impl::TaskContext* context{};
+  if (global_queue_.try_dequeue(context)) return context;
+  return nullptr;
+}
+
+impl::TaskContext* WorkStealingTaskQueue::TrySteal(Consumer& consumer) {
+  const auto count = consumers_.size();
+  if (count <= 1) return nullptr;
+
+  const auto start = consumer.NextRandom() % count;
+  for (std::size_t i = 0; i < count; ++i) {
+    auto& victim = consumers_[(start + i) % count];
+    if (&victim == &consumer) continue;
+
+    if (auto* context = victim.local_queue.TryPop()) return context;
+  }
+
+  // The victims may be stuck in long steps, do not let the tasks in their
+  // LIFO slots wait for them.
+  for (std::size_t i = 0; i < count; ++i) {
+    auto& victim = consumers_[(start + i) % count];
+    if (&victim == &consumer) continue;
+
+    if (victim.lifo_slot.load(std::memory_order_relaxed)) {
+      if (auto* context =
+              victim.lifo_slot.exchange(nullptr, std::memory_order_acq_rel)) {
+        return context;
+      }
+    }
+  }
+  return nullptr;
+}
+
+bool WorkStealingTaskQueue::HasTasksApproximate() const noexcept {
+  if (global_queue_.size_approx() != 0) return true;
+  for (const auto& consumer : consumers_) {
+    if (consumer.local_queue.GetSizeApproximate() != 0 ||
+        consumer.lifo_slot.load(std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool WorkStealingTaskQueue::Park(Consumer& consumer) {
+  {
+    const std::lock_guard lock{parked_mutex_};
+    if (is_stopped_) return false;
+    parked_.push_back(&consumer);
+    parked_count_->fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Pairs with the fence in NotifyParked: either the pusher sees us parked,
+  // or we see its task.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  // The most recently parked consumer is notified first, so in case of
+  // a race with a pusher we most likely wake up ourselves.
+  if (HasTasksApproximate()) NotifyParked();
+
+  // Each registration in parked_ is matched by exactly one signal.
+  consumer.semaphore.wait();
+  return true;
+}
+
+void WorkStealingTaskQueue::NotifyParked() {
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (parked_count_->load(std::memory_order_relaxed) == 0) return;
+
+  Consumer* consumer = nullptr;
+  {
+    const std::lock_guard lock{parked_mutex_};
+    if (parked_.empty()) return;
+    consumer = parked_.back();
+    parked_.pop_back();
+    parked_count_->fetch_sub(1, std::memory_order_relaxed);
+  }
+  consumer->semaphore.signal();
+}
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
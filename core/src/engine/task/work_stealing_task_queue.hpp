@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+#include <moodycamel/concurrentqueue.h>
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+#include <concurrent/impl/interference_shield.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/utils/fixed_array.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+namespace impl {
+class TaskContext;
+}  // namespace impl
+
+/// A task queue with a local queue and a LIFO slot per worker thread.
+///
+/// - A task woken up from a worker thread is put into the LIFO slot of that
+///   worker, so it runs next on the same thread with hot caches
+/// - The previous occupant of the LIFO slot goes to the local FIFO queue
+///   of the worker, or to the global queue if the local one is full
+/// - Tasks scheduled from outside the worker threads (e.g. from ev threads)
+///   go to the global queue
+/// - An idle worker checks the global queue and then steals from the other
+///   workers, starting from a random victim
+class WorkStealingTaskQueue final {
+ public:
+  explicit WorkStealingTaskQueue(const TaskProcessorConfig& config);
+  ~WorkStealingTaskQueue();
+
+  // Must be called from the worker thread number `index` before the first
+  // PopBlocking call.
+  void PrepareWorker(std::size_t index) noexcept;
+
+  void Push(boost::intrusive_ptr<impl::TaskContext>&& context);
+
+  // Returns nullptr as a stop signal
+  boost::intrusive_ptr<impl::TaskContext> PopBlocking();
+
+  void StopProcessing();
+
+  // Reads a counter maintained by Push and PopBlocking, so that the
+  // overload check of every Schedule does not scan all the workers
+  std::size_t GetSizeApproximate() const noexcept;
+
+ private:
+  class Consumer;
+
+  Consumer* GetLocalConsumer() noexcept;
+
+  void DoPush(impl::TaskContext* context);
+
+  void PushToSharedQueues(Consumer* local_consumer,
+                          impl::TaskContext* context);
+
+  impl::TaskContext* TryPop(Consumer& consumer);
+
+  impl::TaskContext* TryPopGlobal(Consumer& consumer);
+
+  impl::TaskContext* TrySteal(Consumer& consumer);
+
+  bool HasTasksApproximate() const noexcept;
+
+  // Returns false if the queue is stopped
+  bool Park(Consumer& consumer);
+
+  void NotifyParked();
+
+  moodycamel::ConcurrentQueue<impl::TaskContext*> global_queue_;
+  utils::FixedArray<Consumer> consumers_;
+
+  concurrent::impl::InterferenceShield<std::atomic<std::size_t>> size_{0};
+
+  concurrent::impl::InterferenceShield<std::atomic<std::size_t>>
+      parked_count_{0};
+  std::mutex parked_mutex_;
+  std::vector<Consumer*> parked_;
+  bool is_stopped_{false};
+};
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
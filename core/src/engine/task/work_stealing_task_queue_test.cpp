@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+
+#include <engine/task/task_processor.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+engine::TaskProcessorPoolsConfig MakeWorkStealingConfig() {
+  engine::TaskProcessorPoolsConfig config;
+  config.task_queue_type = engine::TaskQueueType::kWorkStealingTaskQueue;
+  return config;
+}
+
+}  // namespace
+
+TEST(WorkStealingTaskQueue, SingleThread) {
+  engine::RunStandalone(1, MakeWorkStealingConfig(), [] {
+    std::atomic<int> counter{0};
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (int i = 0; i < 1000; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([&counter] { ++counter; }));
+    }
+    for (auto& task : tasks) task.Get();
+    EXPECT_EQ(counter.load(), 1000);
+  });
+}
+
+TEST(WorkStealingTaskQueue, QueueSize) {
+  engine::RunStandalone(1, MakeWorkStealingConfig(), [] {
+    constexpr std::size_t kTasks = 10;
+    auto& task_processor = engine::current_task::GetTaskProcessor();
+    EXPECT_EQ(task_processor.GetTaskQueueSize(), 0);
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (std::size_t i = 0; i < kTasks; ++i) {
+      tasks.push_back(engine::AsyncNoSpan([] {}));
+    }
+    // The tasks are spread over the LIFO slot and the local queue
+    EXPECT_EQ(task_processor.GetTaskQueueSize(), kTasks);
+
+    for (auto& task : tasks) task.Get();
+    EXPECT_EQ(task_processor.GetTaskQueueSize(), 0);
+  });
+}
+
+TEST(WorkStealingTaskQueue, FanOut) {
+  constexpr int kSpawners = 8;
+  constexpr int kChildren = 500;
+
+  engine::RunStandalone(4, MakeWorkStealingConfig(), [] {
+    std::atomic<int> counter{0};
+    std::vector<engine::TaskWithResult<void>> spawners;
+    for (int i = 0; i < kSpawners; ++i) {
+      spawners.push_back(engine::AsyncNoSpan([&counter] {
+        std::vector<engine::TaskWithResult<void>> children;
+        for (int j = 0; j < kChildren; ++j) {
+          children.push_back(engine::AsyncNoSpan([&counter] {
+            engine::Yield();
+            ++counter;
+          }));
+        }
+        for (auto& child : children) child.Get();
+      }));
+    }
+    for (auto& spawner : spawners) spawner.Get();
+    EXPECT_EQ(counter.load(), kSpawners * kChildren);
+  });
+}
+
+TEST(WorkStealingTaskQueue, YieldDoesNotStarveOthers) {
+  engine::RunStandalone(1, MakeWorkStealingConfig(), [] {
+    std::atomic<bool> stop{false};
+    auto spinner = engine::AsyncNoSpan([&stop] {
+      while (!stop) engine::Yield();
+    });
+
+    engine::SingleConsumerEvent event;
+    auto waker = engine::AsyncNoSpan([&] {
+      stop = true;
+      event.Send();
+    });
+
+    EXPECT_TRUE(event.WaitForEvent());
+    waker.Get();
+    spinner.Get();
+  });
+}
+
+TEST(WorkStealingTaskQueue, PingPong) {
+  constexpr int kIterations = 10000;
+
+  engine::RunStandalone(2, MakeWorkStealingConfig(), [] {
+    engine::SingleConsumerEvent ping;
+    engine::SingleConsumerEvent pong;
+
+    auto other = engine::AsyncNoSpan([&] {
+      for (int i = 0; i < kIterations; ++i) {
+        ASSERT_TRUE(ping.WaitForEvent());
+        pong.Send();
+      }
+    });
+
+    for (int i = 0; i < kIterations; ++i) {
+      ping.Send();
+      ASSERT_TRUE(pong.WaitForEvent());
+    }
+    other.Get();
+  });
+}
+
+TEST(WorkStealingTaskQueue, LifoSlotTaskRunsWhileOwnerIsBusy) {
+  engine::RunStandalone(2, MakeWorkStealingConfig(), [] {
+    engine::SingleConsumerEvent event;
+    std::atomic<bool> is_woken{false};
+    auto waiter = engine::AsyncNoSpan([&] {
+      ASSERT_TRUE(event.WaitForEvent());
+      is_woken = true;
+    });
+
+    // Let the other worker park
+    engine::SleepFor(std::chrono::milliseconds{10});
+
+    // The waiter goes to the LIFO slot of this worker, which is busy
+    event.Send();
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (!is_woken && std::chrono::steady_clock::now() < deadline) {
+    }
+    EXPECT_TRUE(is_woken);
+    waiter.Get();
+  });
+}
+
+USERVER_NAMESPACE_END
@@ -3,7 +3,9 @@
 #include <boost/filesystem/operations.hpp>
 
 #include <userver/engine/async.hpp>
+#include <userver/engine/run_standalone.hpp>
 #include <userver/engine/task/task.hpp>
+#include <userver/fs/blocking/read.hpp>
 #include <userver/fs/blocking/temp_file.hpp>
 #include <userver/fs/blocking/write.hpp>
 #include <userver/fs/read.hpp>
@@ -52,4 +54,29 @@ UTEST_MT(AsyncFs, RewriteFileContentsAtomicallyConcurrent, 4) {
   EXPECT_EQ(new_text, fs::ReadFileContents(async_tp, file.GetPath()));
 }
 
+TEST(AsyncFs, RewriteAndReadIoUring) {
+  engine::TaskProcessorPoolsConfig config;
+  config.io_uring_enabled = true;
+
+  // Falls back to the async_tp if io_uring is not supported
+  engine::RunStandalone(1, config, [] {
+    const auto file = fs::blocking::TempFile::Create();
+    auto& async_tp = engine::current_task::GetTaskProcessor();
+
+    // Spans several read chunks
+    std::string text(200 * 1024 + 7, 'a');
+    text.back() = 'z';
+    UEXPECT_NO_THROW(fs::RewriteFileContents(async_tp, file.GetPath(), text));
+    EXPECT_EQ(fs::blocking::ReadFileContents(file.GetPath()), text);
+    EXPECT_EQ(fs::ReadFileContents(async_tp, file.GetPath()), text);
+
+    UEXPECT_NO_THROW(fs::RewriteFileContents(async_tp, file.GetPath(), ""));
+    EXPECT_EQ(fs::ReadFileContents(async_tp, file.GetPath()), "");
+
+    UEXPECT_THROW(
+        fs::ReadFileContents(async_tp, file.GetPath() + "-does-not-exist"),
+        std::runtime_error);
+  });
+}
+
 USERVER_NAMESPACE_END
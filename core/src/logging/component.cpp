@@ -77,6 +77,12 @@ void Logging::Init(const ComponentConfig& config,
           "for the default logger");
     }
 
+    if (logger_config.testsuite_capture &&
+        logger_config.format == logging::Format::kBinary) {
+      throw std::runtime_error(
+          "Testsuite capture requires a text logging format");
+    }
+
     auto logger = logging::impl::GetDefaultLoggerOrMakeTpLogger(logger_config);
 
     if (is_default_logger) {
@@ -95,7 +101,8 @@ void Logging::Init(const ComponentConfig& config,
 
     logger->StartConsumerTask(context.GetTaskProcessor(tp_name),
                               logger_config.message_queue_size,
-                              logger_config.queue_overflow_behavior);
+                              logger_config.queue_overflow_behavior,
+                              logger_config.thread_buffer_size);
 
     auto insertion_result =
         loggers_.emplace(logger_config.logger_name, std::move(logger));
@@ -262,6 +269,7 @@ properties:
                       - tskv
                       - ltsv
                       - raw
+                      - binary
                 flush_level:
                     type: string
                     description: messages of this and higher levels get flushed to the file immediately
@@ -277,6 +285,10 @@ properties:
                     enum:
                       - discard
                       - block
+                thread_buffer_size:
+                    type: integer
+                    description: the size in bytes of per-thread lock-free buffers for log records, 0 disables them
+                    defaultDescription: 0
                 fs-task-processor:
                     type: string
                     description: task processor for disk I/O operations for this logger
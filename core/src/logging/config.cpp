@@ -52,6 +52,9 @@ LoggerConfig Parse(const yaml_config::YamlConfig& value,
       value["overflow_behavior"].As<QueueOverflowBehavior>(
           config.queue_overflow_behavior);
 
+  config.thread_buffer_size =
+      value["thread_buffer_size"].As<size_t>(config.thread_buffer_size);
+
   config.fs_task_processor =
       value["fs-task-processor"].As<std::optional<std::string>>();
 
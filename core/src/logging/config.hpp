@@ -40,6 +40,8 @@ struct LoggerConfig final {
   size_t message_queue_size = kDefaultMessageQueueSize;
   QueueOverflowBehavior queue_overflow_behavior =
       QueueOverflowBehavior::kDiscard;
+  // 0 disables the per-thread buffers
+  size_t thread_buffer_size = 0;
 
   std::optional<std::string> fs_task_processor;
 
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <atomic>
+#include <string_view>
+#include <vector>
 
 #include <logging/impl/reopen_mode.hpp>
 #include <userver/logging/level.hpp>
+#include <userver/utils/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -22,6 +25,9 @@ class BaseSink {
 
   void Log(const LogMessage& message);
 
+  /// Writes the messages that pass the level filter in a single WriteBatch
+  void LogBatch(utils::span<const LogMessage> messages);
+
   virtual void Flush();
 
   virtual void Reopen(ReopenMode);
@@ -35,8 +41,14 @@ class BaseSink {
 
   virtual void Write(std::string_view log) = 0;
 
+  /// Calls Write for each record by default, may be overridden to write all
+  /// the records at once.
+  virtual void WriteBatch(utils::span<const std::string_view> logs);
+
  private:
   std::atomic<Level> level_{Level::kTrace};
+  // Used by LogBatch only, which is called from a single consumer
+  std::vector<std::string_view> batch_;
 };
 
 }  // namespace logging::impl
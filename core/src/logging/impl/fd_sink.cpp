@@ -1,13 +1,69 @@
 #include "fd_sink.hpp"
 
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <system_error>
+
+#include <userver/utils/fixed_array.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+namespace {
+
+#ifdef IOV_MAX
+constexpr std::size_t kMaxIovecs = IOV_MAX;
+#else
+constexpr std::size_t kMaxIovecs = 1024;
+#endif
+
+// Writes all the iovecs, adjusting them on partial writes
+void WriteAll(int fd, ::iovec* iov, std::size_t count) {
+  while (count != 0) {
+    const auto batch_size = std::min(count, kMaxIovecs);
+    ::ssize_t written = ::writev(fd, iov, static_cast<int>(batch_size));
+    if (written < 0) {
+      if (errno == EAGAIN || errno == EINTR) continue;
+
+      const auto code = std::make_error_code(std::errc{errno});
+      throw std::system_error(code, "calling ::writev");
+    }
+
+    while (count != 0 && static_cast<std::size_t>(written) >= iov->iov_len) {
+      written -= static_cast<::ssize_t>(iov->iov_len);
+      ++iov;
+      --count;
+    }
+    if (count != 0) {
+      iov->iov_base = static_cast<char*>(iov->iov_base) + written;
+      iov->iov_len -= written;
+    }
+  }
+}
+
+}  // namespace
+
 FdSink::FdSink(fs::blocking::FileDescriptor fd) : fd_{std::move(fd)} {}
 
 void FdSink::Write(std::string_view log) { fd_.Write(log); }
 
+void FdSink::WriteBatch(utils::span<const std::string_view> logs) {
+  if (logs.size() == 1) {
+    fd_.Write(logs[0]);
+    return;
+  }
+
+  auto iovecs = utils::GenerateFixedArray(logs.size(), [&](std::size_t i) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+    return ::iovec{const_cast<char*>(logs[i].data()), logs[i].size()};
+  });
+  WriteAll(fd_.GetNative(), iovecs.data(), iovecs.size());
+}
+
 void FdSink::Flush() {
   if (fd_.IsOpen()) {
     fd_.FSync();
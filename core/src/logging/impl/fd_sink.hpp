@@ -21,6 +21,9 @@ class FdSink : public BaseSink {
  protected:
   void Write(std::string_view log) final;
 
+  /// Writes the records with a minimal number of writev calls
+  void WriteBatch(utils::span<const std::string_view> logs) final;
+
   fs::blocking::FileDescriptor& GetFd();
 
   void SetFd(fs::blocking::FileDescriptor&& fd);
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+#include <concurrent/impl/interference_shield.hpp>
+#include <userver/logging/level.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+/// @brief A bounded lock-free ring buffer of formatted log records with
+/// a single producer thread and a single consumer.
+///
+/// Each record is stored contiguously as a header followed by the payload, so
+/// the consumer can pass the payloads to the sinks without copying. A record
+/// that does not fit into the tail of the ring is preceded by a padding
+/// record and written from the beginning of the ring.
+class ThreadLogBuffer final {
+ public:
+  /// @param capacity size of the ring in bytes, rounded up to a power of 2
+  explicit ThreadLogBuffer(std::size_t capacity)
+      : capacity_(RoundUpCapacity(capacity)),
+        storage_(std::make_unique<char[]>(capacity_)),
+        owner_(std::this_thread::get_id()) {}
+
+  ThreadLogBuffer(ThreadLogBuffer&&) = delete;
+  ThreadLogBuffer& operator=(ThreadLogBuffer&&) = delete;
+
+  /// Producer-only. Returns `false` if there is not enough free space.
+  bool TryWrite(Level level, std::string_view payload) noexcept {
+    const auto record_size = GetRecordSize(payload.size());
+    if (record_size > capacity_) return false;
+
+    auto tail = tail_->load(std::memory_order_acquire);
+    const auto head = head_->load(std::memory_order_acquire);
+    const auto offset = tail & (capacity_ - 1);
+    const auto padding =
+        capacity_ - offset < record_size ? capacity_ - offset : 0;
+    if (tail + padding + record_size - head > capacity_) return false;
+
+    if (padding != 0) {
+      WriteHeader(offset, {kPaddingMarker, 0});
+      tail += padding;
+    }
+
+    const auto record_offset = tail & (capacity_ - 1);
+    WriteHeader(record_offset, {static_cast<std::uint32_t>(payload.size()),
+                                static_cast<std::uint32_t>(level)});
+    std::memcpy(storage_.get() + record_offset + sizeof(Header), payload.data(),
+                payload.size());
+    tail_->store(tail + record_size, std::memory_order_release);
+    return true;
+  }
+
+  /// Consumer-only. Calls `func(Level, std::string_view)` for each record
+  /// written so far. The payloads stay valid until `Release` is called with
+  /// the returned position.
+  template <typename Func>
+  std::size_t Consume(Func&& func) const {
+    auto head = head_->load(std::memory_order_relaxed);
+    const auto tail = tail_->load(std::memory_order_acquire);
+
+    while (head != tail) {
+      const auto offset = head & (capacity_ - 1);
+      const auto header = ReadHeader(offset);
+      if (header.size == kPaddingMarker) {
+        head += capacity_ - offset;
+        continue;
+      }
+
+      func(static_cast<Level>(header.level),
+           std::string_view{storage_.get() + offset + sizeof(Header),
+                            header.size});
+      head += GetRecordSize(header.size);
+    }
+    return head;
+  }
+
+  /// Consumer-only. Frees the space of the records consumed up to `position`.
+  void Release(std::size_t position) noexcept {
+    head_->store(position, std::memory_order_release);
+  }
+
+  bool IsEmptyApprox() const noexcept {
+    return head_->load(std::memory_order_relaxed) ==
+           tail_->load(std::memory_order_relaxed);
+  }
+
+  std::size_t GetCapacity() const noexcept { return capacity_; }
+
+  /// The thread that created the buffer, the only one allowed to write to it.
+  std::thread::id GetOwner() const noexcept { return owner_; }
+
+ private:
+  struct Header final {
+    std::uint32_t size;
+    std::uint32_t level;
+  };
+
+  static constexpr std::uint32_t kPaddingMarker = 0xFFFFFFFF;
+  // Every record starts at a multiple of the header size, so a header never
+  // crosses the end of the ring.
+  static constexpr std::size_t kAlignment = sizeof(Header);
+
+  static std::size_t RoundUpCapacity(std::size_t capacity) {
+    UINVARIANT(capacity >= 64 && capacity <= (std::size_t{1} << 31),
+               "Invalid log buffer size");
+    std::size_t result = 64;
+    while (result < capacity) result <<= 1;
+    return result;
+  }
+
+  static std::size_t GetRecordSize(std::size_t payload_size) noexcept {
+    return sizeof(Header) +
+           (payload_size + kAlignment - 1) / kAlignment * kAlignment;
+  }
+
+  void WriteHeader(std::size_t offset, Header header) noexcept {
+    std::memcpy(storage_.get() + offset, &header, sizeof(header));
+  }
+
+  Header ReadHeader(std::size_t offset) const noexcept {
+    Header header{};
+    std::memcpy(&header, storage_.get() + offset, sizeof(header));
+    return header;
+  }
+
+  const std::size_t capacity_;
+  const std::unique_ptr<char[]> storage_;
+  const std::thread::id owner_;
+
+  concurrent::impl::InterferenceShield<std::atomic<std::size_t>> head_{0};
+  concurrent::impl::InterferenceShield<std::atomic<std::size_t>> tail_{0};
+};
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,122 @@
+#include <logging/impl/thread_log_buffer.hpp>
+
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using logging::Level;
+using logging::impl::ThreadLogBuffer;
+
+using Records = std::vector<std::pair<Level, std::string>>;
+
+Records ConsumeAll(ThreadLogBuffer& buffer) {
+  Records result;
+  const auto position =
+      buffer.Consume([&result](Level level, std::string_view payload) {
+        result.emplace_back(level, std::string{payload});
+      });
+  buffer.Release(position);
+  return result;
+}
+
+}  // namespace
+
+TEST(ThreadLogBuffer, Capacity) {
+  EXPECT_EQ(ThreadLogBuffer{64}.GetCapacity(), 64);
+  EXPECT_EQ(ThreadLogBuffer{100}.GetCapacity(), 128);
+  EXPECT_EQ(ThreadLogBuffer{4096}.GetCapacity(), 4096);
+}
+
+TEST(ThreadLogBuffer, Fifo) {
+  ThreadLogBuffer buffer{1024};
+  EXPECT_TRUE(buffer.IsEmptyApprox());
+  EXPECT_EQ(buffer.GetOwner(), std::this_thread::get_id());
+
+  EXPECT_TRUE(buffer.TryWrite(Level::kInfo, "first"));
+  EXPECT_TRUE(buffer.TryWrite(Level::kError, ""));
+  EXPECT_TRUE(buffer.TryWrite(Level::kDebug, "third"));
+  EXPECT_FALSE(buffer.IsEmptyApprox());
+
+  const Records expected{
+      {Level::kInfo, "first"}, {Level::kError, ""}, {Level::kDebug, "third"}};
+  EXPECT_EQ(ConsumeAll(buffer), expected);
+  EXPECT_TRUE(buffer.IsEmptyApprox());
+  EXPECT_TRUE(ConsumeAll(buffer).empty());
+}
+
+TEST(ThreadLogBuffer, Overflow) {
+  ThreadLogBuffer buffer{64};
+  EXPECT_FALSE(buffer.TryWrite(Level::kInfo, std::string(64, 'x')));
+
+  // 8 bytes of header + 24 bytes of payload
+  EXPECT_TRUE(buffer.TryWrite(Level::kInfo, std::string(24, 'a')));
+  EXPECT_TRUE(buffer.TryWrite(Level::kInfo, std::string(24, 'b')));
+  EXPECT_FALSE(buffer.TryWrite(Level::kInfo, "c"));
+
+  EXPECT_EQ(ConsumeAll(buffer).size(), 2);
+  EXPECT_TRUE(buffer.TryWrite(Level::kInfo, "c"));
+}
+
+TEST(ThreadLogBuffer, Wraparound) {
+  ThreadLogBuffer buffer{64};
+
+  for (int i = 0; i < 100; ++i) {
+    const std::string first(i % 20, 'a');
+    const std::string second(20 - i % 20, 'b');
+    ASSERT_TRUE(buffer.TryWrite(Level::kWarning, first));
+    ASSERT_TRUE(buffer.TryWrite(Level::kInfo, second));
+
+    const Records expected{{Level::kWarning, first}, {Level::kInfo, second}};
+    ASSERT_EQ(ConsumeAll(buffer), expected);
+  }
+}
+
+TEST(ThreadLogBuffer, ReleaseKeepsUnconsumed) {
+  ThreadLogBuffer buffer{256};
+  EXPECT_TRUE(buffer.TryWrite(Level::kInfo, "1"));
+
+  Records consumed;
+  const auto position =
+      buffer.Consume([&consumed](Level level, std::string_view payload) {
+        consumed.emplace_back(level, std::string{payload});
+      });
+  EXPECT_TRUE(buffer.TryWrite(Level::kInfo, "2"));
+  buffer.Release(position);
+
+  EXPECT_EQ(consumed, (Records{{Level::kInfo, "1"}}));
+  EXPECT_EQ(ConsumeAll(buffer), (Records{{Level::kInfo, "2"}}));
+}
+
+TEST(ThreadLogBuffer, ConcurrentProducerConsumer) {
+  constexpr int kRecords = 10000;
+  ThreadLogBuffer buffer{256};
+
+  std::thread producer([&buffer] {
+    for (int i = 0; i < kRecords; ++i) {
+      const auto payload = std::to_string(i);
+      while (!buffer.TryWrite(Level::kInfo, payload)) std::this_thread::yield();
+    }
+  });
+
+  int next = 0;
+  while (next < kRecords) {
+    const auto position =
+        buffer.Consume([&next](Level level, std::string_view payload) {
+          ASSERT_EQ(level, Level::kInfo);
+          ASSERT_EQ(payload, std::to_string(next));
+          ++next;
+        });
+    buffer.Release(position);
+  }
+  producer.join();
+  EXPECT_TRUE(buffer.IsEmptyApprox());
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,288 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <logging/binary_log_format.hpp>
+#include <logging/logging_test.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace binary = logging::impl::binary;
+
+struct DecodedRecord final {
+  logging::Level level{};
+  std::chrono::microseconds timestamp{};
+  std::map<std::string, std::string> tags;
+};
+
+class Reader final {
+ public:
+  explicit Reader(std::string_view data) : data_(data) {}
+
+  bool IsEmpty() const { return data_.empty(); }
+
+  std::uint64_t Fixed(std::size_t bytes) {
+    const auto chunk = Take(bytes);
+    std::uint64_t result = 0;
+    for (std::size_t i = 0; i < bytes; ++i) {
+      result |= std::uint64_t{static_cast<std::uint8_t>(chunk[i])} << (8 * i);
+    }
+    return result;
+  }
+
+  std::uint64_t Varint() {
+    std::uint64_t result = 0;
+    for (int shift = 0;; shift += 7) {
+      const auto byte = Fixed(1);
+      result |= (byte & 0x7F) << shift;
+      if (!(byte & 0x80)) return result;
+    }
+  }
+
+  std::string_view Take(std::size_t bytes) {
+    if (bytes > data_.size()) throw std::runtime_error("Truncated record");
+    const auto result = data_.substr(0, bytes);
+    data_.remove_prefix(bytes);
+    return result;
+  }
+
+ private:
+  std::string_view data_;
+};
+
+std::string DecodeValue(Reader& reader) {
+  std::string result;
+  while (true) {
+    switch (static_cast<binary::PartType>(reader.Fixed(1))) {
+      case binary::PartType::kEnd:
+        return result;
+      case binary::PartType::kText:
+        result += reader.Take(reader.Fixed(sizeof(std::uint32_t)));
+        break;
+      case binary::PartType::kUnsigned:
+        result += std::to_string(reader.Varint());
+        break;
+      case binary::PartType::kSigned: {
+        const auto zigzag = reader.Varint();
+        result += std::to_string(static_cast<std::int64_t>(zigzag >> 1) ^
+                                 -static_cast<std::int64_t>(zigzag & 1));
+        break;
+      }
+      case binary::PartType::kHex:
+        result += fmt::format("0x{:016X}", reader.Fixed(sizeof(std::uint64_t)));
+        break;
+      case binary::PartType::kHexShort:
+        result += fmt::format("{:X}", reader.Varint());
+        break;
+      case binary::PartType::kHexBytes:
+        for (const char c : reader.Take(reader.Fixed(1))) {
+          result += fmt::format("{:02x}", static_cast<std::uint8_t>(c));
+        }
+        break;
+      default:
+        throw std::runtime_error("Unknown value part");
+    }
+  }
+}
+
+std::string GetRecordMarker() {
+  std::string marker;
+  binary::AppendFixed(marker, binary::kRecordMarker,
+                      binary::kRecordMarkerBytes);
+  return marker;
+}
+
+DecodedRecord DecodeRecord(Reader reader) {
+  if (reader.Fixed(1) != binary::kVersion) {
+    throw std::runtime_error("Unknown version");
+  }
+
+  DecodedRecord record;
+  record.level = static_cast<logging::Level>(reader.Fixed(1));
+  record.timestamp =
+      std::chrono::microseconds{reader.Fixed(sizeof(std::uint64_t))};
+
+  while (!reader.IsEmpty()) {
+    const auto key_id = static_cast<std::uint8_t>(reader.Fixed(1));
+    std::string key;
+    if (key_id == binary::kInlineKey) {
+      key = reader.Take(reader.Varint());
+    } else {
+      const auto interned = binary::kInternedKeys.TryFindBySecond(key_id);
+      if (!interned) throw std::runtime_error("Unknown key id");
+      key = *interned;
+    }
+    const bool inserted =
+        record.tags.emplace(std::move(key), DecodeValue(reader)).second;
+    if (!inserted) throw std::runtime_error("Repeated key");
+  }
+  return record;
+}
+
+std::vector<DecodedRecord> Decode(std::string_view data) {
+  std::vector<DecodedRecord> records;
+  Reader stream{data};
+  while (!stream.IsEmpty()) {
+    if (stream.Fixed(binary::kRecordMarkerBytes) != binary::kRecordMarker) {
+      throw std::runtime_error("No record marker");
+    }
+    records.push_back(DecodeRecord(
+        Reader{stream.Take(stream.Fixed(binary::kRecordSizeBytes))}));
+  }
+  return records;
+}
+
+// Skips the corrupted data the same way as scripts/binary_logs.py does
+std::vector<DecodedRecord> DecodeSkippingCorrupted(std::string_view data,
+                                                   std::size_t& skipped) {
+  const auto marker = GetRecordMarker();
+  std::vector<DecodedRecord> records;
+  skipped = 0;
+  while (!data.empty()) {
+    if (data.substr(0, marker.size()) != marker) {
+      const auto next = std::min(data.find(marker, 1), data.size());
+      skipped += next;
+      data.remove_prefix(next);
+      continue;
+    }
+
+    try {
+      Reader stream{data};
+      stream.Take(binary::kRecordMarkerBytes);
+      const auto size = stream.Fixed(binary::kRecordSizeBytes);
+      auto record = DecodeRecord(Reader{stream.Take(size)});
+      const auto rest = data.substr(binary::kRecordMarkerBytes +
+                                    binary::kRecordSizeBytes + size);
+      // The size of a truncated record may point into the next records
+      const bool is_followed_by_marker =
+          rest.size() < marker.size()
+              ? std::string_view{marker}.substr(0, rest.size()) == rest
+              : rest.substr(0, marker.size()) == marker;
+      if (!is_followed_by_marker) {
+        throw std::runtime_error("No record marker after the record");
+      }
+      records.push_back(std::move(record));
+      data = rest;
+    } catch (const std::runtime_error&) {
+      ++skipped;
+      data.remove_prefix(1);
+    }
+  }
+  return records;
+}
+
+}  // namespace
+
+TEST_F(LoggingBinaryTest, Basic) {
+  const auto before = std::chrono::system_clock::now();
+  LOG_WARNING() << "text " << 42 << ' ' << -7 << ' ' << logging::HexShort{255U}
+                << ' ' << 1.5 << " with\ttab";
+  logging::LogFlush();
+  const auto after = std::chrono::system_clock::now();
+
+  const auto records = Decode(GetStreamString());
+  ASSERT_EQ(records.size(), 1);
+  const auto& record = records.front();
+
+  EXPECT_EQ(record.level, logging::Level::kWarning);
+  EXPECT_GE(record.timestamp, std::chrono::duration_cast<std::chrono::microseconds>(
+                                  before.time_since_epoch()));
+  EXPECT_LE(record.timestamp, std::chrono::duration_cast<std::chrono::microseconds>(
+                                  after.time_since_epoch()));
+
+  EXPECT_EQ(record.tags.at("text"), "text 42 -7 FF 1.5 with\ttab");
+  EXPECT_NE(record.tags.at("module").find("log_binary_test.cpp"),
+            std::string::npos);
+  EXPECT_EQ(record.tags.at("thread_id").substr(0, 2), "0x");
+  EXPECT_EQ(record.tags.at("thread_id").size(), 18);
+  EXPECT_EQ(record.tags.count("task_id"), 1);
+}
+
+TEST_F(LoggingBinaryTest, LogExtra) {
+  LOG_INFO() << "message"
+             << logging::LogExtra{{"int_tag", -100500},
+                                  {"key.with spaces", "value"},
+                                  {"meta_type", std::string(300, 'x')}};
+  logging::LogFlush();
+
+  const auto records = Decode(GetStreamString());
+  ASSERT_EQ(records.size(), 1);
+  const auto& tags = records.front().tags;
+
+  EXPECT_EQ(tags.at("text"), "message");
+  EXPECT_EQ(tags.at("int_tag"), "-100500");
+  EXPECT_EQ(tags.at("key.with spaces"), "value");
+  EXPECT_EQ(tags.at("meta_type"), std::string(300, 'x'));
+}
+
+TEST_F(LoggingBinaryTest, MultipleRecords) {
+  constexpr std::size_t kRecords = 10;
+  for (std::size_t i = 0; i < kRecords; ++i) {
+    LOG_ERROR() << i;
+  }
+  logging::LogFlush();
+
+  const auto records = Decode(GetStreamString());
+  ASSERT_EQ(records.size(), kRecords);
+  for (std::size_t i = 0; i < kRecords; ++i) {
+    EXPECT_EQ(records[i].level, logging::Level::kError);
+    EXPECT_EQ(records[i].tags.at("text"), std::to_string(i));
+  }
+}
+
+UTEST_F(LoggingBinaryTest, SpanIds) {
+  tracing::Span span{"span_name"};
+  LOG_INFO() << "inside span";
+  logging::LogFlush();
+
+  const auto records = Decode(GetStreamString());
+  ASSERT_EQ(records.size(), 1);
+  const auto& tags = records.front().tags;
+
+  EXPECT_EQ(tags.at("text"), "inside span");
+  EXPECT_EQ(tags.at("trace_id"), span.GetTraceId());
+  EXPECT_EQ(tags.at("span_id"), span.GetSpanId());
+  EXPECT_EQ(tags.at("link"), span.GetLink());
+}
+
+TEST_F(LoggingBinaryTest, SkipsCorruptedRecords) {
+  LOG_INFO() << "first";
+  LOG_INFO() << "second";
+  LOG_INFO() << "third";
+  logging::LogFlush();
+
+  auto data = GetStreamString();
+  ASSERT_EQ(Decode(data).size(), 3);
+
+  // Cut the second record in half, its size now points into the third one
+  const auto marker = GetRecordMarker();
+  const auto second = data.find(marker, 1);
+  ASSERT_NE(second, std::string::npos);
+  const auto third = data.find(marker, second + 1);
+  ASSERT_NE(third, std::string::npos);
+  const auto half = (third - second) / 2;
+  data.erase(second + half, third - second - half);
+  data.insert(0, "garbage");
+
+  std::size_t skipped = 0;
+  const auto records = DecodeSkippingCorrupted(data, skipped);
+  ASSERT_EQ(records.size(), 2);
+  EXPECT_EQ(records[0].tags.at("text"), "first");
+  EXPECT_EQ(records[1].tags.at("text"), "third");
+  EXPECT_EQ(skipped, std::string_view{"garbage"}.size() + half);
+}
+
+USERVER_NAMESPACE_END
@@ -15,7 +15,8 @@ namespace {
 
 class NoopLogger : public logging::impl::LoggerBase {
  public:
-  NoopLogger() noexcept : LoggerBase(logging::Format::kRaw) {
+  explicit NoopLogger(logging::Format format = logging::Format::kRaw) noexcept
+      : LoggerBase(format) {
     SetLevel(logging::Level::kInfo);
   }
   void Log(logging::Level, std::string_view) override {}
@@ -162,6 +163,23 @@ void LogPrependedTags(benchmark::State& state) {
 }
 BENCHMARK(LogPrependedTags);
 
+void LogFormats(benchmark::State& state) {
+  const auto format = static_cast<logging::Format>(state.range(0));
+  const logging::DefaultLoggerGuard guard{std::make_shared<NoopLogger>(format)};
+  const auto text = Launder(std::string{"Request processed"});
+  const auto number = Launder(std::uint64_t{1234567});
+
+  for ([[maybe_unused]] auto _ : state) {
+    LOG_INFO() << text << ", size=" << number << ", id="
+               << logging::HexShort{number}
+               << logging::LogExtra{{"status", 200}, {"path", "/v1/handler"}};
+  }
+}
+BENCHMARK(LogFormats)
+    ->Arg(static_cast<int>(logging::Format::kTskv))
+    ->Arg(static_cast<int>(logging::Format::kLtsv))
+    ->Arg(static_cast<int>(logging::Format::kBinary));
+
 }  // namespace
 
 USERVER_NAMESPACE_END
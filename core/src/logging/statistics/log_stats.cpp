@@ -8,6 +8,7 @@ namespace logging::statistics {
 
 void DumpMetric(utils::statistics::Writer& writer, const LogStatistics& stats) {
   writer["dropped"].ValueWithLabels(stats.dropped, {"version", "2"});
+  writer["thread_buffer_overflow"] = stats.thread_buffer_overflow;
 
   utils::statistics::Rate total;
 
@@ -15,6 +15,9 @@ using Counter = utils::statistics::RateCounter;
 
 struct LogStatistics final {
   Counter dropped{};
+  // Records that did not fit into the per-thread buffer of the producer and
+  // went through the shared queue instead
+  Counter thread_buffer_overflow{};
 
   std::array<Counter, kLevelMax + 1> by_level{};
   std::atomic<bool> has_reopening_error{false};
@@ -1,9 +1,14 @@
 #include "tp_logger.hpp"
 
+#include <algorithm>
+#include <array>
+
 #include <fmt/format.h>
 
 #include <engine/task/task_context.hpp>
+#include <userver/compiler/thread_local.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/tracing/span.hpp>
@@ -14,10 +19,62 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+namespace {
+
+// The buffers of the exited threads are freed, the limit protects from
+// a burst of short-lived threads.
+constexpr std::size_t kMaxThreadBuffers = 1024;
+
+using ThreadAliveFlag = std::atomic<bool>;
+
+struct LocalThreadBuffer final {
+  std::uint64_t logger_id{0};
+  // nullptr for a known logger means that no buffer was left for the thread
+  void* buffer{nullptr};
+  // TpLogger::thread_buffers_freed_ at the time the buffer was not found
+  std::uint64_t buffers_freed{0};
+};
+
+struct LocalThreadBuffersCache final {
+  std::array<LocalThreadBuffer, 4> entries{};
+  std::size_t next_victim{0};
+  // Shared with the buffers of the thread, lets the consumers free them after
+  // the thread exits
+  std::shared_ptr<ThreadAliveFlag> is_alive{
+      std::make_shared<ThreadAliveFlag>(true)};
+
+  ~LocalThreadBuffersCache() {
+    entries = {};
+    if (is_alive) is_alive->store(false, std::memory_order_release);
+    is_alive.reset();
+  }
+};
+
+compiler::ThreadLocal local_thread_buffers = [] {
+  return LocalThreadBuffersCache{};
+};
+
+std::atomic<std::uint64_t> next_logger_instance_id{1};
+
+}  // namespace
+
+struct TpLogger::ThreadBuffer final {
+  ThreadBuffer(std::size_t size, std::shared_ptr<const ThreadAliveFlag> flag)
+      : buffer(size), is_owner_alive(std::move(flag)) {}
+
+  ThreadLogBuffer buffer;
+  const std::shared_ptr<const ThreadAliveFlag> is_owner_alive;
+  // Set by the owner thread while it writes, see WaitForThreadBufferWriters
+  std::atomic<bool> is_writing{false};
+};
+
 struct TpLogger::ActionVisitor final {
   TpLogger& logger;
 
   void operator()(impl::async::Log&& log) const {
+    // Keep the order of records of the current thread: the ones in its buffer
+    // were logged before this one.
+    logger.DrainThreadBuffers();
     logger.AccountLogConsumed();
     logger.BackendLog(std::move(log));
   }
@@ -27,6 +84,7 @@ struct TpLogger::ActionVisitor final {
   }
 
   void operator()(impl::async::ReopenCoro&& reopen) const noexcept {
+    logger.DrainThreadBuffers();
     try {
       logger.BackendReopen(reopen.reopen_mode);
       reopen.promise.set_value();
@@ -39,23 +97,32 @@ struct TpLogger::ActionVisitor final {
 
   template <class Flush>
   void operator()(Flush&& flush) const {
+    logger.DrainThreadBuffers();
     logger.BackendFlush();
     flush.promise.set_value();
   }
 };
 
 TpLogger::TpLogger(Format format, std::string logger_name)
-    : LoggerBase(format), logger_name_(std::move(logger_name)) {
+    : LoggerBase(format),
+      logger_name_(std::move(logger_name)),
+      instance_id_(next_logger_instance_id.fetch_add(1)) {
   SetLevel(logging::Level::kInfo);
 }
 
 void TpLogger::StartConsumerTask(engine::TaskProcessor& task_processor,
                                  std::size_t max_queue_size,
-                                 QueueOverflowBehavior overflow_policy) {
+                                 QueueOverflowBehavior overflow_policy,
+                                 std::size_t thread_buffer_size) {
   UINVARIANT(max_queue_size != 0 && max_queue_size <= (std::size_t{1} << 31),
              "Invalid max queue size");
   max_queue_size_.store(max_queue_size);
   overflow_policy_.store(overflow_policy);
+  UINVARIANT(thread_buffer_size == 0 ||
+                 (thread_buffer_size >= 64 &&
+                  thread_buffer_size <= (std::size_t{1} << 31)),
+             "Invalid thread buffer size");
+  thread_buffer_size_.store(thread_buffer_size);
 
   auto expected = State::kSync;
   const bool success = state_.compare_exchange_strong(expected, State::kAsync);
@@ -132,6 +199,12 @@ void TpLogger::Log(Level level, std::string_view msg) {
     return;
   }
 
+  if (state_.load() == State::kAsync &&
+      thread_buffer_size_.load(std::memory_order_relaxed) != 0 &&
+      TryLogToThreadBuffer(level, msg)) {
+    return;
+  }
+
   if (TryWaitFreeQueueCapacity()) {
     // The queue might have concurrently become full, in which case the size
     // will temporarily go over the max size. The actual number of log actions
@@ -211,6 +284,8 @@ void TpLogger::ProcessingLoop() {
     queue_.WaitWhileEmpty(queue_consumer_);
   }
 
+  WaitForThreadBufferWriters();
+  DrainThreadBuffers();
   CleanUpQueue(std::move(queue_consumer_));
 }
 
@@ -275,11 +350,165 @@ void TpLogger::AccountLogConsumed() noexcept {
   }
 }
 
+TpLogger::ThreadBuffer* TpLogger::GetLocalThreadBuffer() {
+  auto cache = local_thread_buffers.Use();
+  // The thread is exiting
+  if (!cache->is_alive) return nullptr;
+
+  LocalThreadBuffer* overflow_entry = nullptr;
+  for (auto& entry : cache->entries) {
+    if (entry.logger_id != instance_id_) continue;
+    if (entry.buffer) return static_cast<ThreadBuffer*>(entry.buffer);
+    // Do not take the mutex on every record until some buffers are freed
+    if (entry.buffers_freed ==
+        thread_buffers_freed_.load(std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    overflow_entry = &entry;
+    break;
+  }
+
+  const auto buffers_freed =
+      thread_buffers_freed_.load(std::memory_order_relaxed);
+  ThreadBuffer* buffer = nullptr;
+  {
+    const std::lock_guard lock{thread_buffers_mutex_};
+    // The entry might have been evicted from the cache by other loggers
+    for (const auto& thread_buffer : thread_buffers_) {
+      if (thread_buffer->is_owner_alive == cache->is_alive) {
+        buffer = thread_buffer.get();
+        break;
+      }
+    }
+    if (!buffer && thread_buffers_.size() < kMaxThreadBuffers) {
+      thread_buffers_.push_back(std::make_unique<ThreadBuffer>(
+          thread_buffer_size_.load(), cache->is_alive));
+      buffer = thread_buffers_.back().get();
+    }
+  }
+
+  auto& entry =
+      overflow_entry
+          ? *overflow_entry
+          : cache->entries[cache->next_victim++ % cache->entries.size()];
+  entry = {instance_id_, buffer, buffers_freed};
+  return buffer;
+}
+
+bool TpLogger::TryLogToThreadBuffer(Level level, std::string_view msg) {
+  auto* const thread_buffer = GetLocalThreadBuffer();
+  if (!thread_buffer) {
+    ++stats_.thread_buffer_overflow;
+    return false;
+  }
+
+  // Pairs with the fence in WaitForThreadBufferWriters: either the consumer
+  // waits for this write before its final drain, or we see that it stops.
+  thread_buffer->is_writing.store(true, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  utils::FastScopeGuard writing_guard([thread_buffer]() noexcept {
+    thread_buffer->is_writing.store(false, std::memory_order_release);
+  });
+  if (state_.load(std::memory_order_relaxed) != State::kAsync) return false;
+
+  if (!thread_buffer->buffer.TryWrite(level, msg)) {
+    ++stats_.thread_buffer_overflow;
+    return false;
+  }
+
+  // Pairs with the fence in ConsumeNode: either the consumer sees our record,
+  // or we see that the consumer has to be woken up.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (!wakeup_pending_->load(std::memory_order_relaxed) &&
+      !wakeup_pending_->exchange(true)) {
+    DoPush(wakeup_node_);
+  }
+  return true;
+}
+
+void TpLogger::WaitForThreadBufferWriters() {
+  if (thread_buffer_size_.load(std::memory_order_relaxed) == 0) return;
+
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  drained_buffers_.clear();
+  {
+    const std::lock_guard lock{thread_buffers_mutex_};
+    for (const auto& thread_buffer : thread_buffers_) {
+      if (thread_buffer->is_writing.load(std::memory_order_relaxed)) {
+        drained_buffers_.push_back(thread_buffer.get());
+      }
+    }
+  }
+
+  // Only the consumer frees the buffers, a write does not take long
+  for (const auto* thread_buffer : drained_buffers_) {
+    while (thread_buffer->is_writing.load(std::memory_order_acquire)) {
+      engine::Yield();
+    }
+  }
+}
+
+void TpLogger::DrainThreadBuffers() noexcept {
+  if (thread_buffer_size_.load(std::memory_order_relaxed) == 0) return;
+
+  try {
+    drained_buffers_.clear();
+    {
+      const std::lock_guard lock{thread_buffers_mutex_};
+      // Nobody writes into the buffers of the exited threads, they are freed
+      // once drained
+      const auto freed_begin =
+          std::remove_if(thread_buffers_.begin(), thread_buffers_.end(),
+                         [](const auto& thread_buffer) {
+                           return !thread_buffer->is_owner_alive->load(
+                                      std::memory_order_acquire) &&
+                                  thread_buffer->buffer.IsEmptyApprox();
+                         });
+      if (freed_begin != thread_buffers_.end()) {
+        thread_buffers_.erase(freed_begin, thread_buffers_.end());
+        thread_buffers_freed_.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      for (const auto& thread_buffer : thread_buffers_) {
+        if (!thread_buffer->buffer.IsEmptyApprox()) {
+          drained_buffers_.push_back(thread_buffer.get());
+        }
+      }
+    }
+
+    drained_positions_.clear();
+    drained_messages_.clear();
+    for (const auto* thread_buffer : drained_buffers_) {
+      drained_positions_.push_back(thread_buffer->buffer.Consume(
+          [this](Level level, std::string_view payload) {
+            drained_messages_.push_back(LogMessage{payload, level});
+          }));
+    }
+    if (drained_messages_.empty()) return;
+
+    BackendLogBatch(drained_messages_);
+
+    for (std::size_t i = 0; i < drained_buffers_.size(); ++i) {
+      drained_buffers_[i]->buffer.Release(drained_positions_[i]);
+    }
+  } catch (const std::exception& e) {
+    UASSERT_MSG(false, fmt::format("Exception while draining thread buffers: {}",
+                                   e.what()));
+  }
+}
+
 void TpLogger::ConsumeNode(
     concurrent::impl::SinglyLinkedBaseHook& node) noexcept {
   // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
   auto& action_node = static_cast<impl::async::ActionNode&>(node);
   if (&action_node == &stop_node_) return;
+  if (&action_node == &wakeup_node_) {
+    // From now on the producers may push wakeup_node_ again
+    wakeup_pending_->exchange(false);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    DrainThreadBuffers();
+    return;
+  }
 
   BackendPerform(std::move(action_node.action));
   delete &action_node;
@@ -315,6 +544,24 @@ void TpLogger::BackendLog(impl::async::Log&& action) const {
   }
 }
 
+void TpLogger::BackendLogBatch(utils::span<const LogMessage> messages) const {
+  for (const auto& sink : GetSinks()) {
+    try {
+      sink->LogBatch(messages);
+    } catch (const std::exception& e) {
+      UASSERT_MSG(false, "While writing log messages caught an exception: " +
+                             std::string(e.what()));
+    }
+  }
+
+  for (const auto& message : messages) {
+    if (ShouldFlush(message.level)) {
+      BackendFlush();
+      break;
+    }
+  }
+}
+
 void TpLogger::BackendFlush() const {
   for (const auto& sink : GetSinks()) {
     try {
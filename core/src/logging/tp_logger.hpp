@@ -1,9 +1,11 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <future>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <variant>
@@ -22,6 +24,7 @@
 #include <logging/config.hpp>
 #include <logging/impl/base_sink.hpp>
 #include <logging/impl/reopen_mode.hpp>
+#include <logging/impl/thread_log_buffer.hpp>
 #include <logging/statistics/log_stats.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -62,6 +65,15 @@ struct ActionNode final : public concurrent::impl::SinglyLinkedBaseHook {
 }  // namespace async
 
 /// @brief Asynchronous logger that logs into a specific TaskProcessor.
+///
+/// By default each record is allocated and pushed into a shared queue. If
+/// `thread_buffer_size` is passed to StartConsumerTask, the records are
+/// written into per-thread ring buffers instead, and the consumer task drains
+/// them in batches. A record that does not fit into the buffer of its thread
+/// goes through the shared queue, honoring `max_queue_size` and
+/// `overflow_policy`. Records from different threads (including records of
+/// a single task that has migrated between threads) may be reordered. The
+/// buffers of the exited threads are freed once drained.
 class TpLogger final : public LoggerBase {
  public:
   TpLogger(Format format, std::string logger_name);
@@ -69,7 +81,8 @@ class TpLogger final : public LoggerBase {
 
   void StartConsumerTask(engine::TaskProcessor& task_processor,
                          std::size_t max_queue_size,
-                         QueueOverflowBehavior overflow_policy);
+                         QueueOverflowBehavior overflow_policy,
+                         std::size_t thread_buffer_size = 0);
 
   void StopConsumerTask();
 
@@ -90,6 +103,7 @@ class TpLogger final : public LoggerBase {
 
  private:
   struct ActionVisitor;
+  struct ThreadBuffer;
 
   enum class State {
     kSync,
@@ -109,12 +123,19 @@ class TpLogger final : public LoggerBase {
   void ConsumeQueueOnce(Queue::Consumer& consumer) noexcept;
   void CleanUpQueue(Queue::Consumer&& consumer) noexcept;
   void AccountLogConsumed() noexcept;
+  ThreadBuffer* GetLocalThreadBuffer();
+  bool TryLogToThreadBuffer(Level level, std::string_view msg);
+  void WaitForThreadBufferWriters();
+  void DrainThreadBuffers() noexcept;
   void BackendPerform(impl::async::Action&& action) noexcept;
   void BackendLog(impl::async::Log&& action) const;
+  void BackendLogBatch(utils::span<const LogMessage> messages) const;
   void BackendFlush() const;
   void BackendReopen(ReopenMode reopen_mode) const;
 
   const std::string logger_name_;
+  // Distinguishes loggers in the per-thread caches of buffers
+  const std::uint64_t instance_id_;
   std::vector<impl::SinkPtr> sinks_;
   mutable statistics::LogStatistics stats_{};
 
@@ -129,10 +150,27 @@ class TpLogger final : public LoggerBase {
   Queue::Consumer queue_consumer_;
   // A dummy action used for notifying the async task during stopping.
   impl::async::ActionNode stop_node_;
+  // A dummy action used for notifying the async task about new records in
+  // the thread buffers. Is in the queue only while wakeup_pending_ is set.
+  impl::async::ActionNode wakeup_node_;
+
+  // 0 if the thread buffers are disabled
+  std::atomic<std::size_t> thread_buffer_size_{0};
+  std::mutex thread_buffers_mutex_;
+  std::vector<std::unique_ptr<ThreadBuffer>> thread_buffers_;
+  // Incremented under thread_buffers_mutex_ when buffers are freed, lets the
+  // threads left without a buffer retry
+  std::atomic<std::uint64_t> thread_buffers_freed_{0};
+  // Used by the queue consumer only
+  std::vector<ThreadBuffer*> drained_buffers_;
+  std::vector<std::size_t> drained_positions_;
+  std::vector<LogMessage> drained_messages_;
 
   Queue queue_;
   concurrent::impl::InterferenceShield<std::atomic<QueueSize>> produced_{0};
   concurrent::impl::InterferenceShield<std::atomic<QueueSize>> consumed_{0};
+  concurrent::impl::InterferenceShield<std::atomic<bool>> wakeup_pending_{
+      false};
 };
 
 }  // namespace logging::impl
@@ -1,8 +1,13 @@
 #include <logging/tp_logger.hpp>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 #include <gmock/gmock.h>
 
 #include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/utest/utest.hpp>
 #include <userver/utils/statistics/storage.hpp>
@@ -47,7 +52,8 @@ class LoggingTestCoro : public LoggingTestBase {
 
   std::shared_ptr<logging::impl::TpLogger> StartAsyncLogger(
       std::size_t queue_size_max = 10,
-      QueueOverflowBehavior on_overflow = QueueOverflowBehavior::kDiscard) {
+      QueueOverflowBehavior on_overflow = QueueOverflowBehavior::kDiscard,
+      std::size_t thread_buffer_size = 0) {
     UASSERT_MSG(engine::current_task::IsTaskProcessorThread(),
                 "Misconfigured test. Should be run in coroutine environment");
 
@@ -59,7 +65,7 @@ class LoggingTestCoro : public LoggingTestBase {
         });
 
     logger->StartConsumerTask(engine::current_task::GetTaskProcessor(),
-                              queue_size_max, on_overflow);
+                              queue_size_max, on_overflow, thread_buffer_size);
 
     // Tracing should not break the TpLogger
     logger->SetLevel(logging::Level::kTrace);
@@ -784,4 +790,108 @@ UTEST_F_MT(LoggingTestCoro, TpLoggerLogMultipleStdThreadFlushSyncCancelMT, 4) {
   EXPECT_EQ(GetRecordsCount(), message_count);
 }
 
+UTEST_F(LoggingTestCoro, TpLoggerThreadBuffersBasic) {
+  auto logger = StartAsyncLogger(10, QueueOverflowBehavior::kDiscard, 4096);
+
+  LOG_INFO_TO(logger) << "Some log";
+  logger->Flush();
+  EXPECT_THAT(LoggedText(), testing::HasSubstr("Some log"));
+  logger->StopConsumerTask();
+  EXPECT_EQ(GetRecordsCount(), 1);
+
+  EXPECT_EQ(GetMetric("total"), 1);
+  EXPECT_EQ(GetMetric("dropped"), 0);
+  EXPECT_EQ(GetMetric("thread_buffer_overflow"), 0);
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerThreadBuffersKeepOrder) {
+  auto logger = StartAsyncLogger(10, QueueOverflowBehavior::kDiscard, 4096);
+
+  for (std::size_t i = 0; i < kLoggingTestIterations; ++i) {
+    LOG_INFO_TO(logger) << "ordered " << i;
+  }
+  logger->StopConsumerTask();
+
+  const auto logs = GetStreamString();
+  std::size_t prev_position = 0;
+  for (std::size_t i = 0; i < kLoggingTestIterations; ++i) {
+    const auto position = logs.find(fmt::format("text=ordered {}\t", i));
+    ASSERT_NE(position, std::string::npos) << i;
+    EXPECT_GE(position, prev_position) << i;
+    prev_position = position;
+  }
+  EXPECT_EQ(GetMetric("dropped"), 0);
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerThreadBuffersOverflow) {
+  auto logger = StartAsyncLogger(10, QueueOverflowBehavior::kDiscard, 64);
+
+  LOG_INFO_TO(logger) << std::string(100, 'a');
+  logger->Flush();
+  logger->StopConsumerTask();
+
+  EXPECT_THAT(LoggedText(), testing::HasSubstr(std::string(100, 'a')));
+  EXPECT_EQ(GetRecordsCount(), 1);
+  EXPECT_EQ(GetMetric("thread_buffer_overflow"), 1);
+  EXPECT_EQ(GetMetric("dropped"), 0);
+}
+
+UTEST_F_MT(LoggingTestCoro, TpLoggerThreadBuffersMT, 4) {
+  const std::size_t message_count =
+      kLoggingTestIterations * (GetThreadCount() - 1);
+  auto logger = StartAsyncLogger(message_count * 10,
+                                 QueueOverflowBehavior::kDiscard, 1 << 16);
+  LogTestMT(logger, GetThreadCount(), kTestLogging);
+  EXPECT_EQ(GetRecordsCount(), message_count);
+}
+
+UTEST_F_MT(LoggingTestCoro, TpLoggerThreadBuffersFlushSyncCancelMT, 4) {
+  const std::size_t message_count = kLoggingTestIterations * GetThreadCount();
+  auto logger = StartAsyncLogger(message_count * 10,
+                                 QueueOverflowBehavior::kDiscard, 1 << 10);
+  LogTestMT(logger, GetThreadCount(), kTestLogStdThreadFlushSyncCancel);
+  EXPECT_EQ(GetRecordsCount(), message_count);
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerThreadBuffersOfExitedThreads) {
+  auto logger = StartAsyncLogger(10, QueueOverflowBehavior::kDiscard, 4096);
+
+  // More threads than the limit of the thread buffers, one at a time
+  constexpr std::size_t kThreads = 1100;
+  for (std::size_t i = 0; i < kThreads; ++i) {
+    std::thread{[&logger] { LOG_INFO_TO(logger) << "from a thread"; }}.join();
+    logger->Flush();
+  }
+  logger->StopConsumerTask();
+
+  EXPECT_EQ(GetRecordsCount(), kThreads);
+  EXPECT_EQ(GetMetric("thread_buffer_overflow"), 0);
+  EXPECT_EQ(GetMetric("dropped"), 0);
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerThreadBuffersStopWhileLogging) {
+  auto logger =
+      StartAsyncLogger(1 << 20, QueueOverflowBehavior::kDiscard, 1 << 16);
+
+  std::atomic<bool> is_stopped{false};
+  std::atomic<std::size_t> logged{0};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 3; ++i) {
+    threads.emplace_back([&] {
+      while (!is_stopped) {
+        LOG_INFO_TO(logger) << "racing with stop";
+        ++logged;
+      }
+    });
+  }
+
+  engine::SleepFor(std::chrono::milliseconds{10});
+  logger->StopConsumerTask();
+  is_stopped = true;
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(GetRecordsCount(), logged.load());
+  EXPECT_EQ(GetMetric("dropped"), 0);
+}
+
 USERVER_NAMESPACE_END
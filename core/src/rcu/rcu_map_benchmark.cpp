@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/rcu/rcu_map.hpp>
+#include <userver/rcu/sharded_rcu_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using RcuMapType = rcu::RcuMap<std::uint64_t, std::uint64_t>;
+using ShardedRcuMapType = rcu::ShardedRcuMap<std::uint64_t, std::uint64_t>;
+
+template <typename Map>
+void FillMap(Map& map, std::uint64_t size) {
+  typename Map::RawMap raw;
+  raw.reserve(size);
+  for (std::uint64_t i = 0; i < size; ++i) {
+    raw.emplace(i, std::make_shared<std::uint64_t>(i));
+  }
+  map.Assign(std::move(raw));
+}
+
+}  // namespace
+
+// Single-key Insert + Erase on a map of state.range(0) keys. RcuMap copies
+// the whole map on each of them, ShardedRcuMap copies a single shard.
+template <typename Map>
+void rcu_map_single_key_update(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto size = static_cast<std::uint64_t>(state.range(0));
+    Map map;
+    FillMap(map, size);
+
+    std::uint64_t key = size;
+    for ([[maybe_unused]] auto _ : state) {
+      map.Insert(key, std::make_shared<std::uint64_t>(key));
+      map.Erase(key);
+      ++key;
+    }
+  });
+}
+BENCHMARK_TEMPLATE(rcu_map_single_key_update, RcuMapType)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(rcu_map_single_key_update, ShardedRcuMapType)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 19);
+
+template <typename Map>
+void rcu_map_read(benchmark::State& state) {
+  engine::RunStandalone([&] {
+    const auto size = static_cast<std::uint64_t>(state.range(0));
+    Map map;
+    FillMap(map, size);
+
+    std::uint64_t key = 0;
+    for ([[maybe_unused]] auto _ : state) {
+      benchmark::DoNotOptimize(map.Get(key));
+      if (++key == size) key = 0;
+    }
+  });
+}
+BENCHMARK_TEMPLATE(rcu_map_read, RcuMapType)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 19);
+BENCHMARK_TEMPLATE(rcu_map_read, ShardedRcuMapType)
+    ->RangeMultiplier(8)
+    ->Range(1 << 10, 1 << 19);
+
+USERVER_NAMESPACE_END
@@ -20,6 +20,11 @@ struct StdMutexRcuTraits {
   using MutexType = std::mutex;
 };
 
+struct StdMutexEpochRcuTraits {
+  using MutexType = std::mutex;
+  static constexpr auto kReclamation = rcu::Reclamation::kEpochs;
+};
+
 }  // namespace
 
 UTEST(Rcu, Ctr) { rcu::Variable<X> ptr; }
@@ -624,4 +629,127 @@ TEST(Rcu, StdMutexConcurrentWrites) {
   EXPECT_EQ(std::make_pair(3, 2), *reader);
 }
 
+UTEST(Rcu, EpochLifetime) {
+  using Counted = Counted<struct EpochLifetimeTag>;
+
+  rcu::Variable<Counted, rcu::EpochRcuTraits<Counted>> ptr(
+      rcu::DestructionType::kSync);
+  EXPECT_EQ(1, Counted::counter);
+
+  {
+    auto reader = ptr.Read();
+    {
+      auto writer = ptr.StartWrite();
+      writer->value = 10;
+      writer.Commit();
+    }
+    // The old value is still being read
+    EXPECT_EQ(2, Counted::counter);
+    EXPECT_EQ(1, reader->value);
+
+    auto reader_copy = reader;
+    reader = ptr.Read();
+    EXPECT_EQ(10, reader->value);
+    EXPECT_EQ(1, reader_copy->value);
+  }
+  EXPECT_EQ(2, Counted::counter);
+
+  ptr.Emplace();
+  EXPECT_EQ(1, Counted::counter);
+  EXPECT_EQ(1, ptr.ReadCopy().value);
+}
+
+UTEST(Rcu, EpochCleanup) {
+  using Counted = Counted<struct EpochCleanupTag>;
+
+  rcu::Variable<Counted, rcu::EpochRcuTraits<Counted>> ptr(
+      rcu::DestructionType::kSync);
+
+  std::optional<rcu::ReadablePtr<Counted, rcu::EpochRcuTraits<Counted>>> r;
+  r.emplace(ptr.Read());
+  ptr.Emplace();
+  EXPECT_EQ(2, Counted::counter);
+
+  r.reset();
+  ptr.Cleanup();
+  EXPECT_EQ(1, Counted::counter);
+}
+
+UTEST(Rcu, EpochMoveAssignBetweenVariables) {
+  rcu::Variable<int, rcu::EpochRcuTraits<int>> first(1);
+  rcu::Variable<int, rcu::EpochRcuTraits<int>> second(2);
+
+  auto reader = first.Read();
+  reader = second.Read();
+  first.Assign(10);
+  second.Assign(20);
+
+  EXPECT_EQ(2, *reader);
+  EXPECT_EQ(10, first.ReadCopy());
+  EXPECT_EQ(20, second.ReadCopy());
+}
+
+UTEST_MT(Rcu, EpochTortureTest, kTotalTasks) {
+  using Traits = rcu::EpochRcuTraits<CleaningUpInt>;
+  rcu::Variable<CleaningUpInt, Traits> data{1};
+  std::atomic<bool> keep_running{true};
+
+  engine::Mutex ping_pong_mutex;
+  rcu::ReadablePtr<CleaningUpInt, Traits> ptr = data.Read();
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+
+  for (std::size_t i = 0; i < kReadablePtrPingPongTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        std::lock_guard lock(ping_pong_mutex);
+        // copy a ptr created by another thread
+        ptr = rcu::ReadablePtr{ptr};
+        ASSERT_GT(ptr->value, 0);
+        // drop the old epoch from time to time
+        if (ptr->value % 16 == 0) ptr = data.Read();
+      }
+    }));
+  }
+
+  for (std::size_t i = 0; i < kReadingTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        const auto local_ptr = data.Read();
+        ASSERT_GT(local_ptr->value, 0);
+      }
+    }));
+  }
+
+  for (std::size_t i = 0; i < kWritingTasks; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&] {
+      while (keep_running) {
+        const auto old = data.Read();
+        data.Assign(CleaningUpInt{old->value + 1});
+      }
+    }));
+  }
+
+  engine::SleepFor(std::chrono::milliseconds{100});
+  keep_running = false;
+}
+
+TEST(Rcu, StdMutexEpochConcurrentReadWrite) {
+  rcu::Variable<X, StdMutexEpochRcuTraits> ptr(0, 0);
+  constexpr int kIterations = 10000;
+
+  auto writer = std::async([&ptr] {
+    for (int i = 1; i <= kIterations; ++i) ptr.Assign(X{i, i});
+  });
+
+  int last_seen = 0;
+  while (last_seen < kIterations) {
+    const auto reader = ptr.Read();
+    ASSERT_EQ(reader->first, reader->second);
+    ASSERT_GE(reader->first, last_seen);
+    last_seen = reader->first;
+  }
+  writer.get();
+}
+
 USERVER_NAMESPACE_END
@@ -0,0 +1,233 @@
+#include <userver/rcu/sharded_rcu_map.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+template <typename Key, typename Value>
+struct RcuTraitsStdMutex : rcu::DefaultRcuMapTraits<Key, Value> {
+  using MutexType = std::mutex;
+};
+
+// The comparator lives inside the map, so its address identifies the snapshot
+// of a shard that performed the last lookup
+const void* last_lookup_snapshot = nullptr;
+
+struct SnapshotTrackingEqual {
+  bool operator()(int lhs, int rhs) const {
+    last_lookup_snapshot = this;
+    return lhs == rhs;
+  }
+};
+
+struct SnapshotTrackingTraits : rcu::DefaultRcuMapTraits<int, int> {
+  using KeyEqual = SnapshotTrackingEqual;
+};
+
+using SnapshotTrackingMap =
+    rcu::ShardedRcuMap<int, int, SnapshotTrackingTraits>;
+
+const void* GetShardSnapshot(const SnapshotTrackingMap& map, int key) {
+  last_lookup_snapshot = nullptr;
+  EXPECT_TRUE(map.Get(key)) << key;
+  return last_lookup_snapshot;
+}
+
+}  // namespace
+
+TEST(ShardedRcuMap, ShardCount) {
+  using Map = rcu::ShardedRcuMap<int, int>;
+  EXPECT_EQ(Map{}.GetShardCount(), Map::kDefaultShardCount);
+  EXPECT_EQ(Map{1}.GetShardCount(), 1);
+  EXPECT_EQ(Map{5}.GetShardCount(), 8);
+  EXPECT_EQ(Map{16}.GetShardCount(), 16);
+}
+
+TEST(ShardedRcuMap, StdMutexBase) {
+  rcu::ShardedRcuMap<std::string, int, RcuTraitsStdMutex<std::string, int>>
+      map;
+  const auto& cmap = map;
+
+  UEXPECT_THROW(cmap["any"], rcu::MissingKeyException);
+  EXPECT_FALSE(map.Get("any"));
+  EXPECT_FALSE(map.Erase("any"));
+
+  UEXPECT_NO_THROW(*map["any"] = 1);
+  EXPECT_EQ(1, *cmap["any"]);
+  EXPECT_EQ(1, *map.Pop("any"));
+}
+
+UTEST(ShardedRcuMap, Empty) {
+  rcu::ShardedRcuMap<std::string, int> map;
+  const auto& cmap = map;
+
+  EXPECT_EQ(0, map.SizeApprox());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(cmap.begin(), cmap.end());
+  EXPECT_TRUE(map.GetSnapshot().empty());
+}
+
+UTEST(ShardedRcuMap, Modify) {
+  rcu::ShardedRcuMap<std::string, int> map;
+  const auto& cmap = map;
+
+  UEXPECT_THROW(cmap["any"], rcu::MissingKeyException);
+  EXPECT_FALSE(map.Get("any"));
+  EXPECT_FALSE(cmap.Get("any"));
+  EXPECT_FALSE(map.Erase("any"));
+  EXPECT_FALSE(map.Pop("any"));
+
+  UEXPECT_NO_THROW(*map["any"] = 1);
+  EXPECT_EQ(1, *cmap["any"]);
+  EXPECT_EQ(1, *map.Get("any"));
+  EXPECT_TRUE(map.Erase("any"));
+  EXPECT_FALSE(map.Erase("any"));
+
+  EXPECT_TRUE(map.Insert("any", std::make_shared<int>(3)).inserted);
+  EXPECT_FALSE(map.Insert("any", std::make_shared<int>(0)).inserted);
+  EXPECT_EQ(*map.Insert("any", std::make_shared<int>(0)).value, 3);
+  EXPECT_EQ(*map.Pop("any"), 3);
+
+  EXPECT_TRUE(map.Emplace("any", 4).inserted);
+  EXPECT_FALSE(map.Emplace("any", 0).inserted);
+  EXPECT_EQ(*map.Pop("any"), 4);
+
+  EXPECT_TRUE(map.TryEmplace("any", 5).inserted);
+  EXPECT_EQ(*map.TryEmplace("any", 0).value, 5);
+
+  map.InsertOrAssign("any", std::make_shared<int>(6));
+  EXPECT_EQ(*cmap["any"], 6);
+
+  {
+    auto txn = map.StartWriteShard("any");
+    txn->erase("any");
+    txn.Commit();
+  }
+  EXPECT_FALSE(map.Get("any"));
+}
+
+UTEST(ShardedRcuMap, AssignAndIterate) {
+  constexpr int kKeys = 1000;
+  rcu::ShardedRcuMap<int, int> map{16};
+
+  rcu::ShardedRcuMap<int, int>::RawMap raw;
+  for (int i = 0; i < kKeys; ++i) raw.emplace(i, std::make_shared<int>(i));
+  map.Assign(std::move(raw));
+  EXPECT_EQ(kKeys, map.SizeApprox());
+
+  std::array<int, kKeys> seen{};
+  for (const auto& [key, value] : map) {
+    ASSERT_EQ(key, *value);
+    ++seen[key];
+  }
+  for (const auto count : seen) EXPECT_EQ(count, 1);
+
+  const auto snapshot = map.GetSnapshot();
+  EXPECT_EQ(kKeys, snapshot.size());
+
+  map.Clear();
+  EXPECT_EQ(0, map.SizeApprox());
+  EXPECT_EQ(map.begin(), map.end());
+  EXPECT_EQ(kKeys, snapshot.size());
+}
+
+UTEST(ShardedRcuMap, IteratorKeepsShardSnapshot) {
+  rcu::ShardedRcuMap<int, int> map{1};
+  *map[1] = 1;
+  *map[2] = 2;
+
+  auto it = map.begin();
+  ASSERT_NE(it, map.end());
+  map.Erase(1);
+  map.Erase(2);
+
+  int visited = 0;
+  for (; it != map.end(); ++it) ++visited;
+  EXPECT_EQ(visited, 2);
+}
+
+UTEST(ShardedRcuMap, SingleKeyUpdateCopiesOneShard) {
+  constexpr int kKeys = 100;
+  SnapshotTrackingMap map{8};
+  for (int i = 0; i < kKeys; ++i) *map[i] = i;
+
+  std::vector<const void*> before;
+  for (int i = 0; i < kKeys; ++i) before.push_back(GetShardSnapshot(map, i));
+
+  EXPECT_TRUE(map.Erase(0));
+  EXPECT_FALSE(map.Get(0));
+  EXPECT_EQ(std::size_t{kKeys - 1}, map.SizeApprox());
+
+  // The shard of the key is replaced, the other shards keep their snapshots
+  int same_shard_keys = 0;
+  for (int i = 1; i < kKeys; ++i) {
+    const auto* after = GetShardSnapshot(map, i);
+    ASSERT_NE(after, nullptr);
+    if (map.IsSameShard(0, i)) {
+      ++same_shard_keys;
+      EXPECT_NE(before[i], after) << i;
+    } else {
+      EXPECT_EQ(before[i], after) << i;
+    }
+  }
+  EXPECT_GT(same_shard_keys, 0);
+  EXPECT_LT(same_shard_keys, kKeys - 1);
+}
+
+UTEST_MT(ShardedRcuMap, ConcurrentUpdates, 4) {
+  rcu::ShardedRcuMap<std::uint32_t, std::atomic<std::uint32_t>> map;
+  std::array<engine::TaskWithResult<void>, 4> workers;
+  std::atomic<bool> stop_flag{false};
+
+  for (std::uint32_t i = 0; i < workers.size(); ++i) {
+    workers[i] = utils::Async("writer", [i, &map, &stop_flag] {
+      while (!stop_flag) {
+        for (std::uint32_t key = i << 16; key < (i << 16) + 256; ++key) {
+          map[key]->fetch_add(1);
+          ASSERT_TRUE(map.Get(key));
+        }
+        for (std::uint32_t key = i << 16; key < (i << 16) + 256; ++key) {
+          ASSERT_TRUE(map.Erase(key));
+        }
+      }
+    });
+  }
+
+  engine::SleepFor(std::chrono::milliseconds(100));
+  stop_flag = true;
+  for (auto& w : workers) w.Get();
+
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+UTEST(ShardedRcuMap, SampleShardedRcuMap) {
+  /// [Sample rcu::ShardedRcuMap usage]
+  // A large map with frequent single-key updates
+  rcu::ShardedRcuMap<std::string, std::atomic<int>> map;
+
+  // Only the shard of "123" is copied on insertion
+  map["123"]->fetch_add(1);
+  map["other_data"]->store(2);
+  ASSERT_EQ(map["123"]->load(), 1);
+  ASSERT_EQ(map["other_data"]->load(), 2);
+
+  // Each shard is iterated over its own snapshot
+  int sum = 0;
+  for (const auto& [key, value] : map) sum += value->load();
+  ASSERT_EQ(sum, 3);
+  /// [Sample rcu::ShardedRcuMap usage]
+}
+
+USERVER_NAMESPACE_END
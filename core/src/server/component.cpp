@@ -188,6 +188,44 @@ properties:
                         type: integer
                         description: delay in microseconds of the start of abort check routine
                         defaultDescription: 20ms
+                    max_pipelined_requests:
+                        type: integer
+                        description: max number of HTTP/1.1 pipelined requests of a connection to handle concurrently; only GET, HEAD and OPTIONS requests run ahead of the previous ones, the responses are sent in order
+                        defaultDescription: 1
+                        minimum: 1
+                    http_version:
+                        type: string
+                        description: "'2' to accept HTTP/2 over TLS (ALPN h2) and h2c with prior knowledge along with HTTP/1.1"
+                        defaultDescription: '1.1'
+                        enum:
+                          - '1.1'
+                          - '2'
+                    http2_session:
+                        type: object
+                        description: HTTP/2 session options
+                        additionalProperties: false
+                        properties:
+                            max_concurrent_streams:
+                                type: integer
+                                description: max number of concurrent streams (requests) per connection
+                                defaultDescription: 100
+                                minimum: 1
+                            max_frame_size:
+                                type: integer
+                                description: max frame payload size the server accepts
+                                defaultDescription: 16384
+                                minimum: 16384
+                                maximum: 16777215
+                            initial_window_size:
+                                type: integer
+                                description: initial per-stream flow control window for request bodies
+                                defaultDescription: 65535
+                                maximum: 2147483647
+                            max_stream_output_buffer_size:
+                                type: integer
+                                description: max bytes of a streamed response body buffered per stream, the handler waits for the peer to read them beyond that
+                                defaultDescription: 1048576
+                                minimum: 1
             shards:
                 type: integer
                 description: how many concurrent tasks harvest data from a single socket; do not set if not sure what it is doing
@@ -95,6 +95,14 @@ properties:
         type: boolean
         description: allow decompression of the requests
         defaultDescription: false
+    compress_response:
+        type: boolean
+        description: compress the responses with a coding from the Accept-Encoding request header (zstd, br or gzip)
+        defaultDescription: false
+    compress_response_min_size:
+        type: integer
+        description: the responses smaller than this are not compressed
+        defaultDescription: 1024
     throttling_enabled:
         type: boolean
         description: allow throttling of the requests by components::Server , for more info see its `max_response_size_in_flight` and `requests_queue_size_threshold` options
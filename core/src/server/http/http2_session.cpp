@@ -0,0 +1,571 @@
+#include "http2_session.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include <fmt/format.h>
+#include <nghttp2/nghttp2.h>
+
+#include <userver/engine/exception.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/server/http/http_method.hpp>
+#include <userver/server/request/request_base.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace {
+
+// RFC 9113 Section 8.2.2
+bool IsConnectionSpecificHeader(std::string_view name) {
+  return name == "connection" || name == "keep-alive" ||
+         name == "proxy-connection" || name == "transfer-encoding" ||
+         name == "upgrade";
+}
+
+std::string ToLowerAscii(std::string_view str) {
+  std::string result{str};
+  for (auto& c : result) {
+    if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+  }
+  return result;
+}
+
+nghttp2_nv MakeNv(std::string_view name, std::string_view value) {
+  // nghttp2 copies the names and values on submission
+  return {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+      const_cast<std::uint8_t*>(
+          reinterpret_cast<const std::uint8_t*>(name.data())),
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+      const_cast<std::uint8_t*>(
+          reinterpret_cast<const std::uint8_t*>(value.data())),
+      name.size(),
+      value.size(),
+      NGHTTP2_NV_FLAG_NONE,
+  };
+}
+
+}  // namespace
+
+struct Http2Session::Callbacks final {
+  static Http2Session& GetSession(void* user_data) {
+    auto* session = static_cast<Http2Session*>(user_data);
+    UASSERT(session != nullptr);
+    return *session;
+  }
+
+  static int OnBeginHeaders(nghttp2_session*, const nghttp2_frame* frame,
+                            void* user_data) {
+    if (frame->hd.type != NGHTTP2_HEADERS ||
+        frame->headers.cat != NGHTTP2_HCAT_REQUEST) {
+      return 0;
+    }
+    auto& self = GetSession(user_data);
+    LOG_TRACE() << "stream " << frame->hd.stream_id << " begin";
+
+    auto& stream = self.streams_[frame->hd.stream_id];
+    self.stats_.parsing_request_count.Add(1);
+    stream.request_constructor.emplace(self.request_constructor_config_,
+                                       self.handler_info_index_,
+                                       self.data_accounter_);
+    return 0;
+  }
+
+  static int OnHeader(nghttp2_session*, const nghttp2_frame* frame,
+                      const std::uint8_t* name_data, std::size_t name_size,
+                      const std::uint8_t* value_data, std::size_t value_size,
+                      std::uint8_t /*flags*/, void* user_data) {
+    // trailers are ignored, as they are by HttpRequestParser
+    if (frame->hd.type != NGHTTP2_HEADERS ||
+        frame->headers.cat != NGHTTP2_HCAT_REQUEST) {
+      return 0;
+    }
+    auto& self = GetSession(user_data);
+    auto* stream = self.FindStream(frame->hd.stream_id);
+    if (!stream || !stream->request_constructor) return 0;
+
+    const std::string_view name{reinterpret_cast<const char*>(name_data),
+                                name_size};
+    const std::string_view value{reinterpret_cast<const char*>(value_data),
+                                 value_size};
+    LOG_TRACE() << "stream " << frame->hd.stream_id << " header: '" << name
+                << "': '" << value << '\'';
+
+    auto& request_constructor = *stream->request_constructor;
+    try {
+      // nghttp2 guarantees that pseudo-headers precede the regular ones
+      if (name == ":method") {
+        request_constructor.SetMethod(HttpMethodFromString(value));
+      } else if (name == ":path") {
+        request_constructor.AppendUrl(value.data(), value.size());
+      } else if (name == ":authority") {
+        stream->authority = value;
+      } else if (name.front() == ':') {
+        // :scheme
+      } else if (name == "cookie") {
+        // RFC 9113 Section 8.2.3, the crumbs are concatenated back
+        self.CheckUrlComplete(*stream);
+        if (!stream->cookies.empty()) stream->cookies += "; ";
+        stream->cookies += value;
+      } else {
+        self.CheckUrlComplete(*stream);
+        request_constructor.AppendHeaderField(name.data(), name.size());
+        request_constructor.AppendHeaderValue(value.data(), value.size());
+      }
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "can't append header: " << ex;
+      self.FinalizeRequest(frame->hd.stream_id, *stream);
+    }
+    return 0;
+  }
+
+  static int OnDataChunkRecv(nghttp2_session*, std::uint8_t /*flags*/,
+                             std::int32_t stream_id, const std::uint8_t* data,
+                             std::size_t size, void* user_data) {
+    auto& self = GetSession(user_data);
+    auto* stream = self.FindStream(stream_id);
+    // the rest of the body of a rejected request is dropped
+    if (!stream || !stream->request_constructor) return 0;
+
+    LOG_TRACE() << "stream " << stream_id << " body: " << size << " bytes";
+    try {
+      self.CheckUrlComplete(*stream);
+      stream->request_constructor->AppendBody(
+          reinterpret_cast<const char*>(data), size);
+    } catch (const std::exception& ex) {
+      LOG_WARNING() << "can't append body: " << ex;
+      self.FinalizeRequest(stream_id, *stream);
+    }
+    return 0;
+  }
+
+  static int OnFrameRecv(nghttp2_session*, const nghttp2_frame* frame,
+                         void* user_data) {
+    if ((frame->hd.type != NGHTTP2_HEADERS &&
+         frame->hd.type != NGHTTP2_DATA) ||
+        !(frame->hd.flags & NGHTTP2_FLAG_END_STREAM)) {
+      return 0;
+    }
+    auto& self = GetSession(user_data);
+    auto* stream = self.FindStream(frame->hd.stream_id);
+    if (!stream || !stream->request_constructor) return 0;
+
+    LOG_TRACE() << "stream " << frame->hd.stream_id << " request complete";
+    self.FinalizeRequest(frame->hd.stream_id, *stream);
+    return 0;
+  }
+
+  static int OnStreamClose(nghttp2_session*, std::int32_t stream_id,
+                           std::uint32_t error_code, void* user_data) {
+    auto& self = GetSession(user_data);
+    const auto it = self.streams_.find(stream_id);
+    if (it == self.streams_.end()) return 0;
+
+    LOG_TRACE() << "stream " << stream_id
+                << " closed: " << nghttp2_http2_strerror(error_code);
+    auto& stream = it->second;
+    if (stream.request_constructor) {
+      self.stats_.parsing_request_count.Subtract(1);
+    } else if (!stream.is_response_submitted || !stream.is_body_complete) {
+      self.on_stream_reset_cb_(stream_id);
+    }
+    // the producer finds the stream closed
+    if (stream.drain_waiter) stream.drain_waiter->Send();
+    self.streams_.erase(it);
+    return 0;
+  }
+
+  static ssize_t ReadBody(nghttp2_session*, std::int32_t stream_id,
+                          std::uint8_t* buffer, std::size_t size,
+                          std::uint32_t* data_flags, nghttp2_data_source*,
+                          void* user_data) {
+    auto& self = GetSession(user_data);
+    auto* stream = self.FindStream(stream_id);
+    if (!stream) return NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE;
+
+    const std::string_view pending =
+        (stream->body.data() ? stream->body
+                             : std::string_view{stream->body_parts})
+            .substr(stream->body_offset);
+    const auto read_size = std::min(pending.size(), size);
+    if (read_size) std::memcpy(buffer, pending.data(), read_size);
+    stream->body_offset += read_size;
+
+    if (read_size == pending.size()) {
+      if (stream->is_body_complete) {
+        *data_flags |= NGHTTP2_DATA_FLAG_EOF;
+      } else if (read_size == 0) {
+        stream->is_data_deferred = true;
+        return NGHTTP2_ERR_DEFERRED;
+      }
+      if (!stream->body.data()) {
+        stream->body_parts.clear();
+        stream->body_offset = 0;
+      }
+    }
+    if (read_size) self.NotifyBodyRead(*stream);
+    return static_cast<ssize_t>(read_size);
+  }
+
+  static const nghttp2_session_callbacks& Get() {
+    static const auto callbacks = [] {
+      nghttp2_session_callbacks* result = nullptr;
+      UINVARIANT(nghttp2_session_callbacks_new(&result) == 0,
+                 "Failed to allocate nghttp2 callbacks");
+      nghttp2_session_callbacks_set_on_begin_headers_callback(result,
+                                                              &OnBeginHeaders);
+      nghttp2_session_callbacks_set_on_header_callback(result, &OnHeader);
+      nghttp2_session_callbacks_set_on_data_chunk_recv_callback(
+          result, &OnDataChunkRecv);
+      nghttp2_session_callbacks_set_on_frame_recv_callback(result,
+                                                           &OnFrameRecv);
+      nghttp2_session_callbacks_set_on_stream_close_callback(result,
+                                                             &OnStreamClose);
+      return std::unique_ptr<nghttp2_session_callbacks,
+                             decltype(&nghttp2_session_callbacks_del)>(
+          result, &nghttp2_session_callbacks_del);
+    }();
+    return *callbacks;
+  }
+};
+
+Http2Session::Http2Session(const HandlerInfoIndex& handler_info_index,
+                           const request::HttpRequestConfig& request_config,
+                           const net::Http2SessionConfig& session_config,
+                           OnNewRequestCb&& on_new_request_cb,
+                           OnStreamResetCb&& on_stream_reset_cb,
+                           net::ParserStats& stats,
+                           request::ResponseDataAccounter& data_accounter)
+    : handler_info_index_(handler_info_index),
+      request_constructor_config_{request_config},
+      on_new_request_cb_(std::move(on_new_request_cb)),
+      on_stream_reset_cb_(std::move(on_stream_reset_cb)),
+      stats_(stats),
+      data_accounter_(data_accounter),
+      max_stream_output_buffer_size_(
+          session_config.max_stream_output_buffer_size) {
+  if (nghttp2_session_server_new(&session_, &Callbacks::Get(), this) != 0) {
+    throw std::runtime_error("Failed to create an HTTP/2 session");
+  }
+
+  const std::array<nghttp2_settings_entry, 3> settings{{
+      {NGHTTP2_SETTINGS_MAX_CONCURRENT_STREAMS,
+       session_config.max_concurrent_streams},
+      {NGHTTP2_SETTINGS_MAX_FRAME_SIZE, session_config.max_frame_size},
+      {NGHTTP2_SETTINGS_INITIAL_WINDOW_SIZE,
+       session_config.initial_window_size},
+  }};
+  const auto result = nghttp2_submit_settings(session_, NGHTTP2_FLAG_NONE,
+                                              settings.data(), settings.size());
+  if (result != 0) {
+    nghttp2_session_del(session_);
+    throw std::runtime_error(fmt::format("Invalid HTTP/2 session settings: {}",
+                                         nghttp2_strerror(result)));
+  }
+  is_output_pending_ = true;
+}
+
+Http2Session::~Http2Session() {
+  UASSERT(!output_waiter_);
+  // Stream closure callbacks are not invoked on deletion
+  for (const auto& [stream_id, stream] : streams_) {
+    if (stream.request_constructor) stats_.parsing_request_count.Subtract(1);
+  }
+  nghttp2_session_del(session_);
+}
+
+bool Http2Session::Parse(const char* data, size_t size) {
+  std::lock_guard lock(mutex_);
+  const auto result = nghttp2_session_mem_recv(
+      session_, reinterpret_cast<const std::uint8_t*>(data), size);
+  // frames to reply with (e.g. SETTINGS ACK) are pulled by the caller
+  if (result < 0) {
+    LOG_WARNING() << "HTTP/2 session error: "
+                  << nghttp2_strerror(static_cast<int>(result));
+    nghttp2_session_terminate_session(session_, NGHTTP2_PROTOCOL_ERROR);
+    return false;
+  }
+  UASSERT(static_cast<std::size_t>(result) == size);
+  return true;
+}
+
+void Http2Session::PullOutput(std::string& buffer, std::size_t max_size) {
+  std::lock_guard lock(mutex_);
+  while (buffer.size() < max_size) {
+    const std::uint8_t* data = nullptr;
+    const auto size = nghttp2_session_mem_send(session_, &data);
+    if (size < 0) {
+      throw std::runtime_error(
+          fmt::format("Failed to serialize HTTP/2 frames: {}",
+                      nghttp2_strerror(static_cast<int>(size))));
+    }
+    if (size == 0) {
+      is_output_pending_ = false;
+      return;
+    }
+    buffer.append(reinterpret_cast<const char*>(data), size);
+  }
+}
+
+bool Http2Session::IsAlive() {
+  std::lock_guard lock(mutex_);
+  return nghttp2_session_want_read(session_) ||
+         nghttp2_session_want_write(session_);
+}
+
+void Http2Session::Terminate() {
+  std::lock_guard lock(mutex_);
+  nghttp2_session_terminate_session(session_, NGHTTP2_NO_ERROR);
+  is_output_pending_ = true;
+}
+
+void Http2Session::ResetStream(std::int32_t stream_id) {
+  std::lock_guard lock(mutex_);
+  if (!FindStream(stream_id)) return;
+  nghttp2_submit_rst_stream(session_, NGHTTP2_FLAG_NONE, stream_id,
+                            NGHTTP2_INTERNAL_ERROR);
+  NotifyOutput();
+}
+
+bool Http2Session::SetOutputWaiter(engine::SingleUseEvent& event) {
+  std::lock_guard lock(mutex_);
+  UASSERT(!output_waiter_);
+  if (is_output_pending_) return false;
+  output_waiter_ = &event;
+  return true;
+}
+
+void Http2Session::ResetOutputWaiter() noexcept {
+  std::lock_guard lock(mutex_);
+  // If the event was sent, it was sent under the lock
+  output_waiter_ = nullptr;
+}
+
+Http2Session::Stream* Http2Session::FindStream(std::int32_t stream_id) {
+  const auto it = streams_.find(stream_id);
+  return it == streams_.end() ? nullptr : &it->second;
+}
+
+Http2Session::Stream& Http2Session::GetStreamForResponse(
+    std::int32_t stream_id) {
+  auto* stream = FindStream(stream_id);
+  if (!stream) {
+    throw Http2StreamClosedException(
+        fmt::format("HTTP/2 stream {} is closed by peer", stream_id));
+  }
+  UASSERT(stream->request);
+  return *stream;
+}
+
+void Http2Session::CheckUrlComplete(Stream& stream) {
+  if (stream.is_url_complete) return;
+  stream.is_url_complete = true;
+
+  auto& request_constructor = *stream.request_constructor;
+  request_constructor.SetHttpMajor(2);
+  request_constructor.SetHttpMinor(0);
+  request_constructor.ParseUrl();
+  if (!stream.authority.empty()) {
+    // RFC 9113 Section 8.3.1, :authority replaces the Host header
+    constexpr std::string_view kHost = "host";
+    request_constructor.AppendHeaderField(kHost.data(), kHost.size());
+    request_constructor.AppendHeaderValue(stream.authority.data(),
+                                          stream.authority.size());
+  }
+}
+
+void Http2Session::FinalizeRequest(std::int32_t stream_id, Stream& stream) {
+  UASSERT(stream.request_constructor);
+  auto& request_constructor = *stream.request_constructor;
+  try {
+    CheckUrlComplete(stream);
+    if (!stream.cookies.empty()) {
+      constexpr std::string_view kCookie = "cookie";
+      request_constructor.AppendHeaderField(kCookie.data(), kCookie.size());
+      request_constructor.AppendHeaderValue(stream.cookies.data(),
+                                            stream.cookies.size());
+    }
+    // flushes the last header
+    request_constructor.AppendHeaderField("", 0);
+  } catch (const std::exception& ex) {
+    // the error status is already set by the request constructor
+    LOG_WARNING() << "can't complete request headers: " << ex;
+  }
+  request_constructor.SetIsFinal(false);
+
+  stream.request = request_constructor.Finalize();
+  stream.request_constructor.reset();
+  stats_.parsing_request_count.Subtract(1);
+
+  if (!stream.request) {
+    LOG_ERROR() << "request is null after Finalize()";
+    nghttp2_submit_rst_stream(session_, NGHTTP2_FLAG_NONE, stream_id,
+                              NGHTTP2_INTERNAL_ERROR);
+    return;
+  }
+  auto request = stream.request;
+  on_new_request_cb_(stream_id, std::move(request));
+}
+
+void Http2Session::SubmitResponse(std::int32_t stream_id, HttpStatus status,
+                                  const std::vector<Header>& headers,
+                                  std::optional<std::string_view> body) {
+  std::lock_guard lock(mutex_);
+  auto& stream = GetStreamForResponse(stream_id);
+  UASSERT(!stream.is_response_submitted);
+
+  const auto status_string = fmt::to_string(static_cast<int>(status));
+  std::vector<nghttp2_nv> nva;
+  nva.reserve(headers.size() + 1);
+  nva.push_back(MakeNv(":status", status_string));
+  for (const auto& [name, value] : headers) {
+    nva.push_back(MakeNv(name, value));
+  }
+
+  nghttp2_data_provider data_provider{};
+  data_provider.read_callback = &Callbacks::ReadBody;
+  const bool has_body = !body || !body->empty();
+  if (body) {
+    // non-null data() distinguishes a complete body from the streamed one
+    stream.body = has_body ? *body : std::string_view{};
+    stream.is_body_complete = true;
+  }
+
+  const auto result =
+      nghttp2_submit_response(session_, stream_id, nva.data(), nva.size(),
+                              has_body ? &data_provider : nullptr);
+  if (result != 0) {
+    throw std::runtime_error(fmt::format(
+        "Failed to submit HTTP/2 response: {}", nghttp2_strerror(result)));
+  }
+  stream.is_response_submitted = true;
+  NotifyOutput();
+}
+
+void Http2Session::SubmitBodyPart(std::int32_t stream_id,
+                                  std::string&& body_part) {
+  engine::SingleUseEvent drained;
+  {
+    std::lock_guard lock(mutex_);
+    auto& stream = GetStreamForResponse(stream_id);
+    UASSERT(stream.is_response_submitted && !stream.is_body_complete);
+    UASSERT(!stream.drain_waiter);
+
+    if (stream.body_parts.empty()) {
+      stream.body_parts = std::move(body_part);
+    } else {
+      stream.body_parts += body_part;
+    }
+    if (stream.is_data_deferred) {
+      stream.is_data_deferred = false;
+      nghttp2_session_resume_data(session_, stream_id);
+      NotifyOutput();
+    }
+
+    const auto pending = stream.body_parts.size() - stream.body_offset;
+    if (pending <= max_stream_output_buffer_size_) return;
+    stream.drain_waiter = &drained;
+  }
+  // A slow peer or a small flow control window would make the session buffer
+  // the whole body otherwise
+  WaitForBodyDrain(stream_id, drained);
+}
+
+void Http2Session::WaitForBodyDrain(std::int32_t stream_id,
+                                    engine::SingleUseEvent& event) {
+  const auto status = event.WaitUntil(engine::Deadline{});
+
+  std::lock_guard lock(mutex_);
+  auto* stream = FindStream(stream_id);
+  if (stream && stream->drain_waiter == &event) {
+    // If the event was sent, it was sent under the lock
+    stream->drain_waiter = nullptr;
+  }
+  if (status != engine::FutureStatus::kReady) {
+    throw engine::WaitInterruptedException(
+        engine::current_task::CancellationReason());
+  }
+  if (!stream) {
+    throw Http2StreamClosedException(
+        fmt::format("HTTP/2 stream {} is closed by peer", stream_id));
+  }
+}
+
+void Http2Session::FinishBody(std::int32_t stream_id) {
+  std::lock_guard lock(mutex_);
+  auto& stream = GetStreamForResponse(stream_id);
+  UASSERT(stream.is_response_submitted);
+
+  stream.is_body_complete = true;
+  if (stream.is_data_deferred) {
+    stream.is_data_deferred = false;
+    nghttp2_session_resume_data(session_, stream_id);
+    NotifyOutput();
+  }
+}
+
+void Http2Session::NotifyBodyRead(Stream& stream) noexcept {
+  if (!stream.drain_waiter) return;
+  const auto pending = stream.body.data()
+                           ? 0
+                           : stream.body_parts.size() - stream.body_offset;
+  if (pending > max_stream_output_buffer_size_) return;
+  stream.drain_waiter->Send();
+  stream.drain_waiter = nullptr;
+}
+
+void Http2Session::NotifyOutput() noexcept {
+  is_output_pending_ = true;
+  if (output_waiter_) {
+    output_waiter_->Send();
+    output_waiter_ = nullptr;
+  }
+}
+
+Http2StreamWriter::Http2StreamWriter(Http2Session& session,
+                                     std::int32_t stream_id)
+    : session_(session), stream_id_(stream_id) {}
+
+void Http2StreamWriter::AddHeader(std::string_view name,
+                                  std::string_view value) {
+  auto lowercase_name = ToLowerAscii(name);
+  if (IsConnectionSpecificHeader(lowercase_name)) return;
+  headers_.emplace_back(std::move(lowercase_name), std::string{value});
+}
+
+std::size_t Http2StreamWriter::WriteResponse(HttpStatus status,
+                                             std::string_view body) {
+  session_.SubmitResponse(stream_id_, status, headers_, body);
+  return GetHeadersSize() + body.size();
+}
+
+std::size_t Http2StreamWriter::WriteHeaders(HttpStatus status) {
+  session_.SubmitResponse(stream_id_, status, headers_, std::nullopt);
+  return GetHeadersSize();
+}
+
+std::size_t Http2StreamWriter::WriteBodyPart(std::string&& body_part) {
+  const auto size = body_part.size();
+  session_.SubmitBodyPart(stream_id_, std::move(body_part));
+  return size;
+}
+
+void Http2StreamWriter::Finish() { session_.FinishBody(stream_id_); }
+
+std::size_t Http2StreamWriter::GetHeadersSize() const {
+  // uncompressed, as in HTTP/1.1
+  std::size_t size = 0;
+  for (const auto& [name, value] : headers_) {
+    size += name.size() + value.size();
+  }
+  return size;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
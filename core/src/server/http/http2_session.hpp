@@ -0,0 +1,180 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <server/net/connection_config.hpp>
+#include <server/net/stats.hpp>
+#include <server/request/request_parser.hpp>
+
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/single_use_event.hpp>
+#include <userver/server/http/http_status.hpp>
+#include <userver/server/request/request_config.hpp>
+
+#include "http_request_constructor.hpp"
+
+struct nghttp2_session;
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+/// Thrown by Http2StreamWriter if the stream has been closed by the peer
+class Http2StreamClosedException final : public std::runtime_error {
+ public:
+  using std::runtime_error::runtime_error;
+};
+
+/// @brief Server side of an HTTP/2 connection.
+///
+/// Decodes the frames received from the peer into requests via
+/// HttpRequestConstructor and encodes the responses submitted through
+/// Http2StreamWriter into frames. HPACK and per-stream flow control are handled
+/// by nghttp2.
+///
+/// Does no I/O by itself: the connection feeds the received bytes into Parse()
+/// and writes out the bytes returned by PullOutput(). Responses are submitted
+/// from the request tasks, so all the methods are thread safe.
+class Http2Session final : public request::RequestParser {
+ public:
+  using OnNewRequestCb = std::function<void(
+      std::int32_t stream_id, std::shared_ptr<request::RequestBase>&&)>;
+  // Called if the peer closes a stream before its response is submitted
+  using OnStreamResetCb = std::function<void(std::int32_t stream_id)>;
+
+  Http2Session(const HandlerInfoIndex& handler_info_index,
+               const request::HttpRequestConfig& request_config,
+               const net::Http2SessionConfig& session_config,
+               OnNewRequestCb&& on_new_request_cb,
+               OnStreamResetCb&& on_stream_reset_cb, net::ParserStats& stats,
+               request::ResponseDataAccounter& data_accounter);
+  ~Http2Session() override;
+
+  Http2Session(Http2Session&&) = delete;
+  Http2Session& operator=(Http2Session&&) = delete;
+
+  /// Returns false on a connection error, GOAWAY is still to be pulled
+  bool Parse(const char* data, size_t size) override;
+
+  /// Appends the pending frames to `buffer` until it exceeds `max_size`
+  void PullOutput(std::string& buffer, std::size_t max_size);
+
+  /// Returns false once the session has nothing to read and to write
+  bool IsAlive();
+
+  /// Queues GOAWAY, the session ends once the output is pulled
+  void Terminate();
+
+  /// Queues RST_STREAM for a stream whose response can not be completed
+  void ResetStream(std::int32_t stream_id);
+
+  /// @brief Arms the event to be sent on the next output submission.
+  /// @returns false without arming the event if some output is pending already
+  bool SetOutputWaiter(engine::SingleUseEvent& event);
+
+  /// Disarms the event, must be called before the event is destroyed
+  void ResetOutputWaiter() noexcept;
+
+ private:
+  friend class Http2StreamWriter;
+
+  struct Callbacks;
+
+  struct Stream {
+    // request, until it is finalized
+    std::optional<HttpRequestConstructor> request_constructor;
+    std::string authority;
+    std::string cookies;
+    bool is_url_complete{false};
+    std::shared_ptr<request::RequestBase> request;
+
+    // response, `body` points into the request for non-streamed bodies
+    std::string_view body;
+    std::string body_parts;
+    std::size_t body_offset{0};
+    bool is_response_submitted{false};
+    bool is_body_complete{false};
+    bool is_data_deferred{false};
+    // sent once the buffered body parts are read down to the limit
+    engine::SingleUseEvent* drain_waiter{nullptr};
+  };
+
+  using Header = std::pair<std::string, std::string>;
+
+  Stream* FindStream(std::int32_t stream_id);
+  Stream& GetStreamForResponse(std::int32_t stream_id);
+
+  void CheckUrlComplete(Stream& stream);
+  void FinalizeRequest(std::int32_t stream_id, Stream& stream);
+
+  void SubmitResponse(std::int32_t stream_id, HttpStatus status,
+                      const std::vector<Header>& headers,
+                      std::optional<std::string_view> body);
+  void SubmitBodyPart(std::int32_t stream_id, std::string&& body_part);
+  void WaitForBodyDrain(std::int32_t stream_id, engine::SingleUseEvent& event);
+  void FinishBody(std::int32_t stream_id);
+  void NotifyOutput() noexcept;
+  void NotifyBodyRead(Stream& stream) noexcept;
+
+  const HandlerInfoIndex& handler_info_index_;
+  const HttpRequestConstructor::Config request_constructor_config_;
+  OnNewRequestCb on_new_request_cb_;
+  OnStreamResetCb on_stream_reset_cb_;
+  net::ParserStats& stats_;
+  request::ResponseDataAccounter& data_accounter_;
+  const std::size_t max_stream_output_buffer_size_;
+
+  engine::Mutex mutex_;
+  nghttp2_session* session_{nullptr};
+  std::unordered_map<std::int32_t, Stream> streams_;
+  bool is_output_pending_{false};
+  engine::SingleUseEvent* output_waiter_{nullptr};
+};
+
+/// @brief Writes a response into a stream of Http2Session.
+///
+/// Used by HttpResponse::SendResponse for HTTP/2 requests.
+class Http2StreamWriter final {
+ public:
+  Http2StreamWriter(Http2Session& session, std::int32_t stream_id);
+
+  /// Lowercases the name, drops the connection-specific headers
+  void AddHeader(std::string_view name, std::string_view value);
+
+  /// @brief Submits the whole response.
+  /// @param body must be owned by the request of the stream, it is read
+  /// as the peer's flow control window allows.
+  /// @returns the size of the headers and the body
+  std::size_t WriteResponse(HttpStatus status, std::string_view body);
+
+  /// @brief Submits the response headers, the body is written with
+  /// WriteBodyPart and terminated with Finish.
+  /// @returns the size of the headers
+  std::size_t WriteHeaders(HttpStatus status);
+
+  /// Waits for the peer to read the previous parts if too many of them are
+  /// buffered already
+  std::size_t WriteBodyPart(std::string&& body_part);
+
+  void Finish();
+
+ private:
+  std::size_t GetHeadersSize() const;
+
+  Http2Session& session_;
+  const std::int32_t stream_id_;
+  std::vector<Http2Session::Header> headers_;
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
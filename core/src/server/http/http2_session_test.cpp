@@ -0,0 +1,353 @@
+#include <server/http/http2_session.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <server/http/http_request_impl.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::Http2Session;
+using server::http::Http2StreamWriter;
+using server::http::HttpRequestImpl;
+
+using RequestPtr = std::shared_ptr<server::request::RequestBase>;
+
+constexpr std::string_view kClientPreface =
+    "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+
+constexpr std::uint8_t kFrameData = 0x0;
+constexpr std::uint8_t kFrameHeaders = 0x1;
+constexpr std::uint8_t kFrameRstStream = 0x3;
+constexpr std::uint8_t kFrameSettings = 0x4;
+constexpr std::uint8_t kFrameGoaway = 0x7;
+
+constexpr std::uint8_t kFlagEndStream = 0x1;
+constexpr std::uint8_t kFlagEndHeaders = 0x4;
+
+struct Frame {
+  std::uint8_t type{0};
+  std::uint8_t flags{0};
+  std::int32_t stream_id{0};
+  std::string payload;
+};
+
+std::string SerializeFrame(const Frame& frame) {
+  std::string result;
+  const auto size = frame.payload.size();
+  result += static_cast<char>((size >> 16) & 0xff);
+  result += static_cast<char>((size >> 8) & 0xff);
+  result += static_cast<char>(size & 0xff);
+  result += static_cast<char>(frame.type);
+  result += static_cast<char>(frame.flags);
+  for (int shift = 24; shift >= 0; shift -= 8) {
+    result += static_cast<char>((frame.stream_id >> shift) & 0xff);
+  }
+  return result + frame.payload;
+}
+
+std::vector<Frame> ParseFrames(std::string_view data) {
+  std::vector<Frame> result;
+  while (data.size() >= 9) {
+    const auto byte = [&data](std::size_t i) {
+      return static_cast<std::uint8_t>(data[i]);
+    };
+    const std::size_t size = (byte(0) << 16) | (byte(1) << 8) | byte(2);
+    Frame frame;
+    frame.type = byte(3);
+    frame.flags = byte(4);
+    frame.stream_id = static_cast<std::int32_t>(
+        ((byte(5) & 0x7f) << 24) | (byte(6) << 16) | (byte(7) << 8) | byte(8));
+    frame.payload = std::string{data.substr(9, size)};
+    result.push_back(std::move(frame));
+    data.remove_prefix(9 + size);
+  }
+  EXPECT_TRUE(data.empty());
+  return result;
+}
+
+// HPACK (RFC 7541) without Huffman coding, static table indices only
+std::string LiteralHeader(std::uint8_t name_index, std::string_view value) {
+  std::string result;
+  if (name_index < 15) {
+    result += static_cast<char>(name_index);
+  } else {
+    result += '\x0f';
+    result += static_cast<char>(name_index - 15);
+  }
+  result += static_cast<char>(value.size());
+  return result.append(value);
+}
+
+std::string LiteralHeader(std::string_view name, std::string_view value) {
+  std::string result{'\0'};
+  result += static_cast<char>(name.size());
+  result.append(name);
+  result += static_cast<char>(value.size());
+  return result.append(value);
+}
+
+// :method GET, :scheme http, :path /
+constexpr std::string_view kGetRootHeaders = "\x82\x86\x84";
+constexpr std::uint8_t kAuthorityIndex = 1;
+constexpr std::uint8_t kCookieIndex = 32;
+
+std::string MakeRequest(std::int32_t stream_id, std::string header_block) {
+  return SerializeFrame({kFrameHeaders, kFlagEndStream | kFlagEndHeaders,
+                         stream_id, std::move(header_block)});
+}
+
+std::string MakeConnectionStart() {
+  return std::string{kClientPreface} +
+         SerializeFrame({kFrameSettings, 0, 0, {}});
+}
+
+class TestSession final {
+ public:
+  explicit TestSession(server::net::Http2SessionConfig session_config = {})
+      : session_(
+            kHandlerInfoIndex, kRequestConfig, session_config,
+            [this](std::int32_t stream_id, RequestPtr&& request) {
+              requests_.emplace_back(stream_id, std::move(request));
+            },
+            [this](std::int32_t stream_id) {
+              reset_streams_.push_back(stream_id);
+            },
+            stats_, accounter_) {}
+
+  Http2Session& operator*() { return session_; }
+  Http2Session* operator->() { return &session_; }
+
+  std::vector<Frame> PullFrames() {
+    std::string output;
+    session_.PullOutput(output, 1024 * 1024);
+    return ParseFrames(output);
+  }
+
+  const auto& Requests() const { return requests_; }
+  const auto& ResetStreams() const { return reset_streams_; }
+
+ private:
+  static inline const server::http::HandlerInfoIndex kHandlerInfoIndex;
+  static constexpr server::request::HttpRequestConfig kRequestConfig{
+      /*.max_url_size = */ 8192,
+      /*.max_request_size = */ 1024 * 1024,
+      /*.max_headers_size = */ 65536,
+      /*.parse_args_from_body = */ false,
+      /*.testing_mode = */ true,
+      /*.decompress_request = */ false,
+  };
+
+  server::net::ParserStats stats_;
+  server::request::ResponseDataAccounter accounter_;
+  std::vector<std::pair<std::int32_t, RequestPtr>> requests_;
+  std::vector<std::int32_t> reset_streams_;
+  Http2Session session_;
+};
+
+const HttpRequestImpl& AsHttpRequest(const RequestPtr& request) {
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+  return static_cast<const HttpRequestImpl&>(*request);
+}
+
+}  // namespace
+
+UTEST(Http2Session, Request) {
+  TestSession session;
+  const auto data =
+      MakeConnectionStart() +
+      MakeRequest(1, std::string{kGetRootHeaders} +
+                         LiteralHeader(kAuthorityIndex, "localhost") +
+                         LiteralHeader("x-test", "value") +
+                         LiteralHeader(kCookieIndex, "a=1") +
+                         LiteralHeader(kCookieIndex, "b=2"));
+  ASSERT_TRUE(session->Parse(data.data(), data.size()));
+
+  ASSERT_EQ(session.Requests().size(), 1);
+  const auto& [stream_id, request_ptr] = session.Requests().front();
+  EXPECT_EQ(stream_id, 1);
+  const auto& request = AsHttpRequest(request_ptr);
+  EXPECT_EQ(request.GetMethod(), server::http::HttpMethod::kGet);
+  EXPECT_EQ(request.GetUrl(), "/");
+  EXPECT_EQ(request.GetHttpMajor(), 2);
+  EXPECT_EQ(request.GetHeader("Host"), "localhost");
+  EXPECT_EQ(request.GetHeader("X-Test"), "value");
+  EXPECT_EQ(request.GetCookie("a"), "1");
+  EXPECT_EQ(request.GetCookie("b"), "2");
+
+  // server SETTINGS and the ACK of the client ones
+  const auto frames = session.PullFrames();
+  ASSERT_EQ(frames.size(), 2);
+  EXPECT_EQ(frames[0].type, kFrameSettings);
+  EXPECT_EQ(frames[1].type, kFrameSettings);
+  EXPECT_TRUE(session.ResetStreams().empty());
+}
+
+UTEST(Http2Session, Response) {
+  TestSession session;
+  const auto data =
+      MakeConnectionStart() + MakeRequest(1, std::string{kGetRootHeaders});
+  ASSERT_TRUE(session->Parse(data.data(), data.size()));
+  ASSERT_EQ(session.Requests().size(), 1);
+  session.PullFrames();
+
+  engine::SingleUseEvent output_submitted;
+  ASSERT_TRUE(session->SetOutputWaiter(output_submitted));
+
+  constexpr std::string_view kBody = "hello";
+  Http2StreamWriter writer{*session, 1};
+  writer.AddHeader("Content-Type", "text/plain");
+  writer.WriteResponse(server::http::HttpStatus::kOk, kBody);
+  EXPECT_EQ(output_submitted.WaitUntil(engine::Deadline::Passed()),
+            engine::FutureStatus::kReady);
+  session->ResetOutputWaiter();
+
+  const auto frames = session.PullFrames();
+  ASSERT_EQ(frames.size(), 2);
+  EXPECT_EQ(frames[0].type, kFrameHeaders);
+  EXPECT_EQ(frames[0].stream_id, 1);
+  EXPECT_EQ(frames[1].type, kFrameData);
+  EXPECT_EQ(frames[1].stream_id, 1);
+  EXPECT_EQ(frames[1].flags & kFlagEndStream, kFlagEndStream);
+  EXPECT_EQ(frames[1].payload, kBody);
+  EXPECT_TRUE(session.ResetStreams().empty());
+}
+
+UTEST(Http2Session, StreamedResponse) {
+  TestSession session;
+  const auto data =
+      MakeConnectionStart() + MakeRequest(1, std::string{kGetRootHeaders});
+  ASSERT_TRUE(session->Parse(data.data(), data.size()));
+  session.PullFrames();
+
+  Http2StreamWriter writer{*session, 1};
+  writer.WriteHeaders(server::http::HttpStatus::kOk);
+  auto frames = session.PullFrames();
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_EQ(frames[0].type, kFrameHeaders);
+  EXPECT_EQ(frames[0].flags & kFlagEndStream, 0);
+
+  writer.WriteBodyPart("first ");
+  writer.WriteBodyPart("second");
+  frames = session.PullFrames();
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_EQ(frames[0].type, kFrameData);
+  EXPECT_EQ(frames[0].payload, "first second");
+  EXPECT_EQ(frames[0].flags & kFlagEndStream, 0);
+
+  writer.Finish();
+  frames = session.PullFrames();
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_EQ(frames[0].type, kFrameData);
+  EXPECT_TRUE(frames[0].payload.empty());
+  EXPECT_EQ(frames[0].flags & kFlagEndStream, kFlagEndStream);
+}
+
+UTEST(Http2Session, StreamedResponseBackpressure) {
+  server::net::Http2SessionConfig config;
+  config.max_stream_output_buffer_size = 8;
+  TestSession session{config};
+  const auto data =
+      MakeConnectionStart() + MakeRequest(1, std::string{kGetRootHeaders});
+  ASSERT_TRUE(session->Parse(data.data(), data.size()));
+  session.PullFrames();
+
+  Http2StreamWriter writer{*session, 1};
+  writer.WriteHeaders(server::http::HttpStatus::kOk);
+  session.PullFrames();
+
+  // within the limit
+  writer.WriteBodyPart("12345678");
+
+  auto producer = engine::AsyncNoSpan([&writer] {
+    writer.WriteBodyPart("9");
+    writer.Finish();
+  });
+  engine::Yield();
+  EXPECT_FALSE(producer.IsFinished());
+
+  auto frames = session.PullFrames();
+  ASSERT_FALSE(frames.empty());
+  EXPECT_EQ(frames[0].type, kFrameData);
+  EXPECT_EQ(frames[0].payload, "123456789");
+
+  UEXPECT_NO_THROW(producer.Get());
+  frames = session.PullFrames();
+  ASSERT_EQ(frames.size(), 1);
+  EXPECT_EQ(frames[0].flags & kFlagEndStream, kFlagEndStream);
+}
+
+UTEST(Http2Session, StreamResetWhileWaitingForPeer) {
+  server::net::Http2SessionConfig config;
+  config.max_stream_output_buffer_size = 8;
+  TestSession session{config};
+  auto data =
+      MakeConnectionStart() + MakeRequest(1, std::string{kGetRootHeaders});
+  ASSERT_TRUE(session->Parse(data.data(), data.size()));
+  session.PullFrames();
+
+  Http2StreamWriter writer{*session, 1};
+  writer.WriteHeaders(server::http::HttpStatus::kOk);
+  session.PullFrames();
+
+  auto producer = engine::AsyncNoSpan(
+      [&writer] { writer.WriteBodyPart("too large for the buffer"); });
+  engine::Yield();
+  EXPECT_FALSE(producer.IsFinished());
+
+  // CANCEL
+  data = SerializeFrame({kFrameRstStream, 0, 1, std::string{"\0\0\0\x08", 4}});
+  ASSERT_TRUE(session->Parse(data.data(), data.size()));
+  UEXPECT_THROW(producer.Get(), server::http::Http2StreamClosedException);
+}
+
+UTEST(Http2Session, StreamReset) {
+  TestSession session;
+  auto data =
+      MakeConnectionStart() + MakeRequest(1, std::string{kGetRootHeaders});
+  ASSERT_TRUE(session->Parse(data.data(), data.size()));
+  session.PullFrames();
+
+  // CANCEL
+  data = SerializeFrame({kFrameRstStream, 0, 1, std::string{"\0\0\0\x08", 4}});
+  ASSERT_TRUE(session->Parse(data.data(), data.size()));
+  EXPECT_EQ(session.ResetStreams(), std::vector<std::int32_t>{1});
+
+  Http2StreamWriter writer{*session, 1};
+  EXPECT_THROW(writer.WriteResponse(server::http::HttpStatus::kOk, {}),
+               server::http::Http2StreamClosedException);
+}
+
+UTEST(Http2Session, MalformedInput) {
+  TestSession session;
+  constexpr std::string_view kData =
+      "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n";
+  EXPECT_FALSE(session->Parse(kData.data(), kData.size()));
+
+  const auto frames = session.PullFrames();
+  ASSERT_FALSE(frames.empty());
+  EXPECT_EQ(frames.back().type, kFrameGoaway);
+  EXPECT_FALSE(session->IsAlive());
+}
+
+UTEST(Http2Session, Terminate) {
+  TestSession session;
+  const auto data = MakeConnectionStart();
+  ASSERT_TRUE(session->Parse(data.data(), data.size()));
+  EXPECT_TRUE(session->IsAlive());
+
+  session->Terminate();
+  const auto frames = session.PullFrames();
+  ASSERT_FALSE(frames.empty());
+  EXPECT_EQ(frames.back().type, kFrameGoaway);
+  EXPECT_FALSE(session->IsAlive());
+}
+
+USERVER_NAMESPACE_END
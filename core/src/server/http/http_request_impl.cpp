@@ -308,6 +308,7 @@ void HttpRequestImpl::MarkAsInternalServerError() const {
   // TODO : refactor, this being here is a bit ridiculous
   response_.SetStatus(http::HttpStatus::kInternalServerError);
   response_.SetData({});
+  response_.ClearBodySegments();
   response_.ClearHeaders();
 }
 
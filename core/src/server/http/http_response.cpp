@@ -1,5 +1,8 @@
 #include <userver/server/http/http_response.hpp>
 
+#include <unistd.h>
+
+#include <algorithm>
 #include <array>
 
 #include <cctz/time_zone.h>
@@ -7,6 +10,7 @@
 
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
 #include <userver/hostinfo/blocking/get_hostname.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/http/content_type.hpp>
@@ -17,7 +21,9 @@
 #include <userver/utils/datetime/wall_coarse_clock.hpp>
 #include <userver/utils/small_string.hpp>
 
+#include <server/http/http2_session.hpp>
 #include <server/http/http_cached_date.hpp>
+#include <utils/check_syscall.hpp>
 
 #include "http_request_impl.hpp"
 
@@ -96,6 +102,71 @@ void AppendToCharArray(char*& data, const std::string_view what) {
 
 const std::string kEmptyString{};
 
+// Socket::SendAll keeps up to this many buffers on stack
+constexpr std::size_t kMaxIoDataPerWrite = 31;
+constexpr std::size_t kFileChunkSize = 64 * 1024;
+
+std::size_t WriteIoData(engine::io::RwBase& socket,
+                        engine::io::Socket* tcp_socket,
+                        const std::vector<engine::io::IoData>& list) {
+  std::size_t sent_bytes = 0;
+  if (tcp_socket) {
+    for (std::size_t pos = 0; pos < list.size(); pos += kMaxIoDataPerWrite) {
+      sent_bytes += tcp_socket->SendAll(
+          list.data() + pos, std::min(kMaxIoDataPerWrite, list.size() - pos),
+          engine::Deadline{});
+    }
+  } else {
+    for (const auto& io_data : list) {
+      sent_bytes += socket.WriteAll(io_data.data, io_data.len, {});
+    }
+  }
+  return sent_bytes;
+}
+
+std::size_t ReadFileChunk(const server::http::HttpResponse::FileRange& range,
+                          std::size_t offset, std::string& buffer) {
+  buffer.resize(std::min(kFileChunkSize, range.size - offset));
+  const auto read_bytes = utils::CheckSyscall(
+      ::pread(range.file->GetNative(), buffer.data(), buffer.size(),
+              static_cast<off_t>(range.offset + offset)),
+      "reading a response body file");
+  buffer.resize(read_bytes);
+  return read_bytes;
+}
+
+// Content-Length is already sent, so the connection must not be reused
+void ThrowIfFileRangeIsShort(
+    const server::http::HttpResponse::FileRange& range, std::size_t sent) {
+  if (sent < range.size) {
+    throw std::runtime_error(
+        fmt::format("Response body file ended after {} out of {} bytes of "
+                    "the range at offset {}",
+                    sent, range.size, range.offset));
+  }
+}
+
+std::size_t SendFileRange(engine::io::RwBase& socket,
+                          engine::io::Socket* tcp_socket,
+                          const server::http::HttpResponse::FileRange& range) {
+  std::size_t sent_bytes = 0;
+  if (tcp_socket) {
+    sent_bytes = tcp_socket->SendFile(range.file->GetNative(), range.offset,
+                                      range.size, engine::Deadline{});
+  } else {
+    // e.g. TLS, kTLS offload is not used
+    std::string buffer;
+    while (sent_bytes < range.size) {
+      if (!ReadFileChunk(range, sent_bytes, buffer)) break;
+      const auto written = socket.WriteAll(buffer.data(), buffer.size(), {});
+      sent_bytes += written;
+      if (written < buffer.size()) break;
+    }
+  }
+  ThrowIfFileRangeIsShort(range, sent_bytes);
+  return sent_bytes;
+}
+
 }  // namespace
 
 namespace server::http {
@@ -248,6 +319,32 @@ bool HttpResponse::HasHeader(
   return headers_.find(header_name) != headers_.end();
 }
 
+void HttpResponse::AppendBodySegment(std::shared_ptr<const std::string> data) {
+  UASSERT(data);
+  if (data->empty()) return;
+  body_segments_.emplace_back(std::move(data));
+}
+
+void HttpResponse::AppendBodySegment(FileRange range) {
+  UASSERT(range.file);
+  if (range.size == 0) return;
+  body_segments_.emplace_back(std::move(range));
+}
+
+void HttpResponse::ClearBodySegments() { body_segments_.clear(); }
+
+std::size_t HttpResponse::GetBodySize() const {
+  std::size_t size = GetData().size();
+  for (const auto& segment : body_segments_) {
+    if (const auto* range = std::get_if<FileRange>(&segment)) {
+      size += range->size;
+    } else {
+      size += std::get<std::shared_ptr<const std::string>>(segment)->size();
+    }
+  }
+  return size;
+}
+
 HttpResponse::CookiesMapKeys HttpResponse::GetCookieNames() const {
   return HttpResponse::CookiesMapKeys{cookies_};
 }
@@ -326,20 +423,106 @@ void HttpResponse::SendResponse(engine::io::RwBase& socket) {
   SetSent(sent_bytes, std::chrono::steady_clock::now());
 }
 
+void HttpResponse::SendResponse(Http2StreamWriter& writer) {
+  headers_.erase(USERVER_NAMESPACE::http::headers::kContentLength);
+  const auto end = headers_.end();
+  if (headers_.find(USERVER_NAMESPACE::http::headers::kDate) == end) {
+    // impl::GetCachedDate() must not cross thread boundaries
+    writer.AddHeader(USERVER_NAMESPACE::http::headers::kDate,
+                     impl::GetCachedDate());
+  }
+  if (headers_.find(USERVER_NAMESPACE::http::headers::kContentType) == end) {
+    writer.AddHeader(USERVER_NAMESPACE::http::headers::kContentType,
+                     kDefaultContentType);
+  }
+  for (const auto& [name, value] : headers_) {
+    writer.AddHeader(name, value);
+  }
+  for (const auto& cookie : cookies_) {
+    writer.AddHeader(USERVER_NAMESPACE::http::headers::kSetCookie,
+                     cookie.second.ToString());
+  }
+
+  const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
+  const auto& data = GetData();
+  std::size_t sent_bytes{};
+
+  if (IsBodyStreamed() && data.empty()) {
+    if (is_body_forbidden) {
+      sent_bytes = writer.WriteResponse(status_, {});
+    } else {
+      sent_bytes = writer.WriteHeaders(status_);
+      std::string body_part;
+      while (body_stream_->Pop(body_part)) {
+        if (body_part.empty()) continue;
+        sent_bytes += writer.WriteBodyPart(std::move(body_part));
+      }
+      writer.Finish();
+
+      body_stream_producer_.reset();
+      body_stream_.reset();
+    }
+  } else {
+    // e.g. a CustomHandlerException
+    const auto body_size = GetBodySize();
+    if (!is_body_forbidden) {
+      writer.AddHeader(USERVER_NAMESPACE::http::headers::kContentLength,
+                       fmt::format(FMT_COMPILE("{}"), body_size));
+    } else if (body_size != 0) {
+      LOG_LIMITED_WARNING()
+          << "Non-empty body provided for response with HTTP code "
+          << static_cast<int>(status_)
+          << " which does not allow one, it will be dropped";
+    }
+
+    const bool is_head_request = request_.GetMethod() == HttpMethod::kHead;
+    if (is_head_request || is_body_forbidden || body_segments_.empty()) {
+      sent_bytes = writer.WriteResponse(
+          status_, is_head_request || is_body_forbidden
+                       ? std::string_view{}
+                       : std::string_view{data});
+    } else {
+      // the session owns the DATA frames payload, so the segments are copied
+      sent_bytes = writer.WriteHeaders(status_);
+      if (!data.empty()) sent_bytes += writer.WriteBodyPart(std::string{data});
+      for (const auto& segment : body_segments_) {
+        if (const auto* range = std::get_if<FileRange>(&segment)) {
+          std::string buffer;
+          std::size_t offset = 0;
+          while (offset < range->size) {
+            if (!ReadFileChunk(*range, offset, buffer)) break;
+            offset += buffer.size();
+            sent_bytes += writer.WriteBodyPart(std::move(buffer));
+          }
+          ThrowIfFileRangeIsShort(*range, offset);
+        } else {
+          const auto& part =
+              *std::get<std::shared_ptr<const std::string>>(segment);
+          sent_bytes += writer.WriteBodyPart(std::string{part});
+        }
+      }
+      writer.Finish();
+    }
+  }
+
+  SetSent(sent_bytes, std::chrono::steady_clock::now());
+}
+
 std::size_t HttpResponse::SetBodyNotStreamed(
     engine::io::RwBase& socket,
     USERVER_NAMESPACE::http::headers::HeadersString& header) {
   const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
   const bool is_head_request = request_.GetMethod() == HttpMethod::kHead;
   const auto& data = GetData();
+  const auto body_size = GetBodySize();
 
   if (!is_body_forbidden) {
     impl::OutputHeader(header, USERVER_NAMESPACE::http::headers::kContentLength,
-                       fmt::format(FMT_COMPILE("{}"), data.size()));
+                       fmt::format(FMT_COMPILE("{}"), body_size));
   }
   header.append(kCrlf);
 
-  if (is_body_forbidden && !data.empty()) {
+  if (is_body_forbidden && body_size != 0) {
     LOG_LIMITED_WARNING()
         << "Non-empty body provided for response with HTTP code "
         << static_cast<int>(status_)
@@ -347,7 +530,9 @@ std::size_t HttpResponse::SetBodyNotStreamed(
   }
 
   ssize_t sent_bytes = 0;
-  if (!is_head_request && !is_body_forbidden) {
+  if (!is_head_request && !is_body_forbidden && !body_segments_.empty()) {
+    sent_bytes = WriteBodySegments(socket, header);
+  } else if (!is_head_request && !is_body_forbidden) {
     sent_bytes = socket.WriteAll(
         {{header.data(), header.size()}, {data.data(), data.size()}},
         engine::Deadline{});
@@ -359,6 +544,33 @@ std::size_t HttpResponse::SetBodyNotStreamed(
   return sent_bytes;
 }
 
+std::size_t HttpResponse::WriteBodySegments(
+    engine::io::RwBase& socket,
+    USERVER_NAMESPACE::http::headers::HeadersString& header) {
+  auto* tcp_socket = dynamic_cast<engine::io::Socket*>(&socket);
+  const auto& data = GetData();
+
+  // consecutive in-memory parts are gathered into a single writev
+  std::vector<engine::io::IoData> pending;
+  pending.reserve(body_segments_.size() + 2);
+  pending.push_back({header.data(), header.size()});
+  if (!data.empty()) pending.push_back({data.data(), data.size()});
+
+  std::size_t sent_bytes = 0;
+  for (const auto& segment : body_segments_) {
+    if (const auto* range = std::get_if<FileRange>(&segment)) {
+      sent_bytes += WriteIoData(socket, tcp_socket, pending);
+      pending.clear();
+      sent_bytes += SendFileRange(socket, tcp_socket, *range);
+    } else {
+      const auto& part = *std::get<std::shared_ptr<const std::string>>(segment);
+      pending.push_back({part.data(), part.size()});
+    }
+  }
+  sent_bytes += WriteIoData(socket, tcp_socket, pending);
+  return sent_bytes;
+}
+
 std::size_t HttpResponse::SetBodyStreamed(
     engine::io::RwBase& socket,
     USERVER_NAMESPACE::http::headers::HeadersString& header) {
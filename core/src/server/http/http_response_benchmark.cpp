@@ -3,6 +3,7 @@
 #include <fmt/compile.h>
 #include <sstream>
 
+#include <userver/engine/io/common.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/server/http/http_response.hpp>
 #include <userver/server/http/http_status.hpp>
@@ -149,11 +150,59 @@ void HttpResponseSetHeaderBenchmark(benchmark::State& state) {
   }
 }
 
+// Discards the written data, so that only the response serialization and
+// the body copies are measured
+class NullSocket final : public engine::io::RwBase {
+ public:
+  bool IsValid() const override { return true; }
+  bool WaitReadable(engine::Deadline) override { return false; }
+  size_t ReadSome(void*, size_t, engine::Deadline) override { return 0; }
+  size_t ReadAll(void*, size_t, engine::Deadline) override { return 0; }
+  bool WaitWriteable(engine::Deadline) override { return true; }
+
+  size_t WriteAll(const void* buf, size_t len, engine::Deadline) override {
+    benchmark::DoNotOptimize(buf);
+    return len;
+  }
+};
+
+void HttpResponseSendCopiedBody(benchmark::State& state) {
+  server::request::ResponseDataAccounter accounter{};
+  const std::string body(state.range(0), 'x');
+  NullSocket socket;
+
+  for ([[maybe_unused]] auto _ : state) {
+    const server::http::HttpRequestImpl request_impl{accounter};
+    auto& response = request_impl.GetHttpResponse();
+    response.SetData(body);
+    response.SendResponse(socket);
+  }
+}
+
+void HttpResponseSendSharedBody(benchmark::State& state) {
+  server::request::ResponseDataAccounter accounter{};
+  const auto body = std::make_shared<const std::string>(state.range(0), 'x');
+  NullSocket socket;
+
+  for ([[maybe_unused]] auto _ : state) {
+    const server::http::HttpRequestImpl request_impl{accounter};
+    auto& response = request_impl.GetHttpResponse();
+    response.AppendBodySegment(body);
+    response.SendResponse(socket);
+  }
+}
+
 }  // namespace
 
 BENCHMARK(http_headers_serialization_inplace);
 BENCHMARK(http_headers_serialization_no_ostreams);
 BENCHMARK(http_headers_serialization_ostreams);
 BENCHMARK(HttpResponseSetHeaderBenchmark);
+BENCHMARK(HttpResponseSendCopiedBody)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 22);
+BENCHMARK(HttpResponseSendSharedBody)
+    ->RangeMultiplier(16)
+    ->Range(1 << 10, 1 << 22);
 
 USERVER_NAMESPACE_END
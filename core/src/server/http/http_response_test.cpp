@@ -6,6 +6,9 @@
 
 #include <server/http/http_request_impl.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/internal/net/net_listener.hpp>
 #include <userver/server/http/http_response.hpp>
@@ -83,6 +86,98 @@ UTEST(HttpResponse, AccounterLifetimeIfSent) {
   // Now we just should not crash
 }
 
+UTEST(HttpResponse, BodySegments) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  const auto temp_file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(temp_file.GetPath(), "0123456789");
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+
+  response.SetData("head ");
+  response.AppendBodySegment(std::make_shared<const std::string>("middle "));
+  response.AppendBodySegment(server::http::HttpResponse::FileRange{
+      std::make_shared<const fs::blocking::FileDescriptor>(
+          fs::blocking::FileDescriptor::Open(temp_file.GetPath(),
+                                             fs::blocking::OpenFlag::kRead)),
+      2, 5});
+  response.AppendBodySegment(std::make_shared<const std::string>(" tail"));
+
+  constexpr std::string_view kBody = "head middle 23456 tail";
+  EXPECT_EQ(response.GetBodySize(), kBody.size());
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  auto send_task = engine::AsyncNoSpan(
+      [](auto&& response, auto&& socket) { response.SendResponse(socket); },
+      std::ref(response), std::move(server));
+
+  std::vector<char> buffer(4096, '\0');
+  const auto reply_size =
+      client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+
+  std::string_view reply{buffer.data(), reply_size};
+  const auto expected_content_length = fmt::format(
+      "\r\n{}: {}\r\n", http::headers::kContentLength, kBody.size());
+  EXPECT_TRUE(reply.find(expected_content_length) != std::string_view::npos);
+  EXPECT_EQ(reply.substr(reply.size() - 4 - kBody.size()),
+            fmt::format("\r\n\r\n{}", kBody));
+  send_task.Get();
+  EXPECT_EQ(response.BytesSent(), reply_size);
+}
+
+UTEST(HttpResponse, BodySegmentsFileShorterThanRange) {
+  const auto test_deadline =
+      engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+  const auto temp_file = fs::blocking::TempFile::Create();
+  fs::blocking::RewriteFileContents(temp_file.GetPath(), "0123456789");
+
+  server::request::ResponseDataAccounter accounter;
+  server::http::HttpRequestImpl request{accounter};
+  server::http::HttpResponse response{request, accounter};
+
+  response.AppendBodySegment(server::http::HttpResponse::FileRange{
+      std::make_shared<const fs::blocking::FileDescriptor>(
+          fs::blocking::FileDescriptor::Open(temp_file.GetPath(),
+                                             fs::blocking::OpenFlag::kRead)),
+      8, 5});
+
+  auto [server, client] =
+      internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+  auto send_task = engine::AsyncNoSpan(
+      [](auto&& response, auto&& socket) { response.SendResponse(socket); },
+      std::ref(response), std::move(server));
+
+  std::vector<char> buffer(4096, '\0');
+  const auto reply_size =
+      client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+
+  std::string_view reply{buffer.data(), reply_size};
+  const auto expected_content_length =
+      fmt::format("\r\n{}: {}\r\n", http::headers::kContentLength, 5);
+  EXPECT_TRUE(reply.find(expected_content_length) != std::string_view::npos);
+  EXPECT_EQ(reply.substr(reply.size() - 6), "\r\n\r\n89");
+  UEXPECT_THROW(send_task.Get(), std::runtime_error);
+}
+
+UTEST(HttpResponse, BodySegmentsDroppedOnInternalServerError) {
+  server::request::ResponseDataAccounter accounter;
+  const server::http::HttpRequestImpl request{accounter};
+  auto& response = request.GetHttpResponse();
+
+  response.SetData("head ");
+  response.AppendBodySegment(std::make_shared<const std::string>("tail"));
+  request.MarkAsInternalServerError();
+
+  EXPECT_EQ(response.GetStatus(),
+            server::http::HttpStatus::kInternalServerError);
+  EXPECT_EQ(response.GetBodySize(), 0);
+}
+
 class HttpResponseBody : public testing::TestWithParam<int> {};
 
 UTEST_P(HttpResponseBody, ForbiddenBody) {
@@ -24,6 +24,8 @@ MiddlewaresList DefaultPipeline() {
   return {
       // Metrics should go before everything else, basically.
       std::string{HandlerMetrics::kName},
+      // Compresses the response body after Tracing has logged it
+      std::string{ResponseCompression::kName},
       // Tracing should go before UnknownExceptionsHandlingMiddleware because it
       // adds some headers, which otherwise might be cleared
       std::string{Tracing::kName},
@@ -57,6 +59,7 @@ components::ComponentList DefaultMiddlewareComponents() {
       .Append<DeadlinePropagationFactory>()
       .Append<DecompressionFactory>()
       .Append<SetAcceptEncodingFactory>()
+      .Append<ResponseCompressionFactory>()
       .Append<ExceptionsHandlingFactory>()
       .Append<UnknownExceptionsHandlingFactory>()
       .Append<testsuite::ExceptionsHandlingMiddlewareFactory>();
@@ -64,6 +64,7 @@ std::optional<std::chrono::milliseconds> ParseTimeout(
 void SetFormattedErrorResponse(
     http::HttpResponse& http_response,
     handlers::FormattedErrorData&& formatted_error_data) {
+  http_response.ClearBodySegments();
   http_response.SetData(std::move(formatted_error_data.external_body));
   if (formatted_error_data.content_type) {
     http_response.SetContentType(*std::move(formatted_error_data.content_type));
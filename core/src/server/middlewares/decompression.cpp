@@ -1,8 +1,9 @@
 #include <server/middlewares/decompression.hpp>
 
-#include <compression/gzip.hpp>
+#include <compression/codec.hpp>
 
 #include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
 #include <userver/server/handlers/exceptions.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/server/http/http_request.hpp>
@@ -50,9 +51,10 @@ bool Decompression::DecompressRequestBody(http::HttpRequest& request) const {
   }};
 
   try {
-    if (content_encoding == "gzip") {
-      auto body = compression::gzip::Decompress(request.RequestBody(),
-                                                max_request_size_);
+    if (const auto codec =
+            compression::ParseContentEncoding(content_encoding)) {
+      auto body = compression::Decompress(*codec, request.RequestBody(),
+                                          max_request_size_);
       request.SetRequestBody(std::move(body));
       if (parse_args_from_body_) {
         request.ParseArgsFromBody();
@@ -103,10 +105,59 @@ void SetAcceptEncoding::SetResponseAcceptEncoding(
   // User didn't set Accept-Encoding, let us do that
   if (!response.HasHeader(USERVER_NAMESPACE::http::headers::kAcceptEncoding)) {
     response.SetHeader(USERVER_NAMESPACE::http::headers::kAcceptEncoding,
-                       "gzip, identity");
+                       "gzip, zstd, br, identity");
   }
 }
 
+ResponseCompression::ResponseCompression(
+    const handlers::HttpHandlerBase& handler)
+    : compress_response_{handler.GetConfig().compress_response},
+      min_size_{handler.GetConfig().compress_response_min_size} {}
+
+void ResponseCompression::HandleRequest(
+    http::HttpRequest& request, request::RequestContext& context) const {
+  Next(request, context);
+
+  if (compress_response_) CompressResponseBody(request);
+}
+
+void ResponseCompression::CompressResponseBody(
+    const http::HttpRequest& request) const {
+  auto& response = request.GetHttpResponse();
+  const auto& body = response.GetData();
+
+  // The streamed bodies and the appended body segments are sent as is
+  if (response.IsBodyStreamed() || response.GetBodySize() != body.size() ||
+      body.size() < min_size_ ||
+      response.HasHeader(USERVER_NAMESPACE::http::headers::kContentEncoding)) {
+    return;
+  }
+
+  // The body depends on Accept-Encoding, even if it is not compressed
+  auto vary = response.GetHeader(USERVER_NAMESPACE::http::headers::kVary);
+  vary += vary.empty() ? "Accept-Encoding" : ", Accept-Encoding";
+  response.SetHeader(USERVER_NAMESPACE::http::headers::kVary, std::move(vary));
+
+  const auto codec = compression::NegotiateCodec(
+      request.GetHeader(USERVER_NAMESPACE::http::headers::kAcceptEncoding),
+      compression::kCodecs);
+  if (!codec) return;
+
+  const auto scope_time = tracing::ScopeTime::CreateOptionalScopeTime(
+      "http_compress_response_body");
+
+  try {
+    response.SetData(compression::Compress(*codec, body));
+  } catch (const std::exception& e) {
+    LOG_WARNING() << "Failed to compress the response body, sending it "
+                     "uncompressed: "
+                  << e;
+    return;
+  }
+  response.SetHeader(USERVER_NAMESPACE::http::headers::kContentEncoding,
+                     std::string{compression::ToContentEncoding(*codec)});
+}
+
 }  // namespace server::middlewares
 
 USERVER_NAMESPACE_END
@@ -54,6 +54,26 @@ class SetAcceptEncoding final : public HttpMiddlewareBase {
 
 using SetAcceptEncodingFactory = SimpleHttpMiddlewareFactory<SetAcceptEncoding>;
 
+class ResponseCompression final : public HttpMiddlewareBase {
+ public:
+  static constexpr std::string_view kName{
+      "userver-response-compression-middleware"};
+
+  explicit ResponseCompression(const handlers::HttpHandlerBase&);
+
+ private:
+  void HandleRequest(http::HttpRequest& request,
+                     request::RequestContext& context) const override;
+
+  void CompressResponseBody(const http::HttpRequest& request) const;
+
+  const bool compress_response_;
+  const std::size_t min_size_;
+};
+
+using ResponseCompressionFactory =
+    SimpleHttpMiddlewareFactory<ResponseCompression>;
+
 }  // namespace server::middlewares
 
 USERVER_NAMESPACE_END
@@ -1,9 +1,12 @@
 #include "connection.hpp"
 
 #include <array>
+#include <deque>
+#include <string_view>
 #include <system_error>
 #include <vector>
 
+#include <server/http/http_request_impl.hpp>
 #include <server/http/request_handler_base.hpp>
 
 #include <userver/engine/async.hpp>
@@ -12,15 +15,38 @@
 #include <userver/engine/io/tls_wrapper.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/engine/wait_any.hpp>
+#include <userver/engine/single_use_event.hpp>
 #include <userver/logging/log.hpp>
+#include <userver/server/http/http_response.hpp>
 #include <userver/server/request/request_config.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
+#include <userver/utils/text_light.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+namespace {
+
+constexpr std::string_view kHttp2Preface = "PRI * HTTP/2.0\r\n\r\nSM\r\n\r\n";
+constexpr std::string_view kHttp2AlpnProtocol = "h2";
+constexpr std::size_t kHttp2OutputChunkSize = 64 * 1024;
+
+// RFC 9112 Section 9.3.2, only the requests with safe methods are handled
+// concurrently with the previous ones, so that side effects happen in order
+bool IsSafeToRunAhead(const request::RequestBase& request) {
+  UASSERT(dynamic_cast<const http::HttpRequestImpl*>(&request));
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+  const auto method =
+      static_cast<const http::HttpRequestImpl&>(request).GetMethod();
+  return method == http::HttpMethod::kGet ||
+         method == http::HttpMethod::kHead ||
+         method == http::HttpMethod::kOptions;
+}
+
+}  // namespace
+
 Connection::Connection(
     const ConnectionConfig& config,
     const request::HttpRequestConfig& handler_defaults_config,
@@ -69,82 +95,22 @@ void Connection::Shutdown() noexcept {
 
   peer_socket_.reset();
 
+  if (protocol_) --stats_->GetProtocolStats(*protocol_).active_connections;
   --stats_->active_connections;
   ++stats_->connections_closed;
 }
 
 void Connection::ListenForRequests() noexcept {
-  using RequestBasePtr = std::shared_ptr<request::RequestBase>;
-
   try {
-    std::vector<RequestBasePtr> pending_requests;
-
-    http::HttpRequestParser request_parser(
-        request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
-        [&pending_requests](RequestBasePtr&& request_ptr) {
-          pending_requests.push_back(std::move(request_ptr));
-        },
-        stats_->parser_stats, data_accounter_);
-
     pending_data_.resize(config_.in_buffer_size);
-    while (is_accepting_requests_) {
-      auto deadline = engine::Deadline::FromDuration(config_.keepalive_timeout);
-
-      if (pending_data_size_ == 0) {
-        bool is_readable = true;
-        // If we didn't fill the buffer in the previous loop iteration we almost
-        // certainly will hit EWOULDBLOCK on the subsequent recv syscall from
-        // peer_socket_.RecvSome, which will fall back to event-loop waiting
-        // for socket to become readable, and then issue another recv syscall,
-        // effectively doing
-        // 1. recv (returns -1)
-        // 2. notify event-loop about read interest
-        // 3. recv (return some data)
-        //
-        // So instead we just do 2. and 3., shaving off a whole recv syscall
-        if (pending_data_size_ != pending_data_.size()) {
-          is_readable = peer_socket_->WaitReadable(deadline);
-        }
+    const auto protocol = DetectProtocol();
+    AccountProtocol(protocol);
 
-        pending_data_size_ =
-            is_readable ? peer_socket_->ReadSome(pending_data_.data(),
-                                                 pending_data_.size(), deadline)
-                        : 0;
-        if (!pending_data_size_) {
-          LOG_TRACE() << "Peer " << Getpeername() << " on fd " << Fd()
-                      << " closed connection or the connection timed out";
-
-          // RFC7230 does not specify rules for connections half-closed from
-          // client side. However, section 6 tells us that in most cases
-          // connections are closed after sending/receiving the last response.
-          // See also: https://github.com/httpwg/http-core/issues/22
-          //
-          // It is faster (and probably more efficient) for us to cancel
-          // currently processing and pending requests.
-          return;
-        }
-        LOG_TRACE() << "Received " << pending_data_size_ << " byte(s) from "
-                    << Getpeername() << " on fd " << Fd();
-      }
-
-      bool should_stop_accepting_requests = false;
-      if (!request_parser.Parse(pending_data_.data(), pending_data_size_)) {
-        LOG_DEBUG() << "Malformed request from " << Getpeername() << " on fd "
-                    << Fd();
-
-        // Stop accepting new requests, send previous answers.
-        should_stop_accepting_requests = true;
-      }
-      pending_data_size_ = 0;
-
-      for (auto&& request : pending_requests) {
-        ProcessRequest(std::move(request));
-      }
-      pending_requests.resize(0);
-      if (should_stop_accepting_requests) is_accepting_requests_ = false;
+    if (protocol == Protocol::kHttp2) {
+      ListenForHttp2Requests();
+    } else {
+      ListenForHttp1Requests();
     }
-
-    LOG_TRACE() << "Gracefully stopping ListenForRequests()";
   } catch (const engine::io::IoTimeout&) {
     LOG_INFO() << "Closing idle connection on timeout";
   } catch (const engine::io::IoCancelled&) {
@@ -164,6 +130,126 @@ void Connection::ListenForRequests() noexcept {
   }
 }
 
+Protocol Connection::DetectProtocol() {
+  if (config_.http_version != HttpVersion::k2) return Protocol::kHttp1;
+
+  auto* tls_socket = dynamic_cast<engine::io::TlsWrapper*>(peer_socket_.get());
+  if (tls_socket) {
+    return tls_socket->GetAlpnProtocol() == kHttp2AlpnProtocol
+               ? Protocol::kHttp2
+               : Protocol::kHttp1;
+  }
+
+  // Cleartext HTTP/2 with prior knowledge, RFC 9113 Section 3.3. The bytes
+  // read here are left in pending_data_ for the chosen parser.
+  const auto deadline =
+      engine::Deadline::FromDuration(config_.keepalive_timeout);
+  while (pending_data_size_ < kHttp2Preface.size()) {
+    const std::string_view received{pending_data_.data(), pending_data_size_};
+    if (!utils::text::StartsWith(kHttp2Preface, received)) {
+      return Protocol::kHttp1;
+    }
+
+    const auto count = peer_socket_->ReadSome(
+        pending_data_.data() + pending_data_size_,
+        pending_data_.size() - pending_data_size_, deadline);
+    // HTTP/1.1 parser handles the closed connection
+    if (!count) return Protocol::kHttp1;
+    pending_data_size_ += count;
+  }
+
+  return utils::text::StartsWith(
+             std::string_view{pending_data_.data(), pending_data_size_},
+             kHttp2Preface)
+             ? Protocol::kHttp2
+             : Protocol::kHttp1;
+}
+
+void Connection::AccountProtocol(Protocol protocol) {
+  UASSERT(!protocol_);
+  protocol_ = protocol;
+
+  auto& protocol_stats = stats_->GetProtocolStats(protocol);
+  ++protocol_stats.active_connections;
+  ++protocol_stats.connections_created;
+}
+
+void Connection::ListenForHttp1Requests() {
+  using RequestBasePtr = std::shared_ptr<request::RequestBase>;
+
+  std::vector<RequestBasePtr> pending_requests;
+
+  http::HttpRequestParser request_parser(
+      request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
+      [&pending_requests](RequestBasePtr&& request_ptr) {
+        pending_requests.push_back(std::move(request_ptr));
+      },
+      stats_->parser_stats, data_accounter_);
+
+  while (is_accepting_requests_) {
+    auto deadline = engine::Deadline::FromDuration(config_.keepalive_timeout);
+
+    if (pending_data_size_ == 0) {
+      bool is_readable = true;
+      // If we didn't fill the buffer in the previous loop iteration we almost
+      // certainly will hit EWOULDBLOCK on the subsequent recv syscall from
+      // peer_socket_.RecvSome, which will fall back to event-loop waiting
+      // for socket to become readable, and then issue another recv syscall,
+      // effectively doing
+      // 1. recv (returns -1)
+      // 2. notify event-loop about read interest
+      // 3. recv (return some data)
+      //
+      // So instead we just do 2. and 3., shaving off a whole recv syscall
+      if (pending_data_size_ != pending_data_.size()) {
+        is_readable = peer_socket_->WaitReadable(deadline);
+      }
+
+      pending_data_size_ =
+          is_readable ? peer_socket_->ReadSome(pending_data_.data(),
+                                               pending_data_.size(), deadline)
+                      : 0;
+      if (!pending_data_size_) {
+        LOG_TRACE() << "Peer " << Getpeername() << " on fd " << Fd()
+                    << " closed connection or the connection timed out";
+
+        // RFC7230 does not specify rules for connections half-closed from
+        // client side. However, section 6 tells us that in most cases
+        // connections are closed after sending/receiving the last response.
+        // See also: https://github.com/httpwg/http-core/issues/22
+        //
+        // It is faster (and probably more efficient) for us to cancel
+        // currently processing and pending requests.
+        return;
+      }
+      LOG_TRACE() << "Received " << pending_data_size_ << " byte(s) from "
+                  << Getpeername() << " on fd " << Fd();
+    }
+
+    bool should_stop_accepting_requests = false;
+    if (!request_parser.Parse(pending_data_.data(), pending_data_size_)) {
+      LOG_DEBUG() << "Malformed request from " << Getpeername() << " on fd "
+                  << Fd();
+
+      // Stop accepting new requests, send previous answers.
+      should_stop_accepting_requests = true;
+    }
+    pending_data_size_ = 0;
+
+    if (config_.max_pipelined_requests > 1 && pending_requests.size() > 1) {
+      ProcessPipelinedRequests(pending_requests);
+    } else {
+      for (auto&& request : pending_requests) {
+        ProcessRequest(std::move(request));
+      }
+    }
+    pending_requests.resize(0);
+    if (should_stop_accepting_requests) is_accepting_requests_ = false;
+  }
+
+  LOG_TRACE() << "Gracefully stopping ListenForRequests()";
+}
+
 void Connection::ProcessRequest(
     std::shared_ptr<request::RequestBase>&& request_ptr) {
   if (request_ptr->IsFinal()) {
@@ -179,6 +265,63 @@ void Connection::ProcessRequest(
     request_ptr->DoUpgrade(std::move(peer_socket_), std::move(remote_address_));
 }
 
+void Connection::ProcessPipelinedRequests(
+    std::vector<std::shared_ptr<request::RequestBase>>& requests) {
+  struct InFlightRequest {
+    std::shared_ptr<request::RequestBase> request;
+    engine::TaskWithResult<void> task;
+  };
+  std::deque<InFlightRequest> in_flight;
+  std::size_t next_request = 0;
+
+  stats_->queued_pipelined_requests_count.Add(requests.size());
+  utils::FastScopeGuard queued_guard([&]() noexcept {
+    stats_->queued_pipelined_requests_count.Subtract(requests.size() -
+                                                     next_request);
+  });
+
+  const auto start_requests = [&] {
+    while (next_request < requests.size() &&
+           in_flight.size() < config_.max_pipelined_requests) {
+      auto& request = requests[next_request];
+      if (!in_flight.empty()) {
+        // An unsafe request is only started alone, so the front one tells
+        // whether all the requests in flight are safe
+        if (!IsSafeToRunAhead(*request) ||
+            !IsSafeToRunAhead(*in_flight.front().request)) {
+          break;
+        }
+        stats_->pipelined_requests_count.Add(1);
+      }
+
+      stats_->queued_pipelined_requests_count.Subtract(1);
+      stats_->active_request_count.Add(1);
+      auto task = request_handler_.StartRequestTask(request);
+      in_flight.push_back({std::move(request), std::move(task)});
+      ++next_request;
+    }
+  };
+
+  start_requests();
+  while (!in_flight.empty()) {
+    auto [request, request_task] = std::move(in_flight.front());
+    in_flight.pop_front();
+
+    if (request->IsFinal()) {
+      is_accepting_requests_ = false;
+    }
+
+    WaitForRequestTask(request, request_task);
+    SendResponse(*request);
+
+    if (request->IsUpgradeWebsocket()) {
+      request->DoUpgrade(std::move(peer_socket_), std::move(remote_address_));
+    }
+
+    start_requests();
+  }
+}
+
 bool Connection::ReadSome() {
   if (pending_data_size_ == pending_data_.size()) return true;
 
@@ -203,14 +346,20 @@ bool Connection::ReadSome() {
 engine::TaskWithResult<void> Connection::HandleQueueItem(
     const std::shared_ptr<request::RequestBase>& request) noexcept {
   auto request_task = request_handler_.StartRequestTask(request);
+  WaitForRequestTask(request, request_task);
+  return request_task;
+}
 
+void Connection::WaitForRequestTask(
+    const std::shared_ptr<request::RequestBase>& request,
+    engine::TaskWithResult<void>& request_task) noexcept {
   if (engine::current_task::IsCancelRequested()) {
     // We could've packed all remaining requests into a vector and cancel them
     // in parallel. But pipelining is almost never used so why bother.
     request_task.SyncCancel();
     LOG_DEBUG() << "Request processing interrupted";
     is_response_chain_valid_ = false;
-    return request_task;  // avoids throwing and catching exception down below
+    return;  // avoids throwing and catching exception down below
   }
 
   try {
@@ -263,7 +412,6 @@ engine::TaskWithResult<void> Connection::HandleQueueItem(
     LOG_WARNING() << "Request failed with unhandled exception: " << e;
     request->MarkAsInternalServerError();
   }
-  return request_task;
 }
 
 void Connection::SendResponse(request::RequestBase& request) {
@@ -283,16 +431,199 @@ void Connection::SendResponse(request::RequestBase& request) {
               : logging::Level::kError;
       LOG(log_level) << "I/O error while sending data: " << ex;
       response.SetSendFailed(std::chrono::steady_clock::now());
+      CloseAfterFailedSend();
+    } catch (const std::exception& ex) {
+      LOG_ERROR() << "Error while sending data: " << ex;
+      response.SetSendFailed(std::chrono::steady_clock::now());
+      CloseAfterFailedSend();
+    }
+  } else {
+    response.SetSendFailed(std::chrono::steady_clock::now());
+  }
+  FinishResponse(request);
+}
+
+void Connection::CloseAfterFailedSend() noexcept {
+  // A part of the response may have been sent already, the peer would
+  // misparse anything that follows it
+  is_response_chain_valid_ = false;
+  is_accepting_requests_ = false;
+}
+
+void Connection::ListenForHttp2Requests() {
+  // The socket is read and written by this task only, the request tasks
+  // submit their responses into the session and wake this task up.
+  http::Http2Session session(
+      request_handler_.GetHandlerInfoIndex(), handler_defaults_config_,
+      config_.http2_session_config,
+      [this, &session](std::int32_t stream_id,
+                       std::shared_ptr<request::RequestBase>&& request_ptr) {
+        // The wrapping task is critical, the handler task itself is subject
+        // to the task processor overload policy.
+        http2_streams_.emplace(
+            stream_id,
+            engine::CriticalAsyncNoSpan(
+                engine::current_task::GetTaskProcessor(),
+                [this, &session, stream_id](auto request_ptr) {
+                  ProcessHttp2Request(session, stream_id,
+                                      std::move(request_ptr));
+                },
+                std::move(request_ptr)));
+      },
+      [this](std::int32_t stream_id) {
+        const auto it = http2_streams_.find(stream_id);
+        if (it != http2_streams_.end()) it->second.RequestCancel();
+      },
+      stats_->parser_stats, data_accounter_);
+
+  utils::FastScopeGuard cancel_streams_guard([this]() noexcept {
+    for (auto& [stream_id, task] : http2_streams_) task.SyncCancel();
+    http2_streams_.clear();
+  });
+
+  if (pending_data_size_ != 0) {
+    session.Parse(pending_data_.data(), pending_data_size_);
+    pending_data_size_ = 0;
+  }
+
+  std::string output;
+  while (session.IsAlive()) {
+    output.clear();
+    session.PullOutput(output, kHttp2OutputChunkSize);
+    if (!output.empty()) {
+      peer_socket_->WriteAll(output.data(), output.size(), {});
+      continue;
+    }
+
+    EraseFinishedHttp2Streams();
+
+    engine::SingleUseEvent output_submitted;
+    if (!session.SetOutputWaiter(output_submitted)) continue;
+
+    // In-flight requests keep the connection alive
+    const auto deadline =
+        http2_streams_.empty()
+            ? engine::Deadline::FromDuration(config_.keepalive_timeout)
+            : engine::Deadline{};
+    std::optional<std::size_t> ready;
+    {
+      utils::FastScopeGuard reset_waiter_guard(
+          [&session]() noexcept { session.ResetOutputWaiter(); });
+      engine::io::ReadableBase& peer_read = *peer_socket_;
+      ready = engine::WaitAnyUntil(deadline, peer_read, output_submitted);
+    }
+
+    if (!ready) {
+      if (engine::current_task::ShouldCancel()) {
+        LOG_TRACE() << "HTTP/2 connection cancelled";
+        return;
+      }
+      if (deadline.IsReached()) {
+        LOG_INFO() << "Closing idle connection on timeout";
+        session.Terminate();
+      }
+      continue;
+    }
+    if (*ready != 0) continue;
+
+    if (!ReadSome()) {
+      LOG_TRACE() << "Peer " << Getpeername() << " on fd " << Fd()
+                  << " closed connection";
+      return;
+    }
+    if (pending_data_size_ == 0) continue;
+    LOG_TRACE() << "Received " << pending_data_size_ << " byte(s) from "
+                << Getpeername() << " on fd " << Fd();
+
+    if (!session.Parse(pending_data_.data(), pending_data_size_)) {
+      LOG_DEBUG() << "Malformed HTTP/2 frames from " << Getpeername()
+                  << " on fd " << Fd();
+    }
+    pending_data_size_ = 0;
+  }
+
+  LOG_TRACE() << "Gracefully stopping ListenForHttp2Requests()";
+}
+
+void Connection::ProcessHttp2Request(
+    http::Http2Session& session, std::int32_t stream_id,
+    std::shared_ptr<request::RequestBase>&& request_ptr) {
+  stats_->active_request_count.Add(1);
+
+  auto request_task = request_handler_.StartRequestTask(request_ptr);
+  bool is_cancelled = false;
+  try {
+    auto& response = request_ptr->GetResponse();
+    if (response.IsBodyStreamed()) {
+      response.WaitForHeadersEnd();
+    } else {
+      // Peer resets the stream by cancelling this task
+      request_task.Get();
+    }
+  } catch (const engine::TaskCancelledException& e) {
+    LOG_LIMITED_ERROR() << "Handler task was cancelled with reason: "
+                        << ToString(e.Reason());
+    auto& response = request_ptr->GetResponse();
+    if (!response.IsReady()) {
+      response.SetReady();
+      response.SetStatusServiceUnavailable();
+    }
+  } catch (const engine::WaitInterruptedException&) {
+    LOG_DEBUG() << "Request processing interrupted";
+    request_task.SyncCancel();
+    is_cancelled = true;
+  } catch (const std::exception& e) {
+    LOG_WARNING() << "Request failed with unhandled exception: " << e;
+    request_ptr->MarkAsInternalServerError();
+  }
+
+  SendHttp2Response(session, stream_id, *request_ptr, is_cancelled);
+}
+
+void Connection::SendHttp2Response(http::Http2Session& session,
+                                   std::int32_t stream_id,
+                                   request::RequestBase& request,
+                                   bool is_cancelled) {
+  auto& response = request.GetResponse();
+  UASSERT(!response.IsSent());
+  request.SetStartSendResponseTime();
+  if (!is_cancelled) {
+    try {
+      http::Http2StreamWriter writer{session, stream_id};
+      UASSERT(dynamic_cast<http::HttpResponse*>(&response));
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
+      static_cast<http::HttpResponse&>(response).SendResponse(writer);
+    } catch (const http::Http2StreamClosedException& ex) {
+      LOG_WARNING() << "I/O error while sending data: " << ex;
+      response.SetSendFailed(std::chrono::steady_clock::now());
     } catch (const std::exception& ex) {
       LOG_ERROR() << "Error while sending data: " << ex;
       response.SetSendFailed(std::chrono::steady_clock::now());
+      session.ResetStream(stream_id);
     }
   } else {
     response.SetSendFailed(std::chrono::steady_clock::now());
+    session.ResetStream(stream_id);
+  }
+  FinishResponse(request);
+}
+
+void Connection::EraseFinishedHttp2Streams() {
+  for (auto it = http2_streams_.begin(); it != http2_streams_.end();) {
+    if (it->second.IsFinished()) {
+      it = http2_streams_.erase(it);
+    } else {
+      ++it;
+    }
   }
+}
+
+void Connection::FinishResponse(request::RequestBase& request) {
   request.SetFinishSendResponseTime();
   stats_->active_request_count.Subtract(1);
   stats_->requests_processed_count.Add(1);
+  UASSERT(protocol_);
+  stats_->GetProtocolStats(*protocol_).requests_processed_count.Add(1);
 
   request.WriteAccessLogs(request_handler_.LoggerAccess(),
                           request_handler_.LoggerAccessTskv(), peer_name_);
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
+#include <server/http/http2_session.hpp>
 #include <server/http/http_request_parser.hpp>
 #include <server/http/request_handler_base.hpp>
 #include <server/net/connection_config.hpp>
@@ -10,6 +15,7 @@
 #include <server/request/request_parser.hpp>
 
 #include <userver/engine/io/socket.hpp>
+#include <userver/engine/task/task_with_result.hpp>
 #include <userver/server/request/request_base.hpp>
 #include <userver/server/request/request_config.hpp>
 
@@ -39,11 +45,29 @@ class Connection final {
   bool IsRequestTasksEmpty() const noexcept;
 
   void ListenForRequests() noexcept;
+  Protocol DetectProtocol();
+  void AccountProtocol(Protocol protocol);
+
+  void ListenForHttp1Requests();
   void ProcessRequest(std::shared_ptr<request::RequestBase>&& request_ptr);
 
   engine::TaskWithResult<void> HandleQueueItem(
       const std::shared_ptr<request::RequestBase>& request) noexcept;
+  void WaitForRequestTask(const std::shared_ptr<request::RequestBase>& request,
+                          engine::TaskWithResult<void>& request_task) noexcept;
+  void ProcessPipelinedRequests(
+      std::vector<std::shared_ptr<request::RequestBase>>& requests);
   void SendResponse(request::RequestBase& request);
+  void CloseAfterFailedSend() noexcept;
+
+  void ListenForHttp2Requests();
+  void ProcessHttp2Request(http::Http2Session& session, std::int32_t stream_id,
+                           std::shared_ptr<request::RequestBase>&& request_ptr);
+  void SendHttp2Response(http::Http2Session& session, std::int32_t stream_id,
+                         request::RequestBase& request, bool is_cancelled);
+  void EraseFinishedHttp2Streams();
+
+  void FinishResponse(request::RequestBase& request);
 
   std::string Getpeername() const;
 
@@ -66,6 +90,11 @@ class Connection final {
 
   bool is_accepting_requests_{true};
   bool is_response_chain_valid_{true};
+
+  std::optional<Protocol> protocol_;
+  // HTTP/2 request tasks by stream id, connection task only
+  std::unordered_map<std::int32_t, engine::TaskWithResult<void>>
+      http2_streams_;
 };
 
 }  // namespace server::net
@@ -1,11 +1,39 @@
 #include <server/net/connection_config.hpp>
 
+#include <userver/utils/trivial_map.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+HttpVersion Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<HttpVersion>) {
+  static constexpr utils::TrivialBiMap kMap([](auto selector) {
+    return selector().Case(HttpVersion::k11, "1.1").Case(HttpVersion::k2, "2");
+  });
+
+  return utils::ParseFromValueString(value, kMap);
+}
+
+Http2SessionConfig Parse(const yaml_config::YamlConfig& value,
+                         formats::parse::To<Http2SessionConfig>) {
+  Http2SessionConfig config;
+
+  config.max_concurrent_streams =
+      value["max_concurrent_streams"].As<std::uint32_t>(
+          config.max_concurrent_streams);
+  config.max_frame_size =
+      value["max_frame_size"].As<std::uint32_t>(config.max_frame_size);
+  config.initial_window_size = value["initial_window_size"].As<std::uint32_t>(
+      config.initial_window_size);
+  config.max_stream_output_buffer_size =
+      value["max_stream_output_buffer_size"].As<std::size_t>(
+          config.max_stream_output_buffer_size);
+
+  return config;
+}
+
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ConnectionConfig>) {
   ConnectionConfig config;
@@ -20,6 +48,13 @@ ConnectionConfig Parse(const yaml_config::YamlConfig& value,
           config.keepalive_timeout);
   config.abort_check_delay = utils::StringToDuration(
       value["stream_close_check_delay"].As<std::string>("20ms"));
+  config.max_pipelined_requests = value["max_pipelined_requests"].As<size_t>(
+      config.max_pipelined_requests);
+  config.http_version =
+      value["http_version"].As<HttpVersion>(config.http_version);
+  config.http2_session_config =
+      value["http2_session"].As<Http2SessionConfig>(
+          config.http2_session_config);
 
   return config;
 }
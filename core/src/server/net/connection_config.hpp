@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -9,13 +11,37 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+enum class HttpVersion {
+  k11,
+  // HTTP/2 over TLS (ALPN) and h2c with prior knowledge, HTTP/1.1 otherwise
+  k2,
+};
+
+struct Http2SessionConfig {
+  std::uint32_t max_concurrent_streams = 100;
+  std::uint32_t max_frame_size = 1 << 14;
+  std::uint32_t initial_window_size = (1 << 16) - 1;
+  // Streamed response bytes a stream buffers before its producer waits
+  std::size_t max_stream_output_buffer_size = 1024 * 1024;
+};
+
 struct ConnectionConfig {
   size_t in_buffer_size = 32 * 1024;
   size_t requests_queue_size_threshold = 100;
   std::chrono::seconds keepalive_timeout{10 * 60};
   std::chrono::milliseconds abort_check_delay{20};
+  // HTTP/1.1 pipelined requests of a connection to handle concurrently
+  size_t max_pipelined_requests = 1;
+  HttpVersion http_version = HttpVersion::k11;
+  Http2SessionConfig http2_session_config;
 };
 
+HttpVersion Parse(const yaml_config::YamlConfig& value,
+                  formats::parse::To<HttpVersion>);
+
+Http2SessionConfig Parse(const yaml_config::YamlConfig& value,
+                         formats::parse::To<Http2SessionConfig>);
+
 ConnectionConfig Parse(const yaml_config::YamlConfig& value,
                        formats::parse::To<ConnectionConfig>);
 
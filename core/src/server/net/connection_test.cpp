@@ -1,5 +1,11 @@
 #include <server/net/connection.hpp>
 
+#include <algorithm>
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include <fmt/format.h>
 
 #include <server/handlers/http_handler_base_statistics.hpp>
@@ -8,10 +14,13 @@
 #include <server/net/create_socket.hpp>
 #include <userver/clients/http/client.hpp>
 #include <userver/engine/io/sockaddr.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 
 #include <userver/utest/http_client.hpp>
 #include <userver/utest/utest.hpp>
+#include <userver/utils/text_light.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -98,6 +107,169 @@ net::ListenerConfig CreateConfig() {
   return config;
 }
 
+// Responds with the request path in the X-Path header. Requests to "/slow"
+// finish after the request to "/fast", requests to "/together/*" wait for
+// each other, requests to "/sleep/*" take a while.
+class PipeliningRequestHandler : public server::http::RequestHandlerBase {
+ public:
+  struct StartedRequest {
+    std::string path;
+    std::size_t running_requests;
+  };
+
+  explicit PipeliningRequestHandler(std::size_t together_requests = 0)
+      : together_requests_(together_requests) {}
+
+  engine::TaskWithResult<void> StartRequestTask(
+      std::shared_ptr<server::request::RequestBase> request) const override {
+    UASSERT(request);
+
+    auto& http_request = dynamic_cast<server::http::HttpRequestImpl&>(*request);
+    static server::handlers::HttpRequestStatistics statistics;
+    http_request.SetHttpHandlerStatistics(statistics);
+
+    return engine::AsyncNoSpan([this, request = std::move(request),
+                                &http_request] {
+      const auto& path = http_request.GetRequestPath();
+      const auto running = ++running_requests_;
+      {
+        std::lock_guard lock{mutex_};
+        started_.push_back({path, running});
+        max_running_requests_ = std::max(max_running_requests_, running);
+      }
+
+      const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+      if (path == "/slow") {
+        EXPECT_TRUE(fast_finished_.WaitForEventUntil(deadline));
+      } else if (utils::text::StartsWith(path, "/together/")) {
+        ++together_started_;
+        while (together_started_.load() < together_requests_) {
+          if (deadline.IsReached()) {
+            ADD_FAILURE() << "Requests were not handled concurrently";
+            break;
+          }
+          engine::SleepFor(std::chrono::milliseconds{1});
+        }
+      } else if (utils::text::StartsWith(path, "/sleep/")) {
+        engine::SleepFor(std::chrono::milliseconds{10});
+      }
+
+      auto& response = http_request.GetHttpResponse();
+      response.SetStatus(server::http::HttpStatus::kOk);
+      response.SetHeader(std::string{"X-Path"}, "<" + path + ">");
+      --running_requests_;
+      if (path == "/fast") fast_finished_.Send();
+    });
+  }
+
+  const server::http::HandlerInfoIndex& GetHandlerInfoIndex() const override {
+    return handler_info_index_;
+  }
+
+  const logging::LoggerPtr& LoggerAccess() const noexcept override {
+    return no_logger_;
+  };
+  const logging::LoggerPtr& LoggerAccessTskv() const noexcept override {
+    return no_logger_;
+  };
+
+  std::vector<StartedRequest> GetStarted() const {
+    std::lock_guard lock{mutex_};
+    return started_;
+  }
+
+  std::size_t GetMaxRunningRequests() const {
+    std::lock_guard lock{mutex_};
+    return max_running_requests_;
+  }
+
+ private:
+  const std::size_t together_requests_;
+  mutable std::atomic<std::size_t> running_requests_{0};
+  mutable std::atomic<std::size_t> together_started_{0};
+  mutable engine::SingleConsumerEvent fast_finished_;
+  mutable engine::Mutex mutex_;
+  mutable std::vector<StartedRequest> started_;
+  mutable std::size_t max_running_requests_{0};
+  logging::LoggerPtr no_logger_;
+  server::http::HandlerInfoIndex handler_info_index_;
+};
+
+class PipelinedConnection final {
+ public:
+  PipelinedConnection(std::size_t max_pipelined_requests,
+                      const server::http::RequestHandlerBase& handler)
+      : config_(CreateConfig()),
+        listen_socket_(net::CreateSocket(config_)),
+        stats_(std::make_shared<net::Stats>()) {
+    config_.connection_config.max_pipelined_requests = max_pipelined_requests;
+
+    const auto deadline = Deadline::FromDuration(kAcceptTimeout);
+    client_ = engine::io::Socket{listen_socket_.Getsockname().Domain(),
+                                 engine::io::SocketType::kStream};
+    client_.Connect(listen_socket_.Getsockname(), deadline);
+    auto peer = listen_socket_.Accept(deadline);
+    EXPECT_TRUE(peer.IsValid());
+
+    task_ = engine::AsyncNoSpan(
+        [this, &handler, peer = std::move(peer)]() mutable {
+          net::Connection connection(
+              config_.connection_config, config_.handler_defaults,
+              std::make_unique<engine::io::Socket>(std::move(peer)), {},
+              handler, stats_, data_accounter_);
+          connection.Process();
+        });
+  }
+
+  ~PipelinedConnection() { task_.SyncCancel(); }
+
+  const net::Stats& GetStats() const { return *stats_; }
+
+  // Sends the requests in a single write, so that they are pipelined
+  void Send(const std::vector<std::string_view>& requests) {
+    std::string data;
+    for (const auto& request : requests) data += request;
+    const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+    ASSERT_EQ(client_.SendAll(data.data(), data.size(), deadline),
+              data.size());
+  }
+
+  // Returns the positions of the responses to the requests with the paths
+  std::vector<std::size_t> ReceiveResponses(
+      const std::vector<std::string_view>& paths) {
+    const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+    std::vector<std::size_t> positions;
+    while (true) {
+      positions.clear();
+      for (const auto& path : paths) {
+        positions.push_back(received_.find(fmt::format("<{}>", path)));
+      }
+      if (std::find(positions.begin(), positions.end(), std::string::npos) ==
+          positions.end()) {
+        return positions;
+      }
+
+      std::array<char, 1024> buffer{};
+      const auto size =
+          client_.RecvSome(buffer.data(), buffer.size(), deadline);
+      if (!size) {
+        ADD_FAILURE() << "Connection closed, received: " << received_;
+        return positions;
+      }
+      received_.append(buffer.data(), size);
+    }
+  }
+
+ private:
+  net::ListenerConfig config_;
+  engine::io::Socket listen_socket_;
+  std::shared_ptr<net::Stats> stats_;
+  server::request::ResponseDataAccounter data_accounter_;
+  engine::io::Socket client_;
+  std::string received_;
+  engine::TaskWithResult<void> task_;
+};
+
 }  // namespace
 
 UTEST(ServerNetConnection, EarlyCancel) {
@@ -323,4 +495,78 @@ UTEST(ServerNetConnection, CancelMultipleInFlight) {
   FAIL() << "Failed to simulate cancellation of multiple requests";
 }
 
+UTEST(ServerNetConnection, PipelinedSafeRequestsRunConcurrently) {
+  PipeliningRequestHandler handler{3};
+  PipelinedConnection connection{4, handler};
+
+  connection.Send({
+      "GET /together/get HTTP/1.1\r\nHost: x\r\n\r\n",
+      "HEAD /together/head HTTP/1.1\r\nHost: x\r\n\r\n",
+      "OPTIONS /together/options HTTP/1.1\r\nHost: x\r\n\r\n",
+  });
+  const auto positions = connection.ReceiveResponses(
+      {"/together/get", "/together/head", "/together/options"});
+  EXPECT_TRUE(std::is_sorted(positions.begin(), positions.end()));
+
+  EXPECT_EQ(handler.GetMaxRunningRequests(), 3);
+  EXPECT_EQ(connection.GetStats().pipelined_requests_count.Read(), 2);
+}
+
+UTEST(ServerNetConnection, PipelinedResponsesInRequestOrder) {
+  PipeliningRequestHandler handler;
+  PipelinedConnection connection{4, handler};
+
+  // the second request finishes first
+  connection.Send({
+      "GET /slow HTTP/1.1\r\nHost: x\r\n\r\n",
+      "GET /fast HTTP/1.1\r\nHost: x\r\n\r\n",
+  });
+  const auto positions = connection.ReceiveResponses({"/slow", "/fast"});
+  EXPECT_LT(positions[0], positions[1]);
+}
+
+UTEST(ServerNetConnection, PipelinedUnsafeRequestIsBarrier) {
+  PipeliningRequestHandler handler;
+  PipelinedConnection connection{4, handler};
+
+  connection.Send({
+      "GET /sleep/before HTTP/1.1\r\nHost: x\r\n\r\n",
+      "POST /sleep/post HTTP/1.1\r\nHost: x\r\nContent-Length: 0\r\n\r\n",
+      "GET /sleep/after HTTP/1.1\r\nHost: x\r\n\r\n",
+  });
+  const auto positions = connection.ReceiveResponses(
+      {"/sleep/before", "/sleep/post", "/sleep/after"});
+  EXPECT_TRUE(std::is_sorted(positions.begin(), positions.end()));
+
+  // each request starts after the previous one is finished
+  const auto started = handler.GetStarted();
+  ASSERT_EQ(started.size(), 3);
+  for (const auto& request : started) {
+    EXPECT_EQ(request.running_requests, 1) << request.path;
+  }
+  EXPECT_EQ(connection.GetStats().pipelined_requests_count.Read(), 0);
+}
+
+UTEST(ServerNetConnection, PipelinedRequestsLimit) {
+  constexpr std::size_t kMaxPipelinedRequests = 2;
+  PipeliningRequestHandler handler;
+  PipelinedConnection connection{kMaxPipelinedRequests, handler};
+
+  connection.Send({
+      "GET /sleep/1 HTTP/1.1\r\nHost: x\r\n\r\n",
+      "GET /sleep/2 HTTP/1.1\r\nHost: x\r\n\r\n",
+      "GET /sleep/3 HTTP/1.1\r\nHost: x\r\n\r\n",
+      "GET /sleep/4 HTTP/1.1\r\nHost: x\r\n\r\n",
+  });
+  const auto positions = connection.ReceiveResponses(
+      {"/sleep/1", "/sleep/2", "/sleep/3", "/sleep/4"});
+  EXPECT_TRUE(std::is_sorted(positions.begin(), positions.end()));
+
+  EXPECT_LE(handler.GetMaxRunningRequests(), kMaxPipelinedRequests);
+  const auto& stats = connection.GetStats();
+  // all the requests but the first one are started ahead of the previous
+  EXPECT_EQ(stats.pipelined_requests_count.Read(), 3);
+  EXPECT_EQ(stats.queued_pipelined_requests_count.NonNegativeRead(), 0);
+}
+
 USERVER_NAMESPACE_END
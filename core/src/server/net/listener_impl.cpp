@@ -7,6 +7,7 @@
 #include <stdexcept>
 #include <string>
 #include <system_error>
+#include <vector>
 
 #include <server/net/create_socket.hpp>
 #include <userver/engine/async.hpp>
@@ -24,6 +25,12 @@ USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+namespace {
+
+const std::vector<std::string> kHttp2AlpnProtocols{"h2", "http/1.1"};
+
+}  // namespace
+
 ListenerImpl::ListenerImpl(engine::TaskProcessor& task_processor,
                            std::shared_ptr<EndpointInfo> endpoint_info,
                            request::ResponseDataAccounter& data_accounter)
@@ -48,7 +55,10 @@ ListenerImpl::ListenerImpl(engine::TaskProcessor& task_processor,
               }
             }
           },
-          CreateSocket(endpoint_info_->listener_config))) {}
+          CreateSocket(endpoint_info_->listener_config))) {
+  stats_->max_pipelined_requests =
+      endpoint_info_->listener_config.connection_config.max_pipelined_requests;
+}
 
 ListenerImpl::~ListenerImpl() {
   LOG_TRACE() << "Stopping socket listener task";
@@ -105,7 +115,10 @@ void ListenerImpl::ProcessConnection(engine::io::Socket peer_socket) {
     socket = std::make_unique<engine::io::TlsWrapper>(
         engine::io::TlsWrapper::StartTlsServer(
             std::move(peer_socket), config.tls_cert, config.tls_private_key, {},
-            config.tls_certificate_authorities));
+            config.tls_certificate_authorities,
+            config.connection_config.http_version == HttpVersion::k2
+                ? kHttp2AlpnProtocols
+                : std::vector<std::string>{}));
   } else {
     socket = std::make_unique<engine::io::Socket>(std::move(peer_socket));
   }
@@ -0,0 +1,22 @@
+#include <server/net/stats.hpp>
+
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::net {
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ProtocolStatsAggregation& stats) {
+  if (auto conn_stats = writer["connections"]) {
+    conn_stats["active"] = stats.active_connections;
+    conn_stats["opened"] = stats.connections_created;
+  }
+  if (auto request_stats = writer["requests"]) {
+    request_stats["processed"] = stats.requests_processed_count;
+  }
+}
+
+}  // namespace server::net
+
+USERVER_NAMESPACE_END
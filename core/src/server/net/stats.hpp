@@ -1,10 +1,12 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <cstddef>
 #include <vector>
 
 #include <userver/concurrent/striped_counter.hpp>
+#include <userver/utils/statistics/fwd.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -29,6 +31,39 @@ struct ParserStatsAggregation final {
   std::size_t parsing_request_count{0};
 };
 
+enum class Protocol { kHttp1, kHttp2 };
+
+// A connection is accounted to a protocol once the protocol is negotiated
+struct ProtocolStats {
+  std::atomic<size_t> active_connections{0};
+  std::atomic<size_t> connections_created{0};
+  concurrent::StripedCounter requests_processed_count;
+};
+
+struct ProtocolStatsAggregation final {
+  ProtocolStatsAggregation() = default;
+
+  explicit ProtocolStatsAggregation(const ProtocolStats& stats)
+      : active_connections{stats.active_connections.load()},
+        connections_created{stats.connections_created.load()},
+        requests_processed_count{stats.requests_processed_count.Read()} {}
+
+  ProtocolStatsAggregation& operator+=(const ProtocolStatsAggregation& other) {
+    active_connections += other.active_connections;
+    connections_created += other.connections_created;
+    requests_processed_count += other.requests_processed_count;
+
+    return *this;
+  }
+
+  std::size_t active_connections{0};
+  std::size_t connections_created{0};
+  std::size_t requests_processed_count{0};
+};
+
+void DumpMetric(utils::statistics::Writer& writer,
+                const ProtocolStatsAggregation& stats);
+
 struct Stats {
   // per listener
   std::atomic<size_t> active_connections{0};
@@ -39,6 +74,21 @@ struct Stats {
   ParserStats parser_stats;
   concurrent::StripedCounter active_request_count;
   concurrent::StripedCounter requests_processed_count;
+
+  // per protocol
+  ProtocolStats http1_stats;
+  ProtocolStats http2_stats;
+
+  // HTTP/1.1 pipelining, the limit is per listener
+  std::atomic<size_t> max_pipelined_requests{1};
+  // started while an earlier request of the connection is in flight
+  concurrent::StripedCounter pipelined_requests_count;
+  // parsed, waiting for an earlier request to finish
+  concurrent::StripedCounter queued_pipelined_requests_count;
+
+  ProtocolStats& GetProtocolStats(Protocol protocol) noexcept {
+    return protocol == Protocol::kHttp2 ? http2_stats : http1_stats;
+  }
 };
 
 struct StatsAggregation final {
@@ -50,7 +100,13 @@ struct StatsAggregation final {
         connections_closed{stats.connections_closed.load()},
         parser_stats{stats.parser_stats},
         active_request_count{stats.active_request_count.NonNegativeRead()},
-        requests_processed_count{stats.requests_processed_count.Read()} {}
+        requests_processed_count{stats.requests_processed_count.Read()},
+        http1_stats{stats.http1_stats},
+        http2_stats{stats.http2_stats},
+        max_pipelined_requests{stats.max_pipelined_requests.load()},
+        pipelined_requests_count{stats.pipelined_requests_count.Read()},
+        queued_pipelined_requests_count{
+            stats.queued_pipelined_requests_count.NonNegativeRead()} {}
 
   StatsAggregation& operator+=(const StatsAggregation& other) {
     active_connections += other.active_connections;
@@ -60,6 +116,13 @@ struct StatsAggregation final {
     parser_stats += other.parser_stats;
     active_request_count += other.active_request_count;
     requests_processed_count += other.requests_processed_count;
+    http1_stats += other.http1_stats;
+    http2_stats += other.http2_stats;
+
+    max_pipelined_requests =
+        std::max(max_pipelined_requests, other.max_pipelined_requests);
+    pipelined_requests_count += other.pipelined_requests_count;
+    queued_pipelined_requests_count += other.queued_pipelined_requests_count;
 
     return *this;
   }
@@ -72,6 +135,15 @@ struct StatsAggregation final {
   ParserStatsAggregation parser_stats;
   std::size_t active_request_count{0};
   std::size_t requests_processed_count{0};
+
+  // per protocol
+  ProtocolStatsAggregation http1_stats;
+  ProtocolStatsAggregation http2_stats;
+
+  // HTTP/1.1 pipelining, max over the listeners
+  std::size_t max_pipelined_requests{0};
+  std::size_t pipelined_requests_count{0};
+  std::size_t queued_pipelined_requests_count{0};
 };
 
 }  // namespace server::net
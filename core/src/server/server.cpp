@@ -358,6 +358,20 @@ void Server::WriteMonitorData(utils::statistics::Writer& writer) const {
     request_stats["avg-lifetime-ms"] = pimpl->GetAvgRequestTimeMs().count();
     request_stats["processed"] = server_stats.requests_processed_count;
     request_stats["parsing"] = server_stats.parser_stats.parsing_request_count;
+    if (auto pipelining_stats = request_stats["pipelining"]) {
+      pipelining_stats["limit"] = server_stats.max_pipelined_requests;
+      pipelining_stats["started-ahead"] =
+          server_stats.pipelined_requests_count;
+      pipelining_stats["queued"] =
+          server_stats.queued_pipelined_requests_count;
+    }
+  }
+
+  if (auto protocol_stats = writer["by-protocol"]) {
+    protocol_stats.ValueWithLabels(server_stats.http1_stats,
+                                   {"protocol", "http/1.1"});
+    protocol_stats.ValueWithLabels(server_stats.http2_stats,
+                                   {"protocol", "h2"});
   }
 }
 
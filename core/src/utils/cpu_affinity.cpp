@@ -0,0 +1,136 @@
+#include <utils/cpu_affinity.hpp>
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <stdexcept>
+#include <system_error>
+
+#include <fmt/format.h>
+
+#include <userver/fs/blocking/read.hpp>
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+namespace {
+
+constexpr std::string_view kNumaNodesPath = "/sys/devices/system/node";
+
+std::size_t ParseCpuIndex(std::string_view text, std::string_view cpu_list) {
+  std::size_t result{};
+  const auto* const end = text.data() + text.size();
+  const auto [ptr, ec] = std::from_chars(text.data(), end, result);
+  if (text.empty() || ec != std::errc{} || ptr != end) {
+    throw std::runtime_error(
+        fmt::format("Invalid CPU list '{}': bad CPU index '{}'", cpu_list, text));
+  }
+  return result;
+}
+
+}  // namespace
+
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list) {
+  std::vector<std::size_t> result;
+
+  for (auto range : text::SplitIntoStringViewVector(cpu_list, ",")) {
+    while (!range.empty() && text::IsAsciiSpace(range.front())) {
+      range.remove_prefix(1);
+    }
+    while (!range.empty() && text::IsAsciiSpace(range.back())) {
+      range.remove_suffix(1);
+    }
+    if (range.empty()) continue;
+
+    const auto dash_pos = range.find('-');
+    if (dash_pos == std::string_view::npos) {
+      result.push_back(ParseCpuIndex(range, cpu_list));
+      continue;
+    }
+
+    const auto first = ParseCpuIndex(range.substr(0, dash_pos), cpu_list);
+    const auto last = ParseCpuIndex(range.substr(dash_pos + 1), cpu_list);
+    if (first > last) {
+      throw std::runtime_error(
+          fmt::format("Invalid CPU list '{}': bad range '{}'", cpu_list, range));
+    }
+    for (auto cpu = first; cpu <= last; ++cpu) result.push_back(cpu);
+  }
+
+  std::sort(result.begin(), result.end());
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+std::vector<std::size_t> GetNumaNodeCpus(std::size_t numa_node) {
+  const auto path = fmt::format("{}/node{}/cpulist", kNumaNodesPath, numa_node);
+  if (!fs::blocking::FileExists(path)) {
+    throw std::runtime_error(
+        fmt::format("NUMA node {} does not exist: no '{}'", numa_node, path));
+  }
+  return ParseCpuList(fs::blocking::ReadFileContents(path));
+}
+
+std::size_t GetNumaNodesCount() {
+  const auto path = fmt::format("{}/possible", kNumaNodesPath);
+  if (!fs::blocking::FileExists(path)) return 1;
+
+  try {
+    const auto nodes = ParseCpuList(fs::blocking::ReadFileContents(path));
+    return nodes.empty() ? 1 : nodes.back() + 1;
+  } catch (const std::exception&) {
+    return 1;
+  }
+}
+
+std::vector<std::size_t> ResolveCpuSet(const std::vector<std::size_t>& cpu_set,
+                                       std::optional<std::size_t> numa_node) {
+  if (!numa_node) return cpu_set;
+
+  auto node_cpus = GetNumaNodeCpus(*numa_node);
+  if (cpu_set.empty()) return node_cpus;
+
+  std::vector<std::size_t> result;
+  std::set_intersection(cpu_set.begin(), cpu_set.end(), node_cpus.begin(),
+                        node_cpus.end(), std::back_inserter(result));
+  if (result.empty()) {
+    throw std::runtime_error(fmt::format(
+        "None of the CPUs from the cpu-set belong to the NUMA node {}",
+        *numa_node));
+  }
+  return result;
+}
+
+void SetThreadCpuAffinity(std::thread::native_handle_type thread,
+                          const std::vector<std::size_t>& cpus) {
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (const auto cpu : cpus) {
+    if (cpu >= CPU_SETSIZE) {
+      throw std::runtime_error(
+          fmt::format("CPU index {} exceeds CPU_SETSIZE", cpu));
+    }
+    CPU_SET(cpu, &cpu_set);
+  }
+
+  const int res = ::pthread_setaffinity_np(thread, sizeof(cpu_set), &cpu_set);
+  if (res != 0) {
+    throw std::system_error(res, std::generic_category(),
+                            "pthread_setaffinity_np");
+  }
+#else
+  (void)thread;
+  (void)cpus;
+  throw std::runtime_error("Setting CPU affinity is only supported on Linux");
+#endif
+}
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
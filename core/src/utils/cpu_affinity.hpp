@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+/// Parses a Linux-style CPU list, e.g. "0-3,8,10-11". Returns sorted unique
+/// CPU indices. Throws std::runtime_error on a malformed list.
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list);
+
+/// Returns the list of CPUs that belong to the NUMA node @p numa_node.
+/// Throws std::runtime_error if the node does not exist.
+std::vector<std::size_t> GetNumaNodeCpus(std::size_t numa_node);
+
+/// Returns the count of the NUMA nodes, 1 if the information is unavailable.
+std::size_t GetNumaNodesCount();
+
+/// Resolves a CPU set from the optional explicit @p cpu_set and the optional
+/// @p numa_node. If both are specified, returns their intersection. Returns
+/// an empty vector if neither is specified.
+std::vector<std::size_t> ResolveCpuSet(const std::vector<std::size_t>& cpu_set,
+                                       std::optional<std::size_t> numa_node);
+
+/// Binds the thread to the @p cpus. Throws std::system_error on failure.
+void SetThreadCpuAffinity(std::thread::native_handle_type thread,
+                          const std::vector<std::size_t>& cpus);
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,66 @@
+#include <utils/cpu_affinity.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include <userver/fs/blocking/read.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(CpuAffinity, ParseCpuList) {
+  using Cpus = std::vector<std::size_t>;
+
+  EXPECT_EQ(utils::ParseCpuList(""), Cpus{});
+  EXPECT_EQ(utils::ParseCpuList("3"), Cpus{3});
+  EXPECT_EQ(utils::ParseCpuList("0-3"), (Cpus{0, 1, 2, 3}));
+  EXPECT_EQ(utils::ParseCpuList("0-1,8,10-11\n"), (Cpus{0, 1, 8, 10, 11}));
+  EXPECT_EQ(utils::ParseCpuList("5, 1-2, 2"), (Cpus{1, 2, 5}));
+}
+
+TEST(CpuAffinity, ParseCpuListInvalid) {
+  EXPECT_THROW(utils::ParseCpuList("a"), std::runtime_error);
+  EXPECT_THROW(utils::ParseCpuList("1-"), std::runtime_error);
+  EXPECT_THROW(utils::ParseCpuList("3-1"), std::runtime_error);
+  EXPECT_THROW(utils::ParseCpuList("-1"), std::runtime_error);
+}
+
+TEST(CpuAffinity, ResolveCpuSetWithoutNumaNode) {
+  const std::vector<std::size_t> cpus{1, 2};
+  EXPECT_EQ(utils::ResolveCpuSet(cpus, std::nullopt), cpus);
+}
+
+TEST(CpuAffinity, NumaNodesCount) {
+  const auto count = utils::GetNumaNodesCount();
+  EXPECT_GE(count, 1);
+
+  const boost::filesystem::path nodes_path{"/sys/devices/system/node"};
+  if (!boost::filesystem::is_directory(nodes_path)) return;
+
+  // Every online node is counted, including the ones after a gap
+  for (const auto& entry : boost::filesystem::directory_iterator{nodes_path}) {
+    const auto name = entry.path().filename().string();
+    if (name.size() <= 4 || name.compare(0, 4, "node") != 0) continue;
+    EXPECT_LT(std::stoul(name.substr(4)), count) << name;
+  }
+}
+
+TEST(CpuAffinity, NumaNodeCpus) {
+  if (!fs::blocking::FileExists("/sys/devices/system/node/node0/cpulist")) {
+    GTEST_SKIP() << "No NUMA information";
+  }
+
+  const auto cpus = utils::GetNumaNodeCpus(0);
+  ASSERT_FALSE(cpus.empty());
+  EXPECT_EQ(utils::ResolveCpuSet({}, 0), cpus);
+  EXPECT_EQ(utils::ResolveCpuSet({cpus.front()}, 0),
+            std::vector<std::size_t>{cpus.front()});
+
+  EXPECT_THROW(utils::GetNumaNodeCpus(utils::GetNumaNodesCount()),
+               std::runtime_error);
+}
+
+USERVER_NAMESPACE_END
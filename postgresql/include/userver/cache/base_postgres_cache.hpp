@@ -10,17 +10,20 @@
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include <fmt/format.h>
 
 #include <userver/cache/cache_statistics.hpp>
 #include <userver/cache/caching_component_base.hpp>
+#include <userver/cache/chunked_update.hpp>
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
 
 #include <userver/storages/postgres/cluster.hpp>
 #include <userver/storages/postgres/component.hpp>
 #include <userver/storages/postgres/io/chrono.hpp>
+#include <userver/storages/postgres/portal_stream.hpp>
 
 #include <userver/compiler/demangle.hpp>
 #include <userver/logging/log.hpp>
@@ -66,6 +69,8 @@ namespace components {
 /// incremental-update-op-timeout | timeout for an incremental update | 1s
 /// update-correction | incremental update window adjustment | - (0 for caches with defined GetLastKnownUpdated)
 /// chunk-size | number of rows to request from PostgreSQL via portals, 0 to fetch all rows in one request without portals | 1000
+/// full-update-parallel-chunks | number of chunks parsed in parallel with fetching the next ones during a full update via portals, 0 to parse them in the updater task | 0
+/// prefetch-chunks | number of chunks fetched via portals in background ahead of their processing, 0 to fetch them in the updater task, see storages::postgres::PortalStream | 0
 ///
 /// @section pg_cc_cache_policy Cache policy
 ///
@@ -368,6 +373,8 @@ inline constexpr std::string_view kFetchStage = "fetch";
 inline constexpr std::string_view kParseStage = "parse";
 
 inline constexpr std::size_t kDefaultChunkSize = 1000;
+inline constexpr std::size_t kDefaultFullUpdateParallelChunks = 0;
+inline constexpr std::size_t kDefaultPrefetchChunks = 0;
 }  // namespace pg_cache::detail
 
 /// @ingroup userver_components
@@ -419,6 +426,11 @@ class PostgreCache final
   void CacheResults(storages::postgres::ResultSet res, CachedData& data_cache,
                     cache::UpdateStatisticsScope& stats_scope,
                     tracing::ScopeTime& scope);
+  std::vector<ValueType> ParseResults(
+      storages::postgres::ResultSet res,
+      cache::UpdateStatisticsScope& stats_scope) const;
+  void CacheValues(std::vector<ValueType>&& values, CachedData& data_cache,
+                   cache::UpdateStatisticsScope& stats_scope) const;
 
   static storages::postgres::Query GetAllQuery();
   static storages::postgres::Query GetDeltaQuery();
@@ -431,6 +443,8 @@ class PostgreCache final
   const std::chrono::milliseconds full_update_timeout_;
   const std::chrono::milliseconds incremental_update_timeout_;
   const std::size_t chunk_size_;
+  const std::size_t full_update_parallel_chunks_;
+  const std::size_t prefetch_chunks_;
   std::size_t cpu_relax_iterations_parse_{0};
   std::size_t cpu_relax_iterations_copy_{0};
 };
@@ -450,7 +464,12 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config,
           config["incremental-update-op-timeout"].As<std::chrono::milliseconds>(
               pg_cache::detail::kDefaultIncrementalUpdateTimeout)},
       chunk_size_{config["chunk-size"].As<size_t>(
-          pg_cache::detail::kDefaultChunkSize)} {
+          pg_cache::detail::kDefaultChunkSize)},
+      full_update_parallel_chunks_{
+          config["full-update-parallel-chunks"].As<size_t>(
+              pg_cache::detail::kDefaultFullUpdateParallelChunks)},
+      prefetch_chunks_{config["prefetch-chunks"].As<size_t>(
+          pg_cache::detail::kDefaultPrefetchChunks)} {
   UINVARIANT(
       !chunk_size_ || storages::postgres::Portal::IsSupportedByDriver(),
       "Either set 'chunk-size' to 0, or enable PostgreSQL portals by building "
@@ -578,20 +597,45 @@ void PostgreCache<PostgreCachePolicy>::Update(
   size_t changes = 0;
   // Iterate clusters
   for (auto& cluster : clusters_) {
-    if (chunk_size_ > 0) {
+    if (chunk_size_ > 0 && full_update_parallel_chunks_ > 0 &&
+        type == cache::UpdateType::kFull) {
       auto trx = cluster->Begin(
           kClusterHostTypeFlags, pg::Transaction::RO,
           pg::CommandControl{timeout, pg_cache::detail::kStatementTimeoutOff});
-      auto portal =
-          trx.MakePortal(query, GetLastUpdated(last_update, *data_cache));
-      while (portal) {
+      pg::PortalStream chunks{
+          trx.MakePortal(query, GetLastUpdated(last_update, *data_cache)),
+          static_cast<std::uint32_t>(chunk_size_), prefetch_chunks_};
+      cache::ChunkedUpdate<std::vector<ValueType>> chunked_update{
+          full_update_parallel_chunks_, stats_scope,
+          [this, &data_cache, &stats_scope](std::vector<ValueType>&& values) {
+            CacheValues(std::move(values), data_cache, stats_scope);
+          }};
+      while (auto res = chunks.Next()) {
+        stats_scope.IncreaseDocumentsReadCount(res->Size());
+        changes += res->Size();
+        chunked_update.Push([this, res = std::move(*res), &stats_scope] {
+          return ParseResults(res, stats_scope);
+        });
+      }
+      scope.Reset(std::string{pg_cache::detail::kParseStage});
+      chunked_update.Finish();
+      trx.Commit();
+    } else if (chunk_size_ > 0) {
+      auto trx = cluster->Begin(
+          kClusterHostTypeFlags, pg::Transaction::RO,
+          pg::CommandControl{timeout, pg_cache::detail::kStatementTimeoutOff});
+      pg::PortalStream chunks{
+          trx.MakePortal(query, GetLastUpdated(last_update, *data_cache)),
+          static_cast<std::uint32_t>(chunk_size_), prefetch_chunks_};
+      while (true) {
         scope.Reset(std::string{pg_cache::detail::kFetchStage});
-        auto res = portal.Fetch(chunk_size_);
-        stats_scope.IncreaseDocumentsReadCount(res.Size());
+        auto res = chunks.Next();
+        if (!res) break;
+        stats_scope.IncreaseDocumentsReadCount(res->Size());
 
         scope.Reset(std::string{pg_cache::detail::kParseStage});
-        CacheResults(res, data_cache, stats_scope, scope);
-        changes += res.Size();
+        CacheResults(*res, data_cache, stats_scope, scope);
+        changes += res->Size();
       }
       trx.Commit();
     } else {
@@ -682,6 +726,45 @@ void PostgreCache<PostgreCachePolicy>::CacheResults(
   }
 }
 
+template <typename PostgreCachePolicy>
+std::vector<typename PostgreCache<PostgreCachePolicy>::ValueType>
+PostgreCache<PostgreCachePolicy>::ParseResults(
+    storages::postgres::ResultSet res,
+    cache::UpdateStatisticsScope& stats_scope) const {
+  auto values = res.AsSetOf<RawValueType>(storages::postgres::kRowTag);
+  std::vector<ValueType> parsed;
+  parsed.reserve(res.Size());
+  utils::CpuRelax relax{cpu_relax_iterations_parse_, nullptr};
+  for (auto p = values.begin(); p != values.end(); ++p) {
+    relax.Relax();
+    try {
+      parsed.push_back(pg_cache::detail::ExtractValue<PostgreCachePolicy>(*p));
+    } catch (const std::exception& e) {
+      stats_scope.IncreaseDocumentsParseFailures(1);
+      LOG_ERROR() << "Error parsing data row in cache '" << kName << "' to '"
+                  << compiler::GetTypeName<ValueType>() << "': " << e.what();
+    }
+  }
+  return parsed;
+}
+
+template <typename PostgreCachePolicy>
+void PostgreCache<PostgreCachePolicy>::CacheValues(
+    std::vector<ValueType>&& values, CachedData& data_cache,
+    cache::UpdateStatisticsScope& stats_scope) const {
+  for (auto& value : values) {
+    try {
+      using pg_cache::detail::CacheInsertOrAssign;
+      CacheInsertOrAssign(*data_cache, std::move(value),
+                          PostgreCachePolicy::kKeyMember);
+    } catch (const std::exception& e) {
+      stats_scope.IncreaseDocumentsParseFailures(1);
+      LOG_ERROR() << "Error inserting data row in cache '" << kName
+                  << "': " << e.what();
+    }
+  }
+}
+
 template <typename PostgreCachePolicy>
 typename PostgreCache<PostgreCachePolicy>::CachedData
 PostgreCache<PostgreCachePolicy>::GetDataSnapshot(cache::UpdateType type,
@@ -693,6 +776,9 @@ PostgreCache<PostgreCachePolicy>::GetDataSnapshot(cache::UpdateType type,
                                              scope);
     }
   }
+
+  // Not reserved for the current size, that would allocate the whole new
+  // container upfront while the old one is still alive
   return std::make_unique<DataType>();
 }
 
@@ -16,6 +16,7 @@
 #include <userver/storages/postgres/cluster_types.hpp>
 #include <userver/storages/postgres/database.hpp>
 #include <userver/storages/postgres/detail/non_transaction.hpp>
+#include <userver/storages/postgres/detail/query_parameters.hpp>
 #include <userver/storages/postgres/notify.hpp>
 #include <userver/storages/postgres/options.hpp>
 #include <userver/storages/postgres/query.hpp>
@@ -174,6 +175,12 @@ class Cluster {
   /// @brief Execute a statement at host of specified type.
   /// @note You must specify at least one role from ClusterHostType here
   ///
+  /// If `auto_batch_window_us` of the pool settings is not zero, the
+  /// statements to the hosts that are not master are coalesced with the
+  /// concurrent ones and executed in a single pipelined round trip. Such a
+  /// statement waits for up to the batch window before being sent and is
+  /// not interrupted by the task cancellation, only by its timeouts.
+  ///
   /// @snippet storages/postgres/tests/landing_test.cpp Exec sample
   ///
   /// @warning Do NOT create a query string manually by embedding arguments!
@@ -206,6 +213,34 @@ class Cluster {
                     const Query& query, const ParameterStore& store);
   /// @}
 
+  /// @name COPY in an auto-commit transaction
+  /// @{
+
+  /// @brief Load the rows with `COPY ... FROM STDIN (FORMAT binary)` at master
+  /// in a single transaction, see Transaction::CopyFrom
+  template <typename Container>
+  std::size_t CopyFrom(const Query& query, const Container& rows);
+
+  /// @brief Load the rows with `COPY ... FROM STDIN (FORMAT binary)` at master
+  /// with specified command control settings, see Transaction::CopyFrom
+  template <typename Container>
+  std::size_t CopyFrom(OptionalCommandControl, const Query& query,
+                       const Container& rows);
+
+  /// @brief Read the rows with `COPY ... TO STDOUT (FORMAT binary)` at host of
+  /// specified type, see Transaction::CopyTo
+  /// @note You must specify at least one role from ClusterHostType here
+  template <typename T, typename Consumer>
+  std::size_t CopyTo(ClusterHostTypeFlags, const Query& query,
+                     Consumer&& consumer);
+
+  /// @brief Read the rows with `COPY ... TO STDOUT (FORMAT binary)` with
+  /// specified host selection rules and command control settings
+  template <typename T, typename Consumer>
+  std::size_t CopyTo(ClusterHostTypeFlags, OptionalCommandControl,
+                     const Query& query, Consumer&& consumer);
+  /// @}
+
   /// @brief Listen for notifications on channel
   /// @warning Each NotifyScope owns a single connection taken from the pool,
   /// which effectively decreases the number of usable connections
@@ -242,6 +277,11 @@ class Cluster {
  private:
   detail::NonTransaction Start(ClusterHostTypeFlags, OptionalCommandControl);
 
+  bool IsAutoBatchingEnabled(ClusterHostTypeFlags) const;
+  ResultSet ExecuteBatched(ClusterHostTypeFlags, OptionalCommandControl,
+                           const Query& query,
+                           detail::QueryParametersWriter params_writer);
+
   OptionalCommandControl GetQueryCmdCtl(const std::string& query_name) const;
   OptionalCommandControl GetHandlersCmdCtl(
       OptionalCommandControl cmd_ctl) const;
@@ -263,10 +303,59 @@ ResultSet Cluster::Execute(ClusterHostTypeFlags flags,
     statement_cmd_ctl = GetQueryCmdCtl(query.GetName()->GetUnderlying());
   }
   statement_cmd_ctl = GetHandlersCmdCtl(statement_cmd_ctl);
+  if (IsAutoBatchingEnabled(flags)) {
+    detail::StaticQueryParameters<sizeof...(args)> params;
+    return ExecuteBatched(
+        flags, statement_cmd_ctl, query,
+        [&params, &args...](const UserTypes& types) {
+          params.Write(types, args...);
+          return detail::QueryParameters{params};
+        });
+  }
   auto ntrx = Start(flags, statement_cmd_ctl);
   return ntrx.Execute(statement_cmd_ctl, query, args...);
 }
 
+template <typename Container>
+std::size_t Cluster::CopyFrom(const Query& query, const Container& rows) {
+  return CopyFrom(OptionalCommandControl{}, query, rows);
+}
+
+template <typename Container>
+std::size_t Cluster::CopyFrom(OptionalCommandControl statement_cmd_ctl,
+                              const Query& query, const Container& rows) {
+  if (!statement_cmd_ctl && query.GetName()) {
+    statement_cmd_ctl = GetQueryCmdCtl(query.GetName()->GetUnderlying());
+  }
+  statement_cmd_ctl = GetHandlersCmdCtl(statement_cmd_ctl);
+  auto trx = Begin(ClusterHostType::kMaster, Transaction::RW, statement_cmd_ctl);
+  const auto copied = trx.CopyFrom(statement_cmd_ctl, query, rows);
+  trx.Commit();
+  return copied;
+}
+
+template <typename T, typename Consumer>
+std::size_t Cluster::CopyTo(ClusterHostTypeFlags flags, const Query& query,
+                            Consumer&& consumer) {
+  return CopyTo<T>(flags, OptionalCommandControl{}, query,
+                   std::forward<Consumer>(consumer));
+}
+
+template <typename T, typename Consumer>
+std::size_t Cluster::CopyTo(ClusterHostTypeFlags flags,
+                            OptionalCommandControl statement_cmd_ctl,
+                            const Query& query, Consumer&& consumer) {
+  if (!statement_cmd_ctl && query.GetName()) {
+    statement_cmd_ctl = GetQueryCmdCtl(query.GetName()->GetUnderlying());
+  }
+  statement_cmd_ctl = GetHandlersCmdCtl(statement_cmd_ctl);
+  auto trx = Begin(flags, Transaction::RO, statement_cmd_ctl);
+  const auto copied = trx.CopyTo<T>(statement_cmd_ctl, query,
+                                    std::forward<Consumer>(consumer));
+  trx.Commit();
+  return copied;
+}
+
 }  // namespace storages::postgres
 
 USERVER_NAMESPACE_END
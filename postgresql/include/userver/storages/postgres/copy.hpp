@@ -0,0 +1,174 @@
+#pragma once
+
+/// @file userver/storages/postgres/copy.hpp
+/// @brief Binary format of `COPY ... FROM STDIN` and `COPY ... TO STDOUT`
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <boost/pfr/core.hpp>
+
+#include <userver/compiler/demangle.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+#include <userver/storages/postgres/io/field_buffer.hpp>
+#include <userver/storages/postgres/io/row_types.hpp>
+#include <userver/storages/postgres/io/type_mapping.hpp>
+#include <userver/storages/postgres/io/user_types.hpp>
+#include <userver/utils/function_ref.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+/// Default size of the data chunks that are sent to the server by
+/// Transaction::CopyFrom
+inline constexpr std::size_t kDefaultCopyChunkSize = 256 * 1024;
+
+namespace detail {
+
+using CopyBuffer = std::vector<char>;
+
+/// Appends the next chunk of COPY data to the buffer, returns false if there
+/// is no more data
+using CopyDataProducer = USERVER_NAMESPACE::utils::function_ref<bool(
+    CopyBuffer&)>;
+
+/// Receives the chunks of COPY data as they are sent by the server
+using CopyDataConsumer =
+    USERVER_NAMESPACE::utils::function_ref<void(std::string_view)>;
+
+void WriteCopyHeader(CopyBuffer& buffer);
+void WriteCopyTrailer(CopyBuffer& buffer);
+
+template <typename T>
+decltype(auto) GetCopyRowTuple(const T& row) {
+  if constexpr (io::traits::kRowCategory<T> ==
+                io::traits::RowCategoryType::kAggregate) {
+    // unlike io::RowType::GetTuple, does not copy the members
+    return boost::pfr::structure_tie(row);
+  } else {
+    return io::RowType<T>::GetTuple(row);
+  }
+}
+
+/// Writes a tuple of the binary COPY format, a row type is written as a tuple
+/// of its members, any other type as a single column
+template <typename T>
+void WriteCopyRow(const UserTypes& types, CopyBuffer& buffer, const T& row) {
+  if constexpr (io::traits::kIsRowType<T>) {
+    io::WriteBuffer(types, buffer, static_cast<Smallint>(io::RowType<T>::size));
+    std::apply(
+        [&types, &buffer](const auto&... columns) {
+          (io::WriteRawBinary(types, buffer, columns), ...);
+        },
+        GetCopyRowTuple(row));
+  } else {
+    io::WriteBuffer(types, buffer, Smallint{1});
+    io::WriteRawBinary(types, buffer, row);
+  }
+}
+
+template <typename T>
+void ReadCopyColumn(const UserTypes& types, io::FieldBuffer& buffer,
+                    T& value) {
+  const auto& categories = types.GetTypeBufferCategories();
+  const auto category =
+      io::GetTypeBufferCategory(categories, io::CppToPg<T>::GetOid(types));
+  if (category == io::BufferCategory::kNoParser) {
+    throw UnknownBufferCategory("COPY column",
+                                io::CppToPg<T>::GetOid(types));
+  }
+  buffer.ReadRaw(value, categories, category);
+}
+
+/// Parses a tuple of the binary COPY format, see WriteCopyRow
+template <typename T>
+void ReadCopyRow(const UserTypes& types, std::string_view tuple, T& row) {
+  io::FieldBuffer buffer{false, io::BufferCategory::kPlainBuffer, tuple.size(),
+                         reinterpret_cast<const std::uint8_t*>(tuple.data())};
+  Smallint column_count{0};
+  buffer.Read(column_count, io::BufferCategory::kPlainBuffer);
+  // negative count marks the end of data and is handled by CopyBinaryReader
+  const auto size = static_cast<std::size_t>(column_count);
+
+  if constexpr (io::traits::kIsRowType<T>) {
+    if (size != io::RowType<T>::size) {
+      throw FieldTupleMismatch(size, io::RowType<T>::size);
+    }
+    std::apply(
+        [&types, &buffer](auto&... columns) {
+          (ReadCopyColumn(types, buffer, columns), ...);
+        },
+        io::RowType<T>::GetTuple(row));
+  } else {
+    if (size != 1) {
+      throw NonSingleColumnResultSet(size, compiler::GetTypeName<T>(),
+                                     "CopyTo");
+    }
+    ReadCopyColumn(types, buffer, row);
+  }
+}
+
+/// Splits the binary COPY data into tuples. The chunks of data do not have to
+/// be aligned to the tuples, only an incomplete tuple is buffered.
+class CopyBinaryReader final {
+ public:
+  /// Calls `consumer` for each complete tuple of the data
+  void Feed(std::string_view data, CopyDataConsumer consumer);
+
+  /// Whether the end of data was read
+  bool IsFinished() const { return finished_; }
+
+ private:
+  std::size_t ReadTuples(std::string_view data, CopyDataConsumer consumer);
+
+  std::string pending_;
+  bool header_read_{false};
+  bool finished_{false};
+};
+
+/// Encodes the rows of a container into the chunks of binary COPY data of
+/// about `chunk_size` bytes
+template <typename Container>
+class CopyRowsWriter final {
+ public:
+  CopyRowsWriter(const UserTypes& types, const Container& rows,
+                 std::size_t chunk_size)
+      : types_(types),
+        it_(std::cbegin(rows)),
+        end_(std::cend(rows)),
+        chunk_size_(chunk_size) {}
+
+  bool operator()(CopyBuffer& buffer) {
+    if (finished_) return false;
+    if (!started_) {
+      WriteCopyHeader(buffer);
+      started_ = true;
+    }
+    for (; it_ != end_ && buffer.size() < chunk_size_; ++it_) {
+      WriteCopyRow(types_, buffer, *it_);
+    }
+    if (it_ == end_) {
+      WriteCopyTrailer(buffer);
+      finished_ = true;
+    }
+    return true;
+  }
+
+ private:
+  const UserTypes& types_;
+  decltype(std::cbegin(std::declval<const Container&>())) it_;
+  const decltype(std::cend(std::declval<const Container&>())) end_;
+  const std::size_t chunk_size_;
+  bool started_{false};
+  bool finished_{false};
+};
+
+}  // namespace detail
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
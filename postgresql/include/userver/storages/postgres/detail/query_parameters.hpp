@@ -9,6 +9,7 @@
 #include <userver/storages/postgres/io/supported_types.hpp>
 
 #include <userver/storages/postgres/null.hpp>
+#include <userver/utils/function_ref.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -217,6 +218,11 @@ class DynamicQueryParameters {
   IntList param_formats;
 };
 
+/// Writes the parameters of a statement with the user types of the connection
+/// that executes it, the parameters must outlive the statement execution
+using QueryParametersWriter =
+    USERVER_NAMESPACE::utils::function_ref<QueryParameters(const UserTypes&)>;
+
 }  // namespace storages::postgres::detail
 
 USERVER_NAMESPACE_END
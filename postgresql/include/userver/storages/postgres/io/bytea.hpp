@@ -12,6 +12,7 @@
 #include <userver/storages/postgres/io/buffer_io.hpp>
 #include <userver/storages/postgres/io/buffer_io_base.hpp>
 #include <userver/storages/postgres/io/type_mapping.hpp>
+#include <userver/utils/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -26,6 +27,9 @@ template <>
 struct IsByteaCompatible<std::string> : std::true_type {};
 template <>
 struct IsByteaCompatible<std::string_view> : std::true_type {};
+template <>
+struct IsByteaCompatible<USERVER_NAMESPACE::utils::span<const char>>
+    : std::true_type {};
 template <typename... VectorArgs>
 struct IsByteaCompatible<std::vector<char, VectorArgs...>> : std::true_type {};
 template <typename... VectorArgs>
@@ -100,6 +104,12 @@ struct BufferParser<
                                std::string_view>{}) {
       this->value.bytes = std::string_view{
           reinterpret_cast<const char*>(buffer.buffer), buffer.length};
+    } else if constexpr (std::is_same<
+                             typename ByteaType::BytesType,
+                             USERVER_NAMESPACE::utils::span<const char>>{}) {
+      const auto* data = reinterpret_cast<const char*>(buffer.buffer);
+      this->value.bytes = USERVER_NAMESPACE::utils::span<const char>{
+          data, data + buffer.length};
     } else {
       this->value.bytes.resize(buffer.length);
       std::copy(buffer.buffer, buffer.buffer + buffer.length,
@@ -154,6 +164,39 @@ struct BufferFormatter<
   }
 };
 
+//@{
+/** @name utils::span<const char> I/O, maps to `bytea` */
+template <>
+struct BufferFormatter<USERVER_NAMESPACE::utils::span<const char>>
+    : detail::BufferFormatterBase<USERVER_NAMESPACE::utils::span<const char>> {
+  using BaseType =
+      detail::BufferFormatterBase<USERVER_NAMESPACE::utils::span<const char>>;
+  using BaseType::BaseType;
+
+  template <typename Buffer>
+  void operator()(const UserTypes&, Buffer& buf) const {
+    buf.insert(buf.end(), this->value.begin(), this->value.end());
+  }
+};
+
+template <>
+struct BufferParser<USERVER_NAMESPACE::utils::span<const char>>
+    : detail::BufferParserBase<USERVER_NAMESPACE::utils::span<const char>> {
+  using BaseType =
+      detail::BufferParserBase<USERVER_NAMESPACE::utils::span<const char>>;
+  using BaseType::BaseType;
+
+  void operator()(const FieldBuffer& buffer) {
+    const auto* data = reinterpret_cast<const char*>(buffer.buffer);
+    this->value = ValueType{data, data + buffer.length};
+  }
+};
+
+template <>
+struct CppToSystemPg<USERVER_NAMESPACE::utils::span<const char>>
+    : PredefinedOid<PredefinedOids::kBytea> {};
+//@}
+
 template <typename ByteContainer>
 struct CppToSystemPg<postgres::detail::ByteaRefWrapper<ByteContainer>>
     : PredefinedOid<PredefinedOids::kBytea> {};
@@ -5,6 +5,7 @@
 /// @ingroup userver_postgres_parse_and_format
 
 #include <chrono>
+#include <cstdint>
 #include <limits>
 
 #include <userver/storages/postgres/io/buffer_io.hpp>
@@ -169,6 +170,35 @@ struct Input<std::chrono::duration<Rep, Period>> {
                       io::detail::DurationIntervalCvt<Rep, Period>>;
 };
 
+/// @brief Bulk column extraction for std::chrono::time_point
+template <typename Duration>
+struct FixedWidthColumn<std::chrono::time_point<ClockType, Duration>> {
+  using ValueType = std::chrono::time_point<ClockType, Duration>;
+  using WireType = std::uint64_t;
+
+  static ValueType Convert(WireType value) {
+    static const ValueType pg_epoch =
+        std::chrono::time_point_cast<Duration>(PostgresEpochTimePoint());
+    const auto usec = static_cast<Bigint>(value);
+    if (usec == std::numeric_limits<Bigint>::max()) {
+      return kTimestampPositiveInfinity;
+    } else if (usec == std::numeric_limits<Bigint>::min()) {
+      return kTimestampNegativeInfinity;
+    }
+    return pg_epoch + std::chrono::microseconds{usec};
+  }
+};
+
+/// @brief Bulk column extraction for TimePointTz
+template <>
+struct FixedWidthColumn<TimePointTz> {
+  using WireType = std::uint64_t;
+
+  static TimePointTz Convert(WireType value) {
+    return TimePointTz{FixedWidthColumn<TimePoint>::Convert(value)};
+  }
+};
+
 }  // namespace traits
 
 template <>
@@ -114,6 +114,34 @@ template <>
 struct CppToSystemPg<double> : PredefinedOid<PredefinedOids::kFloat8> {};
 //@}
 
+namespace detail {
+
+template <typename T>
+struct FloatingPointFixedWidthColumn {
+  using WireType = std::make_unsigned_t<typename IntegralType<sizeof(T)>::type>;
+  static T Convert(WireType value) {
+    T float_value{};
+    std::memcpy(&float_value, &value, sizeof(T));
+    return float_value;
+  }
+};
+
+}  // namespace detail
+
+namespace traits {
+
+//@{
+/** @name Bulk column extraction for floating point types */
+template <>
+struct FixedWidthColumn<float>
+    : io::detail::FloatingPointFixedWidthColumn<float> {};
+template <>
+struct FixedWidthColumn<double>
+    : io::detail::FloatingPointFixedWidthColumn<double> {};
+//@}
+
+}  // namespace traits
+
 }  // namespace storages::postgres::io
 
 USERVER_NAMESPACE_END
@@ -6,6 +6,7 @@
 
 #include <boost/endian/conversion.hpp>
 
+#include <cstdint>
 #include <type_traits>
 
 #include <userver/storages/postgres/exceptions.hpp>
@@ -207,6 +208,44 @@ struct CppToSystemPg<detail::AltInteger>
 
 //@}
 
+namespace detail {
+
+template <typename T>
+struct IntegralFixedWidthColumn {
+  using WireType = std::make_unsigned_t<typename IntegralType<sizeof(T)>::type>;
+  static T Convert(WireType value) { return static_cast<T>(value); }
+};
+
+}  // namespace detail
+
+namespace traits {
+
+//@{
+/** @name Bulk column extraction for integral types */
+template <>
+struct FixedWidthColumn<Smallint>
+    : io::detail::IntegralFixedWidthColumn<Smallint> {};
+template <>
+struct FixedWidthColumn<Integer>
+    : io::detail::IntegralFixedWidthColumn<Integer> {};
+template <>
+struct FixedWidthColumn<Bigint> : io::detail::IntegralFixedWidthColumn<Bigint> {
+};
+/// @cond
+template <>
+struct FixedWidthColumn<io::detail::AltInteger>
+    : io::detail::IntegralFixedWidthColumn<io::detail::AltInteger> {};
+/// @endcond
+
+template <>
+struct FixedWidthColumn<bool> {
+  using WireType = std::uint8_t;
+  static bool Convert(WireType value) { return value != 0; }
+};
+//@}
+
+}  // namespace traits
+
 }  // namespace storages::postgres::io
 
 USERVER_NAMESPACE_END
@@ -42,6 +42,7 @@
 /// timetz            | N/A                                     |         |
 /// interval          | std::chrono::microseconds               |         |
 /// bytea             | container of one-byte type              |         |
+/// ^                 | utils::span<const char>                 |         |
 /// bit(n)            | utils::Flags                            |         |
 /// ^                 | std::bitset<N>                          |         |
 /// ^                 | std::array<bool, N>                     |         |
@@ -119,10 +120,12 @@
 /// `bytea` type.
 ///
 /// Reading and writing to PostgreSQL is implemented for `std::string`,
-/// `std::string_view` and `std::vector` of `char` or `unsigned char`.
+/// `std::string_view`, `utils::span<const char>` and `std::vector` of `char` or
+/// `unsigned char`. `utils::span<const char>` is mapped to `bytea` without the
+/// storages::postgres::Bytea wrapper.
 ///
-/// @warning When reading to `std::string_view` the value MUST NOT be used after
-/// the PostgreSQL result set is destroyed.
+/// @warning When reading to `std::string_view` or `utils::span<const char>`
+/// the value MUST NOT be used after the PostgreSQL result set is destroyed.
 ///
 /// @code{.cpp}
 /// namespace pg = storages::postgres;
@@ -132,6 +132,23 @@ template <typename T>
 inline constexpr bool kHasFormatter = HasFormatter<T>::value;
 //@}
 
+/// @brief Customisation point for the bulk extraction of result set columns,
+/// see ResultSet::AsColumn.
+///
+/// Specialisations are provided for the types with a fixed size binary
+/// representation. A specialisation defines `WireType`, an unsigned integer
+/// type of the representation size, and a static `Convert` function that
+/// makes a value from the representation in the host byte order.
+template <typename T, typename Enable = USERVER_NAMESPACE::utils::void_t<>>
+struct FixedWidthColumn;
+
+/// @brief Metafunction to detect if a column of a type can be extracted in
+/// bulk.
+template <typename T>
+struct IsFixedWidthColumn : utils::IsDeclComplete<FixedWidthColumn<T>> {};
+template <typename T>
+inline constexpr bool kIsFixedWidthColumn = IsFixedWidthColumn<T>::value;
+
 template <typename T>
 constexpr bool CheckParser() {
   static_assert(kHasParser<T> || std::is_enum_v<T>,
@@ -167,6 +167,9 @@ inline constexpr std::size_t kDefaultPoolMaxQueueSize = 200;
 /// Default limit for concurrent establishing connections number
 inline constexpr std::size_t kDefaultConnectingLimit = 0;
 
+/// Default limit for the number of statements in an automatic batch
+inline constexpr std::size_t kDefaultAutoBatchMaxSize = 32;
+
 struct TopologySettings {
   std::chrono::milliseconds max_replication_lag{kDefaultMaxReplicationLag};
 };
@@ -187,10 +190,19 @@ struct PoolSettings {
   /// Limits number of concurrent establishing connections (0 - unlimited)
   std::size_t connecting_limit{kDefaultConnectingLimit};
 
+  /// Time to collect concurrent single statements to slaves into a single
+  /// pipelined round trip (0 - automatic batching is disabled)
+  std::chrono::microseconds auto_batch_window{0};
+
+  /// Maximum number of statements in an automatic batch
+  std::size_t auto_batch_max_size{kDefaultAutoBatchMaxSize};
+
   bool operator==(const PoolSettings& rhs) const {
     return min_size == rhs.min_size && max_size == rhs.max_size &&
            max_queue_size == rhs.max_queue_size &&
-           connecting_limit == rhs.connecting_limit;
+           connecting_limit == rhs.connecting_limit &&
+           auto_batch_window == rhs.auto_batch_window &&
+           auto_batch_max_size == rhs.auto_batch_max_size;
   }
 };
 
@@ -259,12 +271,17 @@ struct ConnectionSettings {
   /// Execute discard all after establishing a new connection
   DiscardOnConnectOptions discard_on_connect = kDiscardAll;
 
+  /// Prepare this many most frequently prepared statements of the cluster
+  /// on a new connection
+  std::size_t prepare_on_connect = 0;
+
   /// Helps keep track of the changes in settings
   SettingsVersion version{0U};
 
   bool operator==(const ConnectionSettings& rhs) const {
     return !RequiresConnectionReset(rhs) &&
-           recent_errors_threshold == rhs.recent_errors_threshold;
+           recent_errors_threshold == rhs.recent_errors_threshold &&
+           prepare_on_connect == rhs.prepare_on_connect;
   }
 
   bool operator!=(const ConnectionSettings& rhs) const {
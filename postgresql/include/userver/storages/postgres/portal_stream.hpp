@@ -0,0 +1,96 @@
+#pragma once
+
+/// @file userver/storages/postgres/portal_stream.hpp
+/// @brief storages::postgres::PortalStream
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <optional>
+
+#include <userver/storages/postgres/portal.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+/// @brief Reads the results of a portal chunk by chunk, fetching the next
+/// chunks in a background task while the current one is processed.
+///
+/// Up to `prefetch_chunks` chunks are fetched ahead of the reader, one fetch
+/// round trip at a time. With `prefetch_chunks` set to 0 the chunks are
+/// fetched by the reader, the same way as with Portal::Fetch.
+///
+/// The stream takes the portal over together with its connection: the
+/// transaction of the portal must not be used until the stream is done or
+/// destroyed. The destructor waits for the fetch in progress.
+///
+/// Reading suspends the current coroutine only, the chunks may be iterated
+/// over with a range-based for:
+/// @snippet storages/postgres/tests/portal_pgtest.cpp PortalStream
+class PortalStream {
+ public:
+  class Iterator;
+
+  PortalStream(Portal&& portal, std::uint32_t chunk_size,
+               std::size_t prefetch_chunks = 1);
+
+  PortalStream(PortalStream&&) noexcept;
+  PortalStream& operator=(PortalStream&&) noexcept;
+
+  PortalStream(const PortalStream&) = delete;
+  PortalStream& operator=(const PortalStream&) = delete;
+
+  ~PortalStream();
+
+  /// Returns the next non-empty chunk or std::nullopt if the portal is
+  /// exhausted, rethrows the errors of the background fetches
+  std::optional<ResultSet> Next();
+
+  bool Done() const;
+  /// Number of rows returned by Next() so far
+  std::size_t FetchedSoFar() const;
+
+  Iterator begin();
+  Iterator end();
+
+ private:
+  struct Impl;
+  std::unique_ptr<Impl> pimpl_;
+};
+
+/// @brief Input iterator over the chunks of a PortalStream
+class PortalStream::Iterator {
+ public:
+  using iterator_category = std::input_iterator_tag;
+  using value_type = ResultSet;
+  using difference_type = std::ptrdiff_t;
+  using reference = const ResultSet&;
+  using pointer = const ResultSet*;
+
+  Iterator() = default;
+
+  reference operator*() const { return *chunk_; }
+  pointer operator->() const { return &*chunk_; }
+
+  Iterator& operator++();
+
+  bool operator==(const Iterator& rhs) const {
+    return chunk_.has_value() == rhs.chunk_.has_value();
+  }
+  bool operator!=(const Iterator& rhs) const { return !(*this == rhs); }
+
+ private:
+  friend class PortalStream;
+
+  explicit Iterator(PortalStream& stream);
+
+  PortalStream* stream_{nullptr};
+  std::optional<ResultSet> chunk_;
+};
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
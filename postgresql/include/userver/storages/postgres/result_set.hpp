@@ -11,6 +11,7 @@
 #include <type_traits>
 #include <utility>
 #include <variant>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -691,6 +692,18 @@ class ResultSet {
   template <typename Container>
   Container AsContainer(RowTag) const;
 
+  /// @brief Extract a single column into a vector.
+  ///
+  /// Columns of types with a fixed size binary representation (integral,
+  /// floating point, boolean and timestamp types, see
+  /// io::traits::FixedWidthColumn) are decoded in bulk, without per-field
+  /// dispatch. Columns of other types are parsed field by field.
+  /// For more information see @ref psql_typed_results
+  template <typename T>
+  std::vector<T> AsColumn(size_type column_index) const;
+  template <typename T>
+  std::vector<T> AsColumn(const std::string& column_name) const;
+
   /// @brief Extract first row into user type.
   /// A single row result set is expected, will throw an exception when result
   /// set size != 1
@@ -717,6 +730,13 @@ class ResultSet {
   void FillBufferCategories(const UserTypes& types);
   void SetBufferCategoriesFrom(const ResultSet&);
 
+  size_type IndexOfColumn(const std::string& column_name) const;
+  FieldView GetFieldView(size_type row_index, size_type column_index) const;
+  /// Reads the column of `width` byte values into `values` in the host byte
+  /// order, returns false if the column has nulls or values of another size
+  bool ReadFixedWidthColumn(size_type column_index, std::size_t width,
+                            void* values) const;
+
   template <typename T, typename Tag>
   friend class TypedResultSet;
   friend class ConnectionImpl;
@@ -1014,6 +1034,57 @@ Container ResultSet::AsContainer(RowTag) const {
   return c;
 }
 
+template <typename T>
+std::vector<T> ResultSet::AsColumn(size_type column_index) const {
+  detail::AssertSaneTypeToDeserialize<T>();
+  using ValueType = std::decay_t<T>;
+  detail::AssertRowTypeIsMappedToPgOrIsCompositeType<ValueType>();
+  if (column_index >= FieldCount()) {
+    throw FieldIndexOutOfBounds{column_index};
+  }
+
+  std::vector<T> column;
+  if constexpr (io::traits::kIsFixedWidthColumn<ValueType>) {
+    using Column = io::traits::FixedWidthColumn<ValueType>;
+    using WireType = typename Column::WireType;
+    if constexpr (std::is_arithmetic_v<ValueType> &&
+                  !std::is_same_v<ValueType, bool>) {
+      // The binary representation is the value itself
+      static_assert(sizeof(ValueType) == sizeof(WireType));
+      column.resize(Size());
+      if (ReadFixedWidthColumn(column_index, sizeof(WireType),
+                               column.data())) {
+        return column;
+      }
+      column.clear();
+    } else {
+      std::vector<WireType> wire_values(Size());
+      if (ReadFixedWidthColumn(column_index, sizeof(WireType),
+                               wire_values.data())) {
+        column.reserve(wire_values.size());
+        for (const auto value : wire_values) {
+          column.push_back(Column::Convert(value));
+        }
+        return column;
+      }
+    }
+  }
+
+  // Nulls and values of other sizes are handled by the field parsers
+  column.reserve(Size());
+  for (size_type row_index = 0; row_index < Size(); ++row_index) {
+    ValueType value{};
+    GetFieldView(row_index, column_index).To(value);
+    column.push_back(std::move(value));
+  }
+  return column;
+}
+
+template <typename T>
+std::vector<T> ResultSet::AsColumn(const std::string& column_name) const {
+  return AsColumn<T>(IndexOfColumn(column_name));
+}
+
 template <typename T>
 auto ResultSet::AsSingleRow() const {
   return AsSingleRow<T>(kFieldTag);
@@ -91,6 +91,34 @@ struct ConnectionStatistics {
   MmaAccumulator prepared_statements;
 };
 
+/// @brief Template automatic batching statistics storage
+template <typename Counter, typename MmaAccumulator>
+struct BatchingStatistics {
+  /// Number of executed batches
+  Counter batches_total = 0;
+  /// Number of statements executed in batches
+  Counter queries_total = 0;
+  /// Number of batches executed statement by statement after a failure of
+  /// the pipelined execution
+  Counter fallback_total = 0;
+  /// Batch size min-max-avg
+  MmaAccumulator batch_size;
+};
+
+/// @brief Template shared prepared statements statistics storage
+template <typename Counter, typename MmaAccumulator>
+struct SharedStatementsStatistics {
+  /// Number of statements described in their parse round trip, in the
+  /// pipeline mode
+  Counter describe_saved_total = 0;
+  /// Number of statements prepared on the creation of connections
+  Counter prepared_on_connect_total = 0;
+  /// Describe round trip time min-max-avg in microseconds, including the
+  /// parse for the statements described in their parse round trip. The time
+  /// saved is estimated as `describe_saved_total` times its average
+  MmaAccumulator describe_time;
+};
+
 /// @brief Template instance topology statistics storage
 template <typename MmaAccumulator>
 struct InstanceTopologyStatistics {
@@ -110,6 +138,10 @@ struct InstanceStatisticsTemplate {
   TransactionStatistics<Counter, PercentileAccumulator> transaction;
   /// Topology statistics
   InstanceTopologyStatistics<MmaAccumulator> topology;
+  /// Automatic batching statistics
+  BatchingStatistics<Counter, MmaAccumulator> batching;
+  /// Shared prepared statements statistics
+  SharedStatementsStatistics<Counter, MmaAccumulator> shared_statements;
   /// Error caused by pool exhaustion
   Counter pool_exhaust_errors = 0;
   /// Error caused by queue size overflow
@@ -185,6 +217,18 @@ struct InstanceStatisticsNonatomic : InstanceStatisticsNonatomicBase {
     transaction.return_to_pool_percentile =
         stats.transaction.return_to_pool_percentile.GetStatsForPeriod();
 
+    batching.batches_total = stats.batching.batches_total;
+    batching.queries_total = stats.batching.queries_total;
+    batching.fallback_total = stats.batching.fallback_total;
+    batching.batch_size = stats.batching.batch_size.GetStatsForPeriod();
+
+    shared_statements.describe_saved_total =
+        stats.shared_statements.describe_saved_total;
+    shared_statements.prepared_on_connect_total =
+        stats.shared_statements.prepared_on_connect_total;
+    shared_statements.describe_time =
+        stats.shared_statements.describe_time.GetStatsForPeriod();
+
     topology.roundtrip_time = topology_stats.roundtrip_time.GetStatsForPeriod();
     topology.replication_lag =
         topology_stats.replication_lag.GetStatsForPeriod();
@@ -6,6 +6,7 @@
 #include <memory>
 #include <string>
 
+#include <userver/storages/postgres/copy.hpp>
 #include <userver/storages/postgres/detail/connection_ptr.hpp>
 #include <userver/storages/postgres/detail/query_parameters.hpp>
 #include <userver/storages/postgres/detail/time_types.hpp>
@@ -261,6 +262,56 @@ class Transaction {
                             const Query& query, const Container& args,
                             std::size_t chunk_rows = kDefaultRowsInChunk);
 
+  /// Load the rows of a container with `COPY ... FROM STDIN (FORMAT binary)`.
+  ///
+  /// The rows are encoded by the same formatters as the query parameters and
+  /// are sent to the server in chunks of about `chunk_size` bytes, so the
+  /// memory does not grow with the number of rows. A row type (see
+  /// @ref pg_user_row_types) is written as a tuple of its members, any other
+  /// type as a single column. The network timeout limits the whole COPY.
+  ///
+  /// Returns the number of copied rows.
+  ///
+  /// @snippet storages/postgres/tests/copy_pgtest.cpp CopyFrom
+  template <typename Container>
+  std::size_t CopyFrom(const Query& query, const Container& rows,
+                       std::size_t chunk_size = kDefaultCopyChunkSize) {
+    return CopyFrom(OptionalCommandControl{}, query, rows, chunk_size);
+  }
+
+  /// Load the rows of a container with `COPY ... FROM STDIN (FORMAT binary)`
+  /// and per-statement command control, see above.
+  template <typename Container>
+  std::size_t CopyFrom(OptionalCommandControl statement_cmd_ctl,
+                       const Query& query, const Container& rows,
+                       std::size_t chunk_size = kDefaultCopyChunkSize) {
+    detail::CopyRowsWriter<Container> writer{GetConnectionUserTypes(), rows,
+                                             chunk_size};
+    return DoCopyFrom(query, writer, std::move(statement_cmd_ctl));
+  }
+
+  /// Read the rows with `COPY ... TO STDOUT (FORMAT binary)` calling
+  /// `consumer(T&&)` for each of them as they arrive.
+  ///
+  /// Only the rows of a single chunk of data are kept in memory. The rows are
+  /// parsed as in ResultSet::AsSetOf<T>. If the consumer throws, the COPY is
+  /// cancelled and the exception is rethrown, the transaction is failed then.
+  ///
+  /// Returns the number of copied rows.
+  ///
+  /// @snippet storages/postgres/tests/copy_pgtest.cpp CopyTo
+  template <typename T, typename Consumer>
+  std::size_t CopyTo(const Query& query, Consumer&& consumer) {
+    return CopyTo<T>(OptionalCommandControl{}, query,
+                     std::forward<Consumer>(consumer));
+  }
+
+  /// Read the rows with `COPY ... TO STDOUT (FORMAT binary)` and
+  /// per-statement command control, see above.
+  template <typename T, typename Consumer>
+  std::size_t CopyTo(OptionalCommandControl statement_cmd_ctl,
+                     const Query& query, Consumer&& consumer);
+
   /// Create a portal for fetching results of a statement with arbitrary
   /// parameters.
   template <typename... Args>
@@ -317,6 +368,10 @@ class Transaction {
   Portal MakePortal(const PortalName&, const Query& query,
                     const detail::QueryParameters& params,
                     OptionalCommandControl statement_cmd_ctl);
+  std::size_t DoCopyFrom(const Query& query, detail::CopyDataProducer producer,
+                         OptionalCommandControl statement_cmd_ctl);
+  std::size_t DoCopyTo(const Query& query, detail::CopyDataConsumer consumer,
+                       OptionalCommandControl statement_cmd_ctl);
 
   const UserTypes& GetConnectionUserTypes() const;
 
@@ -364,6 +419,26 @@ void Transaction::ExecuteDecomposeBulk(OptionalCommandControl statement_cmd_ctl,
       });
 }
 
+template <typename T, typename Consumer>
+std::size_t Transaction::CopyTo(OptionalCommandControl statement_cmd_ctl,
+                                const Query& query, Consumer&& consumer) {
+  const auto& types = GetConnectionUserTypes();
+  detail::CopyBinaryReader reader;
+  const auto read_row = [&types, &consumer](std::string_view tuple) {
+    T row{};
+    detail::ReadCopyRow(types, tuple, row);
+    consumer(std::move(row));
+  };
+  const auto read_data = [&reader, &read_row](std::string_view data) {
+    reader.Feed(data, read_row);
+  };
+  const auto rows = DoCopyTo(query, read_data, std::move(statement_cmd_ctl));
+  if (!reader.IsFinished()) {
+    throw InvalidBinaryBuffer("Incomplete COPY data");
+  }
+  return rows;
+}
+
 }  // namespace storages::postgres
 
 USERVER_NAMESPACE_END
@@ -139,6 +139,22 @@ namespace storages::postgres {
 ///
 /// @endcode
 ///
+/// @par Column extraction
+///
+/// A single column of a result set of any width can be extracted into a
+/// vector. Columns of integral, floating point, boolean and timestamp types
+/// are decoded in bulk, which is considerably faster than the row by row
+/// extraction of large result sets.
+///
+/// `std::string_view` and bytea `std::string_view` values refer to the result
+/// set memory without copying and must not outlive the result set.
+///
+/// @code
+/// auto ids = generic_result.AsColumn<pg::Bigint>(0);
+/// auto updated = generic_result.AsColumn<pg::TimePointTz>("updated");
+/// auto names = generic_result.AsColumn<std::string_view>("name");
+/// @endcode
+///
 ///
 /// ----------
 ///
@@ -28,6 +28,16 @@ properties:
         type: integer
         description: number of rows to request from PostgreSQL, 0 to fetch all rows in one request
         defaultDescription: 1000
+    full-update-parallel-chunks:
+        type: integer
+        description: number of chunks parsed in parallel with fetching the next ones during a full update via portals, 0 to parse them in the updater task
+        defaultDescription: 0
+        minimum: 0
+    prefetch-chunks:
+        type: integer
+        description: number of chunks fetched via portals in background ahead of their processing, 0 to fetch them in the updater task
+        defaultDescription: 0
+        minimum: 0
     pgcomponent:
         type: string
         description: PostgreSQL component name
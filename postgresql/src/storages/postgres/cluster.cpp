@@ -111,6 +111,17 @@ detail::NonTransaction Cluster::Start(ClusterHostTypeFlags flags,
   return pimpl_->Start(flags, cmd_ctl);
 }
 
+bool Cluster::IsAutoBatchingEnabled(ClusterHostTypeFlags flags) const {
+  return pimpl_->IsAutoBatchingEnabled(flags);
+}
+
+ResultSet Cluster::ExecuteBatched(ClusterHostTypeFlags flags,
+                                  OptionalCommandControl cmd_ctl,
+                                  const Query& query,
+                                  detail::QueryParametersWriter params_writer) {
+  return pimpl_->ExecuteBatched(flags, cmd_ctl, query, params_writer);
+}
+
 OptionalCommandControl Cluster::GetQueryCmdCtl(
     const std::string& query_name) const {
   return pimpl_->GetQueryCmdCtl(query_name);
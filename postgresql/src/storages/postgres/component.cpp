@@ -273,6 +273,13 @@ properties:
         type: boolean
         description: execute discard all on new connections
         defaultDescription: true
+    prepare-hot-statements-on-connect:
+        type: integer
+        minimum: 0
+        description: |
+            number of the most frequently prepared statements of the cluster to
+            prepare on a new connection
+        defaultDescription: 0
     monitoring-dbalias:
         type: string
         description: name of the database for monitorings
@@ -322,6 +329,18 @@ properties:
         type: integer
         description: limit for concurrent establishing connections number per pool (0 - unlimited)
         defaultDescription: 0
+    auto_batch_window_us:
+        type: integer
+        minimum: 0
+        description: |
+            time in microseconds to collect concurrent single statements to slaves
+            into a single pipelined round trip (0 - automatic batching is disabled)
+        defaultDescription: 0
+    auto_batch_max_size:
+        type: integer
+        minimum: 1
+        description: maximum number of statements in an automatic batch
+        defaultDescription: 32
     connlimit_mode:
         type: string
         enum:
@@ -0,0 +1,124 @@
+#include <userver/storages/postgres/copy.hpp>
+
+#include <cstdint>
+
+#include <fmt/format.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+namespace {
+
+// See https://www.postgresql.org/docs/current/sql-copy.html#id-1.9.3.55.9.4
+constexpr std::string_view kSignature{"PGCOPY\n\377\r\n\0", 11};
+// signature, flags and header extension length
+constexpr std::size_t kHeaderSize = kSignature.size() + 4 + 4;
+constexpr std::uint32_t kWithOidsFlag = 1 << 16;
+constexpr Smallint kTrailer = -1;
+
+std::uint32_t ReadUint32(std::string_view data) {
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+  return (std::uint32_t{bytes[0]} << 24) | (std::uint32_t{bytes[1]} << 16) |
+         (std::uint32_t{bytes[2]} << 8) | std::uint32_t{bytes[3]};
+}
+
+std::int16_t ReadInt16(std::string_view data) {
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+  return static_cast<std::int16_t>((bytes[0] << 8) | bytes[1]);
+}
+
+constexpr std::size_t kIncomplete = std::string_view::npos;
+
+// Returns the size of the tuple at the beginning of the data, or kIncomplete
+std::size_t GetTupleSize(std::string_view data) {
+  if (data.size() < sizeof(Smallint)) return kIncomplete;
+  const auto column_count = ReadInt16(data);
+  if (column_count == kTrailer) return sizeof(Smallint);
+  if (column_count < 0) {
+    throw InvalidBinaryBuffer(
+        fmt::format("Invalid column count in COPY data: {}", column_count));
+  }
+
+  std::size_t size = sizeof(Smallint);
+  for (Smallint i = 0; i < column_count; ++i) {
+    if (data.size() - size < sizeof(Integer)) return kIncomplete;
+    const auto length = static_cast<Integer>(ReadUint32(data.substr(size)));
+    size += sizeof(Integer);
+    if (length == io::kPgNullBufferSize) continue;
+    if (length < 0) {
+      throw InvalidBinaryBuffer(
+          fmt::format("Invalid column length in COPY data: {}", length));
+    }
+    if (data.size() - size < static_cast<std::size_t>(length)) {
+      return kIncomplete;
+    }
+    size += length;
+  }
+  return size;
+}
+
+}  // namespace
+
+void WriteCopyHeader(CopyBuffer& buffer) {
+  buffer.insert(buffer.end(), kSignature.begin(), kSignature.end());
+  // no flags and no header extension
+  buffer.insert(buffer.end(), 8, '\0');
+}
+
+void WriteCopyTrailer(CopyBuffer& buffer) {
+  // kTrailer in network byte order
+  buffer.insert(buffer.end(), 2, '\xff');
+}
+
+void CopyBinaryReader::Feed(std::string_view data, CopyDataConsumer consumer) {
+  if (pending_.empty()) {
+    const auto consumed = ReadTuples(data, consumer);
+    pending_.assign(data.substr(consumed));
+  } else {
+    pending_.append(data);
+    const auto consumed = ReadTuples(pending_, consumer);
+    pending_.erase(0, consumed);
+  }
+
+  if (finished_ && !pending_.empty()) {
+    throw InvalidBinaryBuffer("Unexpected data after the end of COPY data");
+  }
+}
+
+std::size_t CopyBinaryReader::ReadTuples(std::string_view data,
+                                         CopyDataConsumer consumer) {
+  std::size_t pos = 0;
+  if (!header_read_) {
+    if (data.size() < kHeaderSize) return 0;
+    if (data.substr(0, kSignature.size()) != kSignature) {
+      throw InvalidBinaryBuffer(
+          "COPY data is not in the binary format, use `(FORMAT binary)`");
+    }
+    if (ReadUint32(data.substr(kSignature.size())) & kWithOidsFlag) {
+      throw InvalidBinaryBuffer("COPY data with OIDs is not supported");
+    }
+    const auto extension_size = ReadUint32(data.substr(kSignature.size() + 4));
+    if (data.size() - kHeaderSize < extension_size) return 0;
+    pos = kHeaderSize + extension_size;
+    header_read_ = true;
+  }
+
+  while (!finished_) {
+    const auto tuple = data.substr(pos);
+    const auto size = GetTupleSize(tuple);
+    if (size == kIncomplete) break;
+
+    if (ReadInt16(tuple) == kTrailer) {
+      finished_ = true;
+    } else {
+      consumer(tuple.substr(0, size));
+    }
+    pos += size;
+  }
+  return pos;
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,165 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/copy.hpp>
+#include <userver/storages/postgres/io/array_types.hpp>
+#include <userver/storages/postgres/io/floating_point_types.hpp>
+#include <userver/storages/postgres/io/string_types.hpp>
+#include <userver/storages/postgres/io/user_types.hpp>
+
+#include <storages/postgres/util_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+using namespace pg::bench;
+
+const pg::UserTypes types;
+
+// bulk loads do not fit into the timeouts of the roundtrip benchmarks
+constexpr pg::CommandControl kCopyCmdCtl{std::chrono::seconds{10},
+                                         std::chrono::seconds{10}};
+
+const pg::Query kCreateTable{
+    "create temporary table copy_bench(id integer, name text, value double "
+    "precision)"};
+const pg::Query kCopyFrom{
+    "copy copy_bench(id, name, value) from stdin (format binary)"};
+const pg::Query kInsertUnnest{
+    "insert into copy_bench(id, name, value) select * from unnest($1::integer[], "
+    "$2::text[], $3::double precision[])"};
+const pg::Query kCopyTo{"copy copy_bench to stdout (format binary)"};
+
+struct BenchRow {
+  pg::Integer id{};
+  std::string name;
+  double value{};
+};
+
+std::vector<BenchRow> MakeRows(std::size_t count) {
+  std::vector<BenchRow> rows;
+  rows.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto id = static_cast<pg::Integer>(i);
+    rows.push_back({id, "name" + std::to_string(i), id * 0.5});
+  }
+  return rows;
+}
+
+std::size_t CopyRows(pg::detail::Connection& conn,
+                     const std::vector<BenchRow>& rows) {
+  pg::detail::CopyRowsWriter<std::vector<BenchRow>> writer{
+      conn.GetUserTypes(), rows, pg::kDefaultCopyChunkSize};
+  return conn.CopyFrom(kCopyFrom, writer, kCopyCmdCtl);
+}
+
+void CopyEncode(benchmark::State& state) {
+  const auto rows = MakeRows(state.range(0));
+  pg::detail::CopyBuffer buffer;
+  for (auto _ : state) {
+    pg::detail::CopyRowsWriter<std::vector<BenchRow>> writer{
+        types, rows, pg::kDefaultCopyChunkSize};
+    while (writer(buffer)) buffer.clear();
+  }
+  state.SetItemsProcessed(state.iterations() * rows.size());
+}
+BENCHMARK(CopyEncode)->RangeMultiplier(10)->Range(100, 100'000);
+
+void CopyDecode(benchmark::State& state) {
+  const auto rows = MakeRows(state.range(0));
+  std::string data;
+  pg::detail::CopyRowsWriter<std::vector<BenchRow>> writer{
+      types, rows, pg::kDefaultCopyChunkSize};
+  pg::detail::CopyBuffer buffer;
+  while (writer(buffer)) {
+    data.append(buffer.data(), buffer.size());
+    buffer.clear();
+  }
+
+  for (auto _ : state) {
+    pg::detail::CopyBinaryReader reader;
+    BenchRow row;
+    reader.Feed(data, [&row](std::string_view tuple) {
+      pg::detail::ReadCopyRow(types, tuple, row);
+    });
+    benchmark::DoNotOptimize(row);
+  }
+  state.SetItemsProcessed(state.iterations() * rows.size());
+}
+BENCHMARK(CopyDecode)->RangeMultiplier(10)->Range(100, 100'000);
+
+BENCHMARK_DEFINE_F(PgConnection, CopyFrom)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto rows = MakeRows(state.range(0));
+    GetConnection().Execute(kCreateTable);
+    for (auto _ : state) {
+      CopyRows(GetConnection(), rows);
+      state.PauseTiming();
+      GetConnection().Execute("truncate copy_bench");
+      state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * rows.size());
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, CopyFrom)
+    ->RangeMultiplier(10)
+    ->Range(100, 100'000);
+
+BENCHMARK_DEFINE_F(PgConnection, InsertUnnest)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    const auto rows = MakeRows(state.range(0));
+    std::vector<pg::Integer> ids;
+    std::vector<std::string> names;
+    std::vector<double> values;
+    for (const auto& row : rows) {
+      ids.push_back(row.id);
+      names.push_back(row.name);
+      values.push_back(row.value);
+    }
+    GetConnection().Execute(kCreateTable);
+    for (auto _ : state) {
+      GetConnection().Execute(kCopyCmdCtl, kInsertUnnest, ids, names, values);
+      state.PauseTiming();
+      GetConnection().Execute("truncate copy_bench");
+      state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * rows.size());
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, InsertUnnest)
+    ->RangeMultiplier(10)
+    ->Range(100, 100'000);
+
+BENCHMARK_DEFINE_F(PgConnection, CopyTo)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    GetConnection().Execute(kCreateTable);
+    CopyRows(GetConnection(), MakeRows(state.range(0)));
+    for (auto _ : state) {
+      pg::detail::CopyBinaryReader reader;
+      BenchRow row;
+      const auto read_row = [&row](std::string_view tuple) {
+        pg::detail::ReadCopyRow(types, tuple, row);
+      };
+      GetConnection().CopyTo(
+          kCopyTo,
+          [&reader, &read_row](std::string_view data) {
+            reader.Feed(data, read_row);
+          },
+          kCopyCmdCtl);
+      benchmark::DoNotOptimize(row);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, CopyTo)
+    ->RangeMultiplier(10)
+    ->Range(100, 100'000);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -100,6 +100,10 @@ ClusterImpl::ClusterImpl(DsnList dsns, clients::dns::Resolver* resolver,
   UASSERT(!dsn_list.empty());
 
   LOG_DEBUG() << "Starting pools initialization";
+  // The hosts share the catalog, so the statements prepared on one of them
+  // are described the same way on the others, e.g. after a failover
+  const auto statement_registry = std::make_shared<StatementRegistry>(
+      cluster_settings.conn_settings.max_prepared_cache_size);
   host_pools_.reserve(dsn_list.size());
   for (const auto& dsn : dsn_list) {
     host_pools_.push_back(ConnectionPool::Create(
@@ -108,7 +112,7 @@ ClusterImpl::ClusterImpl(DsnList dsns, clients::dns::Resolver* resolver,
         cluster_settings.conn_settings,
         cluster_settings.statement_metrics_settings, default_cmd_ctls_,
         testsuite_pg_ctl, ei_settings, cluster_settings.cc_config,
-        config_source_));
+        config_source_, statement_registry));
   }
   LOG_DEBUG() << "Pools initialized";
 
@@ -280,6 +284,24 @@ NonTransaction ClusterImpl::Start(ClusterHostTypeFlags flags,
   return FindPool(flags)->Start(cmd_ctl);
 }
 
+bool ClusterImpl::IsAutoBatchingEnabled(ClusterHostTypeFlags flags) const {
+  // Only the read-only statements are batched, the ones that may reach master
+  // are executed as is
+  const auto role_flags = flags & kClusterHostRolesMask;
+  if (!role_flags || (role_flags & ClusterHostType::kMaster)) return false;
+  const auto settings = cluster_settings_.Read();
+  return settings->pool_settings.auto_batch_window.count() > 0;
+}
+
+ResultSet ClusterImpl::ExecuteBatched(ClusterHostTypeFlags flags,
+                                      OptionalCommandControl cmd_ctl,
+                                      const Query& query,
+                                      QueryParametersWriter params_writer) {
+  UASSERT(IsAutoBatchingEnabled(flags));
+  LOG_TRACE() << "Requested batched statement on " << flags;
+  return FindPool(flags)->ExecuteBatched(cmd_ctl, query, params_writer);
+}
+
 NotifyScope ClusterImpl::Listen(std::string_view channel,
                                 OptionalCommandControl cmd_ctl) {
   return FindPool(ClusterHostType::kMaster)->Listen(channel, cmd_ctl);
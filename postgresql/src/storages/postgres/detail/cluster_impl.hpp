@@ -48,6 +48,12 @@ class ClusterImpl {
 
   NonTransaction Start(ClusterHostTypeFlags, OptionalCommandControl);
 
+  bool IsAutoBatchingEnabled(ClusterHostTypeFlags) const;
+
+  ResultSet ExecuteBatched(ClusterHostTypeFlags, OptionalCommandControl,
+                           const Query& query,
+                           QueryParametersWriter params_writer);
+
   NotifyScope Listen(std::string_view channel, OptionalCommandControl);
 
   QueryQueue CreateQueryQueue(ClusterHostTypeFlags flags,
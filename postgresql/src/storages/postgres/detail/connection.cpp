@@ -23,14 +23,16 @@ std::unique_ptr<Connection> Connection::Connect(
     ConnectionSettings settings, const DefaultCommandControls& default_cmd_ctls,
     const testsuite::PostgresControl& testsuite_pg_ctl,
     const error_injection::Settings& ei_settings,
-    engine::SemaphoreLock&& size_lock) {
+    engine::SemaphoreLock&& size_lock,
+    std::shared_ptr<StatementRegistry> statement_registry) {
   std::unique_ptr<Connection> conn(new Connection());
 
   const auto deadline = engine::Deadline::FromDuration(std::max(
       kMinConnectTimeout, default_cmd_ctls.GetDefaultCmdCtl().execute));
   conn->pimpl_ = std::make_unique<ConnectionImpl>(
       bg_task_processor, bg_task_storage, id, settings, default_cmd_ctls,
-      testsuite_pg_ctl, ei_settings, std::move(size_lock));
+      testsuite_pg_ctl, ei_settings, std::move(size_lock),
+      std::move(statement_registry));
   if (resolver) {
     try {
       conn->pimpl_->AsyncConnect(ResolveDsnHostaddrs(dsn, *resolver, deadline),
@@ -167,6 +169,16 @@ ResultSet Connection::PortalExecute(StatementId statement_id,
                                std::move(statement_cmd_ctl));
 }
 
+std::size_t Connection::CopyFrom(const Query& query, CopyDataProducer producer,
+                                 OptionalCommandControl statement_cmd_ctl) {
+  return pimpl_->CopyFrom(query, producer, std::move(statement_cmd_ctl));
+}
+
+std::size_t Connection::CopyTo(const Query& query, CopyDataConsumer consumer,
+                               OptionalCommandControl statement_cmd_ctl) {
+  return pimpl_->CopyTo(query, consumer, std::move(statement_cmd_ctl));
+}
+
 void Connection::CancelAndCleanup(TimeoutDuration timeout) {
   pimpl_->CancelAndCleanup(timeout);
 }
@@ -2,6 +2,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <memory>
 #include <string>
 
 #include <userver/clients/dns/resolver_fwd.hpp>
@@ -38,6 +39,7 @@ enum class ConnectionState {
 namespace detail {
 
 class ConnectionImpl;
+class StatementRegistry;
 
 /// @brief PostreSQL connection class
 /// Handles connecting to Postgres, sending commands, processing command results
@@ -93,6 +95,12 @@ class Connection {
     /// Number of duplicate prepared statements errors,
     /// probably caused by timeout while preparing
     Counter duplicate_prepared_statements{0};
+    /// Number of describe round trips of prepared statements
+    Counter describe_total{0};
+    /// Number of prepared statements described in their parse round trip
+    Counter describe_saved_total{0};
+    /// Number of statements prepared on connect
+    Counter prepared_on_connect_total{0};
 
     /// Current number of prepared statements
     CurrentValue prepared_statements_current{0};
@@ -108,6 +116,8 @@ class Connection {
     SteadyClock::time_point last_execute_finish;
     /// Sum of all query durations
     SteadyClock::duration sum_query_duration{0};
+    /// Sum of the describe round trip durations of prepared statements
+    SteadyClock::duration sum_describe_duration{0};
   };
 
   using SizeGuard =
@@ -130,6 +140,7 @@ class Connection {
   /// @param testsuite_pg_ctl operation parameters customizer for testsuite
   /// @param ei_settings error injection settings
   /// @param size_guard structure to track the size of owning connection pool
+  /// @param statement_registry statements metadata shared with the other connections
   /// @throws ConnectionFailed, ConnectionTimeoutError
   // clang-format on
   static std::unique_ptr<Connection> Connect(
@@ -140,7 +151,8 @@ class Connection {
       const DefaultCommandControls& default_cmd_ctls,
       const testsuite::PostgresControl& testsuite_pg_ctl,
       const error_injection::Settings& ei_settings,
-      engine::SemaphoreLock&& size_lock = engine::SemaphoreLock{});
+      engine::SemaphoreLock&& size_lock = engine::SemaphoreLock{},
+      std::shared_ptr<StatementRegistry> statement_registry = {});
 
   /// Close the connection
   /// TODO When called from another thread/coroutine will wait for current
@@ -239,7 +251,8 @@ class Connection {
                     const T&... args) {
     detail::StaticQueryParameters<sizeof...(args)> params;
     params.Write(GetUserTypes(), args...);
-    return Execute(query, params, OptionalCommandControl{statement_cmd_ctl});
+    return Execute(query, detail::QueryParameters{params},
+                   OptionalCommandControl{statement_cmd_ctl});
   }
 
   ResultSet Execute(const Query& query, const ParameterStore& store);
@@ -254,6 +267,15 @@ class Connection {
   ResultSet PortalExecute(StatementId, const std::string& portal_name,
                           std::uint32_t n_rows, OptionalCommandControl);
 
+  /// Run `COPY ... FROM STDIN`, sending the data of the `producer`.
+  /// Returns the number of copied rows.
+  std::size_t CopyFrom(const Query& query, CopyDataProducer producer,
+                       OptionalCommandControl);
+  /// Run `COPY ... TO STDOUT`, passing the data to the `consumer`.
+  /// Returns the number of copied rows.
+  std::size_t CopyTo(const Query& query, CopyDataConsumer consumer,
+                     OptionalCommandControl);
+
   /// Send cancel to the database backend
   /// Try to return connection to idle state discarding all results.
   /// If there is a transaction in progress - roll it back.
@@ -1,5 +1,10 @@
 #include <storages/postgres/detail/connection_impl.hpp>
 
+#include <algorithm>
+#include <exception>
+#include <memory>
+#include <vector>
+
 #include <boost/functional/hash.hpp>
 
 #include <userver/error_injection/hook.hpp>
@@ -51,6 +56,27 @@ std::size_t QueryHash(const std::string& statement,
   return res;
 }
 
+/// Parameters of a statement to prepare, without values
+class ParamTypesHolder {
+ public:
+  explicit ParamTypesHolder(const std::vector<Oid>& types) : types_{types} {}
+
+  std::size_t Size() const { return types_.size(); }
+  const char* const* ParamBuffers() const { return nullptr; }
+  const Oid* ParamTypesBuffer() const { return types_.data(); }
+  const int* ParamLengthsBuffer() const { return nullptr; }
+  const int* ParamFormatsBuffer() const { return nullptr; }
+
+ private:
+  const std::vector<Oid>& types_;
+};
+
+std::vector<Oid> GetParamTypes(const QueryParameters& params) {
+  if (params.Empty()) return {};
+  return {params.ParamTypesBuffer(),
+          params.ParamTypesBuffer() + params.Size()};
+}
+
 class CountExecute {
  public:
   CountExecute(Connection::Statistics& stats) : stats_(stats) {
@@ -186,11 +212,13 @@ ConnectionImpl::ConnectionImpl(
     ConnectionSettings settings, const DefaultCommandControls& default_cmd_ctls,
     const testsuite::PostgresControl& testsuite_pg_ctl,
     const error_injection::Settings& ei_settings,
-    engine::SemaphoreLock&& size_lock)
+    engine::SemaphoreLock&& size_lock,
+    std::shared_ptr<StatementRegistry> statement_registry)
     : uuid_{USERVER_NAMESPACE::utils::generators::GenerateUuid()},
       conn_wrapper_{bg_task_processor, bg_task_storage, id,
                     std::move(size_lock)},
       prepared_{settings.max_prepared_cache_size},
+      statement_registry_{std::move(statement_registry)},
       settings_{settings},
       default_cmd_ctls_(default_cmd_ctls),
       testsuite_pg_ctl_{testsuite_pg_ctl},
@@ -240,6 +268,8 @@ void ConnectionImpl::AsyncConnect(const Dsn& dsn, engine::Deadline deadline) {
   if (settings_.user_types != ConnectionSettings::kPredefinedTypesOnly) {
     LoadUserTypes(deadline);
   }
+  // Failed statements are simpler to recover from outside of the pipeline
+  PrepareHotStatements(deadline, span, scope);
   if (settings_.pipeline_mode == PipelineMode::kEnabled) {
     conn_wrapper_.EnterPipelineMode();
   }
@@ -511,6 +541,140 @@ ResultSet ConnectionImpl::PortalExecute(
                     count_execute, span, scope, &prepared_info->description);
 }
 
+std::size_t ConnectionImpl::CopyFrom(
+    const Query& query, CopyDataProducer producer,
+    OptionalCommandControl statement_cmd_ctl) {
+  CheckBusy();
+  TimeoutDuration network_timeout = ExecuteTimeout(statement_cmd_ctl);
+  auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(network_timeout);
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+  CheckDeadlineReached(deadline);
+  auto span = MakeQuerySpan(query, {network_timeout, GetStatementTimeout()});
+  auto scope = span.CreateScopeTime();
+  CountExecute count_execute(stats_);
+
+  auto pipeline_guard = std::optional<ScopeGuard>{};
+  if (StartCopy(query, PGRES_COPY_IN, deadline, scope)) {
+    pipeline_guard.emplace([this] { RestorePipelineAfterCopy(); });
+  }
+  // The connection is unusable until the end of COPY is sent
+  ScopeGuard broken_guard{[this] { MarkAsBroken(); }};
+
+  CopyBuffer buffer;
+  while (true) {
+    bool has_data = false;
+    try {
+      has_data = producer(buffer);
+    } catch (const std::exception& e) {
+      // The server aborts the COPY and fails the statement
+      conn_wrapper_.PutCopyEnd(deadline, e.what());
+      broken_guard.Release();
+      try {
+        WaitResult(query.Statement(), deadline, network_timeout, count_execute,
+                   span, scope, nullptr);
+      } catch (const Error&) {
+        // the error of the aborted COPY is expected
+      }
+      throw;
+    }
+    if (!has_data) break;
+    conn_wrapper_.PutCopyData(deadline, {buffer.data(), buffer.size()});
+    buffer.clear();
+  }
+  conn_wrapper_.PutCopyEnd(deadline, nullptr);
+  broken_guard.Release();
+
+  return WaitResult(query.Statement(), deadline, network_timeout,
+                    count_execute, span, scope, nullptr)
+      .RowsAffected();
+}
+
+std::size_t ConnectionImpl::CopyTo(const Query& query,
+                                   CopyDataConsumer consumer,
+                                   OptionalCommandControl statement_cmd_ctl) {
+  CheckBusy();
+  TimeoutDuration network_timeout = ExecuteTimeout(statement_cmd_ctl);
+  auto deadline = testsuite_pg_ctl_.MakeExecuteDeadline(network_timeout);
+  SetStatementTimeout(std::move(statement_cmd_ctl));
+  CheckDeadlineReached(deadline);
+  auto span = MakeQuerySpan(query, {network_timeout, GetStatementTimeout()});
+  auto scope = span.CreateScopeTime();
+  CountExecute count_execute(stats_);
+
+  auto pipeline_guard = std::optional<ScopeGuard>{};
+  if (StartCopy(query, PGRES_COPY_OUT, deadline, scope)) {
+    pipeline_guard.emplace([this] { RestorePipelineAfterCopy(); });
+  }
+  // The connection is unusable until all the data is read
+  ScopeGuard broken_guard{[this] { MarkAsBroken(); }};
+
+  std::exception_ptr consumer_error;
+  const auto guarded_consumer = [&consumer,
+                                 &consumer_error](std::string_view data) {
+    if (consumer_error) return;
+    try {
+      consumer(data);
+    } catch (const std::exception&) {
+      consumer_error = std::current_exception();
+    }
+  };
+  bool is_cancelled = false;
+  while (conn_wrapper_.GetCopyData(deadline, guarded_consumer)) {
+    if (consumer_error && !is_cancelled) {
+      // The rest of the data is discarded, no need to transfer it
+      Cancel();
+      is_cancelled = true;
+    }
+  }
+  broken_guard.Release();
+
+  if (consumer_error) {
+    try {
+      WaitResult(query.Statement(), deadline, network_timeout, count_execute,
+                 span, scope, nullptr);
+    } catch (const Error&) {
+      // the error of the cancelled COPY is expected
+    }
+    std::rethrow_exception(consumer_error);
+  }
+  return WaitResult(query.Statement(), deadline, network_timeout,
+                    count_execute, span, scope, nullptr)
+      .RowsAffected();
+}
+
+bool ConnectionImpl::StartCopy(const Query& query,
+                               ExecStatusType expected_status,
+                               engine::Deadline deadline,
+                               tracing::ScopeTime& scope) {
+  // COPY is not allowed in pipeline mode
+  const bool exit_pipeline = IsPipelineActive();
+  if (exit_pipeline) {
+    if (conn_wrapper_.IsSyncingPipeline()) {
+      conn_wrapper_.WaitResult(deadline, scope, nullptr);
+    }
+    conn_wrapper_.ExitPipelineMode();
+  }
+
+  try {
+    conn_wrapper_.SendQuery(query.Statement(), scope);
+    conn_wrapper_.WaitCopyStart(deadline, scope, expected_status);
+  } catch (const std::exception&) {
+    if (exit_pipeline) RestorePipelineAfterCopy();
+    throw;
+  }
+  return exit_pipeline;
+}
+
+void ConnectionImpl::RestorePipelineAfterCopy() {
+  if (IsBroken()) return;
+  try {
+    conn_wrapper_.EnterPipelineMode();
+  } catch (const std::exception& e) {
+    LOG_LIMITED_WARNING() << "Failed to enter pipeline mode after COPY: " << e;
+    MarkAsBroken();
+  }
+}
+
 void ConnectionImpl::Listen(std::string_view channel,
                             OptionalCommandControl cmd_ctl) {
   ExecuteCommandNoPrepare(
@@ -747,13 +911,28 @@ const ConnectionImpl::PreparedStatementInfo& ConnectionImpl::DoPrepareStatement(
 
   const std::string statement_name =
       "q" + std::to_string(query_hash) + "_" + uuid_;
+  const auto shared_statement = IsStatementRegistryEnabled()
+                                    ? statement_registry_->Find(query_id)
+                                    : nullptr;
   bool should_prepare = !statement_info;
+  // In the pipeline mode the statement is described in the parse round trip
+  const bool should_describe_with_prepare =
+      should_prepare && conn_wrapper_.IsPipelineActive();
+  ResultSet res{nullptr};
+  auto describe_start = SteadyClock::now();
   if (should_prepare) {
     conn_wrapper_.SendPrepare(statement_name, statement, params, scope);
+    if (should_describe_with_prepare) {
+      conn_wrapper_.SendDescribePrepared(statement_name, scope);
+    }
 
     try {
-      conn_wrapper_.WaitResult(deadline, scope, nullptr);
+      auto prepare_res = conn_wrapper_.WaitResult(deadline, scope, nullptr);
       LOG_DEBUG() << "Prepare successfully sent";
+      if (should_describe_with_prepare) {
+        res = std::move(prepare_res);
+        ++stats_.describe_saved_total;
+      }
     } catch (const DuplicatePreparedStatement& e) {
       // As we have a pretty unique hash for a statement, we can safely use
       // it. This situation might happen when `SendPrepare` times out and we
@@ -779,15 +958,24 @@ const ConnectionImpl::PreparedStatementInfo& ConnectionImpl::DoPrepareStatement(
     LOG_DEBUG() << "Don't send prepare, already sent";
   }
 
-  conn_wrapper_.SendDescribePrepared(statement_name, scope);
-  auto res = conn_wrapper_.WaitResult(deadline, scope, nullptr);
   if (!res.pimpl_) {
-    throw CommandError("WaitResult() returned nullptr");
+    describe_start = SteadyClock::now();
+    conn_wrapper_.SendDescribePrepared(statement_name, scope);
+    res = conn_wrapper_.WaitResult(deadline, scope, nullptr);
+    if (!res.pimpl_) {
+      throw CommandError("WaitResult() returned nullptr");
+    }
   }
+  ++stats_.describe_total;
+  stats_.sum_describe_duration += SteadyClock::now() - describe_start;
   FillBufferCategories(res);
   // Ensure we've got binary format established
   res.GetRowDescription().CheckBinaryFormat(db_types_);
 
+  if (!shared_statement && IsStatementRegistryEnabled()) {
+    statement_registry_->Add(query_id, {statement, GetParamTypes(params)});
+  }
+
   if (!statement_info) {
     prepared_.Put(query_id,
                   {query_id, statement, statement_name, std::move(res)});
@@ -801,11 +989,46 @@ const ConnectionImpl::PreparedStatementInfo& ConnectionImpl::DoPrepareStatement(
   return *statement_info;
 }
 
+void ConnectionImpl::PrepareHotStatements(engine::Deadline deadline,
+                                          tracing::Span& span,
+                                          tracing::ScopeTime& scope) {
+  if (!settings_.prepare_on_connect || !statement_registry_ ||
+      !ArePreparedStatementsEnabled()) {
+    return;
+  }
+
+  const auto statements = statement_registry_->GetMostPrepared(std::min(
+      settings_.prepare_on_connect, settings_.max_prepared_cache_size));
+  for (const auto& hot_statement : statements) {
+    if (deadline.IsReached()) break;
+    ParamTypesHolder param_types{hot_statement->param_types};
+    const QueryParameters params{param_types};
+    try {
+      DoPrepareStatement(hot_statement->statement, params, deadline, span,
+                         scope);
+      ++stats_.prepared_on_connect_total;
+    } catch (const ConnectionError&) {
+      throw;
+    } catch (const Error& e) {
+      // The statement may be obsolete, e.g. after a migration
+      LOG_LIMITED_WARNING() << "Failed to prepare statement `"
+                            << hot_statement->statement
+                            << "` on connect: " << e;
+    }
+  }
+}
+
+bool ConnectionImpl::IsStatementRegistryEnabled() const {
+  return statement_registry_ && settings_.prepare_on_connect > 0;
+}
+
 void ConnectionImpl::DiscardOldPreparedStatements(engine::Deadline deadline) {
   // do not try to do anything in transaction as it may already be broken
   if (is_discard_prepared_pending_ && !IsInTransaction()) {
     LOG_DEBUG() << "Discarding prepared statements";
     prepared_.Clear();
+    // The parameter types of the hot statements may be obsolete as well
+    if (IsStatementRegistryEnabled()) statement_registry_->Clear();
     ExecuteCommandNoPrepare("DEALLOCATE ALL", deadline);
     is_discard_prepared_pending_ = false;
   }
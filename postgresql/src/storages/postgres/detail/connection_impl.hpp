@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -20,6 +21,7 @@
 #include <storages/postgres/default_command_controls.hpp>
 #include <storages/postgres/detail/connection.hpp>
 #include <storages/postgres/detail/pg_connection_wrapper.hpp>
+#include <storages/postgres/detail/statement_registry.hpp>
 #include <userver/storages/postgres/detail/query_parameters.hpp>
 #include <userver/storages/postgres/detail/time_types.hpp>
 #include <userver/storages/postgres/options.hpp>
@@ -45,7 +47,8 @@ class ConnectionImpl {
                  const DefaultCommandControls& default_cmd_ctls,
                  const testsuite::PostgresControl& testsuite_pg_ctl,
                  const error_injection::Settings& ei_settings,
-                 engine::SemaphoreLock&& size_lock);
+                 engine::SemaphoreLock&& size_lock,
+                 std::shared_ptr<StatementRegistry> statement_registry);
 
   void AsyncConnect(const Dsn& dsn, engine::Deadline deadline);
   void Close();
@@ -107,6 +110,11 @@ class ConnectionImpl {
                           const std::string& portal_name, std::uint32_t n_rows,
                           OptionalCommandControl statement_cmd_ctl);
 
+  std::size_t CopyFrom(const Query& query, CopyDataProducer producer,
+                       OptionalCommandControl statement_cmd_ctl);
+  std::size_t CopyTo(const Query& query, CopyDataConsumer consumer,
+                     OptionalCommandControl statement_cmd_ctl);
+
   void Listen(std::string_view channel, OptionalCommandControl);
   void Unlisten(std::string_view channel, OptionalCommandControl);
   Notification WaitNotify(engine::Deadline deadline);
@@ -154,6 +162,9 @@ class ConnectionImpl {
       const std::string& statement, const detail::QueryParameters& params,
       engine::Deadline deadline, tracing::Span& span,
       tracing::ScopeTime& scope);
+  void PrepareHotStatements(engine::Deadline deadline, tracing::Span& span,
+                            tracing::ScopeTime& scope);
+  bool IsStatementRegistryEnabled() const;
   void DiscardOldPreparedStatements(engine::Deadline deadline);
   void DiscardPreparedStatement(const PreparedStatementInfo& info,
                                 engine::Deadline deadline);
@@ -173,6 +184,12 @@ class ConnectionImpl {
 
   void SendCommandNoPrepare(const Query& query, engine::Deadline deadline);
 
+  /// Sends the COPY statement and waits for the server to start the COPY,
+  /// returns whether the pipeline mode was exited for it
+  bool StartCopy(const Query& query, ExecStatusType expected_status,
+                 engine::Deadline deadline, tracing::ScopeTime& scope);
+  void RestorePipelineAfterCopy();
+
   void SendCommandNoPrepare(const Query& query, const QueryParameters& params,
                             engine::Deadline deadline);
 
@@ -199,6 +216,7 @@ class ConnectionImpl {
   Connection::Statistics stats_;
   PGConnectionWrapper conn_wrapper_;
   PreparedStatements prepared_;
+  std::shared_ptr<StatementRegistry> statement_registry_;
   UserTypes db_types_;
   bool is_in_recovery_ = true;
   bool is_read_only_ = true;
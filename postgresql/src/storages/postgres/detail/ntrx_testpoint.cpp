@@ -0,0 +1,30 @@
+#include <storages/postgres/detail/ntrx_testpoint.hpp>
+
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/logging/log.hpp>
+#include <userver/testsuite/testpoint.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+void NonTransactionExecuteTestpoint(const Query& query) {
+  if (!query.GetName().has_value()) return;
+
+  TESTPOINT_CALLBACK(
+      fmt::format("pg_ntrx_execute::{}", query.GetName().value()),
+      formats::json::Value(), [](const formats::json::Value& data) {
+        if (data["inject_failure"].As<bool>()) {
+          LOG_WARNING() << "Failing statement "
+                           "due to Testpoint response";
+          throw std::runtime_error{"Statement failed"};
+        }
+      });
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
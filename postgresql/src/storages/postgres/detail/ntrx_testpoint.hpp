@@ -0,0 +1,15 @@
+#pragma once
+
+#include <userver/storages/postgres/query.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// Calls the `pg_ntrx_execute::<name>` testpoint for a named single
+/// statement, throws if the testsuite requested the statement to fail.
+void NonTransactionExecuteTestpoint(const Query& query);
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -582,6 +582,115 @@ Notification PGConnectionWrapper::WaitNotify(Deadline deadline) {
   return result;
 }
 
+void PGConnectionWrapper::WaitCopyStart(Deadline deadline,
+                                        tracing::ScopeTime& scope,
+                                        ExecStatusType expected_status) {
+  scope.Reset(scopes::kLibpqWaitResult);
+  Flush(deadline);
+  // libpq returns the COPY result until the COPY is finished, so it is
+  // read only once
+  auto handle = MakeResultHandle(ReadResult(deadline, nullptr));
+  const auto status =
+      handle ? PQresultStatus(handle.get()) : PGRES_EMPTY_QUERY;
+  if (status == expected_status) return;
+
+  if (status == PGRES_COPY_IN || status == PGRES_COPY_OUT ||
+      status == PGRES_COPY_BOTH) {
+    PGCW_LOG_LIMITED_ERROR() << "Unexpected direction of PostgreSQL COPY";
+    CloseWithError(LogicError{"Unexpected direction of COPY"});
+  }
+
+  // Not a COPY or an error, the rest of the results is discarded
+  while (auto* pg_res = ReadResult(deadline, nullptr)) {
+    MakeResultHandle(pg_res);
+  }
+  MakeResult(std::move(handle));
+  throw LogicError{
+      "Statement is neither `COPY ... FROM STDIN` nor `COPY ... TO STDOUT`"};
+}
+
+void PGConnectionWrapper::PutCopyData(Deadline deadline,
+                                      std::string_view data) {
+  int put_res = 0;
+  while (!(put_res = PQputCopyData(conn_, data.data(), data.size()))) {
+    // libpq could not queue the data in non-blocking mode
+    if (!WaitSocketWriteable(deadline)) {
+      if (engine::current_task::ShouldCancel()) {
+        throw ConnectionInterrupted("Task cancelled while sending COPY data");
+      }
+      PGCW_LOG_LIMITED_WARNING()
+          << "Timeout while sending COPY data to PostgreSQL connection socket";
+      throw ConnectionTimeoutError("Timed out while sending COPY data");
+    }
+    CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+  }
+  if (put_res < 0) {
+    HandleSocketPostClose();
+    throw CommandError(
+        fmt::format("PQputCopyData error: {}", PQerrorMessage(conn_)));
+  }
+  UpdateLastUse();
+  // libpq grows its output buffer instead of blocking, so the data is flushed
+  // to keep the memory bounded
+  Flush(deadline);
+}
+
+void PGConnectionWrapper::PutCopyEnd(Deadline deadline,
+                                     const char* error_message) {
+  int put_res = 0;
+  while (!(put_res = PQputCopyEnd(conn_, error_message))) {
+    if (!WaitSocketWriteable(deadline)) {
+      if (engine::current_task::ShouldCancel()) {
+        throw ConnectionInterrupted("Task cancelled while finishing COPY");
+      }
+      PGCW_LOG_LIMITED_WARNING()
+          << "Timeout while finishing COPY to PostgreSQL connection socket";
+      throw ConnectionTimeoutError("Timed out while finishing COPY");
+    }
+    CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+  }
+  if (put_res < 0) {
+    HandleSocketPostClose();
+    throw CommandError(
+        fmt::format("PQputCopyEnd error: {}", PQerrorMessage(conn_)));
+  }
+  UpdateLastUse();
+  Flush(deadline);
+}
+
+bool PGConnectionWrapper::GetCopyData(Deadline deadline,
+                                      CopyDataConsumer consumer) {
+  while (true) {
+    char* buffer = nullptr;
+    const auto size = PQgetCopyData(conn_, &buffer, /*async=*/1);
+    if (size > 0) {
+      const std::unique_ptr<char, decltype(&PQfreemem)> buffer_holder{
+          buffer, &PQfreemem};
+      consumer(std::string_view{buffer, static_cast<std::size_t>(size)});
+      return true;
+    }
+    if (size == -1) return false;
+    if (size < -1) {
+      HandleSocketPostClose();
+      throw CommandError(
+          fmt::format("PQgetCopyData error: {}", PQerrorMessage(conn_)));
+    }
+
+    // no complete row is available yet
+    if (!WaitSocketReadable(deadline)) {
+      if (engine::current_task::ShouldCancel()) {
+        throw ConnectionInterrupted("Task cancelled while reading COPY data");
+      }
+      PGCW_LOG_LIMITED_WARNING()
+          << "Timeout while reading COPY data from PostgreSQL connection "
+             "socket";
+      throw ConnectionTimeoutError("Timed out while reading COPY data");
+    }
+    CheckError<CommandError>("PQconsumeInput", PQconsumeInput(conn_));
+    UpdateLastUse();
+  }
+}
+
 std::vector<ResultSet> PGConnectionWrapper::GatherPipeline(
     [[maybe_unused]] Deadline deadline,
     const std::vector<const PGresult*>& descriptions) {
@@ -711,9 +820,10 @@ ResultSet PGConnectionWrapper::MakeResult(ResultHandle&& handle) {
     case PGRES_COPY_OUT:
     case PGRES_COPY_BOTH:
       PGCW_LOG_LIMITED_ERROR()
-          << "PostgreSQL COPY command invoked which is not implemented"
+          << "PostgreSQL COPY command invoked outside of CopyFrom or CopyTo"
           << logging::LogExtra::Stacktrace();
-      CloseWithError(NotImplemented{"Copy is not implemented"});
+      CloseWithError(
+          NotImplemented{"Copy is only supported by CopyFrom and CopyTo"});
     case PGRES_BAD_RESPONSE:
       CloseWithError(ConnectionError{"Failed to parse server response"});
     case PGRES_NONFATAL_ERROR: {
@@ -15,6 +15,7 @@
 #include <storages/postgres/detail/connection.hpp>
 #include <storages/postgres/detail/result_wrapper.hpp>
 #include <userver/engine/semaphore.hpp>
+#include <userver/storages/postgres/copy.hpp>
 #include <userver/storages/postgres/dsn.hpp>
 #include <userver/storages/postgres/notify.hpp>
 
@@ -114,6 +115,23 @@ class PGConnectionWrapper {
   /// @brief Wait for notification
   Notification WaitNotify(Deadline deadline);
 
+  /// @brief Wait for the server to start COPY of the expected direction.
+  /// Throws the error of the statement or LogicError if it is not a COPY.
+  void WaitCopyStart(Deadline deadline, tracing::ScopeTime&,
+                     ExecStatusType expected_status);
+
+  /// @brief Wrapper for PQputCopyData, flushes the data to the server
+  void PutCopyData(Deadline deadline, std::string_view data);
+
+  /// @brief Wrapper for PQputCopyEnd, a non-null `error_message` aborts the
+  /// COPY. The result of the COPY should be read with WaitResult.
+  void PutCopyEnd(Deadline deadline, const char* error_message);
+
+  /// @brief Wrapper for PQgetCopyData, passes the next chunk of data to the
+  /// `consumer`. Returns false at the end of the data, the result of the COPY
+  /// should be read with WaitResult then.
+  bool GetCopyData(Deadline deadline, CopyDataConsumer consumer);
+
   std::vector<ResultSet> GatherPipeline(
       Deadline deadline, const std::vector<const PGresult*>& descriptions);
 
@@ -76,7 +76,8 @@ ConnectionPool::ConnectionPool(
     const testsuite::PostgresControl& testsuite_pg_ctl,
     error_injection::Settings ei_settings,
     const congestion_control::v2::LinearController::StaticConfig& cc_config,
-    dynamic_config::Source config_source)
+    dynamic_config::Source config_source,
+    std::shared_ptr<StatementRegistry> statement_registry)
     : dsn_{std::move(dsn)},
       resolver_{resolver},
       db_name_{db_name},
@@ -96,6 +97,12 @@ ConnectionPool::ConnectionPool(
                     {1, kCancelPeriod}},
       sts_{statement_metrics_settings},
       config_source_(config_source),
+      batcher_{*this, testsuite_pg_ctl_, stats_.batching},
+      statement_registry_{
+          statement_registry
+              ? std::move(statement_registry)
+              : std::make_shared<StatementRegistry>(
+                    conn_settings.max_prepared_cache_size)},
       cc_sensor_(*this),
       cc_limiter_(*this),
       cc_controller_("postgres" + db_name, cc_sensor_, cc_limiter_,
@@ -124,14 +131,15 @@ std::shared_ptr<ConnectionPool> ConnectionPool::Create(
     const testsuite::PostgresControl& testsuite_pg_ctl,
     error_injection::Settings ei_settings,
     const congestion_control::v2::LinearController::StaticConfig& cc_config,
-    dynamic_config::Source config_source) {
+    dynamic_config::Source config_source,
+    std::shared_ptr<StatementRegistry> statement_registry) {
   // FP?: pointer magic in boost.lockfree
   // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
   auto impl = std::make_shared<ConnectionPool>(
       EmplaceEnabler{}, std::move(dsn), resolver, bg_task_processor, db_name,
       pool_settings, conn_settings, statement_metrics_settings,
       default_cmd_ctls, testsuite_pg_ctl, std::move(ei_settings), cc_config,
-      config_source);
+      config_source, std::move(statement_registry));
   // Init() uses shared_from_this for connections and cannot be called from
   // ctor
   impl->Init(init_mode);
@@ -235,6 +243,17 @@ void ConnectionPool::AccountConnectionStats(Connection::Statistics conn_stats) {
   stats_.transaction.duplicate_prepared_statements +=
       conn_stats.duplicate_prepared_statements;
 
+  stats_.shared_statements.describe_saved_total +=
+      conn_stats.describe_saved_total;
+  stats_.shared_statements.prepared_on_connect_total +=
+      conn_stats.prepared_on_connect_total;
+  if (conn_stats.describe_total) {
+    stats_.shared_statements.describe_time.GetCurrentCounter().Account(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            conn_stats.sum_describe_duration / conn_stats.describe_total)
+            .count());
+  }
+
   stats_.transaction.total_percentile.GetCurrentCounter().Account(
       std::chrono::duration_cast<std::chrono::milliseconds>(
           conn_stats.trx_end_time - conn_stats.trx_start_time)
@@ -321,6 +340,20 @@ NonTransaction ConnectionPool::Start(OptionalCommandControl cmd_ctl) {
   return NonTransaction{std::move(conn), start_time};
 }
 
+ResultSet ConnectionPool::ExecuteBatched(OptionalCommandControl cmd_ctl,
+                                         const Query& query,
+                                         QueryParametersWriter params_writer) {
+  std::chrono::microseconds window{};
+  std::size_t max_size = 0;
+  {
+    const auto settings = settings_.Read();
+    window = settings->auto_batch_window;
+    max_size = settings->auto_batch_max_size;
+  }
+  return batcher_.Execute(cmd_ctl.value_or(GetDefaultCommandControl()), query,
+                          params_writer, window, max_size);
+}
+
 NotifyScope ConnectionPool::Listen(std::string_view channel,
                                    OptionalCommandControl cmd_ctl) {
   const auto deadline =
@@ -417,7 +450,7 @@ bool ConnectionPool::DoConnect(engine::SemaphoreLock size_lock) {
     connection = Connection::Connect(
         dsn_, resolver_, bg_task_processor_, close_task_storage_, conn_id,
         *conn_settings, default_cmd_ctls_, testsuite_pg_ctl_, ei_settings_,
-        std::move(size_lock));
+        std::move(size_lock), statement_registry_);
   } catch (const ConnectionTimeoutError&) {
     // No problem if it's connection error
     ++stats_.connection.error_timeout;
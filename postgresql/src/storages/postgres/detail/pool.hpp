@@ -33,6 +33,8 @@
 
 #include <storages/postgres/detail/connection.hpp>
 #include <storages/postgres/detail/pg_impl_types.hpp>
+#include <storages/postgres/detail/query_batcher.hpp>
+#include <storages/postgres/detail/statement_registry.hpp>
 #include <storages/postgres/detail/statement_timings_storage.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -52,7 +54,8 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
       const testsuite::PostgresControl& testsuite_pg_ctl,
       error_injection::Settings ei_settings,
       const congestion_control::v2::LinearController::StaticConfig& cc_config,
-      dynamic_config::Source config_source);
+      dynamic_config::Source config_source,
+      std::shared_ptr<StatementRegistry> statement_registry);
 
   ~ConnectionPool();
 
@@ -66,7 +69,8 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
       const testsuite::PostgresControl& testsuite_pg_ctl,
       error_injection::Settings ei_settings,
       const congestion_control::v2::LinearController::StaticConfig& cc_config,
-      dynamic_config::Source config_source);
+      dynamic_config::Source config_source,
+      std::shared_ptr<StatementRegistry> statement_registry = {});
 
   [[nodiscard]] ConnectionPtr Acquire(engine::Deadline);
   void Release(Connection* connection);
@@ -77,6 +81,11 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
 
   [[nodiscard]] NonTransaction Start(OptionalCommandControl cmd_ctl = {});
 
+  /// Executes a single statement in a batch with the concurrent ones,
+  /// see PoolSettings::auto_batch_window
+  ResultSet ExecuteBatched(OptionalCommandControl cmd_ctl, const Query& query,
+                           QueryParametersWriter params_writer);
+
   NotifyScope Listen(std::string_view channel,
                      OptionalCommandControl cmd_ctl = {});
 
@@ -156,6 +165,8 @@ class ConnectionPool : public std::enable_shared_from_this<ConnectionPool> {
   USERVER_NAMESPACE::utils::TokenBucket cancel_limit_;
   detail::StatementTimingsStorage sts_;
   dynamic_config::Source config_source_;
+  QueryBatcher batcher_;
+  std::shared_ptr<StatementRegistry> statement_registry_;
 
   // Congestion control stuff
   cc::Sensor cc_sensor_;
@@ -0,0 +1,203 @@
+#include <storages/postgres/detail/query_batcher.hpp>
+
+#include <algorithm>
+#include <mutex>
+
+#include <fmt/format.h>
+
+#include <userver/engine/task/cancel.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/tracing/span.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <storages/postgres/detail/ntrx_testpoint.hpp>
+#include <storages/postgres/detail/pool.hpp>
+#include <storages/postgres/detail/statement_timer.hpp>
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+QueryBatcher::QueryBatcher(ConnectionPool& pool,
+                           const testsuite::PostgresControl& testsuite_pg_ctl,
+                           Statistics& stats)
+    : pool_{pool}, testsuite_pg_ctl_{testsuite_pg_ctl}, stats_{stats} {}
+
+ResultSet QueryBatcher::Execute(CommandControl cmd_ctl, const Query& query,
+                                QueryParametersWriter params_writer,
+                                std::chrono::microseconds window,
+                                std::size_t max_size) {
+  // The statement may be failed by the testsuite before it joins a batch
+  NonTransactionExecuteTestpoint(query);
+
+  // The batch executes the statements of other tasks, its leader must not
+  // abandon them and they must not abandon their parameters
+  const engine::TaskCancellationBlocker block_cancel;
+
+  Item item{cmd_ctl, query, params_writer};
+  std::shared_ptr<Batch> batch;
+  bool is_leader = false;
+  {
+    std::unique_lock lock{mutex_};
+    if (!pending_) {
+      pending_ = std::make_shared<Batch>();
+      pending_->items.reserve(max_size);
+      is_leader = true;
+    }
+    batch = pending_;
+    batch->items.push_back(&item);
+
+    if (is_leader) {
+      [[maybe_unused]] const bool is_full =
+          batch->is_full.WaitFor(lock, window, [&batch, max_size] {
+            return batch->items.size() >= max_size;
+          });
+      if (pending_ == batch) pending_.reset();
+    } else if (batch->items.size() >= max_size) {
+      pending_.reset();
+      batch->is_full.NotifyOne();
+    }
+  }
+
+  if (is_leader) {
+    // No statements are added to the batch after it is detached
+    ExecuteBatch(batch->items);
+  } else {
+    [[maybe_unused]] const bool is_done = item.done.WaitForEvent();
+    UASSERT(is_done);
+  }
+
+  if (item.error) std::rethrow_exception(item.error);
+  UASSERT(item.result);
+  return std::move(*item.result);
+}
+
+void QueryBatcher::ExecuteBatch(const std::vector<Item*>& items) {
+  UASSERT(!items.empty());
+  ++stats_.batches_total;
+  stats_.queries_total += items.size();
+  stats_.batch_size.GetCurrentCounter().Account(items.size());
+
+  auto timeout = items.front()->cmd_ctl.execute;
+  for (const auto* item : items) {
+    timeout = std::max(timeout, item->cmd_ctl.execute);
+  }
+
+  const auto fail_all = [&items](std::exception_ptr error) {
+    for (auto* item : items) {
+      if (!item->result && !item->error) item->error = error;
+    }
+  };
+
+  try {
+    auto conn = pool_.Acquire(testsuite_pg_ctl_.MakeExecuteDeadline(timeout));
+    conn->Start(SteadyClock::now());
+    for (auto* item : items) {
+      try {
+        item->params = item->params_writer(conn->GetUserTypes());
+      } catch (const std::exception&) {
+        item->error = std::current_exception();
+      }
+    }
+
+    if (items.size() > 1 && conn->IsPipelineActive() &&
+        conn->ArePreparedStatementsEnabled()) {
+      try {
+        ExecutePipelined(conn, items);
+      } catch (const ConnectionTimeoutError&) {
+        throw;
+      } catch (const std::exception& e) {
+        // The pipeline stops at the first failed statement, the failure is
+        // attributed to the right statement by executing them one by one.
+        // Only the read-only statements are batched, so the ones that
+        // succeeded in the pipeline may be executed again.
+        ++stats_.fallback_total;
+        LOG_WARNING() << "Batch of " << items.size()
+                      << " statements failed, executing them one by one: "
+                      << e;
+        conn->Finish();
+        // Return the connection first, the pool may have no other one
+        conn = ConnectionPtr{nullptr};
+        conn = pool_.Acquire(testsuite_pg_ctl_.MakeExecuteDeadline(timeout));
+        conn->Start(SteadyClock::now());
+        ExecuteOneByOne(conn, items);
+      }
+    } else {
+      ExecuteOneByOne(conn, items);
+    }
+    conn->Finish();
+  } catch (const std::exception&) {
+    fail_all(std::current_exception());
+  }
+
+  // The followers destroy their items as soon as they are woken up
+  for (std::size_t i = 1; i < items.size(); ++i) items[i]->done.Send();
+}
+
+void QueryBatcher::ExecutePipelined(ConnectionPtr& conn,
+                                    const std::vector<Item*>& items) {
+  tracing::Span span{"pg_execute_batch"};
+  auto scope = span.CreateScopeTime();
+
+  std::vector<Item*> pipelined;
+  std::vector<std::string> statement_names;
+  std::vector<ResultSet> descriptions;
+  pipelined.reserve(items.size());
+  statement_names.reserve(items.size());
+  descriptions.reserve(items.size());
+
+  for (auto* item : items) {
+    if (item->error) continue;
+    auto meta =
+        conn->PrepareStatement(item->query, item->params, item->cmd_ctl.execute);
+    pipelined.push_back(item);
+    statement_names.push_back(std::move(meta.statement_name));
+    descriptions.push_back(std::move(meta.description));
+  }
+  if (pipelined.empty()) return;
+
+  // Every statement of the pipeline takes the whole round trip
+  std::vector<StatementTimer> timers;
+  timers.reserve(pipelined.size());
+  auto timeout = pipelined.front()->cmd_ctl.execute;
+  for (std::size_t i = 0; i < pipelined.size(); ++i) {
+    const auto* item = pipelined[i];
+    timeout = std::max(timeout, item->cmd_ctl.execute);
+    timers.emplace_back(item->query, conn);
+    conn->AddIntoPipeline(item->cmd_ctl, statement_names[i], item->params,
+                         descriptions[i], scope);
+  }
+
+  auto results = conn->GatherPipeline(timeout, descriptions);
+  if (results.size() != pipelined.size()) {
+    throw RuntimeError{
+        fmt::format("Batch results count mismatch: expected {}, got {}",
+                    pipelined.size(), results.size())};
+  }
+  for (std::size_t i = 0; i < pipelined.size(); ++i) {
+    timers[i].Account();
+    pipelined[i]->result.emplace(std::move(results[i]));
+  }
+}
+
+void QueryBatcher::ExecuteOneByOne(ConnectionPtr& conn,
+                                   const std::vector<Item*>& items) {
+  for (auto* item : items) {
+    if (item->error || item->result) continue;
+    try {
+      StatementTimer timer{item->query, conn};
+      item->result.emplace(conn->Execute(
+          item->query, item->params, OptionalCommandControl{item->cmd_ctl}));
+      timer.Account();
+    } catch (const ConnectionTimeoutError&) {
+      throw;
+    } catch (const std::exception&) {
+      item->error = std::current_exception();
+    }
+  }
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+#include <userver/testsuite/postgres_control.hpp>
+
+#include <userver/storages/postgres/detail/query_parameters.hpp>
+#include <userver/storages/postgres/options.hpp>
+#include <userver/storages/postgres/query.hpp>
+#include <userver/storages/postgres/result_set.hpp>
+#include <userver/storages/postgres/statistics.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+class ConnectionPool;
+class ConnectionPtr;
+
+/// Coalesces the single statements of concurrent callers into batches that
+/// are executed in a single pipelined round trip on a single connection.
+///
+/// The first statement of a batch waits for the others for the batch window
+/// and then executes the whole batch on behalf of all the callers. Callers
+/// wait for the batch uninterruptibly, it is limited by the execute timeouts
+/// of its statements.
+class QueryBatcher final {
+ public:
+  using Statistics = decltype(InstanceStatistics::batching);
+
+  QueryBatcher(ConnectionPool& pool,
+               const testsuite::PostgresControl& testsuite_pg_ctl,
+               Statistics& stats);
+
+  ResultSet Execute(CommandControl cmd_ctl, const Query& query,
+                    QueryParametersWriter params_writer,
+                    std::chrono::microseconds window, std::size_t max_size);
+
+ private:
+  struct Item {
+    CommandControl cmd_ctl;
+    const Query& query;
+    QueryParametersWriter params_writer;
+    QueryParameters params{};
+    std::optional<ResultSet> result{};
+    std::exception_ptr error{};
+    engine::SingleConsumerEvent done{};
+  };
+
+  struct Batch {
+    std::vector<Item*> items;
+    engine::ConditionVariable is_full;
+  };
+
+  void ExecuteBatch(const std::vector<Item*>& items);
+  void ExecutePipelined(ConnectionPtr& conn, const std::vector<Item*>& items);
+  static void ExecuteOneByOne(ConnectionPtr& conn,
+                              const std::vector<Item*>& items);
+
+  ConnectionPool& pool_;
+  const testsuite::PostgresControl& testsuite_pg_ctl_;
+  Statistics& stats_;
+
+  engine::Mutex mutex_;
+  std::shared_ptr<Batch> pending_;
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include <storages/postgres/detail/result_wrapper.hpp>
 
+#include <cstring>
+
 #include <fmt/compile.h>
 #include <fmt/format.h>
 #include <boost/container/small_vector.hpp>
@@ -292,6 +294,26 @@ io::FieldBuffer ResultWrapper::GetFieldBuffer(std::size_t row,
                              PQgetvalue(handle_.get(), row, col))};
 }
 
+bool ResultWrapper::CopyFixedWidthColumn(std::size_t col, std::size_t width,
+                                         char* values) const {
+  auto* res = handle_.get();
+  if (PQfformat(res, col) != io::kPgBinaryDataFormat) {
+    throw ResultSetError{
+        fmt::format("Column with index {} has text format", col)};
+  }
+  if (PQfsize(res, col) != static_cast<int>(width)) return false;
+
+  const auto row_count = RowCount();
+  for (std::size_t row = 0; row < row_count; ++row, values += width) {
+    if (PQgetisnull(res, row, col) ||
+        static_cast<std::size_t>(PQgetlength(res, row, col)) != width) {
+      return false;
+    }
+    std::memcpy(values, PQgetvalue(res, row, col), width);
+  }
+  return true;
+}
+
 std::string ResultWrapper::GetErrorMessage() const {
   auto* msg = PQresultErrorMessage(handle_.get());
   return {msg ? msg : "no error message"};
@@ -46,6 +46,10 @@ class ResultWrapper {
   bool IsFieldNull(std::size_t row, std::size_t col) const;
   std::size_t GetFieldLength(std::size_t row, std::size_t col) const;
   io::FieldBuffer GetFieldBuffer(std::size_t row, std::size_t col) const;
+  /// Copies the column fields of `width` bytes each to the `values` as is,
+  /// returns false if there is a null or a field of another size
+  bool CopyFixedWidthColumn(std::size_t col, std::size_t width,
+                            char* values) const;
   //@}
 
   //@{
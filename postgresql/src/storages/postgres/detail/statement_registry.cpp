@@ -0,0 +1,61 @@
+#include <storages/postgres/detail/statement_registry.hpp>
+
+#include <algorithm>
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+StatementRegistry::StatementRegistry(std::size_t max_size)
+    : storage_{std::max<std::size_t>(max_size, 1)} {}
+
+StatementRegistry::StatementPtr StatementRegistry::Find(
+    Connection::StatementId id) {
+  auto storage = storage_.Lock();
+  auto* entry = storage->Get(id);
+  if (!entry) return {};
+  ++entry->prepare_count;
+  return entry->statement;
+}
+
+void StatementRegistry::Add(Connection::StatementId id, Statement statement) {
+  auto ptr = std::make_shared<const Statement>(std::move(statement));
+  auto storage = storage_.Lock();
+  auto* entry = storage->Emplace(id);
+  entry->statement = std::move(ptr);
+  ++entry->prepare_count;
+}
+
+std::vector<StatementRegistry::StatementPtr>
+StatementRegistry::GetMostPrepared(std::size_t count) const {
+  std::vector<std::pair<std::size_t, StatementPtr>> entries;
+  {
+    auto storage = storage_.Lock();
+    entries.reserve(storage->GetSize());
+    storage->VisitAll([&entries](const auto& /*id*/, const Entry& entry) {
+      entries.emplace_back(entry.prepare_count, entry.statement);
+    });
+  }
+
+  count = std::min(count, entries.size());
+  std::partial_sort(
+      entries.begin(), entries.begin() + count, entries.end(),
+      [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+
+  std::vector<StatementPtr> result;
+  result.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    result.push_back(std::move(entries[i].second));
+  }
+  return result;
+}
+
+void StatementRegistry::Clear() {
+  auto storage = storage_.Lock();
+  storage->Clear();
+}
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <userver/cache/lru_map.hpp>
+#include <userver/concurrent/variable.hpp>
+#include <userver/engine/mutex.hpp>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/io/pg_types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres::detail {
+
+/// Metadata of the statements prepared by the connections of a cluster.
+///
+/// Prepared statements belong to a session, so each connection still parses
+/// and describes a statement itself. The registry lets the new connections
+/// prepare the most frequently prepared statements up front, e.g. after a
+/// failover.
+///
+/// The result descriptions are not shared, a schema change may alter them
+/// without any error for a connection that prepares the statement afterwards.
+class StatementRegistry final {
+ public:
+  struct Statement {
+    std::string statement;
+    std::vector<Oid> param_types;
+  };
+  using StatementPtr = std::shared_ptr<const Statement>;
+
+  explicit StatementRegistry(std::size_t max_size);
+
+  /// Returns the statement registered by any connection or nullptr,
+  /// counts the statement being prepared once more
+  StatementPtr Find(Connection::StatementId id);
+
+  /// Registers a statement prepared by a connection
+  void Add(Connection::StatementId id, Statement statement);
+
+  /// Returns up to `count` most frequently prepared statements
+  std::vector<StatementPtr> GetMostPrepared(std::size_t count) const;
+
+  /// Forgets all the statements, e.g. after a schema change
+  void Clear();
+
+ private:
+  struct Entry {
+    StatementPtr statement;
+    std::size_t prepare_count{0};
+  };
+
+  using Storage = cache::LruMap<Connection::StatementId, Entry>;
+
+  mutable concurrent::Variable<Storage, engine::Mutex> storage_;
+};
+
+}  // namespace storages::postgres::detail
+
+USERVER_NAMESPACE_END
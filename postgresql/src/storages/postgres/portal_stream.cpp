@@ -0,0 +1,118 @@
+#include <userver/storages/postgres/portal_stream.hpp>
+
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
+
+#include <userver/storages/postgres/exceptions.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace storages::postgres {
+
+struct PortalStream::Impl {
+  using Queue = concurrent::SpscQueue<std::optional<ResultSet>>;
+
+  Portal portal;
+  const std::uint32_t chunk_size;
+  std::size_t fetched_so_far{0};
+  bool done{false};
+
+  std::optional<Queue::Consumer> consumer;
+  engine::TaskWithResult<void> prefetch_task;
+
+  Impl(Portal&& portal, std::uint32_t chunk_size, std::size_t prefetch_chunks)
+      : portal{std::move(portal)}, chunk_size{chunk_size} {
+    if (!chunk_size) {
+      throw LogicError{"Portal stream chunk size must be greater than 0"};
+    }
+    if (prefetch_chunks) {
+      auto queue = Queue::Create(prefetch_chunks);
+      consumer.emplace(queue->GetConsumer());
+      // The portal is used by the background task only from now on
+      prefetch_task = USERVER_NAMESPACE::utils::Async(
+          "pg_portal_prefetch", [this, producer = queue->GetProducer()] {
+            while (this->portal) {
+              auto res = this->portal.Fetch(this->chunk_size);
+              if (res.IsEmpty() || !producer.Push(std::move(res))) break;
+            }
+          });
+    }
+  }
+
+  ~Impl() {
+    if (prefetch_task.IsValid()) {
+      // The producer stops after the fetch in progress, it is not cancelled
+      // to keep the connection usable
+      std::move(*consumer).Reset();
+      const engine::TaskCancellationBlocker block_cancel;
+      prefetch_task.Wait();
+    }
+  }
+
+  std::optional<ResultSet> Next() {
+    if (done) return std::nullopt;
+    auto res = prefetch_task.IsValid() ? Pop() : Fetch();
+    if (!res) {
+      done = true;
+      return std::nullopt;
+    }
+    fetched_so_far += res->Size();
+    return res;
+  }
+
+  std::optional<ResultSet> Fetch() {
+    if (!portal) return std::nullopt;
+    auto res = portal.Fetch(chunk_size);
+    if (res.IsEmpty()) return std::nullopt;
+    return res;
+  }
+
+  std::optional<ResultSet> Pop() {
+    std::optional<ResultSet> res;
+    if (consumer->Pop(res)) return res;
+    // The producer is gone: the portal is exhausted or the fetch failed
+    done = true;
+    prefetch_task.Get();
+    return std::nullopt;
+  }
+};
+
+PortalStream::PortalStream(Portal&& portal, std::uint32_t chunk_size,
+                           std::size_t prefetch_chunks)
+    : pimpl_{std::make_unique<Impl>(std::move(portal), chunk_size,
+                                    prefetch_chunks)} {}
+
+PortalStream::PortalStream(PortalStream&&) noexcept = default;
+PortalStream& PortalStream::operator=(PortalStream&&) noexcept = default;
+PortalStream::~PortalStream() = default;
+
+std::optional<ResultSet> PortalStream::Next() {
+  UASSERT(pimpl_);
+  return pimpl_->Next();
+}
+
+bool PortalStream::Done() const { return pimpl_->done; }
+
+std::size_t PortalStream::FetchedSoFar() const {
+  return pimpl_->fetched_so_far;
+}
+
+PortalStream::Iterator PortalStream::begin() { return Iterator{*this}; }
+
+PortalStream::Iterator PortalStream::end() { return Iterator{}; }
+
+PortalStream::Iterator::Iterator(PortalStream& stream)
+    : stream_{&stream}, chunk_{stream.Next()} {}
+
+PortalStream::Iterator& PortalStream::Iterator::operator++() {
+  UASSERT(stream_);
+  chunk_ = stream_->Next();
+  return *this;
+}
+
+}  // namespace storages::postgres
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include <storages/postgres/postgres_config.hpp>
 
+#include <cstdint>
+
 #include <userver/logging/log.hpp>
 
 #include <storages/postgres/experiments.hpp>
@@ -76,6 +78,10 @@ ConnectionSettings ParseConnectionSettings(const ConfigType& config) {
           ? ConnectionSettings::kDiscardAll
           : ConnectionSettings::kDiscardNone;
 
+  settings.prepare_on_connect =
+      config["prepare-hot-statements-on-connect"].template As<size_t>(
+          settings.prepare_on_connect);
+
   return settings;
 }
 
@@ -116,11 +122,20 @@ PoolSettings ParsePoolSettings(const ConfigType& config) {
       config["max_queue_size"].template As<size_t>(result.max_queue_size);
   result.connecting_limit =
       config["connecting_limit"].template As<size_t>(result.connecting_limit);
+  result.auto_batch_window = std::chrono::microseconds{
+      config["auto_batch_window_us"].template As<std::int64_t>(
+          result.auto_batch_window.count())};
+  result.auto_batch_max_size = config["auto_batch_max_size"].template As<size_t>(
+      result.auto_batch_max_size);
 
   if (result.max_size == 0)
     throw InvalidConfig{"max_pool_size must be greater than 0"};
   if (result.max_size < result.min_size)
     throw InvalidConfig{"max_pool_size cannot be less than min_pool_size"};
+  if (result.auto_batch_window.count() < 0)
+    throw InvalidConfig{"auto_batch_window_us cannot be less than 0"};
+  if (result.auto_batch_max_size == 0)
+    throw InvalidConfig{"auto_batch_max_size must be greater than 0"};
 
   return result;
 }
@@ -1,7 +1,10 @@
 #include <userver/storages/postgres/result_set.hpp>
 
+#include <cstdint>
+#include <cstring>
 #include <string_view>
 
+#include <boost/endian/conversion.hpp>
 #include <fmt/format.h>
 
 #include <storages/postgres/detail/result_wrapper.hpp>
@@ -33,6 +36,16 @@ constexpr std::string_view kUnknownTypeErrorMessageTemplate =
     "the type and probably altering a table was run while service up, the only "
     "way to fix this is to restart the service.";
 
+template <typename UInt>
+void BigToNative(char* data, std::size_t count) {
+  for (std::size_t i = 0; i < count; ++i, data += sizeof(UInt)) {
+    UInt value{};
+    std::memcpy(&value, data, sizeof(UInt));
+    value = boost::endian::big_to_native(value);
+    std::memcpy(data, &value, sizeof(UInt));
+  }
+}
+
 }  // namespace
 
 //----------------------------------------------------------------------------
@@ -252,6 +265,42 @@ void ResultSet::SetBufferCategoriesFrom(const ResultSet& dsc) {
   pimpl_->SetTypeBufferCategories(*dsc.pimpl_);
 }
 
+ResultSet::size_type ResultSet::IndexOfColumn(
+    const std::string& column_name) const {
+  const auto index = pimpl_->IndexOfName(column_name);
+  if (index == npos) throw FieldNameDoesntExist{column_name};
+  return index;
+}
+
+FieldView ResultSet::GetFieldView(size_type row_index,
+                                  size_type column_index) const {
+  return FieldView{*pimpl_, row_index, column_index};
+}
+
+bool ResultSet::ReadFixedWidthColumn(size_type column_index, std::size_t width,
+                                     void* values) const {
+  auto* data = static_cast<char*>(values);
+  if (!pimpl_->CopyFixedWidthColumn(column_index, width, data)) return false;
+
+  // A separate pass over the contiguous values is vectorized
+  switch (width) {
+    case 1:
+      break;
+    case 2:
+      BigToNative<std::uint16_t>(data, Size());
+      break;
+    case 4:
+      BigToNative<std::uint32_t>(data, Size());
+      break;
+    case 8:
+      BigToNative<std::uint64_t>(data, Size());
+      break;
+    default:
+      UINVARIANT(false, fmt::format("Unexpected column value size {}", width));
+  }
+  return true;
+}
+
 Row::size_type Row::IndexOfName(const std::string& name) const {
   return res_->IndexOfName(name);
 }
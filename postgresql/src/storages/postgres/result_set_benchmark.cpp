@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+
+#include <storages/postgres/util_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+namespace pg = storages::postgres;
+using namespace pg::bench;
+
+const pg::Query kSelectBigints{
+    "select i::bigint from generate_series(1, $1) i"};
+const pg::Query kSelectTimestamps{
+    "select timestamp '2000-01-01' + i * interval '1 second' from "
+    "generate_series(1, $1) i"};
+
+template <typename T>
+void ExtractContainer(pg::detail::Connection& conn, benchmark::State& state,
+                      const pg::Query& query) {
+  const auto res =
+      conn.Execute(query, static_cast<pg::Integer>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(res.AsContainer<std::vector<T>>());
+  }
+  state.SetItemsProcessed(state.iterations() * res.Size());
+}
+
+template <typename T>
+void ExtractColumn(pg::detail::Connection& conn, benchmark::State& state,
+                   const pg::Query& query) {
+  const auto res =
+      conn.Execute(query, static_cast<pg::Integer>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(res.AsColumn<T>(0));
+  }
+  state.SetItemsProcessed(state.iterations() * res.Size());
+}
+
+BENCHMARK_DEFINE_F(PgConnection, BigintAsContainer)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    ExtractContainer<pg::Bigint>(GetConnection(), state, kSelectBigints);
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, BigintAsContainer)
+    ->RangeMultiplier(10)
+    ->Range(100, 1'000'000);
+
+BENCHMARK_DEFINE_F(PgConnection, BigintAsColumn)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    ExtractColumn<pg::Bigint>(GetConnection(), state, kSelectBigints);
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, BigintAsColumn)
+    ->RangeMultiplier(10)
+    ->Range(100, 1'000'000);
+
+BENCHMARK_DEFINE_F(PgConnection, TimestampAsContainer)
+(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    ExtractContainer<pg::TimePoint>(GetConnection(), state, kSelectTimestamps);
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, TimestampAsContainer)
+    ->RangeMultiplier(10)
+    ->Range(100, 1'000'000);
+
+BENCHMARK_DEFINE_F(PgConnection, TimestampAsColumn)(benchmark::State& state) {
+  RunStandalone(state, [this, &state] {
+    ExtractColumn<pg::TimePoint>(GetConnection(), state, kSelectTimestamps);
+  });
+}
+BENCHMARK_REGISTER_F(PgConnection, TimestampAsColumn)
+    ->RangeMultiplier(10)
+    ->Range(100, 1'000'000);
+
+}  // namespace
+
+USERVER_NAMESPACE_END
@@ -36,6 +36,18 @@ void DumpMetric(USERVER_NAMESPACE::utils::statistics::Writer& writer,
     query["executed"] = stats.transaction.execute_total;
     query["replies"] = stats.transaction.reply_total;
   }
+  if (auto batching = writer["auto-batching"]) {
+    batching["batches"] = stats.batching.batches_total;
+    batching["queries"] = stats.batching.queries_total;
+    batching["fallbacks"] = stats.batching.fallback_total;
+    batching["batch-size"] = stats.batching.batch_size;
+  }
+  if (auto shared = writer["shared-statements"]) {
+    shared["describes-saved"] = stats.shared_statements.describe_saved_total;
+    shared["prepared-on-connect"] =
+        stats.shared_statements.prepared_on_connect_total;
+    shared["describe-time-us"] = stats.shared_statements.describe_time;
+  }
 
   if (auto errors = writer["errors"]) {
     constexpr std::string_view kPostgresqlError = "postgresql_error";
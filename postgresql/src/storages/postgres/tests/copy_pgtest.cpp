@@ -0,0 +1,128 @@
+#include <storages/postgres/tests/util_pgtest.hpp>
+
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <storages/postgres/detail/connection.hpp>
+#include <userver/storages/postgres/io/floating_point_types.hpp>
+#include <userver/storages/postgres/io/optional.hpp>
+#include <userver/storages/postgres/io/string_types.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+struct CopyRow {
+  pg::Integer id{};
+  std::string name;
+  std::optional<double> value;
+};
+
+std::vector<CopyRow> MakeRows(int count) {
+  std::vector<CopyRow> rows;
+  for (int i = 0; i < count; ++i) {
+    rows.push_back({i, "name" + std::to_string(i),
+                    i % 3 ? std::optional<double>{i * 0.5} : std::nullopt});
+  }
+  return rows;
+}
+
+const pg::Query kCreateTable{
+    "create temporary table copy_test(id integer, name text, value double "
+    "precision)"};
+
+}  // namespace
+
+UTEST_P(PostgreConnection, CopyRoundTrip) {
+  CheckConnection(GetConn());
+  UASSERT_NO_THROW(GetConn()->Execute(kCreateTable));
+
+  const auto rows = MakeRows(10000);
+  pg::Transaction trx{std::move(GetConn())};
+
+  /// [CopyFrom]
+  const auto copied = trx.CopyFrom(
+      "copy copy_test(id, name, value) from stdin (format binary)", rows,
+      /*chunk_size=*/4096);
+  /// [CopyFrom]
+  EXPECT_EQ(copied, rows.size());
+
+  auto res = trx.Execute("select count(*), count(value) from copy_test");
+  EXPECT_EQ(res[0][0].As<pg::Bigint>(), rows.size());
+  EXPECT_EQ(res[0][1].As<pg::Bigint>(), rows.size() - (rows.size() + 2) / 3);
+
+  /// [CopyTo]
+  std::vector<CopyRow> read_rows;
+  trx.CopyTo<CopyRow>(
+      "copy (select id, name, value from copy_test order by id) to stdout "
+      "(format binary)",
+      [&read_rows](CopyRow&& row) { read_rows.push_back(std::move(row)); });
+  /// [CopyTo]
+  ASSERT_EQ(read_rows.size(), rows.size());
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    EXPECT_EQ(read_rows[i].id, rows[i].id);
+    EXPECT_EQ(read_rows[i].name, rows[i].name);
+    EXPECT_EQ(read_rows[i].value, rows[i].value);
+  }
+
+  std::vector<std::string> names;
+  EXPECT_EQ(trx.CopyTo<std::string>(
+                "copy (select name from copy_test where id < 3) to stdout "
+                "(format binary)",
+                [&names](std::string&& name) { names.push_back(name); }),
+            3);
+  EXPECT_EQ(names.size(), 3);
+
+  UEXPECT_NO_THROW(trx.Commit());
+}
+
+UTEST_P(PostgreConnection, CopyErrors) {
+  CheckConnection(GetConn());
+  UASSERT_NO_THROW(GetConn()->Execute(kCreateTable));
+
+  const auto rows = MakeRows(10);
+  pg::Transaction trx{std::move(GetConn())};
+
+  UEXPECT_THROW(trx.CopyFrom("select 1", rows), pg::LogicError);
+
+  trx.Execute("savepoint copy_errors");
+  // the server rejects the rows with extra columns
+  UEXPECT_THROW(
+      trx.CopyFrom("copy copy_test(id, name) from stdin (format binary)", rows),
+      pg::Error);
+  trx.Execute("rollback to savepoint copy_errors");
+
+  EXPECT_EQ(trx.CopyFrom("copy copy_test from stdin (format binary)", rows,
+                         /*chunk_size=*/64),
+            rows.size());
+  trx.Execute("savepoint copy_to_errors");
+
+  // the text format is not supported
+  UEXPECT_THROW(trx.CopyTo<std::string>("copy copy_test(name) to stdout",
+                                        [](std::string&&) {}),
+                pg::InvalidBinaryBuffer);
+  trx.Execute("rollback to savepoint copy_to_errors");
+
+  int consumed = 0;
+  UEXPECT_THROW(
+      trx.CopyTo<CopyRow>("copy copy_test to stdout (format binary)",
+                          [&consumed](CopyRow&&) {
+                            if (++consumed == 2) {
+                              throw std::runtime_error{"consumer failure"};
+                            }
+                          }),
+      std::runtime_error);
+  EXPECT_EQ(consumed, 2);
+  trx.Execute("rollback to savepoint copy_to_errors");
+
+  // the connection is usable after the failures
+  auto res = trx.Execute("select count(*) from copy_test");
+  EXPECT_EQ(res[0][0].As<pg::Bigint>(), rows.size());
+  UEXPECT_NO_THROW(trx.Commit());
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/storages/postgres/copy.hpp>
+#include <userver/storages/postgres/io/floating_point_types.hpp>
+#include <userver/storages/postgres/io/optional.hpp>
+#include <userver/storages/postgres/io/string_types.hpp>
+#include <userver/utest/assert_macros.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace pg = storages::postgres;
+
+namespace {
+
+const pg::UserTypes types;
+
+struct CopyRow {
+  pg::Integer id{};
+  std::string name;
+  std::optional<double> value;
+
+  bool operator==(const CopyRow& other) const {
+    return id == other.id && name == other.name && value == other.value;
+  }
+};
+
+std::vector<CopyRow> MakeRows(int count) {
+  std::vector<CopyRow> rows;
+  for (int i = 0; i < count; ++i) {
+    rows.push_back({i, "name" + std::to_string(i),
+                    i % 3 ? std::optional<double>{i * 0.5} : std::nullopt});
+  }
+  return rows;
+}
+
+template <typename Container>
+std::vector<pg::detail::CopyBuffer> EncodeRows(const Container& rows,
+                                               std::size_t chunk_size) {
+  std::vector<pg::detail::CopyBuffer> chunks;
+  pg::detail::CopyRowsWriter<Container> writer{types, rows, chunk_size};
+  pg::detail::CopyBuffer buffer;
+  while (writer(buffer)) chunks.push_back(std::exchange(buffer, {}));
+  return chunks;
+}
+
+template <typename T>
+std::vector<T> DecodeRows(std::string_view data, std::size_t piece_size) {
+  std::vector<T> rows;
+  pg::detail::CopyBinaryReader reader;
+  const auto read_row = [&rows](std::string_view tuple) {
+    T row{};
+    pg::detail::ReadCopyRow(types, tuple, row);
+    rows.push_back(std::move(row));
+  };
+  for (std::size_t pos = 0; pos < data.size(); pos += piece_size) {
+    reader.Feed(data.substr(pos, piece_size), read_row);
+  }
+  EXPECT_TRUE(reader.IsFinished());
+  return rows;
+}
+
+std::string Join(const std::vector<pg::detail::CopyBuffer>& chunks) {
+  std::string data;
+  for (const auto& chunk : chunks) data.append(chunk.data(), chunk.size());
+  return data;
+}
+
+}  // namespace
+
+TEST(PostgreCopy, RoundTrip) {
+  const auto rows = MakeRows(100);
+  const auto data = Join(EncodeRows(rows, pg::kDefaultCopyChunkSize));
+
+  // the data is split at arbitrary points, as the server does
+  for (const std::size_t piece_size : {1, 3, 17, 4096}) {
+    EXPECT_EQ(DecodeRows<CopyRow>(data, piece_size), rows) << piece_size;
+  }
+}
+
+TEST(PostgreCopy, Chunks) {
+  const auto rows = MakeRows(1000);
+  constexpr std::size_t kChunkSize = 1024;
+  const auto chunks = EncodeRows(rows, kChunkSize);
+
+  ASSERT_GT(chunks.size(), 1);
+  for (const auto& chunk : chunks) {
+    // a chunk is exceeded by at most a single row
+    EXPECT_LT(chunk.size(), kChunkSize + 64);
+  }
+  EXPECT_EQ(DecodeRows<CopyRow>(Join(chunks), 100), rows);
+}
+
+TEST(PostgreCopy, SingleColumn) {
+  const std::vector<std::string> rows{"a", "", "bc"};
+  const auto data = Join(EncodeRows(rows, pg::kDefaultCopyChunkSize));
+  EXPECT_EQ(DecodeRows<std::string>(data, 5), rows);
+
+  const std::vector<pg::Integer> no_rows;
+  EXPECT_TRUE(
+      DecodeRows<pg::Integer>(Join(EncodeRows(no_rows, 1)), 1).empty());
+}
+
+TEST(PostgreCopy, ColumnMismatch) {
+  const auto data =
+      Join(EncodeRows(MakeRows(1), pg::kDefaultCopyChunkSize));
+  UEXPECT_THROW(DecodeRows<std::string>(data, data.size()),
+                pg::NonSingleColumnResultSet);
+}
+
+TEST(PostgreCopy, InvalidData) {
+  pg::detail::CopyBinaryReader reader;
+  const auto read_row = [](std::string_view) { FAIL(); };
+  UEXPECT_THROW(reader.Feed("1\tname\n2\tname\n3\tname\n", read_row),
+                pg::InvalidBinaryBuffer);
+
+  const auto data = Join(EncodeRows(MakeRows(1), pg::kDefaultCopyChunkSize));
+  pg::detail::CopyBinaryReader trailing_reader;
+  UEXPECT_THROW(trailing_reader.Feed(data + "\xff\xff",
+                                     [](std::string_view) {}),
+                pg::InvalidBinaryBuffer);
+}
+
+USERVER_NAMESPACE_END
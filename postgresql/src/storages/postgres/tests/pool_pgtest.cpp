@@ -9,6 +9,7 @@
 #include <engine/task/task_processor.hpp>
 #include <storages/postgres/detail/connection.hpp>
 #include <storages/postgres/detail/pool.hpp>
+#include <storages/postgres/detail/statement_registry.hpp>
 #include <storages/postgres/postgres_config.hpp>
 #include <userver/dynamic_config/test_helpers.hpp>
 #include <userver/storages/postgres/dsn.hpp>
@@ -458,6 +459,129 @@ UTEST_P(PostgrePool, ForQueryQueueBeingNonTransactional) {
   EXPECT_EQ(inserted_values.front(), 1);
 }
 
+UTEST_P(PostgrePool, AutoBatching) {
+  if (GetParam() != pg::InitMode::kSync) {
+    return;
+  }
+
+  pg::PoolSettings settings{1, 1, 10};
+  settings.auto_batch_window = std::chrono::milliseconds{50};
+  settings.auto_batch_max_size = 4;
+  auto pool = pg::detail::ConnectionPool::Create(
+      GetDsnFromEnv(), nullptr, GetTaskProcessor(), "", GetParam(), settings,
+      kPipelineEnabled, {}, GetTestCmdCtls(), {}, {}, {},
+      dynamic_config::GetDefaultSource());
+
+  constexpr int kStatements = 8;
+  constexpr int kFailedStatement = 3;
+  std::vector<engine::TaskWithResult<int>> tasks;
+  for (int i = 0; i < kStatements; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&pool, i] {
+      pg::detail::StaticQueryParameters<2> params;
+      const int divisor = i == kFailedStatement ? 0 : 1;
+      auto res = pool->ExecuteBatched(
+          {}, "select $1 / $2", [&](const pg::UserTypes& types) {
+            params.Write(types, i, divisor);
+            return pg::detail::QueryParameters{params};
+          });
+      return res.AsSingleRow<int>();
+    }));
+  }
+
+  for (int i = 0; i < kStatements; ++i) {
+    if (i == kFailedStatement) {
+      UEXPECT_THROW(tasks[i].Get(), pg::Error);
+    } else {
+      EXPECT_EQ(tasks[i].Get(), i);
+    }
+  }
+
+  const auto& stats = pool->GetStatistics();
+  EXPECT_EQ(stats.batching.queries_total, kStatements);
+  EXPECT_LT(stats.batching.batches_total, kStatements);
+}
+
+UTEST_P(PostgrePool, SharedStatements) {
+  if (GetParam() != pg::InitMode::kSync) {
+    return;
+  }
+
+  const pg::Query kQuery{"select $1::integer + 1"};
+  auto conn_settings = kPipelineEnabled;
+  conn_settings.prepare_on_connect = 1;
+  const auto registry = std::make_shared<pg::detail::StatementRegistry>(
+      conn_settings.max_prepared_cache_size);
+  const auto make_pool = [&] {
+    return pg::detail::ConnectionPool::Create(
+        GetDsnFromEnv(), nullptr, GetTaskProcessor(), "", GetParam(),
+        {1, 1, 10}, conn_settings, {}, GetTestCmdCtls(), {}, {}, {},
+        dynamic_config::GetDefaultSource(), registry);
+  };
+  const auto execute = [&kQuery](pg::detail::ConnectionPool& pool) {
+    auto trx = pool.Begin({});
+    EXPECT_EQ(trx.Execute(kQuery, 1).AsSingleRow<int>(), 2);
+    trx.Commit();
+  };
+
+  auto first_pool = make_pool();
+  const bool is_pipeline_active =
+      first_pool->Acquire(MakeDeadline())->IsPipelineActive();
+  execute(*first_pool);
+  // the statement is described in its parse round trip
+  EXPECT_EQ(first_pool->GetStatistics().shared_statements.describe_saved_total,
+            is_pipeline_active ? 1 : 0);
+
+  // the statement is prepared before it is executed
+  auto second_pool = make_pool();
+  execute(*second_pool);
+  const auto& stats = second_pool->GetStatistics();
+  EXPECT_EQ(stats.shared_statements.prepared_on_connect_total, 1);
+  EXPECT_EQ(stats.transaction.parse_total, 1);
+}
+
+UTEST_P(PostgrePool, SharedStatementsAfterSchemaChange) {
+  if (GetParam() != pg::InitMode::kSync) {
+    return;
+  }
+
+  const pg::Query kQuery{"select * from shared_statements_test"};
+  auto conn_settings = kPipelineEnabled;
+  conn_settings.prepare_on_connect = 1;
+  const auto registry = std::make_shared<pg::detail::StatementRegistry>(
+      conn_settings.max_prepared_cache_size);
+  const auto make_pool = [&] {
+    return pg::detail::ConnectionPool::Create(
+        GetDsnFromEnv(), nullptr, GetTaskProcessor(), "", GetParam(),
+        {1, 1, 10}, conn_settings, {}, GetTestCmdCtls(), {}, {}, {},
+        dynamic_config::GetDefaultSource(), registry);
+  };
+  const auto execute = [](pg::detail::ConnectionPool& pool,
+                          const pg::Query& query) {
+    auto trx = pool.Begin({});
+    auto res = trx.Execute(query);
+    trx.Commit();
+    return res;
+  };
+
+  auto first_pool = make_pool();
+  execute(*first_pool, "drop table if exists shared_statements_test");
+  execute(*first_pool, "create table shared_statements_test(a integer)");
+  execute(*first_pool, "insert into shared_statements_test values (1)");
+  const auto old_res = execute(*first_pool, kQuery);
+  EXPECT_EQ(old_res.Front().Size(), 1);
+
+  execute(*first_pool,
+          "alter table shared_statements_test add column b text default 'b'");
+
+  // the statement prepared after the schema change gets the new description
+  auto second_pool = make_pool();
+  const auto res = execute(*second_pool, kQuery);
+  ASSERT_EQ(res.Front().Size(), 2);
+  EXPECT_EQ(res.Front()[1].As<std::string>(), "b");
+
+  execute(*second_pool, "drop table shared_statements_test");
+}
+
 INSTANTIATE_UTEST_SUITE_P(
     PoolTests, PostgrePool,
     ::testing::Values(pg::InitMode::kAsync, pg::InitMode::kSync),
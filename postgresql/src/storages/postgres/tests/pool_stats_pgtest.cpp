@@ -129,6 +129,33 @@ UTEST_F(PostgrePoolStats, RunSingleTransaction) {
   EXPECT_NE(stats.find(statement_name), stats.end());
 }
 
+UTEST_F(PostgrePoolStats, RunBatchedStatements) {
+  pg::PoolSettings settings{1, 10, 10};
+  settings.auto_batch_window = std::chrono::milliseconds{50};
+  settings.auto_batch_max_size = 4;
+  auto pool = pg::detail::ConnectionPool::Create(
+      GetDsnFromEnv(), nullptr, GetTaskProcessor(), "",
+      storages::postgres::InitMode::kAsync, settings, kPipelineEnabled, {10},
+      GetTestCmdCtls(), {}, {}, {}, dynamic_config::GetDefaultSource());
+
+  const std::string statement_name = "statement_name";
+  const auto query = pg::Query{"select 1", pg::Query::Name{statement_name}};
+
+  std::vector<engine::TaskWithResult<void>> tasks;
+  for (std::size_t i = 0; i < settings.auto_batch_max_size; ++i) {
+    tasks.push_back(engine::AsyncNoSpan([&pool, &query] {
+      pool->ExecuteBatched({}, query, [](const pg::UserTypes&) {
+        return pg::detail::QueryParameters{};
+      });
+    }));
+  }
+  for (auto& task : tasks) UEXPECT_NO_THROW(task.Get());
+
+  pool->GetStatementTimingsStorage().WaitForExhaustion();
+  const auto stats = pool->GetStatementTimingsStorage().GetTimingsPercentiles();
+  EXPECT_NE(stats.find(statement_name), stats.end());
+}
+
 UTEST_F(PostgrePoolStats, RunTransactions) {
   auto pool = pg::detail::ConnectionPool::Create(
       GetDsnFromEnv(), nullptr, GetTaskProcessor(), "",
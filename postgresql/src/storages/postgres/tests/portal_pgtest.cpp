@@ -1,9 +1,16 @@
 #include <storages/postgres/tests/util_pgtest.hpp>
 
+#include <unordered_map>
+
+#include <userver/cache/chunked_update.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/task/cancel.hpp>
+
 #include <storages/postgres/detail/connection.hpp>
 #include <userver/storages/postgres/io/pg_types.hpp>
 #include <userver/storages/postgres/parameter_store.hpp>
 #include <userver/storages/postgres/portal.hpp>
+#include <userver/storages/postgres/portal_stream.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -289,6 +296,136 @@ UTEST_P(PostgreConnection, PortalParallel) {
   EXPECT_EQ(second.FetchedSoFar(), kIterations);
 }
 
+UTEST_P(PostgreConnection, PortalStream) {
+  constexpr int kRows = 1000;
+  constexpr std::uint32_t kChunkSize = 64;
+
+  CheckConnection(GetConn());
+  pg::Transaction trx{std::move(GetConn())};
+
+  for (const std::size_t prefetch_chunks : {0, 1, 3}) {
+    /// [PortalStream]
+    pg::PortalStream stream{
+        trx.MakePortal("SELECT generate_series(1, $1)", kRows), kChunkSize,
+        prefetch_chunks};
+    int expected = 0;
+    for (const auto& chunk : stream) {
+      for (const auto& row : chunk) {
+        EXPECT_EQ(row[0].As<int>(), ++expected);
+      }
+    }
+    /// [PortalStream]
+    EXPECT_EQ(expected, kRows);
+    EXPECT_TRUE(stream.Done());
+    EXPECT_EQ(stream.FetchedSoFar(), kRows);
+    EXPECT_FALSE(stream.Next());
+  }
+
+  // the chunk size divides the number of rows
+  pg::PortalStream stream{
+      trx.MakePortal("SELECT generate_series(1, $1)",
+                     static_cast<int>(kChunkSize * 2)),
+      kChunkSize};
+  EXPECT_EQ(stream.Next()->Size(), kChunkSize);
+  EXPECT_EQ(stream.Next()->Size(), kChunkSize);
+  EXPECT_FALSE(stream.Next());
+
+  UEXPECT_NO_THROW(trx.Commit());
+}
+
+UTEST_P(PostgreConnection, PortalStreamErrors) {
+  CheckConnection(GetConn());
+  pg::Transaction trx{std::move(GetConn())};
+
+  UEXPECT_THROW(
+      pg::PortalStream(trx.MakePortal("SELECT generate_series(1, 10)"), 0),
+      pg::LogicError);
+
+  {
+    // the stream is destroyed before the portal is exhausted
+    pg::PortalStream stream{trx.MakePortal("SELECT generate_series(1, 1000)"),
+                            10, 2};
+    EXPECT_EQ(stream.Next()->Size(), 10);
+  }
+  auto result = trx.Execute("SELECT 1");
+  EXPECT_EQ(result.AsSingleRow<int>(), 1);
+
+  pg::PortalStream stream{
+      trx.MakePortal("SELECT 1 / (50 - i) FROM generate_series(1, 100) i"),
+      10};
+  UEXPECT_THROW(
+      {
+        while (stream.Next()) {
+        }
+      },
+      pg::DataException);
+  EXPECT_TRUE(stream.Done());
+}
+
+// The full update of a PostgreCache with full-update-parallel-chunks
+UTEST_P(PostgreConnection, PortalStreamParallelChunks) {
+  constexpr int kRows = 1000;
+  constexpr std::uint32_t kChunkSize = 64;
+  constexpr std::size_t kChunks = (kRows + kChunkSize - 1) / kChunkSize;
+  using Row = std::tuple<int, std::string>;
+
+  CheckConnection(GetConn());
+  pg::Transaction trx{std::move(GetConn())};
+
+  for (const std::size_t parallel_chunks : {0, 1, 3}) {
+    cache::impl::Statistics stats;
+    std::unordered_map<int, std::string> data;
+    {
+      cache::UpdateStatisticsScope stats_scope(stats, cache::UpdateType::kFull);
+      pg::PortalStream chunks{
+          trx.MakePortal("SELECT i, i::text FROM generate_series(1, $1) i",
+                         kRows),
+          kChunkSize, 2};
+      cache::ChunkedUpdate<std::vector<Row>> chunked_update{
+          parallel_chunks, stats_scope, [&data](std::vector<Row>&& rows) {
+            for (auto& [id, text] : rows) data[id] = std::move(text);
+          }};
+      while (auto res = chunks.Next()) {
+        chunked_update.Push([res = std::move(*res)] {
+          auto rows = res.AsSetOf<Row>(pg::kRowTag);
+          return std::vector<Row>(rows.begin(), rows.end());
+        });
+      }
+      chunked_update.Finish();
+      stats_scope.Finish(data.size());
+    }
+
+    ASSERT_EQ(data.size(), kRows) << parallel_chunks;
+    for (int i = 1; i <= kRows; ++i) EXPECT_EQ(data[i], std::to_string(i));
+    EXPECT_EQ(stats.full_update.documents_chunks_count.Load().value, kChunks);
+  }
+
+  UEXPECT_NO_THROW(trx.Commit());
+}
+
+UTEST_P(PostgreConnection, PortalStreamAbandoned) {
+  CheckConnection(GetConn());
+  pg::Transaction trx{std::move(GetConn())};
+
+  for (const std::size_t prefetch_chunks : {1, 3}) {
+    pg::PortalStream stream{trx.MakePortal("SELECT generate_series(1, 1000)"),
+                            10, prefetch_chunks};
+    EXPECT_EQ(stream.Next()->Size(), 10);
+  }
+
+  // the stream waits for the fetch in progress even if the task is cancelled
+  engine::AsyncNoSpan([&trx] {
+    pg::PortalStream stream{trx.MakePortal("SELECT generate_series(1, 1000)"),
+                            10, 2};
+    EXPECT_EQ(stream.Next()->Size(), 10);
+    engine::current_task::GetCancellationToken().RequestCancel();
+  }).Get();
+
+  auto result = trx.Execute("SELECT 1");
+  EXPECT_EQ(result.AsSingleRow<int>(), 1);
+  UEXPECT_NO_THROW(trx.Commit());
+}
+
 }  // namespace
 
 USERVER_NAMESPACE_END
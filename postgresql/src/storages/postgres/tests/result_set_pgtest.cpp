@@ -1,6 +1,15 @@
 #include <storages/postgres/tests/util_pgtest.hpp>
 
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <userver/storages/postgres/io/bytea.hpp>
+#include <userver/storages/postgres/io/chrono.hpp>
+#include <userver/storages/postgres/io/optional.hpp>
 #include <userver/storages/postgres/result_set.hpp>
+#include <userver/utils/span.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -147,4 +156,79 @@ UTEST_P(PostgreConnection, ResultAsOptionalSingleRow) {
   UEXPECT_THROW(res.AsOptionalSingleRow<int>(), pg::NonSingleRowResultSet);
 }
 
+UTEST_P(PostgreConnection, ResultAsColumn) {
+  CheckConnection(GetConn());
+
+  pg::ResultSet res{nullptr};
+  UEXPECT_NO_THROW(
+      res = GetConn()->Execute(
+          "select i::smallint, i as integer, i::bigint, i / 2.0::double "
+          "precision, i % 2 = 0, 'row' || i, timestamp '2000-01-01' + i * "
+          "interval '1 second' from generate_series(0, 99) i"));
+  ASSERT_EQ(100, res.Size());
+
+  const auto smallints = res.AsColumn<pg::Smallint>(0);
+  const auto integers = res.AsColumn<pg::Integer>(1);
+  const auto bigints = res.AsColumn<pg::Bigint>(2);
+  const auto doubles = res.AsColumn<double>(3);
+  const auto bools = res.AsColumn<bool>(4);
+  const auto strings = res.AsColumn<std::string_view>(5);
+  const auto timestamps = res.AsColumn<pg::TimePoint>(6);
+  // int4 values are widened field by field
+  const auto widened = res.AsColumn<pg::Bigint>(1);
+  ASSERT_EQ(100, timestamps.size());
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(i, smallints[i]);
+    EXPECT_EQ(i, integers[i]);
+    EXPECT_EQ(i, bigints[i]);
+    EXPECT_EQ(i, widened[i]);
+    EXPECT_DOUBLE_EQ(i / 2.0, doubles[i]);
+    EXPECT_EQ(i % 2 == 0, bools[i]);
+    EXPECT_EQ("row" + std::to_string(i), strings[i]);
+    EXPECT_EQ(pg::PostgresEpochTimePoint() + std::chrono::seconds{i},
+              timestamps[i]);
+  }
+  EXPECT_EQ(integers, res.AsColumn<pg::Integer>("integer"));
+}
+
+UTEST_P(PostgreConnection, ResultAsColumnNulls) {
+  CheckConnection(GetConn());
+
+  pg::ResultSet res{nullptr};
+  UEXPECT_NO_THROW(
+      res = GetConn()->Execute(
+          "select nullif(i, 1) as value from generate_series(0, 2) i"));
+
+  UEXPECT_THROW(res.AsColumn<pg::Integer>(0), pg::FieldValueIsNull);
+  const auto values = res.AsColumn<std::optional<pg::Integer>>("value");
+  const std::vector<std::optional<pg::Integer>> expected{0, std::nullopt, 2};
+  EXPECT_EQ(expected, values);
+
+  UEXPECT_THROW(res.AsColumn<pg::Integer>(1), pg::FieldIndexOutOfBounds);
+  UEXPECT_THROW(res.AsColumn<pg::Integer>("missing"),
+                pg::FieldNameDoesntExist);
+}
+
+UTEST_P(PostgreConnection, ResultAsColumnOfSpans) {
+  CheckConnection(GetConn());
+
+  using Bytes = utils::span<const char>;
+  const std::string bytes{"\0\xff\x0a", 3};
+  pg::ResultSet res{nullptr};
+  UEXPECT_NO_THROW(
+      res = GetConn()->Execute(
+          "select $1 || i::text::bytea from generate_series(0, 9) i",
+          Bytes{bytes}));
+
+  // The spans point into the result set
+  const auto column = res.AsColumn<Bytes>(0);
+  ASSERT_EQ(10, column.size());
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(bytes + std::to_string(i),
+              std::string_view(column[i].data(), column[i].size()));
+  }
+  const auto first = res.Front().As<Bytes>();
+  EXPECT_EQ(column[0].data(), first.data());
+}
+
 USERVER_NAMESPACE_END
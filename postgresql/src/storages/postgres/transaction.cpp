@@ -79,6 +79,47 @@ ResultSet Transaction::DoExecute(const Query& query,
   return res;
 }
 
+std::size_t Transaction::DoCopyFrom(const Query& query,
+                                    detail::CopyDataProducer producer,
+                                    OptionalCommandControl statement_cmd_ctl) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "CopyFrom called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  if (!statement_cmd_ctl) {
+    statement_cmd_ctl = conn_->GetQueryCmdCtl(query.GetName());
+  }
+  auto source = conn_.GetConfigSource();
+  if (source) CheckDeadlineIsExpired(source->GetSnapshot());
+
+  detail::StatementTimer timer{query, conn_};
+  const auto rows =
+      conn_->CopyFrom(query, producer, std::move(statement_cmd_ctl));
+  timer.Account();
+  return rows;
+}
+
+std::size_t Transaction::DoCopyTo(const Query& query,
+                                  detail::CopyDataConsumer consumer,
+                                  OptionalCommandControl statement_cmd_ctl) {
+  if (!conn_) {
+    LOG_LIMITED_ERROR() << "CopyTo called after transaction finished"
+                        << logging::LogExtra::Stacktrace();
+    throw NotInTransaction("Transaction handle is not valid");
+  }
+  if (!statement_cmd_ctl) {
+    statement_cmd_ctl = conn_->GetQueryCmdCtl(query.GetName());
+  }
+  auto source = conn_.GetConfigSource();
+  if (source) CheckDeadlineIsExpired(source->GetSnapshot());
+
+  detail::StatementTimer timer{query, conn_};
+  const auto rows = conn_->CopyTo(query, consumer, std::move(statement_cmd_ctl));
+  timer.Account();
+  return rows;
+}
+
 Portal Transaction::MakePortal(const PortalName& portal_name,
                                const Query& query,
                                const detail::QueryParameters& params,
@@ -0,0 +1,314 @@
+#!/usr/bin/env python
+
+"""Renders logs written in the `binary` logging format as text.
+
+The layout is described in universal/src/logging/binary_log_format.hpp,
+keep them in sync.
+"""
+
+import argparse
+import datetime
+import json
+import struct
+import sys
+
+VERSION = 2
+
+RECORD_MARKER = struct.pack('<I', 0x5AC3B11E)
+RECORD_HEADER = struct.Struct('<4sI')
+# Larger sizes come from corrupted data
+MAX_RECORD_SIZE = 1 << 26
+READ_CHUNK_SIZE = 1 << 20
+
+LOG_LEVELS = ('TRACE', 'DEBUG', 'INFO', 'WARNING', 'ERROR', 'CRITICAL', 'NONE')
+
+INLINE_KEY = 0
+INTERNED_KEYS = {
+    1: 'module',
+    2: 'task_id',
+    3: 'thread_id',
+    4: 'text',
+    5: 'trace_id',
+    6: 'span_id',
+    7: 'parent_id',
+    8: 'link',
+    9: 'parent_link',
+    10: 'span_ref_type',
+    11: 'stopwatch_name',
+    12: 'total_time',
+    13: 'stopwatch_units',
+    14: 'start_timestamp',
+    15: '_type',
+    16: 'meta_type',
+}
+
+PART_END = 0
+PART_TEXT = 1
+PART_UNSIGNED = 2
+PART_SIGNED = 3
+PART_HEX = 4
+PART_HEX_SHORT = 5
+PART_HEX_BYTES = 6
+
+
+class DecodeError(Exception):
+    pass
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def empty(self):
+        return self.pos >= len(self.data)
+
+    def take(self, size):
+        if self.pos + size > len(self.data):
+            raise DecodeError('truncated record')
+        result = self.data[self.pos:self.pos + size]
+        self.pos += size
+        return result
+
+    def fixed(self, fmt):
+        return struct.unpack(fmt, self.take(struct.calcsize(fmt)))[0]
+
+    def varint(self):
+        result = 0
+        shift = 0
+        while True:
+            byte = self.fixed('<B')
+            result |= (byte & 0x7F) << shift
+            if not byte & 0x80:
+                return result
+            shift += 7
+
+
+def decode_value(reader):
+    parts = []
+    while True:
+        part = reader.fixed('<B')
+        if part == PART_END:
+            return ''.join(parts)
+        elif part == PART_TEXT:
+            size = reader.fixed('<I')
+            parts.append(reader.take(size).decode('utf-8', 'replace'))
+        elif part == PART_UNSIGNED:
+            parts.append(str(reader.varint()))
+        elif part == PART_SIGNED:
+            zigzag = reader.varint()
+            parts.append(str((zigzag >> 1) ^ -(zigzag & 1)))
+        elif part == PART_HEX:
+            parts.append('0x{:016X}'.format(reader.fixed('<Q')))
+        elif part == PART_HEX_SHORT:
+            parts.append('{:X}'.format(reader.varint()))
+        elif part == PART_HEX_BYTES:
+            size = reader.fixed('<B')
+            parts.append(reader.take(size).hex())
+        else:
+            raise DecodeError('unknown value part {}'.format(part))
+
+
+def decode_record(data):
+    reader = Reader(data)
+    version = reader.fixed('<B')
+    if version != VERSION:
+        raise DecodeError('unsupported format version {}'.format(version))
+
+    level = reader.fixed('<B')
+    timestamp_us = reader.fixed('<Q')
+
+    tags = []
+    while not reader.empty():
+        key_id = reader.fixed('<B')
+        if key_id == INLINE_KEY:
+            key = reader.take(reader.varint()).decode('utf-8', 'replace')
+        elif key_id in INTERNED_KEYS:
+            key = INTERNED_KEYS[key_id]
+        else:
+            raise DecodeError('unknown key id {}'.format(key_id))
+        tags.append((key, decode_value(reader)))
+
+    level_name = LOG_LEVELS[level] if level < len(LOG_LEVELS) else str(level)
+    return level_name, timestamp_us, tags
+
+
+class RecordStream:
+    """Reads records, skipping truncated and corrupted ones.
+
+    A record is accepted if it decodes and is followed by the next record
+    marker or by the end of the input, possibly with a truncated marker.
+    Otherwise the data up to the next marker is skipped.
+    """
+
+    def __init__(self, input_file):
+        self.input_file = input_file
+        self.buffer = bytearray()
+        self.eof = False
+        self.skipped = 0
+
+    def _fill(self, size):
+        while len(self.buffer) < size and not self.eof:
+            chunk = self.input_file.read(
+                max(READ_CHUNK_SIZE, size - len(self.buffer)),
+            )
+            if not chunk:
+                self.eof = True
+            self.buffer.extend(chunk)
+        return len(self.buffer) >= size
+
+    def _skip(self, size):
+        self.skipped += size
+        del self.buffer[:size]
+
+    def _is_record_end(self, position):
+        if not self._fill(position + len(RECORD_MARKER)):
+            # The end of the input or a truncated marker of the next record
+            return RECORD_MARKER.startswith(bytes(self.buffer[position:]))
+        return self.buffer.startswith(RECORD_MARKER, position)
+
+    def _try_decode(self):
+        marker, size = RECORD_HEADER.unpack_from(self.buffer)
+        assert marker == RECORD_MARKER
+        end = RECORD_HEADER.size + size
+        if size > MAX_RECORD_SIZE or not self._fill(end):
+            return None
+        try:
+            record = decode_record(bytes(self.buffer[RECORD_HEADER.size:end]))
+        except DecodeError:
+            return None
+        if not self._is_record_end(end):
+            return None
+        del self.buffer[:end]
+        return record
+
+    def __iter__(self):
+        while self._fill(1):
+            if not self.buffer.startswith(RECORD_MARKER):
+                if not self._fill(len(RECORD_MARKER)):
+                    self._skip(len(self.buffer))
+                    continue
+                next_marker = self.buffer.find(RECORD_MARKER, 1)
+                if next_marker < 0:
+                    # Keep the bytes that may start a marker
+                    next_marker = len(self.buffer) - len(RECORD_MARKER) + 1
+                self._skip(next_marker)
+                continue
+
+            record = self._try_decode() if self._fill(RECORD_HEADER.size) else None
+            if record is None:
+                self._skip(1)
+                continue
+            yield record
+
+
+def format_timestamp(timestamp_us, utc):
+    seconds, micros = divmod(timestamp_us, 1000000)
+    if utc:
+        time = datetime.datetime.utcfromtimestamp(seconds)
+    else:
+        time = datetime.datetime.fromtimestamp(seconds)
+    return '{}.{:06}'.format(time.strftime('%Y-%m-%dT%H:%M:%S'), micros)
+
+
+_VALUE_ESCAPES = {'\t': '\\t', '\r': '\\r', '\n': '\\n', '\0': '\\0'}
+
+
+def escape_value(value):
+    value = value.replace('\\', '\\\\')
+    for char, escaped in _VALUE_ESCAPES.items():
+        value = value.replace(char, escaped)
+    return value
+
+
+def escape_key(key):
+    if not any(c in '\t\r\n\0\\.=' or 'A' <= c <= 'Z' for c in key):
+        return key
+    key = escape_value(key).replace('.', '_').replace('=', '\\=')
+    return ''.join(c.lower() if 'A' <= c <= 'Z' else c for c in key)
+
+
+def render(record, output_format, utc):
+    level, timestamp_us, tags = record
+    timestamp = format_timestamp(timestamp_us, utc)
+
+    if output_format == 'json':
+        obj = {'timestamp': timestamp, 'level': level}
+        obj.update(tags)
+        return json.dumps(obj, ensure_ascii=False)
+
+    separator = ':' if output_format == 'ltsv' else '='
+    fields = [
+        'timestamp' + separator + timestamp,
+        'level' + separator + level,
+    ]
+    fields.extend(
+        escape_key(key) + separator + escape_value(value)
+        for key, value in tags
+    )
+    if output_format == 'tskv':
+        fields.insert(0, 'tskv')
+    return '\t'.join(fields)
+
+
+def process_file(input_file, output_format, utc):
+    records = RecordStream(input_file)
+    try:
+        for record in records:
+            sys.stdout.write(render(record, output_format, utc) + '\n')
+    except (KeyboardInterrupt, BrokenPipeError):
+        pass
+    sys.stdout.flush()
+    if records.skipped:
+        sys.stderr.write(
+            'Skipped {} bytes of truncated or corrupted records\n'.format(
+                records.skipped,
+            ),
+        )
+        return 1
+    return 0
+
+
+__EXAMPLES = """
+Examples:
+#1  ./binary_logs.py logs.bin | ./human_logs.py -x
+
+#2  ./binary_logs.py -f json logs.bin | jq .text
+"""
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Renders binary logs as text',
+        epilog=__EXAMPLES,
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+    )
+    parser.add_argument(
+        '-f',
+        '--format',
+        choices=('tskv', 'ltsv', 'json'),
+        default='tskv',
+        help='Output format',
+    )
+    parser.add_argument(
+        '--utc',
+        action='store_true',
+        help='Render timestamps in UTC instead of the local time zone',
+    )
+    parser.add_argument(
+        'input',
+        nargs='?',
+        default=None,
+        help='Input file or nothing to read from stdin',
+    )
+
+    args = parser.parse_args()
+
+    if args.input is None:
+        return process_file(sys.stdin.buffer, args.format, args.utc)
+    with open(args.input, 'rb') as inp:
+        return process_file(inp, args.format, args.utc)
+
+
+if __name__ == '__main__':
+    sys.exit(main())
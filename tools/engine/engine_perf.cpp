@@ -22,6 +22,7 @@ struct Config {
   size_t io_threads = 1;
   size_t cycle = 1000;
   size_t memory = 1000;
+  bool work_stealing = false;
 };
 
 struct WorkerContext {
@@ -59,6 +60,8 @@ Config ParseConfig(int argc, char* argv[]) {
        "cycle iterations")  //
       ("memory,m", po::value(&config.memory)->default_value(config.memory),
        "memory used in each coro")  //
+      ("work-stealing", po::bool_switch(&config.work_stealing),
+       "use the work stealing task queue")  //
       ;
 
   po::variables_map vm;
@@ -139,5 +142,11 @@ int main(int argc, char* argv[]) {
   LOG_WARNING() << "Starting using requests=" << config.count
                 << " coroutines=" << config.coroutines;
 
-  engine::RunStandalone(config.worker_threads, [&]() { DoWork(config); });
+  engine::TaskProcessorPoolsConfig pools_config;
+  if (config.work_stealing) {
+    pools_config.task_queue_type = engine::TaskQueueType::kWorkStealingTaskQueue;
+  }
+
+  engine::RunStandalone(config.worker_threads, pools_config,
+                        [&]() { DoWork(config); });
 }
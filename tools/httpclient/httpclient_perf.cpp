@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <list>
@@ -26,16 +28,22 @@ struct Config {
   size_t io_threads = 1;
   long timeout_ms = 1000;
   bool multiplexing = false;
+  bool wait_for_multiplexing = false;
+  size_t max_concurrent_streams = 100;
   size_t max_host_connections = 0;
   http::HttpVersion http_version = http::HttpVersion::k11;
   std::string url_file;
   bool defer_events = false;
+  size_t warmup_connections = 0;
 };
 
 struct WorkerContext {
   std::atomic<uint64_t> counter{0};
   const uint64_t print_each_counter;
   uint64_t response_len;
+  std::atomic<uint64_t> reused_connections{0};
+  std::atomic<uint64_t> new_connections{0};
+  std::atomic<uint64_t> connect_time_us{0};
 
   http::Client& http_client;
   const Config& config;
@@ -69,6 +77,12 @@ Config ParseConfig(int argc, char* argv[]) {
       "timeout,t",
       po::value(&config.timeout_ms)->default_value(config.timeout_ms),
       "request timeout in ms")("multiplexing", "enable HTTP/2 multiplexing")(
+      "wait-for-multiplexing",
+      "wait for a pending connection to multiplex on instead of opening a "
+      "new one")("max-concurrent-streams",
+                 po::value(&config.max_concurrent_streams)
+                     ->default_value(config.max_concurrent_streams),
+                 "maximum HTTP/2 streams per connection")(
       "http-version,V", po::value<std::string>(),
       "http version, possible values: 1.0, 1.1, 2.0-prior")(
       "max-host-connections",
@@ -77,7 +91,12 @@ Config ParseConfig(int argc, char* argv[]) {
       "maximum HTTP connection number to a single host")(
       "defer-events",
       po::value(&config.defer_events)->default_value(config.defer_events),
-      "whether to defer curl events to a periodic timer");
+      "whether to defer curl events to a periodic timer")(
+      "warmup-connections",
+      po::value(&config.warmup_connections)
+          ->default_value(config.warmup_connections),
+      "connections to the first URL to open in each io thread before the "
+      "requests");
 
   po::variables_map vm;
   po::store(po::parse_command_line(argc, argv, desc), vm);
@@ -89,6 +108,7 @@ Config ParseConfig(int argc, char* argv[]) {
   }
 
   if (vm.count("multiplexing")) config.multiplexing = true;
+  if (vm.count("wait-for-multiplexing")) config.wait_for_multiplexing = true;
   if (vm.count("http-version")) {
     auto value = vm["http-version"].as<std::string>();
     if (value == "1.0")
@@ -160,6 +180,16 @@ void Worker(WorkerContext& context) {
 
       auto response = request.perform();
       context.response_len += response->body().size();
+      const auto stats = response->GetStats();
+      if (stats.open_socket_count == 0) {
+        ++context.reused_connections;
+      } else {
+        ++context.new_connections;
+        context.connect_time_us +=
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                stats.time_to_connect)
+                .count();
+      }
       LOG_DEBUG() << "Got response body_size=" << response->body().size();
       auto ts3 = std::chrono::system_clock::now();
       LOG_INFO() << "timings create="
@@ -185,18 +215,29 @@ void DoWork(const Config& config, const std::vector<std::string>& urls) {
   LOG_INFO() << "Starting thread " << std::this_thread::get_id();
 
   auto& tp = engine::current_task::GetTaskProcessor();
+  http::ClientSettings settings{"", config.io_threads, config.defer_events};
+  settings.http2.multiplexing = config.multiplexing;
+  settings.http2.wait_for_multiplexing = config.wait_for_multiplexing;
+  settings.http2.max_concurrent_streams = config.max_concurrent_streams;
+  settings.http2.max_host_connections = config.max_host_connections;
+  if (config.warmup_connections > 0) {
+    settings.warmup.destinations = {{urls.front(), config.warmup_connections}};
+    settings.warmup.timeout = std::chrono::milliseconds{config.timeout_ms};
+  }
   http::Client http_client{
-      {"", config.io_threads, config.defer_events},
-      tp,
+      std::move(settings), tp,
       std::vector<utils::NotNull<clients::http::Plugin*>>{}};
   LOG_INFO() << "Client created";
 
-  http_client.SetMultiplexingEnabled(config.multiplexing);
-  if (config.max_host_connections > 0)
-    http_client.SetMaxHostConnections(config.max_host_connections);
+  const auto warmup_start = std::chrono::steady_clock::now();
+  http_client.StartWarmup();
+  http_client.WaitForWarmup();
+  const auto warmup_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                             std::chrono::steady_clock::now() - warmup_start)
+                             .count();
 
-  WorkerContext worker_context{{0},    2000, 0, std::ref(http_client),
-                               config, urls};
+  WorkerContext worker_context{{0},    2000, 0, {0}, {0}, {0},
+                               std::ref(http_client), config, urls};
 
   std::vector<engine::TaskWithResult<void>> tasks;
   tasks.resize(config.coroutines);
@@ -219,6 +260,16 @@ void DoWork(const Config& config, const std::vector<std::string>& urls) {
   LOG_CRITICAL() << "counter = " << worker_context.counter.load()
                  << " sum response body size = " << worker_context.response_len
                  << " average RPS = " << rps;
+
+  const auto new_connections = worker_context.new_connections.load();
+  LOG_CRITICAL() << "warmup = " << warmup_ms << "ms"
+                 << " reused connections = "
+                 << worker_context.reused_connections.load()
+                 << " new connections = " << new_connections
+                 << " average time to connect = "
+                 << worker_context.connect_time_us.load() /
+                        std::max<uint64_t>(new_connections, 1)
+                 << "us";
 }
 
 }  // namespace
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Count-min sketch with 4-bit counters that estimates how often the keys were
+/// accessed recently. All the counters are halved after `10 * capacity`
+/// accesses, so that the keys that were popular long ago are forgotten.
+template <typename T, typename Hash = std::hash<T>>
+class FrequencySketch final {
+ public:
+  explicit FrequencySketch(std::size_t capacity, const Hash& hash = Hash())
+      : hash_(hash) {
+    SetCapacity(capacity);
+  }
+
+  /// Resizes the sketch to track about `capacity` keys, forgets all the
+  /// recorded accesses if the size changes
+  void SetCapacity(std::size_t capacity) {
+    sample_size_ = 10 * capacity;
+
+    std::size_t width = kCountersPerWord;
+    while (width < kCountersPerKey * capacity) width <<= 1;
+    if (width == width_) return;
+
+    width_ = width;
+    table_.assign(kDepth * width_ / kCountersPerWord, 0);
+    additions_ = 0;
+  }
+
+  void RecordAccess(const T& key) {
+    const auto indices = GetIndices(key);
+    bool added = false;
+    for (const auto index : indices) added |= TryIncrement(index);
+
+    if (added && ++additions_ >= sample_size_) Age();
+  }
+
+  std::uint32_t GetFrequency(const T& key) const {
+    std::uint32_t frequency = kMaxCount;
+    for (const auto index : GetIndices(key)) {
+      const auto count = static_cast<std::uint32_t>(
+          (table_[index / kCountersPerWord] >> Shift(index)) & kMaxCount);
+      if (count < frequency) frequency = count;
+    }
+    return frequency;
+  }
+
+  void Clear() noexcept {
+    for (auto& word : table_) word = 0;
+    additions_ = 0;
+  }
+
+ private:
+  static constexpr std::size_t kDepth = 4;
+  static constexpr std::size_t kCountersPerWord = 16;
+  // row width per tracked key, keeps the collisions rare
+  static constexpr std::size_t kCountersPerKey = 4;
+  static constexpr std::uint64_t kMaxCount = 15;
+  static constexpr std::uint64_t kHalfMask = 0x7777777777777777ULL;
+
+  static std::size_t Shift(std::size_t index) noexcept {
+    return (index % kCountersPerWord) * 4;
+  }
+
+  std::array<std::size_t, kDepth> GetIndices(const T& key) const {
+    // std::hash of integers is an identity, so mix the bits before using them
+    std::uint64_t hash = hash_(key);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    const std::uint64_t step = (hash >> 32) | 1;
+
+    std::array<std::size_t, kDepth> indices{};
+    for (std::size_t row = 0; row < kDepth; ++row) {
+      indices[row] = row * width_ + ((hash + row * step) & (width_ - 1));
+    }
+    return indices;
+  }
+
+  bool TryIncrement(std::size_t index) noexcept {
+    auto& word = table_[index / kCountersPerWord];
+    const auto shift = Shift(index);
+    if (((word >> shift) & kMaxCount) == kMaxCount) return false;
+    word += std::uint64_t{1} << shift;
+    return true;
+  }
+
+  void Age() noexcept {
+    for (auto& word : table_) word = (word >> 1) & kHalfMask;
+    additions_ /= 2;
+  }
+
+  Hash hash_;
+  std::vector<std::uint64_t> table_;
+  std::size_t width_{0};
+  std::size_t sample_size_{0};
+  std::size_t additions_{0};
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
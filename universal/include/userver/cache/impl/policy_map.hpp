@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include <userver/cache/impl/lru.hpp>
+#include <userver/cache/impl/slru.hpp>
+#include <userver/cache/impl/tinylfu.hpp>
+#include <userver/cache/policy.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Key value storage with the cache::CachePolicy chosen at runtime, thread
+/// safety matches Standard Library thread safety
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class PolicyMap final {
+ public:
+  PolicyMap(CachePolicy policy, std::size_t max_size, const Hash& hash,
+            const Equal& equal)
+      : impl_(MakeImpl(policy, max_size, hash, equal)) {}
+
+  PolicyMap(PolicyMap&&) noexcept = default;
+  PolicyMap& operator=(PolicyMap&&) noexcept = default;
+
+  bool Put(const T& key, U value) {
+    return std::visit(
+        [&](auto& impl) { return impl.Put(key, std::move(value)); }, impl_);
+  }
+
+  void Erase(const T& key) {
+    std::visit([&key](auto& impl) { impl.Erase(key); }, impl_);
+  }
+
+  U* Get(const T& key) {
+    return std::visit([&key](auto& impl) { return impl.Get(key); }, impl_);
+  }
+
+  U GetOr(const T& key, const U& default_value) {
+    auto* ptr = Get(key);
+    if (ptr) return *ptr;
+    return default_value;
+  }
+
+  void SetMaxSize(std::size_t new_max_size) {
+    std::visit(
+        [new_max_size](auto& impl) {
+          if constexpr (std::is_same_v<std::decay_t<decltype(impl)>, Slru>) {
+            const SlruSizes sizes{new_max_size};
+            impl.SetMaxSize(sizes.probation_size, sizes.protected_size);
+          } else {
+            impl.SetMaxSize(new_max_size);
+          }
+        },
+        impl_);
+  }
+
+  void Clear() noexcept {
+    std::visit([](auto& impl) { impl.Clear(); }, impl_);
+  }
+
+  template <typename Function>
+  void VisitAll(Function&& func) const {
+    std::visit([&func](const auto& impl) { impl.VisitAll(func); }, impl_);
+  }
+
+  template <typename Function>
+  void VisitAll(Function&& func) {
+    std::visit([&func](auto& impl) { impl.VisitAll(func); }, impl_);
+  }
+
+  std::size_t GetSize() const {
+    return std::visit([](const auto& impl) { return impl.GetSize(); }, impl_);
+  }
+
+ private:
+  using Lru = LruBase<T, U, Hash, Equal>;
+  using Slru = SlruBase<T, U, Hash, Equal>;
+  using WTinyLfu = WTinyLfuBase<T, U, Hash, Equal>;
+  using Impl = std::variant<Lru, Slru, WTinyLfu>;
+
+  static Impl MakeImpl(CachePolicy policy, std::size_t max_size,
+                       const Hash& hash, const Equal& equal) {
+    switch (policy) {
+      case CachePolicy::kLRU:
+        return Impl{std::in_place_type<Lru>, max_size, hash, equal};
+      case CachePolicy::kSLRU: {
+        const SlruSizes sizes{max_size};
+        return Impl{std::in_place_type<Slru>, sizes.probation_size,
+                    sizes.protected_size, hash, equal};
+      }
+      case CachePolicy::kWTinyLFU:
+        return Impl{std::in_place_type<WTinyLfu>, max_size, hash, equal};
+      case CachePolicy::kClock:
+        break;
+    }
+    UINVARIANT(false, "Unsupported cache policy");
+  }
+
+  Impl impl_;
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
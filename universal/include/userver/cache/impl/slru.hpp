@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -30,6 +31,17 @@ USERVER_NAMESPACE_BEGIN
 
 namespace cache::impl {
 
+/// Sizes of the SLRU segments for the given total size,
+/// 20% of the elements are kept in the probation segment
+struct SlruSizes final {
+  explicit SlruSizes(std::size_t max_size)
+      : probation_size(std::max<std::size_t>(max_size / 5, 1)),
+        protected_size(std::max<std::size_t>(max_size - probation_size, 1)) {}
+
+  std::size_t probation_size;
+  std::size_t protected_size;
+};
+
 template <typename T, typename U, typename Hash = std::hash<T>,
           typename Equal = std::equal_to<T>>
 class SlruBase final {
@@ -77,6 +89,8 @@ class SlruBase final {
 
   std::size_t GetCapacity() const;
 
+  bool IsProbationFull() const;
+
   U& InsertNode(NodeType&& node) noexcept;
   NodeType ExtractNode(const T& key) noexcept;
 
@@ -207,6 +221,11 @@ std::size_t SlruBase<T, U, Hash, Equal>::GetCapacity() const {
   return probation_part_.GetCapacity() + protected_part_.GetCapacity();
 }
 
+template <typename T, typename U, typename Hash, typename Equal>
+bool SlruBase<T, U, Hash, Equal>::IsProbationFull() const {
+  return probation_part_.GetSize() >= probation_part_.GetCapacity();
+}
+
 template <typename T, typename U, typename Hash, typename Equal>
 U& SlruBase<T, U, Hash, Equal>::InsertNode(NodeType&& node) noexcept {
   return probation_part_.InsertNode(std::move(node));
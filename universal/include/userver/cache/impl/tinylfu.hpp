@@ -0,0 +1,207 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+#include <userver/cache/impl/frequency_sketch.hpp>
+#include <userver/cache/impl/lru.hpp>
+#include <userver/cache/impl/slru.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// W-TinyLFU cache (https://arxiv.org/abs/1512.00727).
+///
+/// New elements are put into the LRU window that takes 1% of the capacity.
+/// An element evicted from the window competes with the least used element of
+/// the SLRU main segment, and the one accessed less frequently is dropped.
+template <typename T, typename U, typename Hash = std::hash<T>,
+          typename Equal = std::equal_to<T>>
+class WTinyLfuBase final {
+ public:
+  using NodeType = std::unique_ptr<LruNode<T, U>>;
+
+  explicit WTinyLfuBase(std::size_t max_size, const Hash& hash = Hash(),
+                        const Equal& equal = Equal());
+
+  WTinyLfuBase(WTinyLfuBase&& other) noexcept = default;
+  WTinyLfuBase& operator=(WTinyLfuBase&& other) noexcept = default;
+
+  WTinyLfuBase(const WTinyLfuBase&) = delete;
+  WTinyLfuBase& operator=(const WTinyLfuBase&) = delete;
+
+  bool Put(const T& key, U value);
+
+  template <typename... Args>
+  U* Emplace(const T& key, Args&&... args);
+
+  void Erase(const T& key);
+
+  U* Get(const T& key);
+
+  void SetMaxSize(std::size_t new_max_size);
+
+  void Clear() noexcept;
+
+  template <typename Function>
+  void VisitAll(Function&& func) const;
+
+  template <typename Function>
+  void VisitAll(Function&& func);
+
+  std::size_t GetSize() const;
+
+  std::size_t GetCapacity() const;
+
+ private:
+  static std::size_t GetWindowSize(std::size_t max_size) {
+    return std::max<std::size_t>(max_size / 100, 1);
+  }
+
+  static std::size_t GetMainSize(std::size_t max_size) {
+    return std::max<std::size_t>(max_size - GetWindowSize(max_size), 1);
+  }
+
+  static SlruBase<T, U, Hash, Equal> MakeMain(std::size_t max_size,
+                                              const Hash& hash,
+                                              const Equal& equal) {
+    const SlruSizes sizes{max_size};
+    return SlruBase<T, U, Hash, Equal>(sizes.probation_size,
+                                       sizes.protected_size, hash, equal);
+  }
+
+  // Moves the least used element of the full window to the main segment if
+  // it is accessed more often than the main segment victim. Returns the
+  // dropped node, if any, to be reused.
+  NodeType MakeRoom();
+
+  FrequencySketch<T, Hash> sketch_;
+  LruBase<T, U, Hash, Equal> window_;
+  SlruBase<T, U, Hash, Equal> main_;
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+WTinyLfuBase<T, U, Hash, Equal>::WTinyLfuBase(std::size_t max_size,
+                                              const Hash& hash,
+                                              const Equal& equal)
+    : sketch_(max_size, hash),
+      window_(GetWindowSize(max_size), hash, equal),
+      main_(MakeMain(GetMainSize(max_size), hash, equal)) {}
+
+template <typename T, typename U, typename Hash, typename Equal>
+bool WTinyLfuBase<T, U, Hash, Equal>::Put(const T& key, U value) {
+  auto* const existing = Get(key);
+  if (existing) {
+    *existing = std::move(value);
+    return false;
+  }
+
+  auto node = MakeRoom();
+  if (node) {
+    node->SetKey(key);
+    node->SetValue(std::move(value));
+  } else {
+    node = std::make_unique<LruNode<T, U>>(T{key}, std::move(value));
+  }
+  window_.InsertNode(std::move(node));
+  return true;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename... Args>
+U* WTinyLfuBase<T, U, Hash, Equal>::Emplace(const T& key, Args&&... args) {
+  auto* const existing = Get(key);
+  if (existing) return existing;
+
+  MakeRoom();
+  return &window_.InsertNode(
+      std::make_unique<LruNode<T, U>>(T{key}, std::forward<Args>(args)...));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void WTinyLfuBase<T, U, Hash, Equal>::Erase(const T& key) {
+  window_.Erase(key);
+  main_.Erase(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* WTinyLfuBase<T, U, Hash, Equal>::Get(const T& key) {
+  sketch_.RecordAccess(key);
+
+  auto* const value = window_.Get(key);
+  if (value) return value;
+  return main_.Get(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void WTinyLfuBase<T, U, Hash, Equal>::SetMaxSize(std::size_t new_max_size) {
+  UASSERT(new_max_size > 0);
+  if (!new_max_size) ++new_max_size;
+
+  const SlruSizes main_sizes{GetMainSize(new_max_size)};
+  window_.SetMaxSize(GetWindowSize(new_max_size));
+  main_.SetMaxSize(main_sizes.probation_size, main_sizes.protected_size);
+  sketch_.SetCapacity(new_max_size);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void WTinyLfuBase<T, U, Hash, Equal>::Clear() noexcept {
+  window_.Clear();
+  main_.Clear();
+  sketch_.Clear();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void WTinyLfuBase<T, U, Hash, Equal>::VisitAll(Function&& func) const {
+  window_.VisitAll(func);
+  main_.VisitAll(func);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void WTinyLfuBase<T, U, Hash, Equal>::VisitAll(Function&& func) {
+  window_.VisitAll(func);
+  main_.VisitAll(func);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t WTinyLfuBase<T, U, Hash, Equal>::GetSize() const {
+  return window_.GetSize() + main_.GetSize();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t WTinyLfuBase<T, U, Hash, Equal>::GetCapacity() const {
+  return window_.GetCapacity() + main_.GetCapacity();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename WTinyLfuBase<T, U, Hash, Equal>::NodeType
+WTinyLfuBase<T, U, Hash, Equal>::MakeRoom() {
+  if (window_.GetSize() < window_.GetCapacity()) return {};
+
+  auto candidate = window_.ExtractLeastUsedNode();
+  UASSERT(candidate);
+  if (!main_.IsProbationFull()) {
+    main_.InsertNode(std::move(candidate));
+    return {};
+  }
+
+  const auto* const victim = main_.GetLeastUsedKey();
+  UASSERT(victim);
+  if (sketch_.GetFrequency(candidate->GetKey()) <=
+      sketch_.GetFrequency(*victim)) {
+    return candidate;
+  }
+
+  auto evicted = main_.ExtractLeastUsedNode();
+  main_.InsertNode(std::move(candidate));
+  return evicted;
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,33 @@
+#pragma once
+
+/// @file userver/cache/policy.hpp
+/// @brief @copybrief cache::CachePolicy
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @brief Admission and eviction policy of a size-bounded cache
+enum class CachePolicy {
+  /// Evicts the least recently used element
+  kLRU,
+  /// Segmented LRU: the elements accessed at least twice are moved to a
+  /// protected segment and are evicted only after the elements seen once
+  kSLRU,
+  /// W-TinyLFU: new elements go to a small LRU window, and leave it for the
+  /// main SLRU segment only if they are accessed more often than the element
+  /// they would evict. Access frequencies are estimated by a count-min sketch.
+  /// Resistant to scans that would flush the working set of an LRU.
+  kWTinyLFU,
+  /// CLOCK: a hit only sets the reference bit of the element, and the clock
+  /// hand evicts the first element without the bit, clearing the bits it
+  /// passes. cache::NWayLRU serves hits of such ways without locking them,
+  /// but each modification copies the index of the way, so the policy suits
+  /// read-mostly caches with a high hit rate. Supported by cache::NWayLRU
+  /// and the caches built on it only.
+  kClock,
+};
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -10,7 +10,12 @@ USERVER_NAMESPACE_BEGIN
 namespace logging {
 
 /// Log formats
-enum class Format { kTskv, kLtsv, kRaw };
+///
+/// kBinary is a compact length-prefixed binary format that is cheaper to
+/// produce than the text ones. Each record starts with a marker, so the
+/// records after a truncated one are still readable. Use
+/// scripts/binary_logs.py to render it as tskv, ltsv or JSON.
+enum class Format { kTskv, kLtsv, kRaw, kBinary };
 
 /// Parse Format enum from string
 Format FormatFromString(std::string_view format_str);
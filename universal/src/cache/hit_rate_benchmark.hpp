@@ -0,0 +1,76 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::bench {
+
+/// Keys accessed with a Zipf distribution, interleaved with scans of the keys
+/// that are accessed only once
+inline const std::vector<unsigned>& GetZipfWithScansTrace() {
+  static const auto kTrace = [] {
+    constexpr unsigned kKeysCount = 100'000;
+    constexpr std::size_t kAccessesCount = 1'000'000;
+    constexpr std::size_t kScanPeriod = 20'000;
+    constexpr std::size_t kScanSize = 5'000;
+
+    std::vector<double> cdf(kKeysCount);
+    double sum = 0;
+    for (unsigned i = 0; i < kKeysCount; ++i) {
+      sum += 1.0 / std::pow(i + 1, 0.9);
+      cdf[i] = sum;
+    }
+
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<double> distribution{0, sum};
+    std::vector<unsigned> trace;
+    trace.reserve(kAccessesCount);
+    unsigned next_scan_key = kKeysCount;
+    while (trace.size() < kAccessesCount) {
+      if (trace.size() % kScanPeriod == 0) {
+        for (std::size_t i = 0; i < kScanSize; ++i) {
+          trace.push_back(next_scan_key++);
+        }
+      }
+      const auto it =
+          std::lower_bound(cdf.begin(), cdf.end(), distribution(generator));
+      trace.push_back(static_cast<unsigned>(it - cdf.begin()));
+    }
+    return trace;
+  }();
+  return kTrace;
+}
+
+/// Replays the trace through a cache that reads through on misses, reports
+/// the hit rate in the `hit_rate` counter
+template <typename MakeCache>
+void RunHitRate(benchmark::State& state, MakeCache make_cache) {
+  const auto& trace = GetZipfWithScansTrace();
+  std::size_t hits = 0;
+  for ([[maybe_unused]] auto _ : state) {
+    auto cache = make_cache(static_cast<std::size_t>(state.range(0)));
+    hits = 0;
+    for (const auto key : trace) {
+      if (cache.Get(key)) {
+        ++hits;
+      } else {
+        cache.Put(key, key);
+      }
+    }
+    benchmark::DoNotOptimize(cache);
+  }
+  state.SetItemsProcessed(state.iterations() * trace.size());
+  state.counters["hit_rate"] =
+      static_cast<double>(hits) / static_cast<double>(trace.size());
+}
+
+}  // namespace cache::bench
+
+USERVER_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include <benchmark/benchmark.h>
 
+#include <cache/hit_rate_benchmark.hpp>
+#include <userver/cache/lru_map.hpp>
 #include <userver/cache/lru_set.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -51,4 +53,11 @@ void LruPutOverflow(benchmark::State& state) {
 }
 BENCHMARK(LruPutOverflow);
 
+void LruHitRate(benchmark::State& state) {
+  cache::bench::RunHitRate(state, [](std::size_t size) {
+    return cache::LruMap<unsigned, unsigned>(size);
+  });
+}
+BENCHMARK(LruHitRate)->Arg(1000)->Arg(10000);
+
 USERVER_NAMESPACE_END
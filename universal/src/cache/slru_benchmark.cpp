@@ -1,6 +1,8 @@
 #include <benchmark/benchmark.h>
 
+#include <cache/hit_rate_benchmark.hpp>
 #include <userver/cache/impl/slru.hpp>
+#include <userver/cache/impl/tinylfu.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -81,4 +83,19 @@ void SlruPutOverflow(benchmark::State& state) {
 }
 BENCHMARK(SlruPutOverflow);
 
+void SlruHitRate(benchmark::State& state) {
+  cache::bench::RunHitRate(state, [](std::size_t size) {
+    const cache::impl::SlruSizes sizes{size};
+    return Slru(sizes.probation_size, sizes.protected_size);
+  });
+}
+BENCHMARK(SlruHitRate)->Arg(1000)->Arg(10000);
+
+void WTinyLfuHitRate(benchmark::State& state) {
+  cache::bench::RunHitRate(state, [](std::size_t size) {
+    return cache::impl::WTinyLfuBase<unsigned, unsigned>(size);
+  });
+}
+BENCHMARK(WTinyLfuHitRate)->Arg(1000)->Arg(10000);
+
 USERVER_NAMESPACE_END
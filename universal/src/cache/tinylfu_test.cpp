@@ -0,0 +1,87 @@
+#include <userver/cache/impl/tinylfu.hpp>
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(FrequencySketch, Frequency) {
+  cache::impl::FrequencySketch<std::size_t> sketch(100);
+  EXPECT_EQ(sketch.GetFrequency(1), 0);
+
+  for (std::size_t i = 0; i < 5; ++i) sketch.RecordAccess(1);
+  sketch.RecordAccess(2);
+  EXPECT_EQ(sketch.GetFrequency(1), 5);
+  EXPECT_EQ(sketch.GetFrequency(2), 1);
+
+  for (std::size_t i = 0; i < 100; ++i) sketch.RecordAccess(3);
+  EXPECT_EQ(sketch.GetFrequency(3), 15);
+
+  sketch.Clear();
+  EXPECT_EQ(sketch.GetFrequency(1), 0);
+  EXPECT_EQ(sketch.GetFrequency(3), 0);
+}
+
+TEST(FrequencySketch, Aging) {
+  constexpr std::size_t kCapacity = 1024;
+  cache::impl::FrequencySketch<std::size_t> sketch(kCapacity);
+  for (std::size_t i = 0; i < 15; ++i) sketch.RecordAccess(0);
+  EXPECT_EQ(sketch.GetFrequency(0), 15);
+
+  for (std::size_t i = 1; i <= 10 * kCapacity; ++i) sketch.RecordAccess(i);
+  EXPECT_LT(sketch.GetFrequency(0), 15);
+}
+
+TEST(WTinyLfuBase, Sample) {
+  cache::impl::WTinyLfuBase<std::string, int> cache(100);
+
+  EXPECT_TRUE(cache.Put("a", 1));
+  EXPECT_FALSE(cache.Put("a", 2));
+  EXPECT_EQ(*cache.Get("a"), 2);
+  EXPECT_EQ(*cache.Emplace("b", 3), 3);
+  EXPECT_EQ(cache.GetSize(), 2);
+
+  cache.Erase("a");
+  EXPECT_EQ(cache.Get("a"), nullptr);
+  EXPECT_EQ(cache.GetSize(), 1);
+
+  cache.Clear();
+  EXPECT_EQ(cache.GetSize(), 0);
+}
+
+TEST(WTinyLfuBase, SizeLimit) {
+  constexpr std::size_t kSize = 100;
+  cache::impl::WTinyLfuBase<std::size_t, std::size_t> cache(kSize);
+  EXPECT_EQ(cache.GetCapacity(), kSize);
+
+  for (std::size_t i = 0; i < 10 * kSize; ++i) cache.Put(i, i);
+  EXPECT_LE(cache.GetSize(), kSize);
+
+  cache.SetMaxSize(kSize / 2);
+  EXPECT_LE(cache.GetSize(), kSize / 2);
+}
+
+TEST(WTinyLfuBase, ScanResistance) {
+  constexpr std::size_t kSize = 100;
+  constexpr std::size_t kHotKeys = 50;
+  cache::impl::WTinyLfuBase<std::size_t, std::size_t> cache(kSize);
+
+  for (std::size_t round = 0; round < 8; ++round) {
+    for (std::size_t i = 0; i < kHotKeys; ++i) {
+      if (!cache.Get(i)) cache.Put(i, i);
+    }
+  }
+
+  // keys that are accessed once do not evict the frequently used ones
+  for (std::size_t i = kSize; i < 6 * kSize; ++i) {
+    if (!cache.Get(i)) cache.Put(i, i);
+  }
+
+  for (std::size_t i = 0; i < kHotKeys; ++i) {
+    ASSERT_TRUE(cache.Get(i)) << i;
+    EXPECT_EQ(*cache.Get(i), i);
+  }
+}
+
+USERVER_NAMESPACE_END
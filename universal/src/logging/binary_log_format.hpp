@@ -0,0 +1,145 @@
+#pragma once
+
+// Layout of logging::Format::kBinary records. The same layout is implemented
+// by scripts/binary_logs.py, keep them in sync.
+//
+// All integers are little-endian. A record is:
+//   u32 kRecordMarker
+//   u32 size of the rest of the record
+//   u8  format version (kVersion)
+//   u8  logging::Level
+//   u64 microseconds since the UNIX epoch
+//   tags until the end of the record
+//
+// A tag is a key followed by value parts and a PartType::kEnd byte. A key is
+// either a non-zero id from kInternedKeys, or kInlineKey followed by a varint
+// size and the key bytes. The text representation of a value is
+// a concatenation of its parts.
+//
+// A truncated or corrupted record has no reliable size, so the decoders skip
+// to the next kRecordMarker that starts a record that decodes.
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+#include <userver/utils/trivial_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl::binary {
+
+inline constexpr std::uint8_t kVersion = 2;
+
+// Bytes 1E B1 C3 5A, starts with the ASCII record separator
+inline constexpr std::uint32_t kRecordMarker = 0x5AC3B11E;
+
+inline constexpr std::size_t kRecordMarkerBytes = sizeof(std::uint32_t);
+inline constexpr std::size_t kRecordSizeBytes = sizeof(std::uint32_t);
+inline constexpr std::size_t kRecordHeaderSize =
+    kRecordMarkerBytes + kRecordSizeBytes + 2 * sizeof(std::uint8_t) +
+    sizeof(std::uint64_t);
+
+enum class PartType : std::uint8_t {
+  kEnd = 0,
+  kText = 1,       // u32 size + bytes
+  kUnsigned = 2,   // varint
+  kSigned = 3,     // zigzag varint
+  kHex = 4,        // u64, rendered as `0x` and 16 upper case hex digits
+  kHexShort = 5,   // varint, rendered as upper case hex digits
+  kHexBytes = 6,   // u8 size + bytes, rendered as lower case hex digits
+};
+
+inline constexpr std::uint8_t kInlineKey = 0;
+
+// Ids are a part of the format: never change or reuse them, only append.
+inline constexpr utils::TrivialBiMap kInternedKeys = [](auto selector) {
+  return selector()
+      .Case("module", 1)
+      .Case("task_id", 2)
+      .Case("thread_id", 3)
+      .Case("text", 4)
+      .Case("trace_id", 5)
+      .Case("span_id", 6)
+      .Case("parent_id", 7)
+      .Case("link", 8)
+      .Case("parent_link", 9)
+      .Case("span_ref_type", 10)
+      .Case("stopwatch_name", 11)
+      .Case("total_time", 12)
+      .Case("stopwatch_units", 13)
+      .Case("start_timestamp", 14)
+      .Case("_type", 15)
+      .Case("meta_type", 16);
+};
+
+inline std::optional<std::uint8_t> FindInternedKey(
+    std::string_view key) noexcept {
+  const auto id = kInternedKeys.TryFindByFirst(key);
+  if (!id) return std::nullopt;
+  return static_cast<std::uint8_t>(*id);
+}
+
+// Values of these keys are usually hex-encoded ids, they are stored as bytes.
+inline constexpr bool IsHexIdKey(std::uint8_t key_id) noexcept {
+  return key_id >= 5 && key_id <= 9;
+}
+
+template <typename Buffer>
+void AppendByte(Buffer& buffer, std::uint8_t value) {
+  buffer.push_back(static_cast<char>(value));
+}
+
+template <typename Buffer>
+void AppendFixed(Buffer& buffer, std::uint64_t value, std::size_t bytes) {
+  for (std::size_t i = 0; i < bytes; ++i) {
+    AppendByte(buffer, static_cast<std::uint8_t>(value >> (8 * i)));
+  }
+}
+
+inline void StoreFixed(char* position, std::uint64_t value,
+                       std::size_t bytes) noexcept {
+  for (std::size_t i = 0; i < bytes; ++i) {
+    position[i] = static_cast<char>(static_cast<std::uint8_t>(value >> (8 * i)));
+  }
+}
+
+template <typename Buffer>
+void AppendVarint(Buffer& buffer, std::uint64_t value) {
+  while (value >= 0x80) {
+    AppendByte(buffer, static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  AppendByte(buffer, static_cast<std::uint8_t>(value));
+}
+
+inline constexpr std::uint64_t ZigZagEncode(std::int64_t value) noexcept {
+  return (static_cast<std::uint64_t>(value) << 1) ^
+         static_cast<std::uint64_t>(value >> 63);
+}
+
+inline constexpr bool IsLowerHexId(std::string_view value) noexcept {
+  if (value.empty() || value.size() % 2 != 0 || value.size() > 510) {
+    return false;
+  }
+  for (const char c : value) {
+    if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) return false;
+  }
+  return true;
+}
+
+template <typename Buffer>
+void AppendHexBytes(Buffer& buffer, std::string_view hex) {
+  const auto digit = [](char c) -> std::uint8_t {
+    return c <= '9' ? c - '0' : c - 'a' + 10;
+  };
+  AppendByte(buffer, static_cast<std::uint8_t>(hex.size() / 2));
+  for (std::size_t i = 0; i < hex.size(); i += 2) {
+    AppendByte(buffer, (digit(hex[i]) << 4) | digit(hex[i + 1]));
+  }
+}
+
+}  // namespace logging::impl::binary
+
+USERVER_NAMESPACE_END
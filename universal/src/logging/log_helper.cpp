@@ -339,13 +339,9 @@ void LogHelper::PutFloatingPoint(long double value) {
                  FMT_COMPILE("{}"), value);
 }
 void LogHelper::PutUnsigned(unsigned long long value) {
-  fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()),
-                 FMT_COMPILE("{}"), value);
-}
-void LogHelper::PutSigned(long long value) {
-  fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()),
-                 FMT_COMPILE("{}"), value);
+  pimpl_->PutUnsignedPart(value);
 }
+void LogHelper::PutSigned(long long value) { pimpl_->PutSignedPart(value); }
 void LogHelper::PutBoolean(bool value) {
   fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()),
                  FMT_COMPILE("{}"), value);
@@ -353,8 +349,7 @@ void LogHelper::PutBoolean(bool value) {
 
 LogHelper& LogHelper::operator<<(Hex hex) noexcept {
   try {
-    fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()),
-                   FMT_COMPILE("0x{:016X}"), hex.value);
+    pimpl_->PutHexPart(hex.value);
   } catch (...) {
     InternalLoggingError("Failed to extend log Hex");
   }
@@ -363,8 +358,7 @@ LogHelper& LogHelper::operator<<(Hex hex) noexcept {
 
 LogHelper& LogHelper::operator<<(HexShort hex) noexcept {
   try {
-    fmt::format_to(fmt::appender(pimpl_->GetBufferForRawValuePart()),
-                   FMT_COMPILE("{:X}"), hex.value);
+    pimpl_->PutHexShortPart(hex.value);
   } catch (...) {
     InternalLoggingError("Failed to extend log HexShort");
   }
@@ -6,6 +6,7 @@
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
+#include <logging/binary_log_format.hpp>
 #include <userver/compiler/impl/constexpr.hpp>
 #include <userver/compiler/thread_local.hpp>
 #include <userver/logging/impl/logger_base.hpp>
@@ -18,10 +19,13 @@ namespace logging {
 
 namespace {
 
+namespace binary = impl::binary;
+
 char GetSeparatorFromLogger(LoggerRef logger) {
   switch (logger.GetFormat()) {
     case Format::kTskv:
     case Format::kRaw:
+    case Format::kBinary:
       return '=';
     case Format::kLtsv:
       return ':';
@@ -88,7 +92,8 @@ std::streamsize LogHelper::Impl::BufferStd::xsputn(const char_type* s,
 LogHelper::Impl::Impl(LoggerRef logger, Level level) noexcept
     : logger_(&logger),
       level_(std::max(level, logger_->GetLevel())),
-      key_value_separator_(GetSeparatorFromLogger(*logger_)) {
+      key_value_separator_(GetSeparatorFromLogger(*logger_)),
+      is_binary_(logger_->GetFormat() == Format::kBinary) {
   static_assert(sizeof(LogHelper::Impl) < 4096,
                 "Structures with size more than 4096 would consume at least "
                 "8KB memory in allocator.");
@@ -128,14 +133,37 @@ void LogHelper::Impl::PutMessageBegin() {
       msg_.append(std::string_view{"tskv"});
       return;
     }
+    case Format::kBinary: {
+      const auto now = std::chrono::time_point_cast<std::chrono::microseconds>(
+          TimePoint::clock::now());
+      binary::AppendFixed(msg_, binary::kRecordMarker,
+                          binary::kRecordMarkerBytes);
+      binary::AppendFixed(msg_, 0, binary::kRecordSizeBytes);
+      binary::AppendByte(msg_, binary::kVersion);
+      binary::AppendByte(msg_, static_cast<std::uint8_t>(level_));
+      binary::AppendFixed(msg_, now.time_since_epoch().count(),
+                          sizeof(std::uint64_t));
+      UASSERT(msg_.size() == binary::kRecordHeaderSize);
+      return;
+    }
   }
   UASSERT_MSG(false, "Invalid value of Format enum");
 }
 
-void LogHelper::Impl::PutMessageEnd() { msg_.push_back('\n'); }
+void LogHelper::Impl::PutMessageEnd() {
+  if (is_binary_) {
+    PutPendingValueEnd();
+    constexpr auto kSizeOffset = binary::kRecordMarkerBytes;
+    binary::StoreFixed(msg_.data() + kSizeOffset,
+                       msg_.size() - kSizeOffset - binary::kRecordSizeBytes,
+                       binary::kRecordSizeBytes);
+    return;
+  }
+  msg_.push_back('\n');
+}
 
 void LogHelper::Impl::PutKey(std::string_view key) {
-  if (!utils::encoding::ShouldKeyBeEscaped(key)) {
+  if (is_binary_ || !utils::encoding::ShouldKeyBeEscaped(key)) {
     PutRawKey(key);
   } else {
     UASSERT(!std::exchange(is_within_value_, true));
@@ -150,6 +178,10 @@ void LogHelper::Impl::PutKey(std::string_view key) {
 void LogHelper::Impl::PutRawKey(std::string_view key) {
   UASSERT(!std::exchange(is_within_value_, true));
   CheckRepeatedKeys(key);
+  if (is_binary_) {
+    PutBinaryKey(key);
+    return;
+  }
   const auto old_size = msg_.size();
   msg_.resize(old_size + 1 + key.size() + 1);
 
@@ -162,23 +194,95 @@ void LogHelper::Impl::PutRawKey(std::string_view key) {
 
 void LogHelper::Impl::PutValuePart(std::string_view value) {
   UASSERT(is_within_value_);
+  if (is_binary_) {
+    if (binary::IsHexIdKey(binary_key_id_) && binary::IsLowerHexId(value)) {
+      CloseTextPart();
+      binary::AppendByte(msg_,
+                         static_cast<std::uint8_t>(binary::PartType::kHexBytes));
+      binary::AppendHexBytes(msg_, value);
+    } else {
+      OpenTextPart();
+      msg_.append(value);
+    }
+    return;
+  }
   utils::encoding::EncodeTskv(msg_, value,
                               utils::encoding::EncodeTskvMode::kValue);
 }
 
 void LogHelper::Impl::PutValuePart(char text_part) {
   UASSERT(is_within_value_);
+  if (is_binary_) {
+    OpenTextPart();
+    msg_.push_back(text_part);
+    return;
+  }
   utils::encoding::EncodeTskv(fmt::appender(msg_), text_part,
                               utils::encoding::EncodeTskvMode::kValue);
 }
 
-LogBuffer& LogHelper::Impl::GetBufferForRawValuePart() noexcept {
+LogBuffer& LogHelper::Impl::GetBufferForRawValuePart() {
   UASSERT(is_within_value_);
+  if (is_binary_) OpenTextPart();
   return msg_;
 }
 
+void LogHelper::Impl::PutUnsignedPart(unsigned long long value) {
+  UASSERT(is_within_value_);
+  if (is_binary_) {
+    CloseTextPart();
+    binary::AppendByte(msg_,
+                       static_cast<std::uint8_t>(binary::PartType::kUnsigned));
+    binary::AppendVarint(msg_, value);
+    return;
+  }
+  fmt::format_to(fmt::appender(msg_), FMT_COMPILE("{}"), value);
+}
+
+void LogHelper::Impl::PutSignedPart(long long value) {
+  UASSERT(is_within_value_);
+  if (is_binary_) {
+    CloseTextPart();
+    binary::AppendByte(msg_,
+                       static_cast<std::uint8_t>(binary::PartType::kSigned));
+    binary::AppendVarint(msg_, binary::ZigZagEncode(value));
+    return;
+  }
+  fmt::format_to(fmt::appender(msg_), FMT_COMPILE("{}"), value);
+}
+
+void LogHelper::Impl::PutHexPart(std::uint64_t value) {
+  UASSERT(is_within_value_);
+  if (is_binary_) {
+    CloseTextPart();
+    binary::AppendByte(msg_, static_cast<std::uint8_t>(binary::PartType::kHex));
+    binary::AppendFixed(msg_, value, sizeof(value));
+    return;
+  }
+  fmt::format_to(fmt::appender(msg_), FMT_COMPILE("0x{:016X}"), value);
+}
+
+void LogHelper::Impl::PutHexShortPart(std::uint64_t value) {
+  UASSERT(is_within_value_);
+  if (is_binary_) {
+    CloseTextPart();
+    binary::AppendByte(msg_,
+                       static_cast<std::uint8_t>(binary::PartType::kHexShort));
+    binary::AppendVarint(msg_, value);
+    return;
+  }
+  fmt::format_to(fmt::appender(msg_), FMT_COMPILE("{:X}"), value);
+}
+
 void LogHelper::Impl::MarkValueEnd() noexcept {
   UASSERT(std::exchange(is_within_value_, false));
+  if (is_binary_) {
+    // The terminator is appended by the next key or by PutMessageEnd, because
+    // appending might throw.
+    CloseTextPart();
+    is_value_end_pending_ = true;
+    binary_key_id_ = 0;
+  }
 }
 
 void LogHelper::Impl::StartText() {
@@ -208,6 +312,40 @@ void LogHelper::Impl::MarkAsBroken() noexcept { logger_ = nullptr; }
 
 bool LogHelper::Impl::IsBroken() const noexcept { return !logger_; }
 
+void LogHelper::Impl::PutBinaryKey(std::string_view key) {
+  PutPendingValueEnd();
+  if (const auto id = binary::FindInternedKey(key)) {
+    binary::AppendByte(msg_, *id);
+    binary_key_id_ = *id;
+  } else {
+    binary::AppendByte(msg_, binary::kInlineKey);
+    binary::AppendVarint(msg_, key.size());
+    msg_.append(key);
+    binary_key_id_ = 0;
+  }
+}
+
+void LogHelper::Impl::OpenTextPart() {
+  if (text_part_begin_ != 0) return;
+  binary::AppendByte(msg_, static_cast<std::uint8_t>(binary::PartType::kText));
+  text_part_begin_ = msg_.size();
+  binary::AppendFixed(msg_, 0, sizeof(std::uint32_t));
+}
+
+void LogHelper::Impl::CloseTextPart() noexcept {
+  if (text_part_begin_ == 0) return;
+  const auto size = msg_.size() - text_part_begin_ - sizeof(std::uint32_t);
+  binary::StoreFixed(msg_.data() + text_part_begin_, size,
+                     sizeof(std::uint32_t));
+  text_part_begin_ = 0;
+}
+
+void LogHelper::Impl::PutPendingValueEnd() {
+  if (!is_value_end_pending_) return;
+  binary::AppendByte(msg_, static_cast<std::uint8_t>(binary::PartType::kEnd));
+  is_value_end_pending_ = false;
+}
+
 void LogHelper::Impl::CheckRepeatedKeys(
     [[maybe_unused]] std::string_view raw_key) {
   UASSERT_MSG(debug_tag_keys_->insert(std::string{raw_key}).second,
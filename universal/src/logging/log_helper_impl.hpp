@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
 #include <ostream>
 #include <unordered_set>
@@ -35,7 +36,12 @@ class LogHelper::Impl final {
 
   void PutValuePart(std::string_view value);
   void PutValuePart(char text_part);
-  LogBuffer& GetBufferForRawValuePart() noexcept;
+  LogBuffer& GetBufferForRawValuePart();
+
+  void PutUnsignedPart(unsigned long long value);
+  void PutSignedPart(long long value);
+  void PutHexPart(std::uint64_t value);
+  void PutHexShortPart(std::uint64_t value);
 
   bool IsWithinValue() const noexcept { return is_within_value_; }
   void MarkValueEnd() noexcept;
@@ -78,14 +84,25 @@ class LogHelper::Impl final {
 
   void CheckRepeatedKeys(std::string_view raw_key);
 
+  // Format::kBinary helpers
+  void PutBinaryKey(std::string_view key);
+  void OpenTextPart();
+  void CloseTextPart() noexcept;
+  void PutPendingValueEnd();
+
   impl::LoggerBase* logger_;
   const Level level_;
   const char key_value_separator_;
+  const bool is_binary_;
   LogBuffer msg_;
   std::optional<LazyInitedStream> lazy_stream_;
   LogExtra extra_;
   std::size_t initial_length_{0};
   bool is_within_value_{false};
+  bool is_value_end_pending_{false};
+  std::uint8_t binary_key_id_{0};
+  // Position of the size of the currently open binary text part, 0 if none
+  std::size_t text_part_begin_{0};
   std::optional<std::unordered_set<std::string>> debug_tag_keys_;
 };
 